@@ -170,6 +170,8 @@ void SERCOM1_1_Handler()
 void SERCOM1_2_Handler()
 {
   Serial1.IrqHandler();
+  // RXC: let the firmware react to the new byte without polling
+  if (Serial1_rxHook) Serial1_rxHook();
 }
 void SERCOM1_3_Handler()
 {
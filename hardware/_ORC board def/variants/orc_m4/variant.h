@@ -258,6 +258,10 @@ extern Uart Serial3;
 extern Uart Serial4;
 extern Uart Serial5;
 
+// Optional hook called from the Serial1 receive interrupt after the byte has
+// been buffered. Weak: define it in the firmware to wake a task.
+extern void Serial1_rxHook(void) __attribute__((weak));
+
 #endif
 
 // These serial port names are intended to allow libraries and architecture-neutral
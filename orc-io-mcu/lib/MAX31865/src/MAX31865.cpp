@@ -29,7 +29,20 @@ int numDevices = 0;
 */
 /**************************************************************************/
 MAX31865::MAX31865(int8_t spi_cs, SPIClass *spi)
-    : _spiConfig{spi, spi_cs, SPISettings(4000000, MSBFIRST, SPI_MODE1)} {}
+    : _spiConfig{spi, spi_cs, SPISettings(4000000, MSBFIRST, SPI_MODE1), nullptr, SPIBUS_NO_DEVICE} {}
+
+/**************************************************************************/
+/*!
+    @brief Share the SPI port through a bus manager: register transfers run
+    under its lock. Call before begin().
+    @param bus The bus the SPI port belongs to
+    @param device Device id from SPIBus::addDevice()
+*/
+/**************************************************************************/
+void MAX31865::setBus(SPIBus *bus, uint8_t device) {
+  _spiConfig.bus = bus;
+  _spiConfig.busDevice = device;
+}
 
 /**************************************************************************/
 /*!
@@ -42,7 +55,9 @@ MAX31865::MAX31865(int8_t spi_cs, SPIClass *spi)
 bool MAX31865::begin(max31865_numwires_t wires) {
   pinMode(_spiConfig.cs, OUTPUT);
   digitalWrite(_spiConfig.cs, HIGH);
+  if (_spiConfig.bus) _spiConfig.bus->lock(_spiConfig.busDevice);
   _spiConfig.spi->begin();
+  if (_spiConfig.bus) _spiConfig.bus->unlock();
 
   setWires(wires);
   enableBias(false);
@@ -323,6 +338,53 @@ uint16_t MAX31865::readRTDauto(void) {
   return rtd;
 }
 
+/**************************************************************************/
+/*!
+    @brief Start a single conversion without waiting for it. Bias must
+    already be on and settled (~10 ms). The result is ready when DRDY goes
+    low, 52 ms (60 Hz filter) or 62.5 ms (50 Hz filter) later
+*/
+/**************************************************************************/
+void MAX31865::startOneShot(void) {
+  uint8_t t = readRegister8(MAX31865_CONFIG_REG);
+  t |= MAX31865_CONFIG_1SHOT;
+  writeRegister8(MAX31865_CONFIG_REG, t);
+}
+
+/**************************************************************************/
+/*!
+    @brief Start the automatic fault detection cycle without waiting for it.
+    Stops auto conversion and leaves bias on. Poll faultCycleDone(), then
+    readFault(MAX31865_FAULT_NONE) for the result
+*/
+/**************************************************************************/
+void MAX31865::startFaultCycle(void) {
+  uint8_t cfg_reg = readRegister8(MAX31865_CONFIG_REG);
+  cfg_reg &= 0x11; // mask out wire and filter bits
+  _autoMode = false;
+  writeRegister8(MAX31865_CONFIG_REG, (cfg_reg | 0b10000100));
+}
+
+/**************************************************************************/
+/*!
+    @brief Check whether the fault detection cycle has finished
+    @return True once the fault cycle bits have cleared
+*/
+/**************************************************************************/
+bool MAX31865::faultCycleDone(void) {
+  return (readRegister8(MAX31865_CONFIG_REG) & 0x0C) == 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief Read the RTD register as it stands, in either mode
+    @return The raw 16-bit register: code in bits 15..1, fault flag in bit 0
+*/
+/**************************************************************************/
+uint16_t MAX31865::readRTDraw(void) {
+  return readRegister16(MAX31865_RTDMSB_REG);
+}
+
 /**********************************************/
 
 uint8_t MAX31865::readRegister8(uint8_t addr) {
@@ -351,6 +413,7 @@ void MAX31865::readRegisterN(uint8_t addr, uint8_t buffer[], uint8_t n) {
 
   addr &= 0x7F; // make sure top bit is not set
 
+  if (_spiConfig.bus) _spiConfig.bus->lock(_spiConfig.busDevice);
   _spiConfig.spi->beginTransaction(_spiConfig.settings);
 
   digitalWrite(_spiConfig.cs, LOW);
@@ -359,6 +422,7 @@ void MAX31865::readRegisterN(uint8_t addr, uint8_t buffer[], uint8_t n) {
   digitalWrite(_spiConfig.cs, HIGH);
 
   _spiConfig.spi->endTransaction();
+  if (_spiConfig.bus) _spiConfig.bus->unlock();
 
   #ifdef MAX31865_DEBUG
     Serial.println("R end");
@@ -376,12 +440,14 @@ void MAX31865::writeRegister8(uint8_t addr, uint8_t data) {
 
   uint8_t buffer[2] = {addr, data};
   
+  if (_spiConfig.bus) _spiConfig.bus->lock(_spiConfig.busDevice);
   _spiConfig.spi->beginTransaction(_spiConfig.settings);
 
   digitalWrite(_spiConfig.cs, LOW);
   _spiConfig.spi->transfer(buffer, 2);
   digitalWrite(_spiConfig.cs, HIGH);
   _spiConfig.spi->endTransaction();
+  if (_spiConfig.bus) _spiConfig.bus->unlock();
 
   #ifdef MAX31865_DEBUG
     Serial.println("W end");
@@ -55,6 +55,7 @@
 
 #include "Arduino.h"
 #include "SPI.h"
+#include "SPIBus.h"
 
 typedef enum max31865_numwires {
   MAX31865_2WIRE = 0,
@@ -73,6 +74,8 @@ struct SPIConfig_t {
   SPIClass *spi;
   int8_t cs;
   SPISettings settings;
+  SPIBus *bus;
+  uint8_t busDevice;
 };
 
 /*! Interface class for the MAX31865 RTD Sensor reader */
@@ -81,12 +84,19 @@ public:
   MAX31865(int8_t spi_cs, SPIClass *spi = &SPI);
 
   bool begin(max31865_numwires_t x = MAX31865_3WIRE);
+  void setBus(SPIBus *bus, uint8_t device);
 
   uint8_t readFault(max31865_fault_cycle_t fault_cycle = MAX31865_FAULT_AUTO);
   void clearFault(void);
   uint16_t readRTD1shot(void);
   uint16_t readRTDauto(void);
 
+  // Non-blocking building blocks: the caller does the waiting
+  void startOneShot(void);
+  void startFaultCycle(void);
+  bool faultCycleDone(void);
+  uint16_t readRTDraw(void);
+
   void setThresholds(uint16_t lower, uint16_t upper);
   uint16_t getLowerThreshold(void);
   uint16_t getUpperThreshold(void);
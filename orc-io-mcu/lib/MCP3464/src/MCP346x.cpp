@@ -50,7 +50,9 @@ bool MCP346x::begin(void)
 	delay(10);
 	
 	// SPI init
+	if(bus) bus->lock(bus_device);
 	descriptor.spi_port->begin();
+	if(bus) bus->unlock();
 	
 	// Reset MCP346x IC and write device configuration
 	uint8_t cmd = {MCP346X_ADDRESS_bm | MCP346X_FULL_RST_bm | MCP346X_FAST_COMMAND_bm};
@@ -64,11 +66,13 @@ bool MCP346x::begin(void)
 // Single byte write function (sends byte as it is passed in to function), returns status byte
 uint8_t MCP346x::write(uint8_t tx_byte)
 {
+	if(bus) bus->lock(bus_device);
 	digitalWrite(descriptor.cs_pin, LOW);
 	descriptor.spi_port->beginTransaction(SPISettings(MCP346x_SPI_CLK_FREQ_MHz, MSBFIRST, SPI_MODE0));
 	uint8_t rx_byte = descriptor.spi_port->transfer(tx_byte);
 	descriptor.spi_port->endTransaction();
 	digitalWrite(descriptor.cs_pin, HIGH);
+	if(bus) bus->unlock();
 	return rx_byte;
 }
 
@@ -76,12 +80,14 @@ uint8_t MCP346x::write(uint8_t tx_byte)
 uint8_t MCP346x::write(uint8_t *tx_data, uint8_t num_bytes, uint8_t reg_addr_bm)
 {
 	uint8_t reg_write_cmd = MCP346X_ADDRESS_bm | reg_addr_bm | MCP346X_INC_WRITE_bm;
+	if(bus) bus->lock(bus_device);
 	digitalWrite(descriptor.cs_pin, LOW);
 	descriptor.spi_port->beginTransaction(SPISettings(MCP346x_SPI_CLK_FREQ_MHz, MSBFIRST, SPI_MODE0));
 	uint8_t rx_byte = descriptor.spi_port->transfer(reg_write_cmd);
 	for(int i = 0; i < num_bytes; i++) descriptor.spi_port->transfer(tx_data[i]);
 	descriptor.spi_port->endTransaction();
 	digitalWrite(descriptor.cs_pin, HIGH);
+	if(bus) bus->unlock();
 	return rx_byte;
 }
 
@@ -89,12 +95,14 @@ uint8_t MCP346x::write(uint8_t *tx_data, uint8_t num_bytes, uint8_t reg_addr_bm)
 int MCP346x::read(uint8_t *rx_buf, uint8_t num_bytes, uint8_t reg_addr_bm)
 {
 	uint8_t reg_read_cmd = MCP346X_ADDRESS_bm | reg_addr_bm | MCP346X_INC_READ_bm;
+	if(bus) bus->lock(bus_device);
 	digitalWrite(descriptor.cs_pin, LOW);
 	descriptor.spi_port->beginTransaction(SPISettings(MCP346x_SPI_CLK_FREQ_MHz, MSBFIRST, SPI_MODE0));
 	descriptor.spi_port->transfer(reg_read_cmd);
 	for(int i = 0; i < num_bytes; i++) rx_buf[i] = descriptor.spi_port->transfer(0);
 	descriptor.spi_port->endTransaction();
 	digitalWrite(descriptor.cs_pin, HIGH);
+	if(bus) bus->unlock();
 	return 1;
 }
 
@@ -184,10 +192,9 @@ bool MCP346x::read_adc(void)
 		uint8_t rx_data[4];
 		read(rx_data, 4, MCP346X_ADCDATA_bm);
 		
-		uint8_t channel = (rx_data[0] >> 4) & 0x0F;
-				
-		descriptor.results[channel] = (uint32_t)rx_data[2] << 8 | (uint32_t)rx_data[3];
-		if(rx_data[1] && 1) descriptor.results[channel] -= 0xFFFF;
+		uint8_t channel;
+		int32_t result = decode_adc_data(rx_data, &channel);
+		descriptor.results[channel] = result;
 		
 		descriptor.microvolts[channel] = (float)descriptor.results[channel] * MCP346X_uV_PER_LSB;
 		
@@ -197,6 +204,26 @@ bool MCP346x::read_adc(void)
 	return false;
 }
 
+void MCP346x::set_data_ready_callback(void (*callback)(void))
+{
+	data_ready_callback = callback;
+}
+
+void MCP346x::set_bus(SPIBus *spi_bus, uint8_t device)
+{
+	bus = spi_bus;
+	bus_device = device;
+}
+
+// Channel ID in the top nibble, then the sign byte and the 16-bit result
+int32_t MCP346x::decode_adc_data(const uint8_t *rx_data, uint8_t *channel)
+{
+	*channel = (rx_data[0] >> 4) & 0x0F;
+	int32_t result = (uint32_t)rx_data[2] << 8 | (uint32_t)rx_data[3];
+	if(rx_data[1] && 1) result -= 0xFFFF;
+	return result;
+}
+
 //----------------------------------Private Functions-------------------------------------//
 
 void MCP346x::get_config_bytes(uint8_t *config_bytes)
@@ -251,6 +278,7 @@ void MCP346x::get_config_bytes(uint8_t *config_bytes)
 void MCP346x::adc_read_complete_ISR(void)
 {
 	adc_completed = true;
+	if(data_ready_callback) data_ready_callback();
 
 	// Read ADC from within ISR - only use if a single IC is on this SPI bus!!!
 	/*noInterrupts();
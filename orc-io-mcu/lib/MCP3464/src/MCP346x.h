@@ -8,6 +8,7 @@ Driver library for the MCP3464 sigma delta 8 channel ADC. Read the datasheet and
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <SPIBus.h>
 
 //Hardware Specific
 #define MCP346X_ADDRESS_bm			0x01 << 6
@@ -258,6 +259,9 @@ class MCP346x
 		bool start_continuous_adc(uint16_t channels);
 		bool start_single_adc(uint16_t channels);
 		bool read_adc(void);
+		void set_data_ready_callback(void (*callback)(void));	// Runs in the IRQ ISR, keep it short
+		void set_bus(SPIBus *spi_bus, uint8_t device);			// Shared bus: register transfers run under its lock
+		static int32_t decode_adc_data(const uint8_t *rx_data, uint8_t *channel);	// 4 ADCDATA bytes (32-bit with channel ID)
 		
 	private:
 		void get_config_bytes(uint8_t *config_bytes);
@@ -266,7 +270,10 @@ class MCP346x
 			anchor->adc_read_complete_ISR();
 		}		
 		static MCP346x* anchor;
-		bool adc_completed = false;
+		volatile bool adc_completed = false;
+		void (*data_ready_callback)(void) = nullptr;
+		SPIBus *bus = nullptr;
+		uint8_t bus_device = SPIBUS_NO_DEVICE;
 };
 
 #endif //MCP346x_h
\ No newline at end of file
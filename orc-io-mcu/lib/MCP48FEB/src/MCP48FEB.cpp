@@ -23,7 +23,9 @@ bool MCP48FEBxx::begin(void) {
         pinMode(_dac_lat_pin, OUTPUT);
         digitalWrite(_dac_lat_pin, LOW);    // Write new DAC values immediately
     }
+    if (_dac_bus) _dac_bus->lock(_dac_bus_device);
     _dac_spi->begin();
+    if (_dac_bus) _dac_bus->unlock();
     uint16_t data = 0;
     _initialised = true;
     bool valid = readRegister(MCP48FEBxx_REG_GAIN_STATUS, &data);
@@ -145,6 +147,7 @@ bool MCP48FEBxx:: readRegister(uint8_t reg, uint16_t *data) {
     if (!_initialised) return false;
     uint8_t cmd_valid = 0;
     uint8_t cmd = reg << MCP48FEBxx_REG_ADDRESS_bp | MCP48FEBxx_CMD_READ << MCP48FEBxx_CMD_bp;
+    if (_dac_bus) _dac_bus->lock(_dac_bus_device);
     _dac_spi->beginTransaction(SPISettings(MCP48FEBxx_SPI_SPEED, MSBFIRST, SPI_MODE0));
     digitalWrite(_dac_cs_pin, LOW);
     cmd_valid = _dac_spi->transfer(cmd);
@@ -152,6 +155,7 @@ bool MCP48FEBxx:: readRegister(uint8_t reg, uint16_t *data) {
     if (cmd_valid) *data = _dac_spi->transfer16(0);
     digitalWrite(_dac_cs_pin, HIGH);
     _dac_spi->endTransaction();
+    if (_dac_bus) _dac_bus->unlock();
     return (bool)cmd_valid;
 }
 
@@ -159,6 +163,7 @@ bool MCP48FEBxx:: writeRegister(uint8_t reg, uint16_t data) {
     if (!_initialised) return false;
     uint8_t cmd_valid = 0;
     uint8_t cmd = reg << MCP48FEBxx_REG_ADDRESS_bp | MCP48FEBxx_CMD_WRITE << MCP48FEBxx_CMD_bp;
+    if (_dac_bus) _dac_bus->lock(_dac_bus_device);
     _dac_spi->beginTransaction(SPISettings(MCP48FEBxx_SPI_SPEED, MSBFIRST, SPI_MODE0));
     digitalWrite(_dac_cs_pin, LOW);
     cmd_valid = _dac_spi->transfer(cmd);
@@ -166,9 +171,15 @@ bool MCP48FEBxx:: writeRegister(uint8_t reg, uint16_t data) {
     if (cmd_valid) _dac_spi->transfer16(data);
     digitalWrite(_dac_cs_pin, HIGH);
     _dac_spi->endTransaction();
+    if (_dac_bus) _dac_bus->unlock();
     return (bool)cmd_valid;
 }
 
+void MCP48FEBxx::setBus(SPIBus *bus, uint8_t device) {
+    _dac_bus = bus;
+    _dac_bus_device = device;
+}
+
 // Private functions
 bool MCP48FEBxx::waitForEEWA(void) {
     bool busy = true;
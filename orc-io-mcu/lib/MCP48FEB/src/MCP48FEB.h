@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <SPIBus.h>
 
 // SPI speed 10MHz
 #define MCP48FEBxx_SPI_SPEED              10000000
@@ -116,6 +117,7 @@ class MCP48FEBxx
 
         // Initialisation
         bool begin(void);
+        void setBus(SPIBus *bus, uint8_t device);      // Shared bus: call before begin(), transfers run under its lock
 
         // Configuration functions
         bool setVREF(uint8_t channel, MCP48FEBxx_VREF vref);
@@ -146,6 +148,8 @@ class MCP48FEBxx
         int _dac_cs_pin;
         int _dac_lat_pin;
         SPIClass *_dac_spi;
+        SPIBus *_dac_bus = nullptr;
+        uint8_t _dac_bus_device = SPIBUS_NO_DEVICE;
         bool _initialised;
 
         // Safe wait for EEPROM write to complete (wait max of MCP48FEBxx_EEPROM_MAX_WAIT_ms)
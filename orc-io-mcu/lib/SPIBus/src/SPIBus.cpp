@@ -0,0 +1,318 @@
+#include "SPIBus.h"
+
+// Queue and active-transfer state is shared with ISRs. PRIMASK is saved so
+// the same sections can run inside an ISR without re-enabling interrupts.
+#if defined(__arm__)
+static inline uint32_t busEnterCritical(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+static inline void busExitCritical(uint32_t primask) {
+    __set_PRIMASK(primask);
+}
+#else
+static inline uint32_t busEnterCritical(void) {
+    noInterrupts();
+    return 0;
+}
+static inline void busExitCritical(uint32_t primask) {
+    (void)primask;
+    interrupts();
+}
+#endif
+
+#if SPIBUS_DMA
+SPIBus *SPIBus::_dmaOwners[2] = {nullptr, nullptr};
+#endif
+
+SPIBus::SPIBus(SPIClass *spi) : _spi(spi) {
+}
+
+#if SPIBUS_DMA
+SPIBus::SPIBus(SPIClass *spi, Sercom *sercom, uint8_t rxTrigger, uint8_t txTrigger)
+    : _spi(spi), _sercom(sercom), _rxTrigger(rxTrigger), _txTrigger(txTrigger) {
+}
+#endif
+
+bool SPIBus::begin(void) {
+    _spi->begin();
+    resetStats();
+#if SPIBUS_DMA
+    if (_sercom == nullptr || _dmaReady) return true;
+    uint8_t slot = _dmaOwners[0] == nullptr ? 0 : 1;
+    if (_dmaOwners[slot] != nullptr) return false;
+    if (_rxDma.allocate() != DMA_STATUS_OK) return false;
+    if (_txDma.allocate() != DMA_STATUS_OK) {
+        _rxDma.free();
+        return false;
+    }
+
+    // One beat per SERCOM trigger: RX empties DATA as each byte arrives, TX
+    // refills it as soon as it is free. The descriptors are rewritten for
+    // every transfer by changeDescriptor().
+    void *data = (void *)&_sercom->SPI.DATA.reg;
+    _rxDma.setTrigger(_rxTrigger);
+    _rxDma.setAction(DMA_TRIGGER_ACTON_BEAT);
+    _txDma.setTrigger(_txTrigger);
+    _txDma.setAction(DMA_TRIGGER_ACTON_BEAT);
+    _rxDesc = _rxDma.addDescriptor(data, &_dummyRx, 1, DMA_BEAT_SIZE_BYTE, false, false);
+    _txDesc = _txDma.addDescriptor(&_dummyTx, data, 1, DMA_BEAT_SIZE_BYTE, false, false);
+    if (_rxDesc == nullptr || _txDesc == nullptr) {
+        _rxDma.free();
+        _txDma.free();
+        return false;
+    }
+    _rxDma.setCallback(dmaComplete);
+    _dmaOwners[slot] = this;
+    _dmaReady = true;
+#endif
+    return true;
+}
+
+bool SPIBus::dmaEnabled(void) const {
+#if SPIBUS_DMA
+    return _dmaReady;
+#else
+    return false;
+#endif
+}
+
+uint8_t SPIBus::addDevice(const char *name, uint8_t csPin, SPISettings settings) {
+    if (_deviceCount >= SPIBUS_MAX_DEVICES) return SPIBUS_NO_DEVICE;
+    uint8_t device = _deviceCount;
+    _csPin[device] = csPin;
+    _settings[device] = settings;
+    memset(&_stats[device], 0, sizeof(SPIBusDeviceStats));
+    strncpy(_stats[device].name, name, SPIBUS_NAME_LEN - 1);
+    _deviceCount++;
+    return device;
+}
+
+uint8_t SPIBus::getDeviceCount(void) const {
+    return _deviceCount;
+}
+
+bool SPIBus::queue(SPIBusTransaction *txn) {
+    if (txn == nullptr || txn->device >= _deviceCount || txn->length == 0) return false;
+
+    uint32_t primask = busEnterCritical();
+    if (txn->state == SPIBUS_TXN_QUEUED || txn->state == SPIBUS_TXN_ACTIVE) {
+        _stats[txn->device].refused++;
+        busExitCritical(primask);
+        return false;
+    }
+    txn->state = SPIBUS_TXN_QUEUED;
+    txn->queuedUs = micros();
+    txn->next = nullptr;
+    if (_tail) _tail->next = txn;
+    else _head = txn;
+    _tail = txn;
+    if (++_queueDepth > _queuePeak) _queuePeak = _queueDepth;
+    bool idle = _active == nullptr && !_locked;
+    if (!idle) _stats[txn->device].deferred++;
+    busExitCritical(primask);
+
+    if (idle) startNext();
+    return true;
+}
+
+void SPIBus::lock(uint8_t device) {
+    uint32_t start = micros();
+    uint32_t primask = busEnterCritical();
+    _locked = true;         // Nothing new starts from here on
+    busExitCritical(primask);
+
+    while (_active != nullptr) {
+        if (micros() - start > SPIBUS_LOCK_TIMEOUT_US) {
+#if SPIBUS_DMA
+            _txDma.abort();
+            _rxDma.abort();
+#endif
+            _lockTimeouts++;
+            primask = busEnterCritical();
+            if (_active != nullptr) finish(SPIBUS_TXN_ABORTED);
+            busExitCritical(primask);
+            break;
+        }
+    }
+
+    _lockDevice = device;
+    _lockStartUs = micros();
+    if (device < _deviceCount) {
+        uint32_t wait = _lockStartUs - start;
+        if (wait > _stats[device].maxWaitUs) _stats[device].maxWaitUs = wait;
+    }
+}
+
+void SPIBus::unlock(void) {
+    uint32_t now = micros();
+    uint32_t primask = busEnterCritical();
+    if (_lockDevice < _deviceCount) {
+        SPIBusDeviceStats *stats = &_stats[_lockDevice];
+        stats->lockedTransactions++;
+        stats->busyUs += now - _lockStartUs;
+    }
+    addBusy(now, now - _lockStartUs);
+    _lockDevice = SPIBUS_NO_DEVICE;
+    _locked = false;
+    busExitCritical(primask);
+    startNext();
+}
+
+// Start the head of the queue if the bus is free. Runs from task context
+// (queue, unlock) and from the completion ISR; the pop is atomic so only one
+// of them can claim the bus.
+void SPIBus::startNext(void) {
+    uint32_t primask = busEnterCritical();
+    SPIBusTransaction *txn = _head;
+    if (txn == nullptr || _active != nullptr || _locked) {
+        busExitCritical(primask);
+        return;
+    }
+    _head = txn->next;
+    if (_head == nullptr) _tail = nullptr;
+    _queueDepth--;
+    _active = txn;
+    txn->state = SPIBUS_TXN_ACTIVE;
+    busExitCritical(primask);
+
+    _activeStartUs = micros();
+    SPIBusDeviceStats *stats = &_stats[txn->device];
+    uint32_t wait = _activeStartUs - txn->queuedUs;
+    if (wait > stats->maxWaitUs) stats->maxWaitUs = wait;
+    transfer(txn);
+}
+
+void SPIBus::transfer(SPIBusTransaction *txn) {
+    _spi->beginTransaction(_settings[txn->device]);
+    digitalWrite(_csPin[txn->device], LOW);
+
+#if SPIBUS_DMA
+    if (_dmaReady) {
+        // Fixed dummy addresses when there is no buffer: the increment bits
+        // must be right before changeDescriptor() works out the end address
+        void *data = (void *)&_sercom->SPI.DATA.reg;
+        _rxDesc->BTCTRL.bit.DSTINC = txn->rx != nullptr;
+        _txDesc->BTCTRL.bit.SRCINC = txn->tx != nullptr;
+        _rxDma.changeDescriptor(_rxDesc, data, txn->rx ? txn->rx : &_dummyRx, txn->length);
+        _txDma.changeDescriptor(_txDesc, txn->tx ? (void *)txn->tx : &_dummyTx, data, txn->length);
+        _rxDma.startJob();      // RX first so no byte is missed
+        _txDma.startJob();
+        return;
+    }
+#endif
+
+    for (uint16_t i = 0; i < txn->length; i++) {
+        uint8_t rx = _spi->transfer(txn->tx ? txn->tx[i] : 0);
+        if (txn->rx) txn->rx[i] = rx;
+    }
+    uint32_t primask = busEnterCritical();
+    finish(SPIBUS_TXN_DONE);
+    busExitCritical(primask);
+    startNext();
+}
+
+// Release the bus from the active transaction. Called with interrupts
+// disabled; the callback and event run here too.
+void SPIBus::finish(uint8_t state) {
+    SPIBusTransaction *txn = _active;
+    uint32_t now = micros();
+    digitalWrite(_csPin[txn->device], HIGH);
+    _spi->endTransaction();
+
+    SPIBusDeviceStats *stats = &_stats[txn->device];
+    if (state == SPIBUS_TXN_DONE) {
+        stats->queuedTransactions++;
+        stats->queuedBytes += txn->length;
+    } else {
+        stats->aborted++;
+    }
+    stats->busyUs += now - _activeStartUs;
+    addBusy(now, now - _activeStartUs);
+
+    txn->state = state;
+    _active = nullptr;
+    if (txn->callback) txn->callback(txn);
+    if (txn->event) txn->event->post();
+}
+
+void SPIBus::addBusy(uint32_t now, uint32_t busyUs) {
+    _busyUs += busyUs;
+    _windowBusyUs += busyUs;
+    uint32_t window = now - _windowStartUs;
+    if (window >= SPIBUS_UTIL_WINDOW_US) {
+        uint32_t util = (uint32_t)((uint64_t)_windowBusyUs * 1000 / window);
+        _utilisation = util > 1000 ? 1000 : util;
+        if (_utilisation > _peakUtilisation) _peakUtilisation = _utilisation;
+        _windowStartUs = now;
+        _windowBusyUs = 0;
+    }
+}
+
+#if SPIBUS_DMA
+void SPIBus::dmaComplete(Adafruit_ZeroDMA *dma) {
+    for (uint8_t i = 0; i < 2; i++) {
+        SPIBus *bus = _dmaOwners[i];
+        if (bus == nullptr || dma != &bus->_rxDma) continue;
+        // RX finishes last: every byte has been clocked and read back
+        uint32_t primask = busEnterCritical();
+        if (bus->_active != nullptr) bus->finish(SPIBUS_TXN_DONE);
+        busExitCritical(primask);
+        bus->startNext();
+        return;
+    }
+}
+#endif
+
+const SPIBusDeviceStats *SPIBus::getDeviceStats(uint8_t device) const {
+    if (device >= _deviceCount) return nullptr;
+    return &_stats[device];
+}
+
+uint16_t SPIBus::getUtilisation(void) {
+    // A quiet bus has no transfers to close the window
+    uint32_t primask = busEnterCritical();
+    addBusy(micros(), 0);
+    busExitCritical(primask);
+    return _utilisation;
+}
+
+uint16_t SPIBus::getPeakUtilisation(void) const {
+    return _peakUtilisation;
+}
+
+uint32_t SPIBus::getBusyUs(void) const {
+    return _busyUs;
+}
+
+uint8_t SPIBus::getQueuePeak(void) const {
+    return _queuePeak;
+}
+
+uint32_t SPIBus::getLockTimeouts(void) const {
+    return _lockTimeouts;
+}
+
+void SPIBus::resetStats(void) {
+    uint32_t primask = busEnterCritical();
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        SPIBusDeviceStats *stats = &_stats[i];
+        stats->queuedTransactions = 0;
+        stats->lockedTransactions = 0;
+        stats->queuedBytes = 0;
+        stats->busyUs = 0;
+        stats->maxWaitUs = 0;
+        stats->deferred = 0;
+        stats->refused = 0;
+        stats->aborted = 0;
+    }
+    _queuePeak = _queueDepth;
+    _lockTimeouts = 0;
+    _busyUs = 0;
+    _windowStartUs = micros();
+    _windowBusyUs = 0;
+    _utilisation = 0;
+    _peakUtilisation = 0;
+    busExitCritical(primask);
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Scheduler.h>
+
+// Shared SPI bus manager.
+//
+// Every chip select on one SPIClass is registered as a device. Two kinds of
+// access are arbitrated:
+//  - Queued transactions: caller-owned SPIBusTransaction structs are queued
+//    (from a task or an ISR) and run back to back. By default they run
+//    synchronously in queue() (or in unlock() if the bus was locked). Built
+//    with -DSPIBUS_DMA=1 on the SAMD51 they run on two DMAC channels of the
+//    SERCOM, so the CPU is free for the transfer. Completion runs the
+//    transaction callback (interrupt context) and/or posts its scheduler task.
+//  - Locked access: the device libraries keep their blocking register
+//    transfers and wrap them in lock()/unlock(). lock() waits for the DMA
+//    transfer in flight and holds the queue until unlock().
+//
+// Per-device transaction counts, bus time and waits are kept for both, and
+// bus utilisation is measured over 1 s windows.
+
+#define SPIBUS_MAX_DEVICES          8
+#define SPIBUS_NO_DEVICE            0xFF
+#define SPIBUS_NAME_LEN             12
+#define SPIBUS_LOCK_TIMEOUT_US      2000        // lock() aborts a DMA transfer that runs longer than this
+#define SPIBUS_UTIL_WINDOW_US       1000000
+
+// The DMA engine is opt-in until it has been run on the board. It needs
+// Adafruit_ZeroDMA, which ships with the Adafruit SAMD core.
+#ifndef SPIBUS_DMA
+#define SPIBUS_DMA                  0
+#endif
+#if SPIBUS_DMA
+#if !defined(__SAMD51__)
+#error "SPIBUS_DMA needs the SAMD51 DMAC"
+#endif
+#include <Adafruit_ZeroDMA.h>
+#endif
+
+enum SPIBusTxnState : uint8_t {
+    SPIBUS_TXN_IDLE,
+    SPIBUS_TXN_QUEUED,
+    SPIBUS_TXN_ACTIVE,
+    SPIBUS_TXN_DONE,
+    SPIBUS_TXN_ABORTED          // Cut short by a lock() timeout, rx is incomplete
+};
+
+struct SPIBusTransaction;
+typedef void (*SPIBusCallback)(SPIBusTransaction *txn);
+
+// Owned by the caller and must stay valid (and unmodified) until it is no
+// longer QUEUED or ACTIVE. The buffers are used in place by the DMA.
+struct SPIBusTransaction {
+    uint8_t device;
+    const uint8_t *tx;          // nullptr clocks out zeros
+    uint8_t *rx;                // nullptr discards the received bytes
+    uint16_t length;
+    SPIBusCallback callback;    // Interrupt context, keep it short. May queue() again.
+    ScheduledTask *event;       // Posted after the callback
+    void *context;
+    volatile uint8_t state;     // SPIBusTxnState
+    uint32_t queuedUs;          // micros() when queued
+    SPIBusTransaction *next;
+};
+
+struct SPIBusDeviceStats {
+    char name[SPIBUS_NAME_LEN];
+    uint32_t queuedTransactions;    // Completed queued transactions
+    uint32_t lockedTransactions;    // lock()/unlock() pairs
+    uint32_t queuedBytes;
+    uint32_t busyUs;                // Bus time held, both kinds
+    uint32_t maxWaitUs;             // Longest wait for the bus, queue or lock
+    uint32_t deferred;              // Transactions that found the bus busy
+    uint32_t refused;               // queue() with the transaction still pending
+    uint32_t aborted;               // Transfers cut short by a lock() timeout
+};
+
+class SPIBus {
+public:
+    SPIBus(SPIClass *spi);
+#if SPIBUS_DMA
+    // DMA capable: the SERCOM behind spi and its DMAC trigger sources
+    SPIBus(SPIClass *spi, Sercom *sercom, uint8_t rxTrigger, uint8_t txTrigger);
+#endif
+
+    bool begin(void);           // Starts the SPIClass, allocates the DMA channels
+    bool dmaEnabled(void) const;
+
+    // Returns the device id, or SPIBUS_NO_DEVICE when the table is full.
+    // settings are only used for queued transactions.
+    uint8_t addDevice(const char *name, uint8_t csPin, SPISettings settings = SPISettings());
+    uint8_t getDeviceCount(void) const;
+
+    // Queue a transaction, safe from an ISR. Returns false if it is invalid or
+    // still queued/active from an earlier call.
+    bool queue(SPIBusTransaction *txn);
+
+    // Exclusive use of the bus for a blocking transfer. Not from an ISR and
+    // not reentrant; every lock() needs its unlock().
+    void lock(uint8_t device);
+    void unlock(void);
+
+    const SPIBusDeviceStats *getDeviceStats(uint8_t device) const;
+    uint16_t getUtilisation(void);          // Last full window, per mille
+    uint16_t getPeakUtilisation(void) const;
+    uint32_t getBusyUs(void) const;         // Total since resetStats()
+    uint8_t getQueuePeak(void) const;       // Deepest the queue has been
+    uint32_t getLockTimeouts(void) const;
+    void resetStats(void);
+
+private:
+    SPIClass *_spi;
+    uint8_t _csPin[SPIBUS_MAX_DEVICES];
+    SPISettings _settings[SPIBUS_MAX_DEVICES];
+    SPIBusDeviceStats _stats[SPIBUS_MAX_DEVICES];
+    uint8_t _deviceCount = 0;
+
+    SPIBusTransaction *_head = nullptr;
+    SPIBusTransaction *_tail = nullptr;
+    SPIBusTransaction * volatile _active = nullptr;
+    uint8_t _queueDepth = 0;
+    uint8_t _queuePeak = 0;
+    volatile bool _locked = false;
+    uint8_t _lockDevice = SPIBUS_NO_DEVICE;
+    uint32_t _activeStartUs = 0;
+    uint32_t _lockStartUs = 0;
+    uint32_t _lockTimeouts = 0;
+
+    uint32_t _busyUs = 0;
+    uint32_t _windowStartUs = 0;
+    uint32_t _windowBusyUs = 0;
+    uint16_t _utilisation = 0;
+    uint16_t _peakUtilisation = 0;
+
+    void startNext(void);
+    void transfer(SPIBusTransaction *txn);
+    void finish(uint8_t state);
+    void addBusy(uint32_t now, uint32_t busyUs);
+
+#if SPIBUS_DMA
+    Sercom *_sercom = nullptr;
+    uint8_t _rxTrigger = 0;
+    uint8_t _txTrigger = 0;
+    bool _dmaReady = false;
+    Adafruit_ZeroDMA _rxDma;
+    Adafruit_ZeroDMA _txDma;
+    DmacDescriptor *_rxDesc = nullptr;
+    DmacDescriptor *_txDesc = nullptr;
+    uint8_t _dummyTx = 0;
+    uint8_t _dummyRx = 0;
+
+    static void dmaComplete(Adafruit_ZeroDMA *dma);
+    static SPIBus *_dmaOwners[2];
+#endif
+};
@@ -45,49 +45,175 @@ bool NoBlockDelay::complete() {
 }
 
 // Scheduled task class
-ScheduledTask::ScheduledTask(TaskCallback callback, unsigned long interval, bool repeat, bool highPriority)
-    : _callback(callback),
-      _interval(interval),
-      _repeat(repeat),
-      _paused(false),
-      _highPriority(highPriority),
-      _timer(),                 // _timer comes before stats variables
-      _lastExecTime(0),
-      _minExecTime(ULONG_MAX),
-      _maxExecTime(0),
-      _totalExecTime(0),
-      _execCount(0),
-      _cpuUsageWindowStart(millis()),
-      _cpuUsageInWindow(0)
-{
-    _timer.setMode(_repeat);
-    if (_interval > 0) _timer.start(_interval);
-}
-
-void ScheduledTask::update() {
-    if (!_paused && _timer.complete()) {
-        unsigned long start = micros();
-        if (_callback) _callback();
-        unsigned long elapsed = micros() - start;
-        _updateStats(elapsed);
-        _updateCpuUsage(elapsed);
-    }
-}
-
-void ScheduledTask::pause() { _paused = true; }
-
-void ScheduledTask::resume() { _paused = false; }
+void ScheduledTask::_init(TaskCallback callback, unsigned long interval, bool repeat, bool highPriority) {
+    // Pool entries are reused: start from a clean slate
+    *this = ScheduledTask();
+    _callback = callback;
+    _intervalUs = interval * 1000UL;
+    _repeat = repeat;
+    _highPriority = highPriority;
+    _cpuUsageWindowStart = millis();
+    if (_intervalUs > 0) {
+        // Phase the first deadline on the SysTick edge (micros() == millis() * 1000 there)
+        _nextRun = millis() * 1000UL + _intervalUs;
+        _armed = true;
+    }
+}
+
+void ScheduledTask::_execute(unsigned long dueAt) {
+    unsigned long start = micros();
+    unsigned long lateness = ((long)(start - dueAt) > 0) ? (start - dueAt) : 0;
+    _lastLateness = lateness;
+    if (lateness > _maxLateness) _maxLateness = lateness;
+    _totalLateness += lateness;
+    _histogramAdd(_latenessHistogram, lateness);
+
+    if (_callback) _callback();
+    unsigned long elapsed = micros() - start;
+    _updateStats(elapsed);
+    _updateCpuUsage(elapsed);
+    _histogramAdd(_execHistogram, elapsed);
+    if (_budgetUs && elapsed > _budgetUs) _overrunCount++;
+}
+
+void ScheduledTask::_rearm(unsigned long now) {
+    if (!_repeat || _intervalUs == 0) {
+        _armed = false;
+        return;
+    }
+    if (_timing == TIMING_FIXED_DELAY) {
+        // Restart from the current tick, as NoBlockDelay did
+        _nextRun = millis() * 1000UL + _intervalUs;
+        return;
+    }
+
+    _nextRun += _intervalUs;
+    long behind = (long)(now - _nextRun);
+    if (behind < 0) return;
+
+    // The next slot is already in the past: we have missed whole periods
+    unsigned long missed = (unsigned long)behind / _intervalUs + 1;
+    if (_catchUp == CATCHUP_SKIP || missed > MAX_BURST_PERIODS) {
+        _nextRun += missed * _intervalUs;
+        _missedPeriods += missed;
+    }
+    // CATCHUP_BURST: leave the deadline in the past, the next update() runs it again
+}
+
+void ScheduledTask::setName(const char* name) {
+    strncpy(_name, name ? name : "", sizeof(_name) - 1);
+    _name[sizeof(_name) - 1] = '\0';
+}
+
+const char* ScheduledTask::getName() const { return _name; }
+
+void ScheduledTask::pause() {
+    if (_paused) return;
+    _paused = true;
+    if (_scheduler) _scheduler->_heapRemove(this);
+}
+
+void ScheduledTask::resume() {
+    if (!_paused) return;
+    _paused = false;
+    // Keep the original deadline: a task whose deadline passed while paused runs on the next update()
+    if (_scheduler && _armed) _scheduler->_heapPush(this);
+}
 
 bool ScheduledTask::isPaused() const { return _paused; }
 
 bool ScheduledTask::isHighPriority() const { return _highPriority; }
 
 void ScheduledTask::setInterval(unsigned long interval) {
-    _interval = interval;
-    _timer.start(_interval);
+    _intervalUs = interval * 1000UL;
+    if (_intervalUs == 0) {
+        // Not armed, as _init() leaves it: only post() runs the task
+        _armed = false;
+        if (_scheduler) _scheduler->_heapRemove(this);
+        return;
+    }
+    _nextRun = millis() * 1000UL + _intervalUs;
+    _armed = true;
+    if (_scheduler) _scheduler->_reschedule(this);
+}
+
+void ScheduledTask::setIntervalMicros(unsigned long intervalUs) {
+    _intervalUs = intervalUs;
+    if (_intervalUs == 0) {
+        // Not armed, as _init() leaves it: only post() runs the task
+        _armed = false;
+        if (_scheduler) _scheduler->_heapRemove(this);
+        return;
+    }
+    _nextRun = micros() + _intervalUs;
+    _armed = true;
+    if (_scheduler) _scheduler->_reschedule(this);
 }
 
-unsigned long ScheduledTask::getInterval() const { return _interval; }
+unsigned long ScheduledTask::getInterval() const { return _intervalUs / 1000UL; }
+
+unsigned long ScheduledTask::getIntervalMicros() const { return _intervalUs; }
+
+void ScheduledTask::setTiming(TaskTimingMode mode, TaskCatchUp catchUp) {
+    _timing = mode;
+    _catchUp = catchUp;
+}
+
+TaskTimingMode ScheduledTask::getTimingMode() const { return _timing; }
+
+TaskCatchUp ScheduledTask::getCatchUp() const { return _catchUp; }
+
+void ScheduledTask::post() {
+    // Latency is measured from the first post of a coalesced burst
+    if (!_eventPending) _postedAt = micros();
+    _eventPending = true;
+    if (_scheduler) _scheduler->_eventPosted = true;
+}
+
+bool ScheduledTask::isEventDriven() const { return _eventDriven; }
+
+unsigned long ScheduledTask::getEventCount() const { return _eventCount; }
+
+unsigned long ScheduledTask::getNextRunTime() const { return _nextRun; }
+
+bool ScheduledTask::isArmed() const { return _armed; }
+
+unsigned long ScheduledTask::getLastLateness() const { return _lastLateness; }
+
+unsigned long ScheduledTask::getMaxLateness() const { return _maxLateness; }
+
+float ScheduledTask::getAverageLateness() const { return _execCount ? ((float)_totalLateness / _execCount) : 0; }
+
+unsigned long ScheduledTask::getMissedPeriods() const { return _missedPeriods; }
+
+void ScheduledTask::setBudget(unsigned long budgetUs) { _budgetUs = budgetUs; }
+
+unsigned long ScheduledTask::getBudget() const { return _budgetUs; }
+
+unsigned long ScheduledTask::getOverrunCount() const { return _overrunCount; }
+
+const uint16_t* ScheduledTask::getExecHistogram() const { return _execHistogram; }
+
+const uint16_t* ScheduledTask::getLatenessHistogram() const { return _latenessHistogram; }
+
+unsigned long ScheduledTask::getExecCount() const { return _execCount; }
+
+uint8_t ScheduledTask::histogramBucket(unsigned long us) {
+    uint8_t bucket = 0;
+    while (us && bucket < SCHED_HIST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void ScheduledTask::_histogramAdd(uint16_t* histogram, unsigned long us) {
+    uint16_t& count = histogram[histogramBucket(us)];
+    if (count == UINT16_MAX) {
+        for (uint8_t i = 0; i < SCHED_HIST_BUCKETS; i++) histogram[i] >>= 1;
+    }
+    count++;
+}
 
 unsigned long ScheduledTask::getLastExecTime() const { return _lastExecTime; }
 
@@ -114,6 +240,14 @@ void ScheduledTask::resetStats() {
     _maxExecTime = 0;
     _totalExecTime = 0;
     _execCount = 0;
+    _lastLateness = 0;
+    _maxLateness = 0;
+    _totalLateness = 0;
+    _missedPeriods = 0;
+    _eventCount = 0;
+    _overrunCount = 0;
+    memset(_execHistogram, 0, sizeof(_execHistogram));
+    memset(_latenessHistogram, 0, sizeof(_latenessHistogram));
     _cpuUsageWindowStart = millis();
     _cpuUsageInWindow = 0;
 }
@@ -140,63 +274,345 @@ void ScheduledTask::_updateCpuUsage(unsigned long duration) {
 }
 
 // Task scheduler class
-TaskScheduler::~TaskScheduler() {
-    for (auto* task : _tasks) {
-        delete task;
+TaskScheduler::TaskScheduler() {
+    for (int i = SCHED_MAX_TASKS - 1; i >= 0; i--) {
+        _pool[i]._removed = true;
+        _pool[i]._next = _free;
+        _free = &_pool[i];
     }
-    _tasks.clear();
+    _freeCount = SCHED_MAX_TASKS;
 }
 
-ScheduledTask* TaskScheduler::addTask(TaskCallback callback, unsigned long interval, bool repeat, bool highPriority) {
-    ScheduledTask* task = new ScheduledTask(callback, interval, repeat, highPriority);
-    _tasks.push_back(task);
+ScheduledTask* TaskScheduler::addTask(TaskCallback callback, unsigned long interval, bool repeat, bool highPriority,
+                                      const char* name) {
+    if (_free == nullptr) return nullptr;
+    ScheduledTask* task = _free;
+    _free = task->_next;
+    _freeCount--;
+
+    task->_init(callback, interval, repeat, highPriority);
+    task->setName(name);
+    task->_scheduler = this;
+
+    // Append to the active list so report order follows creation order
+    task->_prev = _tail;
+    task->_next = nullptr;
+    if (_tail) _tail->_next = task;
+    else _head = task;
+    _tail = task;
+    _taskCount++;
+
+    if (task->_armed) _heapPush(task);
+    return task;
+}
+
+ScheduledTask* TaskScheduler::addEventTask(TaskCallback callback, const char* name, bool highPriority,
+                                           unsigned long fallbackInterval) {
+    ScheduledTask* task = addTask(callback, fallbackInterval, true, highPriority, name);
+    if (task) task->_eventDriven = true;
     return task;
 }
 
 void TaskScheduler::removeTask(ScheduledTask* task) {
-    _tasks.erase(std::remove(_tasks.begin(), _tasks.end(), task), _tasks.end());
-    delete task;
+    if (task == nullptr || task->_removed || task->_scheduler != this) return;
+    _heapRemove(task);
+
+    if (task->_prev) task->_prev->_next = task->_next;
+    else _head = task->_next;
+    if (task->_next) task->_next->_prev = task->_prev;
+    else _tail = task->_prev;
+    task->_prev = nullptr;
+    _taskCount--;
+
+    task->_removed = true;
+    task->_armed = false;
+    // Device/controller tasks are removed from inside IPC handlers, i.e. while
+    // update() may still hold the pointer in _due. Keep the entry out of the
+    // free list until dispatch has finished.
+    if (_dispatching) {
+        task->_next = _graveyard;
+        _graveyard = task;
+    } else {
+        task->_next = _free;
+        _free = task;
+        _freeCount++;
+    }
 }
 
 void TaskScheduler::update() {
-    for (auto* task : _tasks) {
-        if (task->isHighPriority()) task->update();
+    unsigned long now = micros();
+
+    // Pop everything that is due, then re-arm it before the callback runs so a
+    // callback calling setInterval()/pause() on itself behaves as before. A
+    // task is dispatched at most once per update(), even when bursting.
+    _dueCount = 0;
+    while (_queueCount > 0 && (long)(now - _queue[0]->_nextRun) >= 0) {
+        ScheduledTask* task = _queue[0];
+        _heapRemove(task);
+        task->_inDue = true;
+        _due[_dueCount] = task;
+        _dueAt[_dueCount] = task->_nextRun;
+        _dueCount++;
     }
-    for (auto* task : _tasks) {
-        if (!task->isHighPriority()) task->update();
+    for (int i = 0; i < _dueCount; i++) {
+        _due[i]->_rearm(now);
+        if (_due[i]->_armed) _heapPush(_due[i]);
+    }
+
+    if (_eventPosted) _collectEvents();
+
+    if (_dueCount == 0) {
+        _idle();
+        return;
+    }
+
+    _dispatching = true;
+    for (int i = 0; i < _dueCount; i++) {
+        ScheduledTask* task = _due[i];
+        if (task->isHighPriority() && !task->_removed && !task->_paused) task->_execute(_dueAt[i]);
+    }
+    for (int i = 0; i < _dueCount; i++) {
+        ScheduledTask* task = _due[i];
+        if (!task->isHighPriority() && !task->_removed && !task->_paused) task->_execute(_dueAt[i]);
+    }
+    _dispatching = false;
+    for (int i = 0; i < _dueCount; i++) {
+        _due[i]->_inDue = false;
+    }
+    _dueCount = 0;
+
+    while (_graveyard) {
+        ScheduledTask* task = _graveyard;
+        _graveyard = task->_next;
+        task->_next = _free;
+        _free = task;
+        _freeCount++;
+    }
+}
+
+size_t TaskScheduler::getTaskCapacity() const { return SCHED_MAX_TASKS; }
+
+size_t TaskScheduler::getFreeTaskCount() const { return _freeCount; }
+
+size_t TaskScheduler::getTaskCount() const { return _taskCount; }
+
+ScheduledTask* TaskScheduler::getTask(size_t index) const {
+    ScheduledTask* task = _head;
+    while (task && index--) task = task->_next;
+    return task;
+}
+
+ScheduledTask* TaskScheduler::firstTask() const { return _head; }
+
+ScheduledTask* TaskScheduler::nextTask(const ScheduledTask* task) const { return task ? task->_next : nullptr; }
+
+void TaskScheduler::resetAllStats() {
+    for (ScheduledTask* task = _head; task; task = task->_next) {
+        task->resetStats();
+    }
+    _idleWindowStart = millis();
+    _idleInWindow = 0;
+}
+
+void TaskScheduler::setIdleSleep(bool enabled) { _idleSleep = enabled; }
+
+bool TaskScheduler::getIdleSleep() const { return _idleSleep; }
+
+bool TaskScheduler::getNextDeadline(unsigned long* dueAt) const {
+    if (_eventPosted || _queueCount == 0) return false;
+    *dueAt = _queue[0]->_nextRun;
+    return true;
+}
+
+// Move posted tasks onto the dispatch list. A task that is also due by its
+// deadline this spin runs once and the post counts as served.
+void TaskScheduler::_collectEvents() {
+    _eventPosted = false;   // Cleared first: a post from here on is seen next update()
+    for (ScheduledTask* task = _head; task; task = task->_next) {
+        if (!task->_eventPending) continue;
+        task->_eventPending = false;
+        if (task->_inDue || task->_paused) continue;
+
+        task->_inDue = true;
+        task->_eventCount++;
+        _due[_dueCount] = task;
+        _dueAt[_dueCount] = task->_postedAt;
+        _dueCount++;
+
+        // Restart the fallback interval of an event-driven task
+        if (task->_eventDriven && task->_intervalUs > 0) {
+            task->_nextRun = millis() * 1000UL + task->_intervalUs;
+            task->_armed = true;
+            _reschedule(task);
+        }
     }
 }
 
+void TaskScheduler::_idle() {
+    unsigned long nowMs = millis();
+    if (nowMs - _idleWindowStart >= ScheduledTask::CPU_USAGE_WINDOW_MS) {
+        _idleWindowStart = nowMs;
+        _idleInWindow = 0;
+    }
+    if (!_idleSleep) return;
+
+    // Close to a deadline that does not sit on a SysTick edge: spin rather than
+    // oversleep to the next tick
+    unsigned long start = micros();
+    if (_queueCount > 0 && (long)(_queue[0]->_nextRun - start) <= (long)IDLE_SPIN_US) return;
+
+    // Any interrupt (SysTick, UART RX, USB) wakes the core and loop() spins again.
+    // With interrupts masked a post() that lands after the check still leaves
+    // its interrupt pending, so WFI falls straight through.
+#if defined(__arm__)
+    __disable_irq();
+    if (!_eventPosted) __WFI();
+    __enable_irq();
+#endif
+    _idleInWindow += micros() - start;
+}
+
+// Deadline heap ---------------------------------------------------------------
+
+bool TaskScheduler::_before(const ScheduledTask* a, const ScheduledTask* b) {
+    long diff = (long)(a->_nextRun - b->_nextRun);     // Wrap-safe micros() comparison
+    if (diff != 0) return diff < 0;
+    return a->_highPriority && !b->_highPriority;
+}
+
+void TaskScheduler::_heapSwap(int a, int b) {
+    ScheduledTask* tmp = _queue[a];
+    _queue[a] = _queue[b];
+    _queue[b] = tmp;
+    _queue[a]->_heapIndex = a;
+    _queue[b]->_heapIndex = b;
+}
+
+void TaskScheduler::_heapSiftUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!_before(_queue[index], _queue[parent])) break;
+        _heapSwap(index, parent);
+        index = parent;
+    }
+}
+
+void TaskScheduler::_heapSiftDown(int index) {
+    int count = _queueCount;
+    for (;;) {
+        int left = 2 * index + 1;
+        int right = left + 1;
+        int smallest = index;
+        if (left < count && _before(_queue[left], _queue[smallest])) smallest = left;
+        if (right < count && _before(_queue[right], _queue[smallest])) smallest = right;
+        if (smallest == index) break;
+        _heapSwap(index, smallest);
+        index = smallest;
+    }
+}
+
+void TaskScheduler::_heapPush(ScheduledTask* task) {
+    if (task->_heapIndex >= 0 || task->_paused || !task->_armed) return;
+    if (_queueCount >= SCHED_MAX_TASKS) return;     // Unreachable: every queued task is a pool entry
+    _queue[_queueCount] = task;
+    task->_heapIndex = _queueCount++;
+    _heapSiftUp(task->_heapIndex);
+}
+
+void TaskScheduler::_heapRemove(ScheduledTask* task) {
+    int index = task->_heapIndex;
+    if (index < 0) return;
+    int last = _queueCount - 1;
+    if (index != last) _heapSwap(index, last);
+    _queueCount--;
+    task->_heapIndex = -1;
+    if (index < last) {
+        _heapSiftUp(index);
+        _heapSiftDown(index);
+    }
+}
+
+void TaskScheduler::_reschedule(ScheduledTask* task) {
+    _heapRemove(task);
+    _heapPush(task);
+}
+
 float TaskScheduler::getTotalCpuUsagePercent() const {
     float totalUsage = 0.0;
-    for (const auto* task : _tasks) {
+    for (const ScheduledTask* task = _head; task; task = task->_next) {
         totalUsage += task->getCpuUsagePercent();
     }
     return totalUsage;
 }
 
+float TaskScheduler::getIdlePercent() const {
+    unsigned long windowDuration = millis() - _idleWindowStart;
+    if (windowDuration == 0) return 0.0;
+    return ((_idleInWindow / 1000.0) / windowDuration) * 100.0;
+}
+
+unsigned long TaskScheduler::getTotalOverrunCount() const {
+    unsigned long total = 0;
+    for (const ScheduledTask* task = _head; task; task = task->_next) {
+        total += task->getOverrunCount();
+    }
+    return total;
+}
+
 void TaskScheduler::printCpuUsageReport() const {
     Serial.println("=== CPU Usage Report ===");
     Serial.print("Total CPU Usage: ");
     Serial.print(getTotalCpuUsagePercent(), 2);
     Serial.println("%");
+    if (_idleSleep) {
+        Serial.print("Idle (WFI): ");
+        Serial.print(getIdlePercent(), 2);
+        Serial.println("%");
+    }
     Serial.println();
     
     Serial.println("Individual Task Usage:");
-    for (size_t i = 0; i < _tasks.size(); i++) {
-        const auto* task = _tasks[i];
-        Serial.print("Task ");
-        Serial.print(i);
+    size_t i = 0;
+    for (const ScheduledTask* task = _head; task; task = task->_next, i++) {
+        if (task->getName()[0]) {
+            Serial.print(task->getName());
+        } else {
+            Serial.print("Task ");
+            Serial.print(i);
+        }
         Serial.print(": ");
         Serial.print(task->getCpuUsagePercent(), 2);
         Serial.print("% (Avg: ");
         Serial.print(task->getAverageExecTime(), 1);
         Serial.print("μs, Interval: ");
         Serial.print(task->getInterval());
-        Serial.print("ms");
+        Serial.print("ms, Late avg/max: ");
+        Serial.print(task->getAverageLateness(), 1);
+        Serial.print("/");
+        Serial.print(task->getMaxLateness());
+        Serial.print("μs");
+        if (task->getOverrunCount()) {
+            Serial.print(", Overruns: ");
+            Serial.print(task->getOverrunCount());
+        }
+        if (task->getEventCount()) {
+            Serial.print(", Events: ");
+            Serial.print(task->getEventCount());
+        }
+        if (task->getMissedPeriods()) {
+            Serial.print(", Missed: ");
+            Serial.print(task->getMissedPeriods());
+        }
+        if (task->getTimingMode() == TIMING_FIXED_RATE) Serial.print(", FIXED RATE");
+        if (task->isEventDriven()) Serial.print(", EVENT");
         if (task->isHighPriority()) Serial.print(", HIGH PRIORITY");
         if (task->isPaused()) Serial.print(", PAUSED");
         Serial.println(")");
     }
+    Serial.print("Task pool: ");
+    Serial.print(_taskCount);
+    Serial.print("/");
+    Serial.print((int)SCHED_MAX_TASKS);
+    Serial.println(" used");
     Serial.println("========================");
 }
\ No newline at end of file
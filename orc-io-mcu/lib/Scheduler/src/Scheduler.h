@@ -1,8 +1,6 @@
 #pragma once
 
 #include <Arduino.h>
-#include <vector>
-#include <algorithm>
 
 class NoBlockDelay {
 public:
@@ -24,11 +22,31 @@ private:
 
 typedef void (*TaskCallback)();
 
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS         48      // Task pool size (fixed + device + controller tasks)
+#endif
+#define SCHED_TASK_NAME_LEN     16      // Task name buffer, terminator included
+#define SCHED_HIST_BUCKETS      16      // log2 buckets: [0] = 0 us, [n] = 2^(n-1)..2^n - 1 us, last is open-ended
+
+// How a repeating task computes its next deadline after it runs
+enum TaskTimingMode : uint8_t {
+    TIMING_FIXED_DELAY,     // Next run = dispatch time + interval (legacy, late runs shift the period)
+    TIMING_FIXED_RATE       // Next run = previous deadline + interval (drift-free)
+};
+
+// What a fixed-rate task does when it has missed one or more whole periods
+enum TaskCatchUp : uint8_t {
+    CATCHUP_SKIP,           // Drop the missed periods and resume on the next slot in the grid
+    CATCHUP_BURST           // Run once per update() until caught up (bounded by MAX_BURST_PERIODS)
+};
+
+class TaskScheduler;
+
+// Tasks live in the scheduler's static pool; use TaskScheduler::addTask() to get one
 class ScheduledTask {
 public:
-    ScheduledTask(TaskCallback callback, unsigned long interval, bool repeat = true, bool highPriority = false);
-
-    void update();
+    void setName(const char* name);
+    const char* getName() const;
 
     void pause();
     void resume();
@@ -36,7 +54,44 @@ public:
     bool isHighPriority() const;
 
     void setInterval(unsigned long interval);
+    void setIntervalMicros(unsigned long intervalUs);
     unsigned long getInterval() const;
+    unsigned long getIntervalMicros() const;
+
+    void setTiming(TaskTimingMode mode, TaskCatchUp catchUp = CATCHUP_SKIP);
+    TaskTimingMode getTimingMode() const;
+    TaskCatchUp getCatchUp() const;
+
+    // Event trigger, safe to call from an ISR: the task runs on the next
+    // update() instead of waiting for its deadline. Posts coalesce until then.
+    void post();
+    bool isEventDriven() const;
+    unsigned long getEventCount() const;        // Runs triggered by post()
+
+    // micros() deadline of the next run, only meaningful while isArmed()
+    unsigned long getNextRunTime() const;
+    bool isArmed() const;
+
+    // Start lateness (callback start - deadline, or - first post for event runs) in microseconds
+    unsigned long getLastLateness() const;
+    unsigned long getMaxLateness() const;
+    float getAverageLateness() const;
+    unsigned long getMissedPeriods() const;     // Periods dropped by CATCHUP_SKIP / burst overflow
+
+    // Execution time budget; a run longer than the budget counts as an overrun.
+    // 0 (default) means no budget: the task is never counted as overrunning.
+    void setBudget(unsigned long budgetUs);
+    unsigned long getBudget() const;
+    unsigned long getOverrunCount() const;
+
+    // log2 histograms of execution time and start lateness (SCHED_HIST_BUCKETS
+    // entries). Counters saturate by halving the whole histogram, so the shape
+    // is kept with a bias towards recent runs.
+    const uint16_t* getExecHistogram() const;
+    const uint16_t* getLatenessHistogram() const;
+    static uint8_t histogramBucket(unsigned long us);
+
+    unsigned long getExecCount() const;
 
     unsigned long getLastExecTime() const;
     unsigned long getMinExecTime() const;
@@ -47,40 +102,148 @@ public:
     void resetStats();
 
 private:
+    friend class TaskScheduler;
+
+    ScheduledTask() = default;
+    void _init(TaskCallback callback, unsigned long interval, bool repeat, bool highPriority);
+    void _execute(unsigned long dueAt);
+    void _rearm(unsigned long now);
     void _updateStats(unsigned long duration);
     void _updateCpuUsage(unsigned long duration);
-
-    TaskCallback _callback;
-    unsigned long _interval;
-    bool _repeat;
-    bool _paused;
-    bool _highPriority;
-    NoBlockDelay _timer;
+    static void _histogramAdd(uint16_t* histogram, unsigned long us);
+
+    TaskCallback _callback = nullptr;
+    char _name[SCHED_TASK_NAME_LEN] = "";
+    unsigned long _intervalUs = 0;
+    bool _repeat = true;
+    bool _paused = false;
+    bool _highPriority = false;
+    TaskTimingMode _timing = TIMING_FIXED_DELAY;
+    TaskCatchUp _catchUp = CATCHUP_SKIP;
+
+    // A late fixed-rate CATCHUP_BURST task is resynchronised (as CATCHUP_SKIP) beyond this many periods
+    static const unsigned long MAX_BURST_PERIODS = 10;
+
+    // Pool and deadline bookkeeping, owned by the scheduler
+    TaskScheduler* _scheduler = nullptr;
+    ScheduledTask* _prev = nullptr;     // Task list (free list uses _next only)
+    ScheduledTask* _next = nullptr;
+    unsigned long _nextRun = 0;     // micros() deadline, compared wrap-safe (intervals < ~35 min)
+    bool _armed = false;            // Has a pending deadline (false for expired one-shots / interval 0)
+    bool _removed = false;          // Removed while the scheduler was dispatching, delete deferred
+    int _heapIndex = -1;            // Position in the scheduler's deadline heap, -1 when not queued
+    bool _inDue = false;            // Already in this update()'s dispatch list
+
+    // Event trigger, written from interrupt context
+    volatile bool _eventPending = false;
+    volatile unsigned long _postedAt = 0;
+    bool _eventDriven = false;      // Interval is a fallback restarted by every run
+    unsigned long _eventCount = 0;
 
     unsigned long _lastExecTime = 0;
     unsigned long _minExecTime = ULONG_MAX;
     unsigned long _maxExecTime = 0;
     unsigned long _totalExecTime = 0;
     unsigned long _execCount = 0;
-    
+
+    unsigned long _lastLateness = 0;
+    unsigned long _maxLateness = 0;
+    unsigned long _totalLateness = 0;
+    unsigned long _missedPeriods = 0;
+
+    unsigned long _budgetUs = 0;
+    unsigned long _overrunCount = 0;
+    uint16_t _execHistogram[SCHED_HIST_BUCKETS] = {0};
+    uint16_t _latenessHistogram[SCHED_HIST_BUCKETS] = {0};
+
     // CPU usage tracking over a rolling window
     static const unsigned long CPU_USAGE_WINDOW_MS = 10000; // 10 second window
     unsigned long _cpuUsageWindowStart = 0;
     unsigned long _cpuUsageInWindow = 0;
 };
 
+// Deadline-ordered scheduler: tasks sit in a min-heap keyed on their next
+// micros() deadline, so update() only touches tasks that are actually due.
+// When nothing is due the core idles in WFI until the next interrupt
+// (SysTick wakes it at least every millisecond). Deadlines of whole-ms
+// intervals are aligned to the SysTick edge so that wake-up is on time;
+// within IDLE_SPIN_US of a deadline the scheduler spins instead.
+//
+// All storage is static: tasks come from a pool of SCHED_MAX_TASKS entries
+// kept on intrusive lists, so addTask()/removeTask() are O(1) (plus the heap
+// update) and never touch the heap allocator.
 class TaskScheduler {
 public:
-    ~TaskScheduler();
-
-    ScheduledTask* addTask(TaskCallback callback, unsigned long interval, bool repeat = true, bool highPriority = false);
+    TaskScheduler();
+
+    // Returns nullptr when the pool is exhausted
+    ScheduledTask* addTask(TaskCallback callback, unsigned long interval, bool repeat = true, bool highPriority = false,
+                           const char* name = nullptr);
+    // Event-driven task: runs when post()ed. A non-zero fallbackInterval (ms)
+    // also runs it that long after its last run, covering a lost interrupt.
+    ScheduledTask* addEventTask(TaskCallback callback, const char* name = nullptr, bool highPriority = false,
+                                unsigned long fallbackInterval = 0);
     void removeTask(ScheduledTask* task);
     void update();
-    
+
+    // Pool capacity
+    size_t getTaskCapacity() const;
+    size_t getFreeTaskCount() const;
+
+    // Task table access (creation order, invalidated by addTask/removeTask)
+    size_t getTaskCount() const;
+    ScheduledTask* getTask(size_t index) const;
+    ScheduledTask* firstTask() const;
+    ScheduledTask* nextTask(const ScheduledTask* task) const;
+    void resetAllStats();
+
+    // Idle sleep between deadlines (enabled by default)
+    void setIdleSleep(bool enabled);
+    bool getIdleSleep() const;
+    // Earliest armed deadline (micros()); false when nothing is armed or an
+    // event is waiting to be collected
+    bool getNextDeadline(unsigned long* dueAt) const;
+
     // CPU usage monitoring
     float getTotalCpuUsagePercent() const;
+    float getIdlePercent() const;
+    unsigned long getTotalOverrunCount() const;
     void printCpuUsageReport() const;
 
 private:
-    std::vector<ScheduledTask*> _tasks;
+    friend class ScheduledTask;
+
+    // Deadline heap maintenance (O(log n), keeps ScheduledTask::_heapIndex in sync)
+    static bool _before(const ScheduledTask* a, const ScheduledTask* b);
+    void _heapPush(ScheduledTask* task);
+    void _heapRemove(ScheduledTask* task);
+    void _heapSiftUp(int index);
+    void _heapSiftDown(int index);
+    void _heapSwap(int a, int b);
+    void _reschedule(ScheduledTask* task);
+    void _collectEvents();
+    void _idle();
+
+    static const unsigned long IDLE_SPIN_US = 50;
+
+    ScheduledTask _pool[SCHED_MAX_TASKS];
+    ScheduledTask* _head = nullptr;         // Active tasks (doubly linked, creation order)
+    ScheduledTask* _tail = nullptr;
+    ScheduledTask* _free = nullptr;         // Unused pool entries (singly linked)
+    ScheduledTask* _graveyard = nullptr;    // Removed inside a callback, returned to _free after dispatch
+    size_t _taskCount = 0;
+    size_t _freeCount = 0;
+
+    ScheduledTask* _queue[SCHED_MAX_TASKS]; // Armed, unpaused tasks ordered by deadline (min-heap)
+    int _queueCount = 0;
+    ScheduledTask* _due[SCHED_MAX_TASKS];   // Tasks dispatched this spin
+    unsigned long _dueAt[SCHED_MAX_TASKS];  // Deadline each _due entry was dispatched for
+    int _dueCount = 0;
+    bool _dispatching = false;
+    bool _idleSleep = true;
+    volatile bool _eventPosted = false;     // Some task has _eventPending set
+
+    // Idle time tracking over the same rolling window as the task CPU usage
+    unsigned long _idleWindowStart = 0;
+    unsigned long _idleInWindow = 0;
 };
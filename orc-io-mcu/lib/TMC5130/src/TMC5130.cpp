@@ -18,11 +18,18 @@ TMC5130::TMC5130(int cs_pin, SPIClass *spi) {
     _initialised = false;
 }
 
+void TMC5130::setBus(SPIBus *bus, uint8_t device) {
+    _bus = bus;
+    _busDevice = device;
+}
+
 // Initialisation
 bool TMC5130::begin(void) {
     pinMode(_cs_pin, OUTPUT);
     digitalWrite(_cs_pin, HIGH);
+    if (_bus) _bus->lock(_busDevice);
     _spi->begin();
+    if (_bus) _bus->unlock();
 
     _initialised = true;
 
@@ -278,6 +285,7 @@ uint8_t TMC5130::readRegister(uint8_t reg, uint32_t *data) {
     if (!_initialised) return 0;
     uint8_t result = 0;
     uint8_t buf[4] = {0, 0, 0, 0};
+    if (_bus) _bus->lock(_busDevice);
     _spi->beginTransaction(SPISettings(TMC5130_SPI_SPEED, MSBFIRST, SPI_MODE3));
 
     // Send read datagram (40-bit)
@@ -293,6 +301,7 @@ uint8_t TMC5130::readRegister(uint8_t reg, uint32_t *data) {
     for (int i = 0; i < 4; i++) buf[i] = _spi->transfer(0);
     digitalWrite(_cs_pin, HIGH);
     _spi->endTransaction();
+    if (_bus) _bus->unlock();
     *data = (uint32_t)buf[0] << 24 | (uint32_t)buf[1] << 16 | (uint32_t)buf[2] << 8 | (uint32_t)buf[3];
     return result;
 }
@@ -306,6 +315,7 @@ bool TMC5130::writeRegister(uint8_t reg, uint32_t data) {
     buf[2] = data >> 8;
     buf[3] = data;
     //Serial.printf("Write to register 0x%02X data: 0x%02X%02X%02X%02X\n", reg, buf[0], buf[1], buf[2], buf[3]);
+    if (_bus) _bus->lock(_busDevice);
     _spi->beginTransaction(SPISettings(TMC5130_SPI_SPEED, MSBFIRST, SPI_MODE3));
 
     // Send write datagram (40-bit)
@@ -315,6 +325,7 @@ bool TMC5130::writeRegister(uint8_t reg, uint32_t data) {
     digitalWrite(_cs_pin, HIGH);
     delayMicroseconds(10);
     _spi->endTransaction();
+    if (_bus) _bus->unlock();
     return true;  // Return success - status byte of 0 is normal, not an error
 }
 
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <SPI.h>
+#include <SPIBus.h>
 #include "TMC5130_reg.h"
 
 // SPI default speed 4MHz
@@ -35,6 +36,7 @@ class TMC5130 {
 
         // Initialisation
         bool begin(void);
+        void setBus(SPIBus *bus, uint8_t device);      // Call before begin(), transfers run under the bus lock
 
         // Configuration
         bool setStepsPerRev(uint32_t steps);        // Default 200, call before any other config if changing
@@ -151,6 +153,8 @@ class TMC5130 {
     private:
         int _cs_pin;
         SPIClass *_spi;
+        SPIBus *_bus = nullptr;
+        uint8_t _busDevice = SPIBUS_NO_DEVICE;
         bool _initialised;
 
         uint8_t ImAtoIRUN_IHOLD(uint16_t mAval, bool vsense);
@@ -0,0 +1,98 @@
+// ADC burst capture and the inputs it leaves out: while a capture scans only
+// its channel mask, every other analog input holds its last value and must be
+// flagged fault until the normal scan is back (block complete, abort, or a
+// capture that replaces it with another mask). A capture the ADC cannot be
+// switched to is refused.
+#include "sys_init.h"
+#include "mock_hw.h"
+#include "checks.h"
+
+#include <string.h>
+
+namespace {
+    // Inputs flagged fault, as a channel mask
+    uint8_t faultMask(void) {
+        uint8_t mask = 0;
+        for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+            if (adcDriver.inputObj[i]->fault) mask |= 1 << i;
+        }
+        return mask;
+    }
+
+    void clearMessages(void) {
+        for (int i = 0; i < ADC_NUM_CHANNELS; i++) adcDriver.inputObj[i]->newMessage = false;
+    }
+
+    bool arm(uint8_t mask, uint16_t lengthScans) {
+        IPC_AdcCaptureArm_t req = {};
+        req.channelMask = mask;
+        req.trigger = IPC_ADC_TRIG_IMMEDIATE;
+        req.sampleRateHz = 1000;
+        req.lengthScans = lengthScans;
+        return ADC_captureArm(&req);
+    }
+
+    // One data-ready edge, converted by the ADC task
+    void scan(void) {
+        MockHw::adcDataReady();
+        tasks.update();
+    }
+
+    uint8_t captureState(void) {
+        IPC_AdcCaptureStatus_t status;
+        ADC_captureGetStatus(&status);
+        return status.state;
+    }
+}
+
+void checkAdcCapture(void) {
+    checkFirmwareSetup();
+    ADC_captureAbort();
+    CHECK(faultMask() == 0);
+
+    // Armed on channels 0 and 1: 2-7 are flagged, with a message, and hold
+    // their value while 0 and 1 follow the input
+    clearMessages();
+    CHECK(arm(0x03, 50));
+    CHECK(faultMask() == 0xFC);
+    CHECK(adcDriver.inputObj[5]->newMessage && strstr(adcDriver.inputObj[5]->message, "frozen") != nullptr);
+    CHECK(!adcDriver.inputObj[0]->newMessage);
+    float frozen = adcDriver.inputObj[5]->value;
+    float live = adcDriver.inputObj[0]->value;
+    MockHw::adcRaw[0] += 1000;
+    MockHw::adcRaw[5] += 1000;
+    scan();
+    CHECK(adcDriver.inputObj[5]->value == frozen);
+    CHECK(adcDriver.inputObj[0]->value != live);
+
+    // An invalid request changes nothing, a new mask moves the flags
+    CHECK(!arm(0, 50));
+    CHECK(faultMask() == 0xFC);
+    CHECK(arm(0x21, 50));
+    CHECK(faultMask() == 0xDE);
+
+    // Block complete: the normal scan is back and the flags are cleared
+    clearMessages();
+    for (int i = 0; i < 100 && captureState() != IPC_ADC_CAPTURE_COMPLETE; i++) scan();
+    CHECK(captureState() == IPC_ADC_CAPTURE_COMPLETE);
+    CHECK(faultMask() == 0);
+    CHECK(adcDriver.inputObj[1]->newMessage && strcmp(adcDriver.inputObj[1]->message, "Sampling resumed") == 0);
+    CHECK(!adcDriver.inputObj[0]->newMessage);
+    scan();
+    CHECK(adcDriver.inputObj[5]->value != frozen);
+
+    // Aborted
+    CHECK(arm(0x80, 50));
+    CHECK(faultMask() == 0x7F);
+    ADC_captureAbort();
+    CHECK(faultMask() == 0);
+
+    // The ADC refuses the capture scan: the arm is refused, with the state
+    // FAILED, and the normal scan and the flags are back
+    MockHw::adcScanFault = true;
+    CHECK(!arm(0x03, 50));
+    CHECK(captureState() == IPC_ADC_CAPTURE_FAILED);
+    CHECK(faultMask() == 0);
+    ADC_captureAbort();
+    clearMessages();
+}
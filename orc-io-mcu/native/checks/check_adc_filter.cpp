@@ -0,0 +1,196 @@
+// ADC filter kernels (drivers/onboard/adc_filter.*), one section per kernel:
+// moving-average step response and running sum over many ring wraps, the IIR
+// coefficient, the median against spikes and a sorted reference, the CIC
+// decimation ratio and gain, and priming after every (re)configure.
+#include "drivers/onboard/adc_filter.h"
+#include "checks.h"
+
+#include <algorithm>
+#include <math.h>
+#include <random>
+#include <vector>
+
+namespace {
+    const int32_t CODE_MAX = 65535;         // MCP346x 16-bit codes, 17 bits with the sign
+    const int32_t CODE_MIN = -65536;
+
+    float feed(ADCFilter_t *f, int32_t x) {
+        float out = NAN;
+        ADC_filterInput(f, x, &out);
+        return out;
+    }
+
+    void checkMovingAverage(std::mt19937 &rng) {
+        ADCFilter_t f;
+
+        // Step 0 -> 800 over N = 8: one eighth of the step per sample, then flat
+        ADC_filterConfigure(&f, ADC_FILTER_MOVING_AVERAGE, 8);
+        CHECK(feed(&f, 0) == 0.0f);
+        bool step = true;
+        for (int i = 1; i <= 8; i++) step = step && feed(&f, 800) == 100.0f * i;
+        CHECK(step);
+        CHECK(feed(&f, 800) == 800.0f);
+
+        // The running sum stays exact over many ring wraps at full-scale codes:
+        // every output matches the mean of the last N codes
+        std::uniform_int_distribution<int32_t> code(CODE_MIN, CODE_MAX);
+        for (uint8_t n : {1, 5, 8, 32}) {
+            ADC_filterConfigure(&f, ADC_FILTER_MOVING_AVERAGE, n);
+            std::vector<int32_t> history;
+            uint32_t mismatches = 0;
+            for (int i = 0; i < 100000; i++) {
+                int32_t x = code(rng);
+                if (history.empty()) history.assign(n, x);      // Primed
+                else {
+                    history.erase(history.begin());
+                    history.push_back(x);
+                }
+                int64_t sum = 0;
+                for (int32_t h : history) sum += h;
+                if (feed(&f, x) != (float)sum * (1.0f / n)) mismatches++;
+            }
+            CHECK(mismatches == 0);
+            CHECK(f.pos < n);
+        }
+    }
+
+    void checkIIR(void) {
+        ADCFilter_t f;
+
+        // y += (x - y) / N: after k samples of a step the output is 1 - (1 - 1/N)^k
+        for (uint8_t n : {1, 4, 16}) {
+            ADC_filterConfigure(&f, ADC_FILTER_IIR, n);
+            CHECK(f.invLength == 1.0f / n);
+            feed(&f, 0);
+            bool response = true;
+            for (int k = 1; k <= 4 * n; k++) {
+                double expected = 10000.0 * (1.0 - pow(1.0 - 1.0 / n, k));
+                response = response && checkNear(feed(&f, 10000), expected, 0.05);
+            }
+            CHECK(response);
+        }
+        ADC_filterConfigure(&f, ADC_FILTER_IIR, 4);
+        feed(&f, 0);
+        CHECK(feed(&f, 1000) == 250.0f);
+        CHECK(feed(&f, 1000) == 437.5f);
+
+        // Long run of a constant settles on it exactly
+        for (int i = 0; i < 1000; i++) feed(&f, -1234);
+        CHECK_NEAR(feed(&f, -1234), -1234.0, 0.01);
+    }
+
+    void checkMedian(std::mt19937 &rng) {
+        ADCFilter_t f;
+
+        // A single spike, and two in a row, never reach the output of N = 5;
+        // three in the window do
+        ADC_filterConfigure(&f, ADC_FILTER_MEDIAN, 5);
+        feed(&f, 100);
+        CHECK(feed(&f, 60000) == 100.0f);
+        CHECK(feed(&f, 100) == 100.0f);
+        CHECK(feed(&f, CODE_MIN) == 100.0f);
+        CHECK(feed(&f, CODE_MIN) == 100.0f);
+        CHECK(feed(&f, 100) == 100.0f);
+        feed(&f, 9000);
+        feed(&f, 9000);
+        CHECK(feed(&f, 9000) == 9000.0f);
+
+        // Matches the sorted window (upper median for even N) on random codes
+        std::uniform_int_distribution<int32_t> code(CODE_MIN, CODE_MAX);
+        std::uniform_int_distribution<int32_t> narrow(-3, 3);      // Many ties
+        for (uint8_t n = 1; n <= ADC_FILTER_MEDIAN_MAX; n++) {
+            ADC_filterConfigure(&f, ADC_FILTER_MEDIAN, n);
+            std::vector<int32_t> history;
+            uint32_t mismatches = 0;
+            for (int i = 0; i < 5000; i++) {
+                int32_t x = (i / 1000) % 2 ? narrow(rng) : code(rng);
+                if (history.empty()) history.assign(n, x);
+                else {
+                    history.erase(history.begin());
+                    history.push_back(x);
+                }
+                std::vector<int32_t> sorted = history;
+                std::sort(sorted.begin(), sorted.end());
+                if (feed(&f, x) != (float)sorted[n / 2]) mismatches++;
+            }
+            CHECK(mismatches == 0);
+        }
+    }
+
+    void checkCIC(void) {
+        ADCFilter_t f;
+
+        // One output per N codes and unity gain (N^3 divided out), up to the
+        // longest ratio at both ends of the code range. Exact where 1 / N^3 is;
+        // otherwise within the float rounding of the scaled sum
+        for (uint8_t n : {2, 4, 10, ADC_FILTER_CIC_MAX}) {
+            for (int32_t level : {CODE_MIN, -1, 0, 777, CODE_MAX}) {
+                ADC_filterConfigure(&f, ADC_FILTER_CIC, n);
+                bool primed = feed(&f, level) == (float)level;
+                double tol = fabs((double)level) * 1e-6;
+                uint32_t outputs = 0;
+                uint32_t wrong = 0;
+                for (int i = 1; i <= 100 * n; i++) {
+                    float out;
+                    if (!ADC_filterInput(&f, level, &out)) continue;
+                    outputs++;
+                    if (!checkNear(out, level, tol)) wrong++;
+                }
+                CHECK(primed && outputs == 100u);
+                CHECK(wrong == 0);
+            }
+        }
+
+        // A step on a decimation boundary settles exactly on the ORDER-th
+        // output and not before
+        const uint8_t n = 8;
+        ADC_filterConfigure(&f, ADC_FILTER_CIC, n);
+        feed(&f, 0);
+        for (int i = 1; i < n; i++) feed(&f, 0);
+        std::vector<float> outputs;
+        for (int i = 0; i < 5 * n; i++) {
+            float out;
+            if (ADC_filterInput(&f, 4096, &out)) outputs.push_back(out);
+        }
+        CHECK(outputs.size() == 5);
+        CHECK(outputs[0] > 0.0f && outputs[0] < outputs[1]);
+        CHECK(outputs[ADC_FILTER_CIC_ORDER - 2] < 4096.0f);
+        CHECK(outputs[ADC_FILTER_CIC_ORDER - 1] == 4096.0f && outputs[4] == 4096.0f);
+    }
+
+    void checkPriming(void) {
+        ADCFilter_t f;
+
+        // The first code after configure comes straight out, whatever the
+        // history before it; reconfiguring mid-stream drops that history
+        for (uint8_t type = ADC_FILTER_NONE; type < ADC_FILTER_TYPE_COUNT; type++) {
+            ADC_filterConfigure(&f, type, 8);
+            for (int i = 0; i < 50; i++) feed(&f, 30000);
+            for (uint8_t next = ADC_FILTER_NONE; next < ADC_FILTER_TYPE_COUNT; next++) {
+                ADC_filterConfigure(&f, next, 8);
+                float out = NAN;
+                bool ready = ADC_filterInput(&f, -500, &out);
+                CHECK(ready && out == -500.0f);
+                CHECK(feed(&f, -500) == -500.0f || next == ADC_FILTER_CIC);
+            }
+        }
+
+        // Lengths are clamped to each kernel's limit, unknown types are NONE
+        CHECK(ADC_filterLength(ADC_FILTER_MOVING_AVERAGE, 0) == 1);
+        CHECK(ADC_filterLength(ADC_FILTER_MOVING_AVERAGE, 200) == ADC_FILTER_MAX_LENGTH);
+        CHECK(ADC_filterLength(ADC_FILTER_MEDIAN, 20) == ADC_FILTER_MEDIAN_MAX);
+        CHECK(ADC_filterLength(ADC_FILTER_CIC, 20) == ADC_FILTER_CIC_MAX);
+        CHECK(ADC_filterLength(ADC_FILTER_NONE, 8) == 1);
+        ADC_filterConfigure(&f, ADC_FILTER_TYPE_COUNT, 8);
+        CHECK(f.type == ADC_FILTER_NONE && feed(&f, 12) == 12.0f);
+    }
+}
+
+void checkAdcFilter(void) {
+    std::mt19937 rng(12345);
+    checkMovingAverage(rng);
+    checkIIR();
+    checkMedian(rng);
+    checkCIC();
+    checkPriming();
+}
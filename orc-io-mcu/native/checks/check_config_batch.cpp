@@ -0,0 +1,252 @@
+// Configuration batches (CONFIG_BEGIN / CONFIG_BATCH / CONFIG_COMMIT) through
+// the IO MCU handlers: a batch applied in one pass, a batch with a gap, the
+// same batch resent, batches that are too large or malformed, a lost BEGIN and
+// per-record status. A rejected batch must leave the configuration untouched.
+#include "sys_init.h"
+#include "checks.h"
+
+#include <string.h>
+#include <vector>
+
+namespace {
+    const uint16_t ADC_SECTION = 1u << IPC_CONFIG_SECTION_ADC;
+
+    struct Batch {
+        std::vector<uint8_t> records;
+        std::vector<uint16_t> offsets;      // Start of each record
+    };
+
+    void addRecord(Batch &batch, uint8_t msgType, const void *payload, uint16_t length) {
+        batch.offsets.push_back((uint16_t)batch.records.size());
+        IPC_ConfigRecord_t rec;
+        rec.msgType = msgType;
+        rec.length = length;
+        const uint8_t *r = (const uint8_t*)&rec;
+        batch.records.insert(batch.records.end(), r, r + sizeof(rec));
+        const uint8_t *p = (const uint8_t*)payload;
+        batch.records.insert(batch.records.end(), p, p + length);
+    }
+
+    // ADC input as setup() left it
+    IPC_ConfigAnalogInput_t adcConfig(uint16_t index) {
+        IPC_ConfigAnalogInput_t cfg = {};
+        cfg.index = index;
+        if (index < ADC_NUM_CHANNELS) {
+            AnalogInput_t *sensor = (AnalogInput_t*)objIndex[index].obj;
+            strncpy(cfg.unit, sensor->unit, sizeof(cfg.unit) - 1);
+            cfg.calScale = sensor->cal->scale;
+            cfg.calOffset = sensor->cal->offset;
+            cfg.filterType = adcDriver.pipeline.filter[index].type;
+            cfg.filterLength = (uint8_t)adcDriver.pipeline.filter[index].length;
+        }
+        return cfg;
+    }
+
+    void addAdc(Batch &batch, uint16_t index, float scale) {
+        IPC_ConfigAnalogInput_t cfg = adcConfig(index);
+        cfg.calScale = scale;
+        addRecord(batch, IPC_MSG_CONFIG_ANALOG_INPUT, &cfg, sizeof(cfg));
+    }
+
+    // Eight ADC inputs, scale base + index
+    Batch adcBatch(float base) {
+        Batch batch;
+        for (uint16_t i = 0; i < 8; i++) addAdc(batch, i, base + i);
+        return batch;
+    }
+
+    uint16_t recordCount(const Batch &batch) {
+        return (uint16_t)batch.offsets.size();
+    }
+
+    void sendBegin(uint16_t txn, uint16_t records, uint16_t bytes) {
+        IPC_ConfigBegin_t begin = {txn, records, bytes, ADC_SECTION};
+        ipc_handleMessage(IPC_MSG_CONFIG_BEGIN, (const uint8_t*)&begin, sizeof(begin));
+    }
+
+    // Records [first, first + count) in one CONFIG_BATCH frame
+    void sendFrame(uint16_t txn, const Batch &batch, uint16_t first, uint8_t count) {
+        static uint8_t frame[IPC_MAX_PAYLOAD_SIZE];
+        IPC_ConfigBatchHeader_t hdr = {txn, first, count};
+        uint16_t from = batch.offsets[first];
+        uint16_t to = (first + count < recordCount(batch)) ? batch.offsets[first + count] : (uint16_t)batch.records.size();
+        memcpy(frame, &hdr, sizeof(hdr));
+        memcpy(&frame[sizeof(hdr)], &batch.records[from], to - from);
+        ipc_handleMessage(IPC_MSG_CONFIG_BATCH, frame, sizeof(hdr) + to - from);
+    }
+
+    void sendCommit(uint16_t txn, uint16_t records) {
+        IPC_ConfigCommit_t commit = {txn, records};
+        ipc_handleMessage(IPC_MSG_CONFIG_COMMIT, (const uint8_t*)&commit, sizeof(commit));
+    }
+
+    // The whole batch in frames of up to perFrame records
+    void sendBatch(uint16_t txn, const Batch &batch, uint8_t perFrame) {
+        sendBegin(txn, recordCount(batch), (uint16_t)batch.records.size());
+        for (uint16_t first = 0; first < recordCount(batch); first += perFrame) {
+            uint16_t left = recordCount(batch) - first;
+            sendFrame(txn, batch, first, (uint8_t)(left < perFrame ? left : perFrame));
+        }
+        sendCommit(txn, recordCount(batch));
+    }
+
+    // The CONFIG_RESULT sent for txn
+    bool takeResult(uint16_t txn, IPC_ConfigResult_t *result) {
+        memset(result, 0xEE, sizeof(*result));
+        int len = checkTxTake(IPC_MSG_CONFIG_RESULT, (uint8_t*)result, sizeof(*result));
+        return len >= (int)(sizeof(IPC_ConfigResult_t) - IPC_CONFIG_MAX_RECORDS) &&
+               len == (int)(sizeof(IPC_ConfigResult_t) - IPC_CONFIG_MAX_RECORDS + result->recordCount) &&
+               result->transactionId == txn;
+    }
+
+    bool allRecords(const IPC_ConfigResult_t &result, uint8_t status) {
+        for (uint16_t i = 0; i < result.recordCount; i++) {
+            if (result.recordStatus[i] != status) return false;
+        }
+        return true;
+    }
+
+    // ADC inputs 0-7 hold scale base + index
+    bool adcScalesAre(float base) {
+        for (uint16_t i = 0; i < 8; i++) {
+            AnalogInput_t *sensor = (AnalogInput_t*)objIndex[i].obj;
+            if (sensor == nullptr || sensor->cal == nullptr || sensor->cal->scale != base + i) return false;
+        }
+        return true;
+    }
+
+    uint32_t adcDigest(void) {
+        IPC_ConfigDigest_t digest;
+        ipc_getConfigDigest(&digest);
+        return digest.section[IPC_CONFIG_SECTION_ADC];
+    }
+}
+
+void checkConfigBatch(void) {
+    checkFirmwareSetup();
+    ipc_clearTxQueue();
+    IPC_ConfigResult_t result;
+    Batch restore;
+    for (uint16_t i = 0; i < 8; i++) {
+        IPC_ConfigAnalogInput_t cfg = adcConfig(i);
+        addRecord(restore, IPC_MSG_CONFIG_ANALOG_INPUT, &cfg, sizeof(cfg));
+    }
+
+    // Applied: eight records over three frames, one CONFIG_RESULT
+    Batch first = adcBatch(2.0f);
+    sendBatch(100, first, 3);
+    CHECK(takeResult(100, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_APPLIED);
+    CHECK(result.recordCount == 8 && result.appliedCount == 8);
+    CHECK(allRecords(result, IPC_CONFIG_REC_OK));
+    CHECK(adcScalesAre(2.0f));
+    uint32_t digest = adcDigest();
+    CHECK(digest != 0);
+
+    // Gap: record 3 never arrives. Nothing is applied and the rest of the
+    // batch's frames are ignored.
+    Batch second = adcBatch(5.0f);
+    sendBegin(101, 8, (uint16_t)second.records.size());
+    sendFrame(101, second, 0, 3);
+    sendFrame(101, second, 4, 4);
+    CHECK(ipcDriver.configStage.status == IPC_CONFIG_BATCH_INCOMPLETE);
+    sendFrame(101, second, 3, 1);
+    sendCommit(101, 8);
+    CHECK(takeResult(101, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_INCOMPLETE);
+    CHECK(result.recordCount == 8 && result.appliedCount == 0);
+    CHECK(allRecords(result, IPC_CONFIG_REC_NOT_APPLIED));
+    CHECK(adcScalesAre(2.0f));
+    CHECK(adcDigest() == digest);
+
+    // Resend under a new transaction: applied, and a late frame of the
+    // rejected batch in between is dropped
+    sendBegin(102, 8, (uint16_t)second.records.size());
+    sendFrame(102, second, 0, 4);
+    sendFrame(101, first, 4, 4);
+    sendFrame(102, second, 4, 4);
+    sendCommit(102, 8);
+    CHECK(takeResult(102, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_APPLIED && result.appliedCount == 8);
+    CHECK(adcScalesAre(5.0f));
+    CHECK(adcDigest() != digest);
+    digest = adcDigest();
+
+    // The same batch again changes nothing, so the digest is unchanged
+    sendBatch(103, second, 8);
+    CHECK(takeResult(103, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_APPLIED);
+    CHECK(adcDigest() == digest);
+
+    // Too many records or bytes announced in BEGIN
+    Batch third = adcBatch(9.0f);
+    sendBegin(104, IPC_CONFIG_MAX_RECORDS + 1, (uint16_t)third.records.size());
+    sendFrame(104, third, 0, 8);
+    sendCommit(104, 8);
+    CHECK(takeResult(104, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_MALFORMED);
+    CHECK(allRecords(result, IPC_CONFIG_REC_NOT_APPLIED));
+    sendBegin(105, 8, IPC_CONFIG_STAGING_SIZE + 1);
+    sendFrame(105, third, 0, 8);
+    sendCommit(105, 8);
+    CHECK(takeResult(105, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_MALFORMED);
+
+    // Frames that overrun the staging buffer although BEGIN fitted
+    Batch big;
+    static uint8_t filler[IPC_MAX_PAYLOAD_SIZE - 16];
+    memset(filler, 0, sizeof(filler));
+    for (uint16_t i = 0; i < 5; i++) addRecord(big, IPC_MSG_CONFIG_ANALOG_INPUT, filler, sizeof(filler));
+    sendBegin(106, 5, IPC_CONFIG_STAGING_SIZE);
+    for (uint16_t i = 0; i < 5; i++) sendFrame(106, big, i, 1);
+    CHECK(ipcDriver.configStage.status == IPC_CONFIG_BATCH_MALFORMED);
+    sendCommit(106, 5);
+    CHECK(takeResult(106, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_MALFORMED && result.appliedCount == 0);
+
+    // A record whose length runs past the end of its frame
+    Batch cut = adcBatch(9.0f);
+    cut.records.pop_back();
+    sendBegin(107, 8, (uint16_t)cut.records.size());
+    sendFrame(107, cut, 0, 8);
+    sendCommit(107, 8);
+    CHECK(takeResult(107, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_MALFORMED);
+    CHECK(adcScalesAre(5.0f));
+
+    // BEGIN lost: the commit reports every record not applied
+    sendFrame(108, third, 0, 8);
+    sendCommit(108, 8);
+    CHECK(takeResult(108, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_INCOMPLETE && result.recordCount == 8);
+    CHECK(allRecords(result, IPC_CONFIG_REC_NOT_APPLIED));
+
+    // Fewer records than BEGIN announced
+    sendBegin(109, 8, (uint16_t)third.records.size());
+    sendFrame(109, third, 0, 7);
+    sendCommit(109, 7);
+    CHECK(takeResult(109, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_INCOMPLETE);
+    CHECK(adcScalesAre(5.0f));
+    CHECK(adcDigest() == digest);
+
+    // Per-record status: a type that may not be batched and a bad index are
+    // reported, the other records are applied
+    Batch mixed = adcBatch(7.0f);
+    uint8_t ping[4] = {};
+    addRecord(mixed, IPC_MSG_PING, ping, sizeof(ping));
+    addAdc(mixed, MAX_NUM_OBJECTS, 1.0f);
+    sendBatch(110, mixed, 4);
+    CHECK(takeResult(110, &result));
+    CHECK(result.status == IPC_CONFIG_BATCH_APPLIED);
+    CHECK(result.recordCount == 10 && result.appliedCount == 8);
+    CHECK(result.recordStatus[7] == IPC_CONFIG_REC_OK);
+    CHECK(result.recordStatus[8] == IPC_CONFIG_REC_UNSUPPORTED);
+    CHECK(result.recordStatus[9] == IPC_CONFIG_REC_ERROR);
+    CHECK(adcScalesAre(7.0f));
+
+    // Leave the inputs as setup() configured them
+    sendBatch(111, restore, 8);
+    CHECK(takeResult(111, &result));
+    ipc_clearTxQueue();
+}
@@ -0,0 +1,208 @@
+// CRC16 equivalence: the table and slice-by-4 paths of the IO and SYS MCU
+// headers against a bitwise reference, and whole frames with START/ESC bytes
+// through the IO MCU's stuffing transmitter and its receiver.
+#include "sys_init.h"
+#include "drivers/ipc/ipc_crc16.h"
+#include "checks.h"
+
+#include <chrono>
+#include <random>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+namespace {
+    uint16_t crcBitwise(const uint8_t *data, size_t length) {
+        uint16_t crc = IPC_CRC16_INIT;
+        for (size_t i = 0; i < length; i++) {
+            crc ^= (uint16_t)data[i] << 8;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ IPC_CRC16_POLY) : (uint16_t)(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    // Every entry point of both headers, whole and split in two at split
+    bool crcMatches(const uint8_t *data, size_t length, size_t split) {
+        uint16_t ref = crcBitwise(data, length);
+        uint16_t io = IPC_CRC16_INIT;
+        uint16_t sys = IPC_CRC16_INIT;
+        for (size_t i = 0; i < length; i++) {
+            io = ipc_crc16_byte(io, data[i]);
+            sys = SysCrc::byte(sys, data[i]);
+        }
+        size_t rest = length - split;
+        return io == ref && sys == ref &&
+               ipc_crc16(data, length) == ref &&
+               ipc_calcCRC16(data, (uint16_t)length) == ref &&
+               ipc_crc16_update(IPC_CRC16_INIT, data, length) == ref &&
+               ipc_crc16_update_slice4(IPC_CRC16_INIT, data, length) == ref &&
+               ipc_crc16_update_slice4(ipc_crc16_update_slice4(IPC_CRC16_INIT, data, split), data + split, rest) == ref &&
+               SysCrc::crc16(data, length) == ref &&
+               SysCrc::update(IPC_CRC16_INIT, data, length) == ref &&
+               SysCrc::updateSlice4(IPC_CRC16_INIT, data, length) == ref &&
+               SysCrc::updateSlice4(SysCrc::updateSlice4(IPC_CRC16_INIT, data, split), data + split, rest) == ref;
+    }
+
+    // Random payload with START and ESC bytes at flagPercent density
+    void fillFramePayload(std::mt19937 &rng, uint8_t *buf, size_t length, uint32_t flagPercent) {
+        for (size_t i = 0; i < length; i++) {
+            uint32_t r = rng();
+            if (r % 100 < flagPercent) buf[i] = (r & 0x100) ? IPC_START_BYTE : IPC_ESCAPE_BYTE;
+            else buf[i] = (uint8_t)(r >> 8);
+        }
+    }
+
+    // Wire bytes of one frame sent with ipc_sendPacket()
+    size_t transmitFrame(const uint8_t *payload, uint16_t length, uint8_t *wire, size_t space) {
+        if (!ipc_sendPacket(IPC_MSG_PONG, payload, length)) return 0;
+        size_t wireLen = 0;
+        bool done;
+        do {
+            done = ipc_processTxQueue();
+            wireLen += Serial1.hostTxRead(&wire[wireLen], space - wireLen);
+        } while (!done && (ipcDriver.txFramePos != 0 || ipcDriver.txEscapePending));
+        return wireLen;
+    }
+
+    // Back in through Serial1 and ipc_update(), a ring buffer at a time
+    void receiveFrame(const uint8_t *wire, size_t wireLen) {
+        while (wireLen > 0) {
+            size_t n = min(wireLen, Serial1.hostRxFree());
+            Serial1.hostInject(wire, n);
+            ipc_update();
+            wire += n;
+            wireLen -= n;
+        }
+    }
+
+    // Undo the stuffing between the flags; returns the unstuffed length
+    size_t unstuff(const uint8_t *wire, size_t wireLen, uint8_t *out) {
+        size_t n = 0;
+        for (size_t i = 1; i + 1 < wireLen; i++) {
+            out[n++] = (wire[i] == IPC_ESCAPE_BYTE) ? (uint8_t)(wire[++i] ^ IPC_ESCAPE_XOR) : wire[i];
+        }
+        return n;
+    }
+}
+
+void checkCrc(void) {
+    // CRC-16/CCITT-FALSE check value
+    const uint8_t *digits = (const uint8_t *)"123456789";
+    CHECK(crcBitwise(digits, 9) == 0x29B1);
+    CHECK(ipc_crc16(digits, 9) == 0x29B1);
+    CHECK(SysCrc::crc16(digits, 9) == 0x29B1);
+
+    // Every length to 64 and random lengths to a full payload, at each
+    // alignment and split of the four-byte loop
+    std::mt19937 rng(4);
+    static uint8_t buf[IPC_MAX_PAYLOAD_SIZE + 4];
+    uint32_t mismatches = 0;
+    for (uint32_t n = 0; n < 4000; n++) {
+        size_t length = n < 520 ? n / 8 : rng() % (IPC_MAX_PAYLOAD_SIZE + 1);
+        uint8_t *data = &buf[n & 3];
+        for (size_t i = 0; i < length; i++) data[i] = (uint8_t)rng();
+        if (!crcMatches(data, length, length ? rng() % (length + 1) : 0)) mismatches++;
+    }
+    CHECK(mismatches == 0);
+
+    // Frames out and back in: the transmitter folds the CRC in while it
+    // stuffs, the receiver checks it over the unstuffed bytes. Keep going
+    // until both flag values have also turned up inside a CRC.
+    ipc_init();
+    static uint8_t payload[IPC_MAX_PAYLOAD_SIZE];
+    static uint8_t wire[2 * (IPC_MAX_PAYLOAD_SIZE + 8)];
+    static uint8_t frame[IPC_MAX_PAYLOAD_SIZE + 8];
+    uint32_t frames = 0, badWire = 0, badCrc = 0, lost = 0;
+    uint32_t crcWithStart = 0, crcWithEsc = 0;
+    while (frames < 2000 || ((crcWithStart == 0 || crcWithEsc == 0) && frames < 50000)) {
+        uint16_t length = (frames < 64) ? frames : rng() % (IPC_MAX_PAYLOAD_SIZE + 1);
+        fillFramePayload(rng, payload, length, (frames % 3) * 20);
+        size_t wireLen = transmitFrame(payload, length, wire, sizeof(wire));
+        size_t n = unstuff(wire, wireLen, frame);
+        frames++;
+        if (wireLen < 2 || wire[0] != IPC_START_BYTE || wire[wireLen - 1] != IPC_END_BYTE ||
+            n != 5u + length || memcmp(&frame[3], payload, length) != 0) {
+            badWire++;
+            continue;
+        }
+        uint16_t sent = (uint16_t)((frame[n - 2] << 8) | frame[n - 1]);
+        if (sent != crcBitwise(frame, n - 2) || sent != SysCrc::crc16(frame, n - 2)) badCrc++;
+        if ((sent >> 8) == IPC_START_BYTE || (sent & 0xFF) == IPC_START_BYTE) crcWithStart++;
+        if ((sent >> 8) == IPC_ESCAPE_BYTE || (sent & 0xFF) == IPC_ESCAPE_BYTE) crcWithEsc++;
+
+        uint32_t received = ipcDriver.rxPacketCount;
+        receiveFrame(wire, wireLen);
+        if (ipcDriver.rxPacketCount != received + 1) lost++;
+    }
+    CHECK(badWire == 0);
+    CHECK(badCrc == 0);
+    CHECK(lost == 0);
+    CHECK(ipcDriver.crcErrorCount == 0);
+    CHECK(crcWithStart > 0);
+    CHECK(crcWithEsc > 0);
+
+    // A flipped bit inside the payload is caught
+    fillFramePayload(rng, payload, 100, 20);
+    size_t wireLen = transmitFrame(payload, 100, wire, sizeof(wire));
+    size_t flip = wireLen / 2;
+    while (wire[flip - 1] == IPC_ESCAPE_BYTE || (wire[flip] | 1) == (IPC_START_BYTE | 1)) flip++;  // Not a flag or escape
+    wire[flip] ^= 0x01;
+    receiveFrame(wire, wireLen);
+    CHECK(ipcDriver.crcErrorCount == 1);
+
+    ipc_init();
+}
+
+bool benchCrc(uint64_t bytes) {
+    bool equal = runChecks("crc") == 0;
+
+    static uint8_t buf[IPC_MAX_PAYLOAD_SIZE];
+    std::mt19937 rng(1);
+    for (uint8_t &b : buf) b = (uint8_t)rng();
+    uint64_t frames = bytes / sizeof(buf) ? bytes / sizeof(buf) : 1;
+    double total = (double)frames * sizeof(buf);
+
+    static const struct {
+        const char *name;
+        uint16_t (*crc)(const uint8_t *, size_t);
+    } impls[] = {
+        {"Bitwise reference", crcBitwise},
+        {"IO table", [](const uint8_t *d, size_t n) { return ipc_crc16_update(IPC_CRC16_INIT, d, n); }},
+        {"IO slice-by-4", [](const uint8_t *d, size_t n) { return ipc_crc16_update_slice4(IPC_CRC16_INIT, d, n); }},
+        {"SYS table", [](const uint8_t *d, size_t n) { return SysCrc::update(IPC_CRC16_INIT, d, n); }},
+        {"SYS slice-by-4", [](const uint8_t *d, size_t n) { return SysCrc::updateSlice4(IPC_CRC16_INIT, d, n); }},
+    };
+
+    printf("CRC16, %llu x %u-byte frames\n", (unsigned long long)frames, (unsigned)sizeof(buf));
+    double reference = 0;
+    uint16_t first = 0;
+    for (const auto &impl : impls) {
+        uint16_t crc = 0;
+        auto t0 = std::chrono::steady_clock::now();
+#ifdef BENCH_HAS_TSC
+        uint64_t c0 = __rdtsc();
+#endif
+        for (uint64_t n = 0; n < frames; n++) {
+            buf[0] = (uint8_t)n;            // New data every frame
+            asm volatile("" ::: "memory");
+            crc ^= impl.crc(buf, sizeof(buf));
+        }
+        double cycles = 0;
+#ifdef BENCH_HAS_TSC
+        cycles = (double)(__rdtsc() - c0) / total;
+#endif
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / total;
+        if (&impl == &impls[0]) {
+            reference = ns;
+            first = crc;
+        }
+        equal = equal && crc == first;
+        printf("  %-20s %8.3f ns/byte %8.2f cycles/byte %8.1f MB/s  %.1fx\n",
+               impl.name, ns, cycles, 1e3 / ns, reference / ns);
+    }
+    printf("  %s\n", equal ? "All implementations agree" : "MISMATCH");
+    return equal;
+}
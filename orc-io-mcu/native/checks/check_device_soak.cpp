@@ -0,0 +1,94 @@
+// Device create/delete soak through the IPC handlers: 10,000 cycles over the
+// Modbus and analog device types, each device's task run (and its Modbus
+// request queued) before it is deleted. The scheduler pool and the heap must
+// end where they started.
+#include "sys_init.h"
+#include "sim_clock.h"
+#include "checks.h"
+
+#include <malloc.h>
+
+namespace {
+    const uint32_t SOAK_CYCLES = 10000;
+    const uint32_t WARMUP_CYCLES = 10;      // Lazily allocated driver state settles first
+
+    struct SoakDevice {
+        uint8_t deviceType;
+        uint8_t busType;
+        uint8_t busIndex;
+        uint8_t address;
+    };
+
+    const SoakDevice soakDevices[] = {
+        {IPC_DEV_HAMILTON_PH, IPC_BUS_MODBUS_RTU, 0, 1},
+        {IPC_DEV_HAMILTON_DO, IPC_BUS_MODBUS_RTU, 0, 2},
+        {IPC_DEV_HAMILTON_OD, IPC_BUS_MODBUS_RTU, 1, 3},
+        {IPC_DEV_ALICAT_MFC, IPC_BUS_MODBUS_RTU, 1, 4},
+        {IPC_DEV_PRESSURE_CTRL, IPC_BUS_ANALOG, 0, 0},
+    };
+    const uint8_t SOAK_DEVICE_TYPES = sizeof(soakDevices) / sizeof(soakDevices[0]);
+
+    size_t heapInUse(void) {
+        return mallinfo2().uordblks;
+    }
+
+    // Runs the scheduler up to the next deadline
+    void runNext(void) {
+        unsigned long due;
+        if (tasks.getNextDeadline(&due)) SimClock::advanceTo(due);
+        tasks.update();
+    }
+
+    // One create, run, delete cycle. Returns false if any step failed.
+    bool cycle(uint32_t n) {
+        const SoakDevice &d = soakDevices[n % SOAK_DEVICE_TYPES];
+        IPC_DeviceCreate_t create = {};
+        create.transactionId = (uint16_t)n;
+        create.startIndex = (uint8_t)(70 + 2 * (n % SOAK_DEVICE_TYPES));
+        create.config.deviceType = d.deviceType;
+        create.config.busType = d.busType;
+        create.config.busIndex = d.busIndex;
+        create.config.address = d.address;
+        create.config.maxFlowRate_mL_min = (d.deviceType == IPC_DEV_ALICAT_MFC) ? 1000.0f : 0;
+        ipc_handleMessage(IPC_MSG_DEVICE_CREATE, (const uint8_t*)&create, sizeof(create));
+        ManagedDevice *dev = DeviceManager::findDevice(create.startIndex);
+        if (dev == nullptr || !dev->active || dev->updateTask == nullptr) return false;
+
+        SimClock::advanceTo(dev->updateTask->getNextRunTime());
+        tasks.update();
+        runNext();
+        bool ran = dev->updateTask != nullptr && dev->updateTask->getExecCount() > 0;
+
+        IPC_DeviceDelete_t del = {(uint16_t)n, create.startIndex};
+        ipc_handleMessage(IPC_MSG_DEVICE_DELETE, (const uint8_t*)&del, sizeof(del));
+        runNext();
+        ipc_clearTxQueue();
+        return ran && DeviceManager::findDevice(create.startIndex) == nullptr && !objIndex[create.startIndex].valid;
+    }
+}
+
+void checkDeviceSoak(void) {
+    checkFirmwareSetup();
+    Serial1.hostTxDiscard(true);
+    ipc_clearTxQueue();
+
+    size_t freeTasks = tasks.getFreeTaskCount();
+    uint32_t n = 0;
+    bool ok = true;
+    for (; n < WARMUP_CYCLES && ok; n++) ok = cycle(n);
+    CHECK(ok);
+    size_t heap = heapInUse();
+
+    uint32_t failedCycles = 0;
+    uint32_t leakedTasks = 0;       // Cycles that did not return their task to the pool
+    for (uint32_t i = 0; i < SOAK_CYCLES; i++, n++) {
+        if (!cycle(n)) failedCycles++;
+        if (tasks.getFreeTaskCount() != freeTasks) leakedTasks++;
+    }
+    CHECK(failedCycles == 0);
+    CHECK(leakedTasks == 0);
+    CHECK(tasks.getFreeTaskCount() == freeTasks);
+    CHECK(heapInUse() == heap);
+
+    Serial1.hostTxDiscard(false);
+}
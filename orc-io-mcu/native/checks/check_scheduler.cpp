@@ -0,0 +1,167 @@
+// Fixed-rate scheduling on the simulated clock: a 10 ms task holds its grid
+// when update() is late, CATCHUP_SKIP drops the missed periods, CATCHUP_BURST
+// runs them back to back (once per update()) and falls back to skipping past
+// MAX_BURST_PERIODS. Overruns are only counted against a budget that was set,
+// and interval 0 disarms a task.
+// Uses a scheduler of its own, not the firmware's.
+#include <Arduino.h>
+#include <Scheduler.h>
+#include "sim_clock.h"
+#include "checks.h"
+
+#include <vector>
+
+namespace {
+    const unsigned long PERIOD_MS = 10;
+    const uint64_t PERIOD_US = PERIOD_MS * 1000;
+
+    std::vector<uint64_t> runs;         // Start of each callback run
+
+    void record(void) {
+        runs.push_back(SimClock::now());
+    }
+
+    // Runs for three periods
+    void hog(void) {
+        SimClock::advance(3 * PERIOD_US);
+    }
+
+    // Dispatch every deadline up to endUs, each exactly on time
+    void runUntil(TaskScheduler &sched, uint64_t endUs) {
+        unsigned long due;
+        while (sched.getNextDeadline(&due) && due <= endUs) {
+            SimClock::advanceTo(due);
+            sched.update();
+        }
+        SimClock::advanceTo(endUs);
+    }
+
+    // Every run since index first is a whole number of periods after start
+    bool onGrid(size_t first, uint64_t start) {
+        for (size_t i = first; i < runs.size(); i++) {
+            if ((runs[i] - start) % PERIOD_US != 0) return false;
+        }
+        return true;
+    }
+
+    ScheduledTask *addRateTask(TaskScheduler &sched, TaskCatchUp catchUp) {
+        ScheduledTask *task = sched.addTask(record, PERIOD_MS, true, false, "rate");
+        if (task) task->setTiming(TIMING_FIXED_RATE, catchUp);
+        return task;
+    }
+
+    // A stall: update() is next called stallUs after the task's deadline
+    uint64_t stall(TaskScheduler &sched, ScheduledTask *task, uint64_t stallUs) {
+        uint64_t deadline = task->getNextRunTime();
+        SimClock::advanceTo(deadline + stallUs);
+        sched.update();
+        return deadline;
+    }
+}
+
+void checkScheduler(void) {
+    TaskScheduler sched;
+    sched.setIdleSleep(false);
+
+    // Late updates do not shift a fixed-rate task; a fixed-delay task moves
+    // by the lateness
+    ScheduledTask *rate = addRateTask(sched, CATCHUP_SKIP);
+    CHECK(rate != nullptr);
+    if (rate == nullptr) return;
+    uint64_t start = rate->getNextRunTime();
+    runs.clear();
+    runUntil(sched, start + 20 * PERIOD_US);
+    CHECK(runs.size() == 21 && onGrid(0, start));
+    CHECK(rate->getMaxLateness() == 0 && rate->getMissedPeriods() == 0);
+
+    runs.clear();
+    for (int i = 0; i < 10; i++) stall(sched, rate, 2500);
+    CHECK(runs.size() == 10 && onGrid(0, start + 2500));
+    CHECK(rate->getLastLateness() == 2500 && rate->getMaxLateness() == 2500);
+    CHECK(rate->getNextRunTime() % PERIOD_US == start % PERIOD_US);
+    CHECK(rate->getMissedPeriods() == 0);
+
+    sched.removeTask(rate);
+
+    ScheduledTask *delay = sched.addTask(record, PERIOD_MS, true, false, "delay");
+    uint64_t delayStart = delay->getNextRunTime();
+    for (int i = 0; i < 10; i++) stall(sched, delay, 2000);
+    CHECK(delay->getNextRunTime() == delayStart + 10 * (PERIOD_US + 2000));
+    sched.removeTask(delay);
+
+    // CATCHUP_SKIP: a 35 ms stall runs the task once, drops three periods
+    // and resumes on the next slot of the grid
+    rate = addRateTask(sched, CATCHUP_SKIP);
+    runUntil(sched, rate->getNextRunTime() + 5 * PERIOD_US);
+    runs.clear();
+    uint64_t deadline = stall(sched, rate, 3 * PERIOD_US + 5000);
+    CHECK(runs.size() == 1 && rate->getLastLateness() == 3 * PERIOD_US + 5000);
+    CHECK(rate->getMissedPeriods() == 3);
+    CHECK(rate->getNextRunTime() == deadline + 4 * PERIOD_US);
+    sched.update();
+    CHECK(runs.size() == 1);
+    runUntil(sched, deadline + 10 * PERIOD_US);
+    CHECK(runs.size() == 8 && onGrid(1, deadline));
+    CHECK(rate->getLastLateness() == 0);
+    sched.removeTask(rate);
+
+    // CATCHUP_BURST: the same stall runs the three missed periods on the
+    // following updates, one per update(), then the task is back on time
+    rate = addRateTask(sched, CATCHUP_BURST);
+    runUntil(sched, rate->getNextRunTime() + 5 * PERIOD_US);
+    runs.clear();
+    deadline = stall(sched, rate, 3 * PERIOD_US + 5000);
+    CHECK(runs.size() == 1 && rate->getMissedPeriods() == 0);
+    unsigned long lateness[3];
+    for (int i = 0; i < 3; i++) {
+        sched.update();
+        lateness[i] = rate->getLastLateness();
+    }
+    CHECK(runs.size() == 4);
+    CHECK(lateness[0] == 2 * PERIOD_US + 5000 && lateness[1] == PERIOD_US + 5000 && lateness[2] == 5000);
+    sched.update();
+    CHECK(runs.size() == 4);
+    CHECK(rate->getNextRunTime() == deadline + 4 * PERIOD_US);
+    runUntil(sched, deadline + 10 * PERIOD_US);
+    CHECK(runs.size() == 11 && rate->getMissedPeriods() == 0);
+    CHECK(rate->getMaxLateness() == 3 * PERIOD_US + 5000);
+
+    // Beyond MAX_BURST_PERIODS the burst is dropped as CATCHUP_SKIP would
+    runs.clear();
+    deadline = stall(sched, rate, 15 * PERIOD_US);
+    sched.update();
+    CHECK(runs.size() == 1);
+    CHECK(rate->getMissedPeriods() == 15);
+    CHECK(rate->getNextRunTime() == deadline + 16 * PERIOD_US);
+    sched.removeTask(rate);
+
+    // Budget 0 is no budget, whatever the interval: a run three periods long
+    // is only an overrun once a budget is set
+    ScheduledTask *slow = sched.addTask(hog, PERIOD_MS, true, false, "slow");
+    CHECK(slow->getBudget() == 0);
+    stall(sched, slow, 0);
+    CHECK(slow->getOverrunCount() == 0 && sched.getTotalOverrunCount() == 0);
+    slow->setBudget(PERIOD_US);
+    stall(sched, slow, 0);
+    CHECK(slow->getOverrunCount() == 1 && slow->getBudget() == PERIOD_US);
+    sched.removeTask(slow);
+
+    // Interval 0 disarms a running task, in both units, until a new interval
+    rate = addRateTask(sched, CATCHUP_SKIP);
+    runUntil(sched, rate->getNextRunTime());
+    runs.clear();
+    rate->setInterval(0);
+    unsigned long due;
+    CHECK(!rate->isArmed() && !sched.getNextDeadline(&due));
+    runUntil(sched, SimClock::now() + 5 * PERIOD_US);
+    CHECK(runs.empty());
+    rate->setInterval(PERIOD_MS);
+    rate->setIntervalMicros(0);
+    CHECK(!rate->isArmed() && !sched.getNextDeadline(&due));
+    rate->setIntervalMicros(PERIOD_US);
+    runUntil(sched, rate->getNextRunTime());
+    CHECK(rate->isArmed() && runs.size() == 1);
+    sched.removeTask(rate);
+
+    CHECK(sched.getFreeTaskCount() == sched.getTaskCapacity());
+}
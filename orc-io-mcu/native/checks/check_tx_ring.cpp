@@ -0,0 +1,255 @@
+// TX byte ring: variable-length records in both lanes, the wrap marker at a
+// lane end, frames resumed across a UART with little room (including a split
+// escape pair), and refusal, statistics and the space callback on a full lane.
+#include "sys_init.h"
+#include "drivers/ipc/ipc_crc16.h"
+#include "checks.h"
+
+#include <deque>
+#include <random>
+#include <string.h>
+#include <vector>
+
+namespace {
+    struct SentFrame {
+        uint8_t msgType;
+        std::vector<uint8_t> payload;
+    };
+
+    std::vector<uint8_t> wire;
+
+    // Numbered payload; flagPercent of the bytes are START/ESC so they stuff
+    std::vector<uint8_t> makePayload(std::mt19937 &rng, uint16_t length, uint32_t seq, uint32_t flagPercent) {
+        std::vector<uint8_t> payload(length);
+        for (uint16_t i = 0; i < length; i++) {
+            uint32_t r = rng();
+            if (r % 100 < flagPercent) payload[i] = (r & 0x100) ? IPC_START_BYTE : IPC_ESCAPE_BYTE;
+            else payload[i] = (uint8_t)(r >> 8);
+        }
+        for (uint16_t i = 0; i < length && i < 4; i++) payload[i] = (uint8_t)(seq >> (8 * i));
+        return payload;
+    }
+
+    bool queueFrame(std::deque<SentFrame> &sent, uint8_t msgType, const std::vector<uint8_t> &payload) {
+        if (!ipc_sendPacket(msgType, payload.data(), (uint16_t)payload.size())) return false;
+        sent.push_back({msgType, payload});
+        return true;
+    }
+
+    bool frameInProgress(void) {
+        return ipcDriver.txFramePos != 0 || ipcDriver.txEscapePending;
+    }
+
+    // Run the encoder until `frames` more frames are complete (or the queue is
+    // empty), collecting the wire bytes
+    uint32_t drainFrames(uint32_t frames) {
+        uint8_t buf[Uart::BUFFER_SIZE];
+        uint32_t done = 0;
+        uint32_t stalls = 0;
+        while (done < frames && (ipc_txQueueCount() > 0 || frameInProgress()) && stalls < 100000) {
+            if (ipc_processTxQueue()) done++;
+            size_t n = Serial1.hostTxRead(buf, sizeof(buf));
+            wire.insert(wire.end(), buf, buf + n);
+            stalls = n ? 0 : stalls + 1;
+        }
+        return done;
+    }
+
+    // Split the collected wire bytes into frames and compare each against the
+    // next frame queued. Returns the number of bad frames.
+    uint32_t matchFrames(std::deque<SentFrame> &sent) {
+        uint32_t bad = 0;
+        size_t i = 0;
+        while (i < wire.size()) {
+            if (wire[i++] != IPC_START_BYTE) {
+                bad++;
+                continue;
+            }
+            std::vector<uint8_t> frame;
+            while (i < wire.size() && wire[i] != IPC_END_BYTE) {
+                uint8_t byte = wire[i++];
+                if (byte == IPC_ESCAPE_BYTE && i < wire.size()) byte = wire[i++] ^ IPC_ESCAPE_XOR;
+                frame.push_back(byte);
+            }
+            i++;
+            if (sent.empty() || frame.size() < 5) {
+                bad++;
+                continue;
+            }
+            const SentFrame &expect = sent.front();
+            size_t n = frame.size();
+            uint16_t length = (uint16_t)((frame[0] << 8) | frame[1]);
+            uint16_t crc = (uint16_t)((frame[n - 2] << 8) | frame[n - 1]);
+            if (length != 1 + expect.payload.size() || n != 5 + expect.payload.size() ||
+                frame[2] != expect.msgType || crc != ipc_crc16(frame.data(), n - 2) ||
+                (!expect.payload.empty() && memcmp(&frame[3], expect.payload.data(), expect.payload.size()) != 0)) {
+                bad++;
+            }
+            sent.pop_front();
+        }
+        wire.clear();
+        return bad;
+    }
+
+    uint32_t spaceCallbacks = 0;
+    void onTxSpace(void) {
+        spaceCallbacks++;
+    }
+}
+
+void checkTxRing(void) {
+    std::mt19937 rng(6);
+    std::deque<SentFrame> sent;
+    IPC_TxLane_t *control = &ipcDriver.txLane[IPC_TX_LANE_CONTROL];
+    IPC_TxLane_t *bulk = &ipcDriver.txLane[IPC_TX_LANE_BULK];
+    const uint16_t header = sizeof(IPC_TxRecord_t);
+
+    // Wrap: 1000-byte records until the bulk lane is full, three sent, then
+    // one that no longer fits before the lane end goes to offset 0 behind a
+    // wrap marker
+    ipc_init();
+    wire.clear();
+    uint16_t record = (header + 1000 + 3) & ~3;
+    uint16_t records = 0;
+    while (queueFrame(sent, IPC_MSG_SENSOR_DATA, makePayload(rng, 1000, records, 10))) records++;
+    CHECK(records == bulk->size / record);
+    CHECK(bulk->count == records && bulk->used == records * record && bulk->head == records * record);
+    CHECK(bulk->highWater == records * record);
+    CHECK(ipcDriver.txHighWater == records * record);
+    CHECK(bulk->fullCount == 1);
+    CHECK(drainFrames(3) == 3);
+    CHECK(bulk->tail == 3 * record);
+
+    uint16_t wrapAt = bulk->head;
+    uint16_t skipped = bulk->size - wrapAt;
+    uint16_t length = skipped;          // Header plus this payload overruns the lane end
+    CHECK(queueFrame(sent, IPC_MSG_SENSOR_DATA, makePayload(rng, length, records, 10)));
+    const IPC_TxRecord_t *marker = (const IPC_TxRecord_t*)&ipcDriver.txRing[bulk->base + wrapAt];
+    CHECK(marker->payloadLen == IPC_TX_RECORD_WRAP);
+    CHECK(bulk->head == ((header + length + 3) & ~3));
+    CHECK(bulk->used == (records - 3) * record + skipped + bulk->head);
+    CHECK(bulk->count == records - 2);
+    CHECK(control->count == 0);
+    CHECK(drainFrames(records) == records - 2u);
+    CHECK(bulk->count == 0 && bulk->used == 0 && bulk->head == 0 && bulk->tail == 0);
+    CHECK(sent.size() == records + 1u);
+    CHECK(matchFrames(sent) == 0);
+    CHECK(sent.empty());
+    CHECK(bulk->peak == records);
+
+    // Random sizes on both lanes with partial drains: every frame comes out
+    // intact and in lane order, across many wraps
+    ipc_init();
+    std::deque<SentFrame> sentControl;
+    uint32_t wraps = 0, refused = 0, badFrames = 0;
+    for (uint32_t seq = 0; seq < 20000; seq++) {
+        bool toBulk = rng() % 3 != 0;
+        IPC_TxLane_t *lane = toBulk ? bulk : control;
+        uint16_t len = (rng() % 8 == 0) ? IPC_MAX_PAYLOAD_SIZE : rng() % 400;
+        uint16_t headBefore = lane->head;
+        uint32_t fullBefore = lane->fullCount;
+        std::deque<SentFrame> &queue = toBulk ? sent : sentControl;
+        std::vector<uint8_t> payload = makePayload(rng, len, seq, 5);
+        bool fits = ipc_txQueueHasSpace(toBulk ? IPC_MSG_SENSOR_DATA : IPC_MSG_PONG, len);
+        if (queueFrame(queue, toBulk ? IPC_MSG_SENSOR_DATA : IPC_MSG_PONG, payload)) {
+            if (!fits) badFrames++;
+            if (lane->head < headBefore && lane->head != 0) wraps++;
+        } else {
+            if (fits || lane->fullCount != fullBefore + 1) badFrames++;
+            refused++;
+        }
+        if (rng() % 4 == 0) {
+            // One frame at a time so the wire bytes can be credited to a lane
+            uint32_t frames = rng() % 4;
+            for (uint32_t f = 0; f < frames && ipc_txQueueCount() > 0; f++) {
+                drainFrames(1);
+                badFrames += matchFrames(ipcDriver.txActiveLane == IPC_TX_LANE_BULK ? sent : sentControl);
+            }
+        }
+    }
+    while (ipc_txQueueCount() > 0) {
+        drainFrames(1);
+        badFrames += matchFrames(ipcDriver.txActiveLane == IPC_TX_LANE_BULK ? sent : sentControl);
+    }
+    CHECK(badFrames == 0);
+    CHECK(sent.empty() && sentControl.empty());
+    CHECK(wraps > 100);
+    CHECK(refused > 0);
+    CHECK(bulk->used == 0 && control->used == 0);
+
+    // Partial room: a UART that takes only a few bytes per call. The frame
+    // resumes where it stopped, including between an escape and its byte.
+    ipc_init();
+    uint32_t escapeSplits = 0, resumes = 0;
+    for (size_t room = 1; room <= 24; room++) {
+        Serial1.hostSetTxSize(room);
+        std::vector<uint8_t> payload = makePayload(rng, 300, (uint32_t)room, 40);
+        CHECK(queueFrame(sent, IPC_MSG_PONG, payload));
+        uint32_t calls = 0;
+        uint8_t buf[32];
+        bool done = false;
+        while (!done && calls < 10000) {
+            done = ipc_processTxQueue();
+            calls++;
+            if (ipcDriver.txEscapePending) escapeSplits++;
+            size_t n = Serial1.hostTxRead(buf, sizeof(buf));
+            wire.insert(wire.end(), buf, buf + n);
+        }
+        resumes += calls - 1;
+        CHECK(done);
+        CHECK(!frameInProgress());
+        CHECK(matchFrames(sent) == 0);
+    }
+    CHECK(escapeSplits > 0);
+    CHECK(resumes > 0);
+    Serial1.hostSetTxSize(Uart::BUFFER_SIZE);
+
+    // Full lane: refused without touching the other lane, counted, and the
+    // waiting producer is called back once a frame has gone out
+    ipc_init();
+    std::vector<uint8_t> payload = makePayload(rng, 200, 0, 0);
+    uint32_t queued = 0;
+    while (ipc_sendPacket(IPC_MSG_PONG, payload.data(), 200)) queued++;
+    uint16_t record200 = (header + 200 + 3) & ~3;
+    CHECK(queued == IPC_TX_CONTROL_RING_SIZE / record200);
+    CHECK(control->fullCount == 1);
+    CHECK(ipcDriver.txErrorCount == 1);
+    CHECK(!ipc_txQueueHasSpace(IPC_MSG_PONG, 200));
+    CHECK(ipc_txQueueFree(IPC_MSG_PONG) == IPC_TX_CONTROL_RING_SIZE - queued * record200);
+    CHECK(ipc_txQueueHasSpace(IPC_MSG_SENSOR_DATA, IPC_MAX_PAYLOAD_SIZE));
+    CHECK(!ipc_txQueueHasSpace(IPC_MSG_SENSOR_DATA, IPC_MAX_PAYLOAD_SIZE + 1));
+
+    // Top up to exactly full: nothing fits, not even an empty payload
+    uint16_t rest = ipc_txQueueFree(IPC_MSG_PONG);
+    CHECK(ipc_sendPacket(IPC_MSG_PONG, payload.data(), rest - header));
+    CHECK(control->used == control->size);
+    CHECK(control->highWater == control->size);
+    CHECK(!ipc_txQueueHasSpace(IPC_MSG_PONG, 0));
+    CHECK(!ipc_sendPacket(IPC_MSG_PONG, payload.data(), 0));
+    CHECK(control->fullCount == 2);
+    CHECK(ipc_sendPacket(IPC_MSG_SENSOR_DATA, payload.data(), 200));
+    CHECK(bulk->fullCount == 0);
+
+    // Registering twice keeps one waiter; a UART with no room frees nothing
+    CHECK(ipc_txNotifyWhenFree(IPC_MSG_PONG, 200, onTxSpace));
+    CHECK(ipc_txNotifyWhenFree(IPC_MSG_PONG, 200, onTxSpace));
+    CHECK(ipcDriver.txWaiterCount == 1);
+    CHECK(!ipc_txNotifyWhenFree(IPC_MSG_PONG, 200, nullptr));
+    Serial1.hostSetTxSize(1);
+    spaceCallbacks = 0;
+    ipc_update();
+    CHECK(spaceCallbacks == 0);
+    CHECK(ipcDriver.txWaiterCount == 1);
+    uint8_t buf[Uart::BUFFER_SIZE];
+    Serial1.hostTxRead(buf, sizeof(buf));
+    Serial1.hostSetTxSize(Uart::BUFFER_SIZE);
+    ipc_update();
+    CHECK(spaceCallbacks == 1);
+    CHECK(ipcDriver.txWaiterCount == 0);
+    CHECK(ipc_txQueueHasSpace(IPC_MSG_PONG, 200));
+    ipc_update();
+    CHECK(spaceCallbacks == 1);
+
+    Serial1.hostTxRead(buf, sizeof(buf));
+    ipc_init();
+}
@@ -0,0 +1,97 @@
+#include "sys_init.h"
+#include "drivers/ipc/ipc_crc16.h"
+#include "checks.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+void setup();
+
+namespace {
+    struct NativeCheck {
+        const char *name;
+        void (*run)(void);
+    };
+
+    const NativeCheck nativeChecks[] = {
+        {"crc", checkCrc},
+        {"tx-ring", checkTxRing},
+        {"config-batch", checkConfigBatch},
+        {"scheduler", checkScheduler},
+        {"device-soak", checkDeviceSoak},
+        {"adc-filter", checkAdcFilter},
+        {"adc-capture", checkAdcCapture},
+    };
+
+    uint32_t expectations = 0;
+    uint32_t failures = 0;
+}
+
+bool checkExpect(bool ok, const char *file, int line, const char *expr) {
+    expectations++;
+    if (!ok) {
+        failures++;
+        printf("  FAIL %s:%d: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+bool checkNear(double a, double b, double tol) {
+    return fabs(a - b) <= tol;
+}
+
+void checkFirmwareSetup(void) {
+    static bool done = false;
+    if (!done) {
+        setup();
+        done = true;
+    }
+}
+
+int checkTxTake(uint8_t msgType, uint8_t *payload, uint16_t space) {
+    static uint8_t wire[2 * (IPC_MAX_PAYLOAD_SIZE + 8)];
+    static uint8_t frame[IPC_MAX_PAYLOAD_SIZE + 8];
+    int taken = -1;
+    size_t wireLen = 0;
+    while (ipc_txQueueCount() > 0 || ipcDriver.txFramePos != 0 || ipcDriver.txEscapePending) {
+        bool done = ipc_processTxQueue();
+        wireLen += Serial1.hostTxRead(&wire[wireLen], sizeof(wire) - wireLen);
+        if (!done) continue;
+
+        // Unstuff between the flags, check the CRC and the type
+        size_t n = 0;
+        for (size_t i = 1; i + 1 < wireLen && n < sizeof(frame); i++) {
+            frame[n++] = (wire[i] == IPC_ESCAPE_BYTE) ? (uint8_t)(wire[++i] ^ IPC_ESCAPE_XOR) : wire[i];
+        }
+        wireLen = 0;
+        if (n < 5 || frame[2] != msgType) continue;
+        uint16_t crc = (uint16_t)((frame[n - 2] << 8) | frame[n - 1]);
+        uint16_t len = (uint16_t)(n - 5);
+        if (crc != ipc_crc16(frame, n - 2) || len > space) continue;
+        memcpy(payload, &frame[3], len);
+        taken = len;
+    }
+    return taken;
+}
+
+int runChecks(const char *name) {
+    bool all = strcmp(name, "all") == 0;
+    int failed = 0;
+    int ran = 0;
+    for (const NativeCheck &check : nativeChecks) {
+        if (!all && strcmp(name, check.name) != 0) continue;
+        expectations = 0;
+        failures = 0;
+        check.run();
+        printf("%-4s %-16s %lu expectations, %lu failed\n", failures ? "FAIL" : "ok", check.name,
+               (unsigned long)expectations, (unsigned long)failures);
+        if (failures) failed++;
+        ran++;
+    }
+    return ran ? failed : -1;
+}
+
+void listChecks(void) {
+    for (const NativeCheck &check : nativeChecks) printf("  %s\n", check.name);
+}
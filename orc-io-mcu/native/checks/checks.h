@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Pass/fail checks for the native build, run with --check NAME (or all).
+// A check is a function that states its expectations with CHECK(); each
+// failed expectation is printed with its location and fails the run.
+
+#define CHECK(cond)             checkExpect((cond), __FILE__, __LINE__, #cond)
+#define CHECK_NEAR(a, b, tol)   checkExpect(checkNear((a), (b), (tol)), __FILE__, __LINE__, #a " ~ " #b)
+
+bool checkExpect(bool ok, const char *file, int line, const char *expr);
+bool checkNear(double a, double b, double tol);
+
+// Runs the named check, or every check for "all". Returns the number of
+// checks that failed, or -1 for an unknown name.
+int runChecks(const char *name);
+void listChecks(void);
+
+// Firmware setup() once per run, for checks that need the object index,
+// drivers and tasks. The IPC link stays disconnected.
+void checkFirmwareSetup(void);
+
+// Sends everything queued on the IO MCU IPC link and copies out the payload of
+// the last good frame of msgType. Returns its length, or -1 if none was sent.
+int checkTxTake(uint8_t msgType, uint8_t *payload, uint16_t space);
+
+// The checks (native/checks/check_*.cpp)
+void checkCrc(void);
+void checkTxRing(void);
+void checkConfigBatch(void);
+void checkScheduler(void);
+void checkDeviceSoak(void);
+void checkAdcFilter(void);
+void checkAdcCapture(void);
+
+// Benchmarks with built-in equivalence assertions; return false on a mismatch
+bool benchCrc(uint64_t bytes);
+
+// SYS MCU CRC header (orc-sys-mcu/lib/IPCprotocol/IPCCrc16.h), compiled in a
+// translation unit of its own as it mirrors the IO MCU header's names
+namespace SysCrc {
+    uint16_t crc16(const uint8_t *data, size_t length);
+    uint16_t update(uint16_t crc, const uint8_t *data, size_t length);
+    uint16_t updateSlice4(uint16_t crc, const uint8_t *data, size_t length);
+    uint16_t byte(uint16_t crc, uint8_t b);
+}
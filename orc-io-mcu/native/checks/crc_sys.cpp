@@ -0,0 +1,10 @@
+// The SYS MCU CRC header under test, kept out of the IO header's way
+#include "../../../orc-sys-mcu/lib/IPCprotocol/IPCCrc16.h"
+#include "checks.h"
+
+namespace SysCrc {
+    uint16_t crc16(const uint8_t *data, size_t length) { return ipc_crc16(data, length); }
+    uint16_t update(uint16_t crc, const uint8_t *data, size_t length) { return ipc_crc16_update(crc, data, length); }
+    uint16_t updateSlice4(uint16_t crc, const uint8_t *data, size_t length) { return ipc_crc16_update_slice4(crc, data, length); }
+    uint16_t byte(uint16_t crc, uint8_t b) { return ipc_crc16_byte(crc, b); }
+}
@@ -0,0 +1,86 @@
+// Native mock of drivers/onboard/drv_adc.cpp: same objects and conversion
+// pipeline, results come from MockHw::adcRaw instead of the MCP346x
+#include "sys_init.h"
+#include "mock_hw.h"
+
+AnalogInput_t adcInput[8];
+ADCDriver_t adcDriver;
+
+namespace MockHw {
+    int32_t adcRaw[8] = {0};
+    uint32_t adcConversions = 0;
+    uint32_t adcScanPeriodUs = 0;
+    bool adcScanFault = false;
+    static bool adcNewData = false;
+    static uint8_t adcScanMask = 0xFF;
+
+    void adcDataReady() {
+        adcConversions++;
+        adcNewData = true;
+        adcDriver.dataReadyUs = micros();
+        if (analog_input_task) analog_input_task->post();
+    }
+}
+
+bool ADC_init(void) {
+    adcDriver.adc = nullptr;
+    for (int i = 0; i < 8; i++) {
+        adcDriver.inputObj[i] = &adcInput[i];
+        adcDriver.inputObj[i]->value = 0;
+        adcDriver.inputObj[i]->cal = &calTable[i + CAL_ADC_PTR];
+        strcpy(adcDriver.inputObj[i]->unit, "mV");
+        ADC_configure(i);
+        ADC_setFilter(i, ADC_FILTER_NONE, 1);
+
+        objIndex[0 + i].type = OBJ_T_ANALOG_INPUT;
+        objIndex[0 + i].obj = adcDriver.inputObj[i];
+        sprintf(objIndex[0 + i].name, "Analogue Input %d", i + 1);
+        objIndex[0 + i].valid = true;
+    }
+    adcDriver.fault = false;
+    adcDriver.ready = true;
+    adcDriver.newMessage = true;
+    strcpy(adcDriver.message, "ADC initialisation successful (mock)");
+    return true;
+}
+
+void ADC_update(void) {
+    if (!MockHw::adcNewData) return;
+    MockHw::adcNewData = false;
+    adcDriver.ready = true;
+    ADC_pipelineConvert(&adcDriver.pipeline, MockHw::adcRaw, MockHw::adcScanMask);     // A whole scan per data-ready edge
+    if (ADC_captureRunning()) {
+        for (uint8_t ch = 0; ch < ADC_NUM_CHANNELS; ch++) {
+            if (MockHw::adcScanMask & (1 << ch)) ADC_captureInput(ch, MockHw::adcRaw[ch], adcDriver.dataReadyUs);
+        }
+    }
+    for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+        adcDriver.inputObj[i]->value = adcDriver.pipeline.value[i];
+    }
+}
+
+void ADC_configure(uint8_t channel) {
+    if (channel >= ADC_NUM_CHANNELS) return;
+    AnalogInput_t *input = adcDriver.inputObj[channel];
+    ADC_pipelineConfigure(&adcDriver.pipeline, channel, input->unit, input->cal);
+}
+
+void ADC_setFilter(uint8_t channel, uint8_t type, uint8_t length) {
+    ADC_pipelineSetFilter(&adcDriver.pipeline, channel, type, length);
+}
+
+bool ADC_setCaptureScan(uint8_t channelMask, uint8_t osr, uint32_t timer) {
+    if (MockHw::adcScanFault) {
+        MockHw::adcScanFault = false;
+        return false;
+    }
+    MockHw::adcScanMask = channelMask;
+    MockHw::adcScanPeriodUs = max(ADC_captureScanPeriodUs(__builtin_popcount(channelMask), osr, timer), 1u);
+    return true;
+}
+
+bool ADC_restoreScan(void) {
+    MockHw::adcScanMask = 0xFF;
+    MockHw::adcScanPeriodUs = 0;
+    return true;
+}
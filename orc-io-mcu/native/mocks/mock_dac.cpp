@@ -0,0 +1,56 @@
+// Native mock of drivers/onboard/drv_dac.cpp: codes land in MockHw::dacCode
+#include "sys_init.h"
+#include "mock_hw.h"
+
+AnalogOutput_t dacOutput[2] = {};
+DACDriver_t dacDriver;
+
+namespace MockHw {
+    uint16_t dacCode[2] = {0};
+    uint32_t dacWrites = 0;
+}
+
+bool DAC_init(void) {
+    dacDriver.dac = nullptr;
+    for (int i = 0; i < 2; i++) {
+        dacDriver.outputObj[i] = &dacOutput[i];
+        dacDriver.outputObj[i]->value = 0;
+        dacDriver.outputObj[i]->cal = &calTable[i + CAL_DAC_PTR];
+        strcpy(dacDriver.outputObj[i]->unit, "mV");
+
+        objIndex[8 + i].type = OBJ_T_ANALOG_OUTPUT;
+        objIndex[8 + i].obj = &dacOutput[i];
+        sprintf(objIndex[8 + i].name, "Analogue Output %d", i + 1);
+        objIndex[8 + i].valid = true;
+
+        dacDriver.outputObj[i]->enabled = true;
+        dacDriver.outputObj[i]->fault = false;
+        dacDriver.outputObj[i]->newMessage = false;
+    }
+    return true;
+}
+
+bool DAC_writeOutputs(void) {
+    for (int i = 0; i < 2; i++) {
+        if (!dacDriver.outputObj[i]->enabled) continue;
+        if (dacDriver.outputObj[i]->value > 10240) dacDriver.outputObj[i]->value = 10240;
+        else if (dacDriver.outputObj[i]->value < 0) dacDriver.outputObj[i]->value = 0;
+
+        float dacVal = dacDriver.outputObj[i]->value;
+        dacVal /= dacDriver.outputObj[i]->cal->scale;
+        dacVal -= dacDriver.outputObj[i]->cal->offset;
+        dacVal /= mV_PER_LSB;
+        MockHw::dacCode[i] = (uint16_t)dacVal;
+        MockHw::dacWrites++;
+    }
+    return true;
+}
+
+void DAC_update(void) {
+    static float dacVal[2] = {0, 0};
+    if (dacDriver.outputObj[0]->value != dacVal[0] || dacDriver.outputObj[1]->value != dacVal[1]) {
+        DAC_writeOutputs();
+        dacVal[0] = dacDriver.outputObj[0]->value;
+        dacVal[1] = dacDriver.outputObj[1]->value;
+    }
+}
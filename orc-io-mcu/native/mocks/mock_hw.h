@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// Simulated plant behind the mocked onboard drivers of the native build.
+// Simulations write the inputs and read back what the firmware drove.
+namespace MockHw {
+    // Inputs
+    extern int32_t adcRaw[8];           // MCP346x result codes, converted by ADC_update()
+    extern float rtdCelsius[3];         // MAX31865 temperatures
+    extern float pwrVolts[2];           // INA260 readings
+    extern float pwrAmps[2];
+    extern bool stepperStall;           // Raise a TMC5130 stall on the next status update
+    extern bool motorFault[4];          // Raise a DRV8235 fault on the next update
+    extern bool adcScanFault;           // Fail the next switch to a capture scan
+
+    // Outputs
+    extern uint16_t dacCode[2];         // Last code written to the MCP48FEB
+    extern float heaterDuty;            // Heater PWM duty (%) while in PWM mode
+    extern float stepperRpm;            // RPM commanded to the TMC5130 (0 when stopped)
+
+    // Counters
+    extern uint32_t adcConversions;     // Data-ready edges raised by adcDataReady()
+    extern uint32_t dacWrites;
+
+    // Scan period the firmware asked for with a burst capture (0 = normal scan,
+    // paced by the simulation). Simulations raise adcDataReady() at this period.
+    extern uint32_t adcScanPeriodUs;
+
+    // Raise the MCP346x data-ready IRQ (one channel converted)
+    void adcDataReady();
+}
@@ -0,0 +1,77 @@
+// Native mock of drivers/onboard/drv_bdc_mot.cpp: the DRV8235 draws a current
+// proportional to the commanded power while running
+#include "sys_init.h"
+#include "mock_hw.h"
+
+MotorDriver_t motorDriver[4];
+MotorDevice_t motorDevice[4];
+
+namespace MockHw {
+    bool motorFault[4] = {false};
+}
+
+static const uint16_t MOCK_MOTOR_MA_PER_PERCENT = 10;
+
+bool motor_init(void) {
+    for (int i = 0; i < 4; i++) {
+        motorDriver[i].motor = nullptr;
+        motorDriver[i].device = &motorDevice[i];
+        motorDriver[i].ready = true;
+        motorDriver[i].fault = false;
+        motorDriver[i].newMessage = false;
+
+        motorDevice[i].power = 0;
+        motorDevice[i].running = false;
+        motorDevice[i].enabled = false;
+        strcpy(motorDevice[i].unit, "%");
+        motorDevice[i].fault = false;
+        motorDevice[i].newMessage = false;
+        motorDevice[i].message[0] = '\0';
+
+        objIndex[27 + i].type = OBJ_T_BDC_MOTOR;
+        objIndex[27 + i].obj = &motorDevice[i];
+        sprintf(objIndex[27 + i].name, "DC Motor %d", i + 1);
+        objIndex[27 + i].valid = true;
+    }
+    return true;
+}
+
+void motor_update(void) {
+    for (int i = 0; i < 4; i++) {
+        motorDevice[i].runCurrent = motorDevice[i].running ? (uint16_t)(motorDevice[i].power * MOCK_MOTOR_MA_PER_PERCENT) : 0;
+        if (MockHw::motorFault[i]) {
+            MockHw::motorFault[i] = false;
+            motorDriver[i].fault = true;
+            motorDriver[i].newMessage = true;
+            strcpy(motorDriver[i].message, "Motor driver fault");
+            motorDevice[i].fault = true;
+            motorDevice[i].newMessage = true;
+            strcpy(motorDevice[i].message, motorDriver[i].message);
+        }
+    }
+}
+
+bool motor_stop(uint8_t motor) {
+    if (motor >= 4) return false;
+    motorDevice[motor].running = false;
+    motorDevice[motor].runCurrent = 0;
+    return true;
+}
+
+bool motor_run(uint8_t motor) {
+    if (motor >= 4) return false;
+    if (!motorDevice[motor].enabled) {
+        strcpy(motorDriver[motor].message, "Motor driver not enabled");
+        motorDriver[motor].newMessage = true;
+        return false;
+    }
+    motorDevice[motor].running = true;
+    return true;
+}
+
+bool motor_run(uint8_t motor, uint8_t power, bool reverse) {
+    if (motor >= 4) return false;
+    motorDevice[motor].power = power;
+    motorDevice[motor].direction = reverse;
+    return motor_run(motor);
+}
@@ -0,0 +1,73 @@
+// Native mock of drivers/onboard/drv_output.cpp: open-drain outputs drive the
+// host pin table, the heater's TCC0 PWM is reduced to MockHw::heaterDuty
+#include "sys_init.h"
+#include "mock_hw.h"
+
+OutputDriver_t outputDriver;
+DigitalOutput_t digitalOutput[4];
+DigitalOutput_t heaterOutput[1];
+
+namespace MockHw {
+    float heaterDuty = 0;
+}
+
+void output_init(void) {
+    int outputPins[4] = {PIN_OUT_1, PIN_OUT_2, PIN_OUT_3, PIN_OUT_4};
+    for (int i = 0; i < 4; i++) {
+        digitalOutput[i].state = false;
+        digitalOutput[i].pwmEnabled = false;
+        digitalOutput[i].pwmDuty = 0.0f;
+
+        outputDriver.outputObj[i] = &digitalOutput[i];
+        outputDriver.pin[i] = outputPins[i];
+        pinMode(outputDriver.pin[i], OUTPUT);
+        digitalWrite(outputDriver.pin[i], LOW);
+
+        objIndex[21 + i].type = OBJ_T_DIGITAL_OUTPUT;
+        objIndex[21 + i].obj = &digitalOutput[i];
+        sprintf(objIndex[21 + i].name, "Digital Output %d", i + 1);
+        objIndex[21 + i].valid = true;
+    }
+
+    heaterOutput[0].state = false;
+    heaterOutput[0].pwmEnabled = false;
+    heaterOutput[0].pwmDuty = 0.0f;
+    outputDriver.outputObj[4] = &heaterOutput[0];
+    outputDriver.pin[4] = PIN_HEAT_OUT;
+    pinMode(PIN_HEAT_OUT, OUTPUT);
+
+    objIndex[25].type = OBJ_T_DIGITAL_OUTPUT;
+    objIndex[25].obj = &heaterOutput[0];
+    strcpy(objIndex[25].name, "Heater Output");
+    objIndex[25].valid = true;
+}
+
+void output_force_digital_mode(uint8_t outputIndex) {
+    if (outputIndex >= 21 && outputIndex <= 24) {
+        int arrayIdx = outputIndex - 21;
+        digitalWrite(outputDriver.pin[arrayIdx], outputDriver.outputObj[arrayIdx]->state);
+    } else if (outputIndex == 25) {
+        MockHw::heaterDuty = 0;
+        digitalWrite(outputDriver.pin[4], outputDriver.outputObj[4]->state);
+    }
+}
+
+void output_update(void) {
+    for (int i = 0; i < 4; i++) {
+        DigitalOutput_t *out = outputDriver.outputObj[i];
+        if (out->pwmEnabled) {
+            out->pwmDuty = constrain(out->pwmDuty, 0.0f, 100.0f);
+            analogWrite(outputDriver.pin[i], static_cast<uint8_t>(out->pwmDuty * 2.55));
+        } else {
+            digitalWrite(outputDriver.pin[i], out->state);
+        }
+    }
+
+    if (heaterOutput[0].pwmEnabled) {
+        heaterOutput[0].pwmDuty = constrain(heaterOutput[0].pwmDuty, 0.0f, 100.0f);
+        MockHw::heaterDuty = heaterOutput[0].pwmDuty;
+    } else {
+        MockHw::heaterDuty = 0;
+        digitalWrite(outputDriver.pin[4], heaterOutput[0].state);
+    }
+}
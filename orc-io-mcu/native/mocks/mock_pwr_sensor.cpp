@@ -0,0 +1,41 @@
+// Native mock of drivers/onboard/drv_pwr_sensor.cpp: readings come from MockHw
+#include "sys_init.h"
+#include "mock_hw.h"
+
+EnergySensor_t pwr_energy[2];
+PowerSensorDriver_t pwr_interface[2];
+
+namespace MockHw {
+    float pwrVolts[2] = {24.0f, 24.0f};
+    float pwrAmps[2] = {0.5f, 0.0f};
+}
+
+bool pwrSensor_init(void) {
+    const char* sensorNames[] = {"Main", "Heater"};
+    for (int i = 0; i < 2; i++) {
+        pwr_interface[i].sensor = nullptr;
+        pwr_interface[i].updateInterval = 1.0;
+
+        pwr_energy[i].voltage = 0.0f;
+        pwr_energy[i].current = 0.0f;
+        pwr_energy[i].power = 0.0f;
+        strcpy(pwr_energy[i].unit, "V");
+        pwr_energy[i].fault = false;
+        pwr_energy[i].newMessage = false;
+        pwr_energy[i].message[0] = '\0';
+
+        objIndex[31 + i].type = OBJ_T_ENERGY_SENSOR;
+        objIndex[31 + i].obj = &pwr_energy[i];
+        sprintf(objIndex[31 + i].name, "%s Power Monitor", sensorNames[i]);
+        objIndex[31 + i].valid = true;
+    }
+    return true;
+}
+
+void pwrSensor_update(void) {
+    for (int i = 0; i < 2; i++) {
+        pwr_energy[i].voltage = MockHw::pwrVolts[i];
+        pwr_energy[i].current = MockHw::pwrAmps[i];
+        pwr_energy[i].power = MockHw::pwrVolts[i] * MockHw::pwrAmps[i];
+    }
+}
@@ -0,0 +1,87 @@
+// Native mock of drivers/onboard/drv_rtd.cpp: temperatures come from MockHw::rtdCelsius
+#include "sys_init.h"
+#include "mock_hw.h"
+
+TemperatureSensor_t rtd_sensor[3];
+RTDDriver_t rtd_interface[3];
+
+namespace MockHw {
+    float rtdCelsius[3] = {25.0f, 25.0f, 25.0f};
+}
+
+bool init_rtdDriver(void) {
+    for (int i = 0; i < NUM_MAX31865_INTERFACES; i++) {
+        rtd_interface[i].temperatureObj = &rtd_sensor[i];
+        rtd_interface[i].cs_pin = -1;
+        rtd_interface[i].drdy_pin = -1;
+        rtd_interface[i].sensor = nullptr;
+        rtd_interface[i].wires = MAX31865_3WIRE;
+        rtd_interface[i].sensorType = PT100;
+        rtd_interface[i].cal = &calTable[i + CAL_RTD_PTR];
+        rtd_interface[i].state = RTD_STATE_IDLE;
+        rtd_interface[i].samplePeriodMs = RTD_DEFAULT_PERIOD_MS;
+        rtd_interface[i].nextSample = millis();
+        rtd_interface[i].samples = 0;
+        rtd_interface[i].drdyTimeouts = 0;
+
+        rtd_sensor[i].temperature = 0;
+        strcpy(rtd_sensor[i].unit, "°C");
+        rtd_sensor[i].fault = false;
+        rtd_sensor[i].newMessage = false;
+        rtd_sensor[i].cal = &calTable[i + CAL_RTD_PTR];
+
+        objIndex[10 + i].type = OBJ_T_TEMPERATURE_SENSOR;
+        objIndex[10 + i].obj = &rtd_sensor[i];
+        sprintf(objIndex[10 + i].name, "RTD Temperature %d", i + 1);
+        objIndex[10 + i].valid = true;
+    }
+    return true;
+}
+
+bool initTemperatureSensor(RTDDriver_t *sensorObj) { return sensorObj != nullptr; }
+
+// A sample lands every samplePeriodMs, like the real state machine
+bool readRtdSensor(RTDDriver_t *sensorObj) {
+    if (sensorObj == nullptr || sensorObj->temperatureObj == nullptr) return false;
+    uint32_t now = millis();
+    if ((int32_t)(now - sensorObj->nextSample) < 0) return true;
+    sensorObj->nextSample = now + sensorObj->samplePeriodMs;
+    sensorObj->samples++;
+    int i = sensorObj - rtd_interface;
+    float tempCelsius = MockHw::rtdCelsius[i] * sensorObj->cal->scale + sensorObj->cal->offset;
+    if (strcmp(sensorObj->temperatureObj->unit, "F") == 0) {
+        sensorObj->temperatureObj->temperature = (tempCelsius * 9.0 / 5.0) + 32.0;
+    } else if (strcmp(sensorObj->temperatureObj->unit, "K") == 0) {
+        sensorObj->temperatureObj->temperature = tempCelsius + 273.15;
+    } else {
+        sensorObj->temperatureObj->temperature = tempCelsius;
+    }
+    return true;
+}
+
+bool readRtdSensors(void) {
+    for (int i = 0; i < NUM_MAX31865_INTERFACES; i++) {
+        rtd_interface[i].temperatureObj->fault = !readRtdSensor(&rtd_interface[i]);
+    }
+    return true;
+}
+
+bool setRtdSamplePeriod(RTDDriver_t *sensorObj, uint16_t periodMs) {
+    if (periodMs == 0) periodMs = RTD_DEFAULT_PERIOD_MS;
+    sensorObj->samplePeriodMs = constrain(periodMs, RTD_MIN_PERIOD_MS, RTD_MAX_PERIOD_MS);
+    return true;
+}
+
+bool setRtdSensorType(RTDDriver_t *sensorObj, RtdSensorType sensorType) {
+    sensorObj->sensorType = sensorType;
+    return true;
+}
+
+bool setRtdWires(RTDDriver_t *sensorObj, max31865_numwires_t wires) {
+    sensorObj->wires = wires;
+    return true;
+}
+
+void RTD_manage(void) {
+    readRtdSensors();
+}
@@ -0,0 +1,56 @@
+// Native mock of drivers/onboard/drv_stepper.cpp: the TMC5130 follows the
+// device object immediately, commanded speed lands in MockHw::stepperRpm
+#include "sys_init.h"
+#include "mock_hw.h"
+
+StepperDriver_t stepperDriver;
+StepperDevice_t stepperDevice;
+
+namespace MockHw {
+    float stepperRpm = 0;
+    bool stepperStall = false;
+}
+
+bool stepper_init(void) {
+    stepperDriver.stepper = nullptr;
+    stepperDriver.device = &stepperDevice;
+    stepperDriver.ready = true;
+    stepperDriver.fault = false;
+
+    stepperDevice.rpm = 0;
+    stepperDevice.running = false;
+    stepperDevice.enabled = false;
+    strcpy(stepperDevice.unit, "rpm");
+    stepperDevice.fault = false;
+    stepperDevice.newMessage = false;
+    stepperDevice.message[0] = '\0';
+
+    objIndex[26].type = OBJ_T_STEPPER_MOTOR;
+    objIndex[26].obj = &stepperDevice;
+    strcpy(objIndex[26].name, "Stepper Motor");
+    objIndex[26].valid = true;
+    return true;
+}
+
+void stepper_update(void) {
+    stepper_update_cfg(false);
+}
+
+bool stepper_update_cfg(bool setParams) {
+    if (MockHw::stepperStall) {
+        MockHw::stepperStall = false;
+        stepperDriver.fault = true;
+        stepperDriver.newMessage = true;
+        strcpy(stepperDriver.message, "Stepper stall detected");
+        stepperDevice.fault = true;
+        stepperDevice.newMessage = true;
+        strcpy(stepperDevice.message, stepperDriver.message);
+    }
+    if (setParams) {
+        stepperDriver.ready = true;
+        float rpm = stepperDevice.rpm > stepperDevice.maxRPM ? stepperDevice.maxRPM : stepperDevice.rpm;
+        MockHw::stepperRpm = stepperDevice.enabled ? rpm : 0;
+    }
+    stepperDevice.running = MockHw::stepperRpm > 0;
+    return true;
+}
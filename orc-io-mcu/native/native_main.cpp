@@ -0,0 +1,243 @@
+// Host entry point for the native build: runs the unchanged setup()/loop() of
+// src/main.cpp against the shim and the mocked onboard drivers.
+//
+//   orc-io-mcu-native [--seconds N] [--realtime] [--quiet] [--adc-period-us N]
+//   orc-io-mcu-native --bench-adc N
+//   orc-io-mcu-native --bench-crc BYTES
+//   orc-io-mcu-native --check NAME|all|list
+//
+// In simulated time (the default) the loop jumps the clock straight to the
+// next scheduler deadline or ADC data-ready edge whenever nothing is due.
+// --bench-adc times N scans of the ADC conversion pipeline against the
+// per-sample unit lookup it replaced, then each input filter kernel, in host
+// ns and TSC cycles per sample. --bench-crc runs the CRC check, then times
+// the bitwise reference and the IO and SYS table paths over BYTES bytes.
+// --check runs the pass/fail checks in native/checks/ and exits non-zero if
+// any expectation fails.
+#include "sys_init.h"
+#include "mock_hw.h"
+#include "checks/checks.h"
+
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#endif
+
+void setup();
+void loop();
+
+namespace {
+    struct NativeOptions {
+        uint64_t seconds = 10;
+        bool realtime = false;
+        bool quiet = false;
+        uint64_t adcPeriodUs = 12500;   // 8 channels at the MCP346x scan rate, one edge per scan
+        uint64_t benchAdcScans = 0;
+        uint64_t benchCrcBytes = 0;
+        const char* check = nullptr;
+    };
+
+    void usage(const char* prog) {
+        fprintf(stderr, "usage: %s [--seconds N] [--realtime] [--quiet] [--adc-period-us N]\n"
+                        "       %s --bench-adc N\n"
+                        "       %s --bench-crc BYTES\n"
+                        "       %s --check NAME|all|list\n", prog, prog, prog, prog);
+    }
+
+    // Per-sample unit lookup as ADC_update() did it before the pipeline
+    void legacyConvert(const int32_t* raw, AnalogInput_t* inputs) {
+        for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+            float result = raw[i] * inputs[i].cal->scale + inputs[i].cal->offset;
+            if (strcmp(inputs[i].unit, "mV") == 0) {
+                inputs[i].value = result * ADC_mV_PER_LSB;
+            } else if (strcmp(inputs[i].unit, "mA") == 0) {
+                inputs[i].value = result * ADC_mA_PER_LSB;
+            } else if (strcmp(inputs[i].unit, "V") == 0) {
+                inputs[i].value = result * ADC_V_PER_LSB;
+            } else if (strcmp(inputs[i].unit, "uV") == 0) {
+                inputs[i].value = result * ADC_uV_PER_LSB;
+            } else {
+                inputs[i].value = result * ADC_mV_PER_LSB;
+            }
+        }
+    }
+
+    struct BenchTime {
+        double ns;
+        double cycles;
+    };
+
+    template <typename F>
+    BenchTime timeScans(uint64_t scans, int32_t* raw, F convert) {
+        auto t0 = std::chrono::steady_clock::now();
+#ifdef BENCH_HAS_TSC
+        uint64_t c0 = __rdtsc();
+#endif
+        for (uint64_t n = 0; n < scans; n++) {
+            raw[n & 7] = (int32_t)(n & 0x7FFF);     // New data every scan
+            asm volatile("" ::: "memory");
+            convert();
+            asm volatile("" ::: "memory");
+        }
+        BenchTime t = {0, 0};
+#ifdef BENCH_HAS_TSC
+        t.cycles = (double)(__rdtsc() - c0) / (scans * ADC_NUM_CHANNELS);
+#endif
+        t.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / (scans * ADC_NUM_CHANNELS);
+        return t;
+    }
+
+    void benchAdc(uint64_t scans) {
+        static const char* units[ADC_NUM_CHANNELS] = {"mV", "mA", "mA", "V", "uV", "mA", "V", "mV"};
+        Calibrate_t cal[ADC_NUM_CHANNELS];
+        AnalogInput_t inputs[ADC_NUM_CHANNELS] = {};
+        ADCPipeline_t pipe;
+        int32_t raw[ADC_NUM_CHANNELS];
+        for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+            cal[i].scale = 1.0f + 0.01f * i;
+            cal[i].offset = -2.0f * i;
+            strcpy(inputs[i].unit, units[i]);
+            inputs[i].cal = &cal[i];
+            ADC_pipelineConfigure(&pipe, i, units[i], &cal[i]);
+            ADC_pipelineSetFilter(&pipe, i, ADC_FILTER_NONE, 1);
+            raw[i] = 1000 * (i + 1);
+        }
+
+        BenchTime legacy = timeScans(scans, raw, [&] { legacyConvert(raw, inputs); });
+        BenchTime fused = timeScans(scans, raw, [&] { ADC_pipelineConvert(&pipe, raw, 0xFF); });
+
+        double maxErr = 0;
+        legacyConvert(raw, inputs);
+        ADC_pipelineConvert(&pipe, raw, 0xFF);
+        for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+            maxErr = max(maxErr, fabs((double)inputs[i].value - pipe.value[i]) / max(1e-6, fabs((double)inputs[i].value)));
+        }
+
+        printf("ADC conversion, %llu scans x %d channels (mixed units)\n", (unsigned long long)scans, ADC_NUM_CHANNELS);
+        printf("  %-28s %8.2f ns/sample %8.1f cycles/sample\n", "Per-sample unit lookup", legacy.ns, legacy.cycles);
+        printf("  %-28s %8.2f ns/sample %8.1f cycles/sample\n", "Fused gain/offset pipeline", fused.ns, fused.cycles);
+        printf("  Speed-up %.1fx, max relative difference %.2g\n", legacy.ns / fused.ns, maxErr);
+
+        // Filter kernels on a noisy step: time per sample, and the settled
+        // output against the step level as a sanity check
+        static const struct { uint8_t type; uint8_t length; } filters[] = {
+            {ADC_FILTER_NONE, 1}, {ADC_FILTER_MOVING_AVERAGE, 16}, {ADC_FILTER_MOVING_AVERAGE, 32},
+            {ADC_FILTER_IIR, 8}, {ADC_FILTER_MEDIAN, 5}, {ADC_FILTER_MEDIAN, 15},
+            {ADC_FILTER_CIC, 4}, {ADC_FILTER_CIC, 16},
+        };
+        printf("Filter kernels, %llu samples each (step 0 -> 10000 codes, +/-64 noise)\n", (unsigned long long)scans);
+        for (const auto& fc : filters) {
+            ADCFilter_t f;
+            ADC_filterConfigure(&f, fc.type, fc.length);
+            float out = 0, settled = 0;
+            uint32_t lcg = 1;
+            int32_t x = 0;
+            BenchTime t = timeScans(scans / ADC_NUM_CHANNELS, raw, [&] {
+                lcg = lcg * 1664525u + 1013904223u;
+                x = 10000 + (int32_t)(lcg >> 25) - 64;
+                ADC_filterInput(&f, x, &out);
+            });
+            // Mean over the last 256 outputs of a fresh run
+            ADC_filterConfigure(&f, fc.type, fc.length);
+            ADC_filterInput(&f, 0, &out);
+            for (int n = 0; n < 4096; n++) {
+                lcg = lcg * 1664525u + 1013904223u;
+                ADC_filterInput(&f, 10000 + (int32_t)(lcg >> 25) - 64, &out);
+                if (n >= 4096 - 256) settled += out / 256;
+            }
+            char name[24];
+            snprintf(name, sizeof(name), "%s/%u", ADC_filterName(fc.type), f.length);
+            printf("  %-28s %8.2f ns/sample %8.1f cycles/sample  settled %.1f\n",
+                   name, t.ns * ADC_NUM_CHANNELS, t.cycles * ADC_NUM_CHANNELS, settled);
+        }
+    }
+
+    bool parseArgs(int argc, char** argv, NativeOptions& opt) {
+        for (int i = 1; i < argc; i++) {
+            if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+                opt.seconds = strtoull(argv[++i], nullptr, 10);
+            } else if (strcmp(argv[i], "--realtime") == 0) {
+                opt.realtime = true;
+            } else if (strcmp(argv[i], "--quiet") == 0) {
+                opt.quiet = true;
+            } else if (strcmp(argv[i], "--adc-period-us") == 0 && i + 1 < argc) {
+                opt.adcPeriodUs = strtoull(argv[++i], nullptr, 10);
+            } else if (strcmp(argv[i], "--bench-adc") == 0 && i + 1 < argc) {
+                opt.benchAdcScans = strtoull(argv[++i], nullptr, 10);
+            } else if (strcmp(argv[i], "--bench-crc") == 0 && i + 1 < argc) {
+                opt.benchCrcBytes = strtoull(argv[++i], nullptr, 10);
+            } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+                opt.check = argv[++i];
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    NativeOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (opt.benchAdcScans > 0) {
+        benchAdc(opt.benchAdcScans);
+        return 0;
+    }
+    Serial.setEcho(false);          // Checks and benchmarks print their own results
+    if (opt.benchCrcBytes > 0) {
+        return benchCrc(opt.benchCrcBytes) ? 0 : 1;
+    }
+    if (opt.check) {
+        if (strcmp(opt.check, "list") == 0) {
+            listChecks();
+            return 0;
+        }
+        int failed = runChecks(opt.check);
+        if (failed < 0) fprintf(stderr, "unknown check: %s\n", opt.check);
+        return failed == 0 ? 0 : 1;
+    }
+
+    Serial.setEcho(!opt.quiet);
+    Serial1.hostTxDiscard(true);    // No SYS MCU attached: IPC frames go nowhere
+    SimClock::setRealtime(opt.realtime);
+
+    setup();
+
+    const uint64_t endUs = SimClock::now() + opt.seconds * 1000000ULL;
+    uint64_t nextAdcUs = SimClock::now() + opt.adcPeriodUs;
+
+    while (SimClock::now() < endUs) {
+        loop();
+
+        if (opt.adcPeriodUs > 0 && SimClock::now() >= nextAdcUs) {
+            MockHw::adcDataReady();
+            nextAdcUs += opt.adcPeriodUs;
+            continue;
+        }
+        if (opt.realtime) continue;
+
+        // Skip ahead to whatever happens next. A posted event hides the
+        // deadline until the next loop() has collected it.
+        uint64_t target = endUs;
+        unsigned long dueAt;
+        if (!tasks.getNextDeadline(&dueAt)) {
+            loop();
+            if (!tasks.getNextDeadline(&dueAt)) dueAt = (unsigned long)endUs;
+        }
+        if ((long)(dueAt - micros()) <= 0) continue;
+        target = min(target, (uint64_t)dueAt);
+        if (opt.adcPeriodUs > 0) target = min(target, nextAdcUs);
+        SimClock::advanceTo(target);
+    }
+
+    Serial.setEcho(true);
+    Serial.printf("\nSimulated %llu s, %lu ADC conversions, %lu DAC writes\n",
+                  (unsigned long long)opt.seconds, (unsigned long)MockHw::adcConversions,
+                  (unsigned long)MockHw::dacWrites);
+    tasks.printCpuUsageReport();
+    return 0;
+}
@@ -0,0 +1,325 @@
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+
+#include <chrono>
+#include <thread>
+
+// Simulated clock ------------------------------------------------------------
+
+namespace {
+    uint64_t simNowUs = 0;
+    bool simRealtime = false;
+    std::chrono::steady_clock::time_point simRealStart = std::chrono::steady_clock::now();
+}
+
+uint64_t SimClock::now() {
+    if (simRealtime) {
+        auto elapsed = std::chrono::steady_clock::now() - simRealStart;
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    }
+    return simNowUs;
+}
+
+void SimClock::advance(uint64_t us) {
+    if (simRealtime) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+        return;
+    }
+    simNowUs += us;
+}
+
+void SimClock::advanceTo(uint64_t us) {
+    uint64_t current = now();
+    if (us > current) advance(us - current);
+}
+
+void SimClock::setRealtime(bool realtime) {
+    if (realtime && !simRealtime) {
+        // Carry on from the current simulated time
+        simRealStart = std::chrono::steady_clock::now() - std::chrono::microseconds(simNowUs);
+    } else if (!realtime && simRealtime) {
+        simNowUs = now();
+    }
+    simRealtime = realtime;
+}
+
+bool SimClock::isRealtime() { return simRealtime; }
+
+unsigned long micros(void) { return (unsigned long)SimClock::now(); }
+
+unsigned long millis(void) { return (unsigned long)(SimClock::now() / 1000ULL); }
+
+void delay(unsigned long ms) { SimClock::advance((uint64_t)ms * 1000ULL); }
+
+void delayMicroseconds(unsigned int us) { SimClock::advance(us); }
+
+void yield(void) {}
+
+// Pins and interrupts ----------------------------------------------------------
+
+namespace {
+    struct SimPin {
+        uint32_t mode = INPUT;
+        int input = LOW;
+        int analog = 0;
+        int output = LOW;
+        voidFuncPtr isr = nullptr;
+    };
+    SimPin simPins[SIM_NUM_PINS];
+}
+
+void pinMode(uint32_t pin, uint32_t mode) {
+    if (pin >= SIM_NUM_PINS) return;
+    simPins[pin].mode = mode;
+    // Pulled inputs idle at the pull level until the simulation drives them
+    if (mode == INPUT_PULLUP) simPins[pin].input = HIGH;
+    else if (mode == INPUT_PULLDOWN) simPins[pin].input = LOW;
+}
+
+void digitalWrite(uint32_t pin, uint32_t value) {
+    if (pin < SIM_NUM_PINS) simPins[pin].output = value ? HIGH : LOW;
+}
+
+int digitalRead(uint32_t pin) {
+    if (pin >= SIM_NUM_PINS) return LOW;
+    return simPins[pin].mode == OUTPUT ? simPins[pin].output : simPins[pin].input;
+}
+
+int analogRead(uint32_t pin) { return pin < SIM_NUM_PINS ? simPins[pin].analog : 0; }
+
+void analogWrite(uint32_t pin, uint32_t value) {
+    if (pin < SIM_NUM_PINS) simPins[pin].output = (int)value;
+}
+
+void analogReadResolution(int res) { (void)res; }
+
+void analogWriteResolution(int res) { (void)res; }
+
+void analogReference(eAnalogReference mode) { (void)mode; }
+
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode) {
+    (void)mode;
+    if (pin < SIM_NUM_PINS) simPins[pin].isr = callback;
+}
+
+void detachInterrupt(uint32_t pin) {
+    if (pin < SIM_NUM_PINS) simPins[pin].isr = nullptr;
+}
+
+// Single-threaded host: interrupts are only "fired" between firmware calls
+void noInterrupts(void) {}
+
+void interrupts(void) {}
+
+void SimPins::setInput(uint32_t pin, int level) {
+    if (pin < SIM_NUM_PINS) simPins[pin].input = level ? HIGH : LOW;
+}
+
+void SimPins::setAnalog(uint32_t pin, int value) {
+    if (pin < SIM_NUM_PINS) simPins[pin].analog = value;
+}
+
+int SimPins::getOutput(uint32_t pin) { return pin < SIM_NUM_PINS ? simPins[pin].output : LOW; }
+
+uint32_t SimPins::getMode(uint32_t pin) { return pin < SIM_NUM_PINS ? simPins[pin].mode : INPUT; }
+
+bool SimPins::fireInterrupt(uint32_t pin) {
+    if (pin >= SIM_NUM_PINS || simPins[pin].isr == nullptr) return false;
+    simPins[pin].isr();
+    return true;
+}
+
+long random(long howbig) { return howbig > 0 ? rand() % howbig : 0; }
+
+long random(long howsmall, long howbig) { return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall); }
+
+void randomSeed(unsigned long seed) { srand((unsigned)seed); }
+
+// Print / Stream ---------------------------------------------------------------
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+
+size_t Print::print(const char *str) { return write(str); }
+
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(unsigned char n, int base) { return printNumber(n, base, false); }
+
+size_t Print::print(int n, int base) { return print((long long)n, base); }
+
+size_t Print::print(unsigned int n, int base) { return printNumber(n, base, false); }
+
+size_t Print::print(long n, int base) { return print((long long)n, base); }
+
+size_t Print::print(unsigned long n, int base) { return printNumber(n, base, false); }
+
+size_t Print::print(long long n, int base) {
+    if (base == 10 && n < 0) return printNumber((unsigned long long)(-(n + 1)) + 1, base, true);
+    return printNumber((unsigned long long)n, base, false);
+}
+
+size_t Print::print(unsigned long long n, int base) { return printNumber(n, base, false); }
+
+size_t Print::print(double n, int digits) {
+    char buf[64];
+    int len = snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write((const uint8_t *)buf, len > 0 ? (size_t)len : 0);
+}
+
+size_t Print::println(void) { return write("\r\n"); }
+
+size_t Print::printf(const char *format, ...) {
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len >= sizeof(buf)) len = sizeof(buf) - 1;
+    return write((const uint8_t *)buf, (size_t)len);
+}
+
+size_t Print::printNumber(unsigned long long n, int base, bool negative) {
+    if (base < 2) base = 10;
+    char buf[72];
+    char *p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        int digit = (int)(n % base);
+        *--p = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        n /= base;
+    } while (n);
+    if (negative) *--p = '-';
+    return write(p);
+}
+
+size_t Stream::readBytes(uint8_t *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = read();
+        if (c < 0) break;
+        buffer[count++] = (uint8_t)c;
+    }
+    return count;
+}
+
+// UARTs ------------------------------------------------------------------------
+
+bool Uart::Ring::put(uint8_t c) {
+    if (count == data.size()) return false;
+    data[head] = c;
+    head = (head + 1) % data.size();
+    count++;
+    return true;
+}
+
+int Uart::Ring::get() {
+    if (count == 0) return -1;
+    uint8_t c = data[tail];
+    tail = (tail + 1) % data.size();
+    count--;
+    return c;
+}
+
+int Uart::Ring::peek() const { return count ? data[tail] : -1; }
+
+Uart::Uart(const char *name) : _name(name) {}
+
+void Uart::begin(unsigned long baud) { begin(baud, SERIAL_8N1); }
+
+void Uart::begin(unsigned long baud, uint16_t config) {
+    _baud = baud;
+    _config = config;
+}
+
+void Uart::end() {
+    // Both cores drop whatever is still buffered
+    _baud = 0;
+    _rx.head = _rx.tail = _rx.count = 0;
+    _tx.head = _tx.tail = _tx.count = 0;
+}
+
+int Uart::available() { return (int)_rx.count; }
+
+int Uart::peek() { return _rx.peek(); }
+
+int Uart::read() { return _rx.get(); }
+
+void Uart::flush() {
+    // On the board flush() waits for the wire; here the host drains on its own schedule
+}
+
+size_t Uart::write(uint8_t c) {
+    if (_txDiscard) return 1;
+    return _tx.put(c) ? 1 : 0;
+}
+
+bool Uart::setFIFOSize(size_t size) {
+    if (size == 0 || _rx.count) return false;
+    _rx.data.assign(size, 0);
+    _rx.head = _rx.tail = 0;
+    return true;
+}
+
+int Uart::availableForWrite() { return _txDiscard ? (int)_tx.data.size() : (int)(_tx.data.size() - _tx.count); }
+
+size_t Uart::hostInject(const uint8_t *data, size_t len) {
+    size_t accepted = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (_rx.put(data[i])) accepted++;
+        else _rxOverflow++;
+        if (_rxHook) _rxHook();
+    }
+    return accepted;
+}
+
+void Uart::hostSetTxSize(size_t size) {
+    if (size == 0 || _tx.count) return;
+    _tx.data.assign(size, 0);
+    _tx.head = _tx.tail = 0;
+}
+
+size_t Uart::hostTxAvailable() const { return _tx.count; }
+
+size_t Uart::hostTxRead(uint8_t *buffer, size_t max) {
+    size_t n = 0;
+    while (n < max && _tx.count) buffer[n++] = (uint8_t)_tx.get();
+    return n;
+}
+
+size_t Serial_::write(uint8_t c) {
+    if (_echo) fputc(c, stdout);
+    return 1;
+}
+
+size_t Serial_::write(const uint8_t *buffer, size_t size) {
+    if (_echo) fwrite(buffer, 1, size, stdout);
+    return size;
+}
+
+// Peripheral instances, as the board variant defines them
+Serial_ Serial;
+Uart Serial1("Serial1");
+Uart Serial2("Serial2");
+Uart Serial3("Serial3");
+Uart Serial4("Serial4");
+Uart Serial5("Serial5");
+SPIClass SPI;
+SPIClass SPI1;
+TwoWire Wire;
+
+// Serial1 is the inter-MCU link: run the firmware's RX hook like the variant does
+namespace {
+    struct Serial1HookInit {
+        Serial1HookInit() {
+            if (Serial1_rxHook) Serial1.setRxHook(Serial1_rxHook);
+        }
+    } serial1HookInit;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+// Host (native) stand-in for the Arduino SAMD core. Only the API the IO MCU
+// firmware and its libraries actually use is provided. Time comes from the
+// simulated clock in sim_clock.h, so simulations can run faster than real time.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+
+#include "sim_clock.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH            0x1
+#define LOW             0x0
+
+#define INPUT           0x0
+#define OUTPUT          0x1
+#define INPUT_PULLUP    0x2
+#define INPUT_PULLDOWN  0x3
+
+#define CHANGE          2
+#define FALLING         3
+#define RISING          4
+
+#define DEC             10
+#define HEX             16
+#define OCT             8
+#define BIN             2
+
+#define PI              3.1415926535897932384626433832795
+#define HALF_PI         1.5707963267948966192313216916398
+#define TWO_PI          6.283185307179586476925286766559
+#define DEG_TO_RAD      0.017453292519943295769236907684886
+#define RAD_TO_DEG      57.295779513082320876798154814105
+
+#define F(str)          (str)
+#define PROGMEM
+
+#define digitalPinToInterrupt(p)    (p)
+#define bitRead(value, bit)         (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)          ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)        ((value) &= ~(1UL << (bit)))
+#define lowByte(w)                  ((uint8_t)((w) & 0xff))
+#define highByte(w)                 ((uint8_t)((w) >> 8))
+
+// Same two-type templates as the SAMD core, so mixed-type calls resolve
+template<class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template<class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+#define constrain(amt, low, high)   ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define sq(x)                       ((x) * (x))
+
+typedef void (*voidFuncPtr)(void);
+
+// newlib has strlcpy(); glibc only from 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+static inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+// Time (simulated clock, see sim_clock.h)
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+// GPIO (pin state lives in the host pin table, see sim_pins.h)
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+int digitalRead(uint32_t pin);
+int analogRead(uint32_t pin);
+void analogWrite(uint32_t pin, uint32_t value);
+void analogReadResolution(int res);
+void analogWriteResolution(int res);
+
+typedef enum _eAnalogReference {
+    AR_DEFAULT,
+    AR_INTERNAL1V0,
+    AR_INTERNAL1V1,
+    AR_INTERNAL1V2,
+    AR_INTERNAL1V25,
+    AR_INTERNAL2V0,
+    AR_INTERNAL2V2,
+    AR_INTERNAL2V23,
+    AR_INTERNAL2V4,
+    AR_INTERNAL2V5,
+    AR_INTERNAL1V65,
+    AR_EXTERNAL
+} eAnalogReference;
+void analogReference(eAnalogReference mode);
+
+// Interrupts: handlers are only called when the simulation fires them
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode);
+void detachInterrupt(uint32_t pin);
+void noInterrupts(void);
+void interrupts(void);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+#include "HardwareSerial.h"
+#include "sim_pins.h"
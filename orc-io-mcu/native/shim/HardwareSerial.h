@@ -0,0 +1,177 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <vector>
+
+// Frame config bits, as the SAMD core encodes them
+#define HARDSER_STOP_BIT_1      0x0001
+#define HARDSER_STOP_BIT_1_5    0x0002
+#define HARDSER_STOP_BIT_2      0x0003
+#define HARDSER_STOP_BIT_MASK   0x000F
+#define HARDSER_PARITY_EVEN     0x0010
+#define HARDSER_PARITY_ODD      0x0020
+#define HARDSER_PARITY_NONE     0x0030
+#define HARDSER_PARITY_MASK     0x00F0
+#define HARDSER_DATA_5          0x0100
+#define HARDSER_DATA_6          0x0200
+#define HARDSER_DATA_7          0x0300
+#define HARDSER_DATA_8          0x0400
+#define HARDSER_DATA_MASK       0x0F00
+
+#define SERIAL_7N1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_NONE | HARDSER_DATA_7)
+#define SERIAL_8N1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_NONE | HARDSER_DATA_8)
+#define SERIAL_7N2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_NONE | HARDSER_DATA_7)
+#define SERIAL_8N2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_NONE | HARDSER_DATA_8)
+#define SERIAL_7E1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_EVEN | HARDSER_DATA_7)
+#define SERIAL_8E1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_EVEN | HARDSER_DATA_8)
+#define SERIAL_7E2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_EVEN | HARDSER_DATA_7)
+#define SERIAL_8E2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_EVEN | HARDSER_DATA_8)
+#define SERIAL_7O1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_ODD | HARDSER_DATA_7)
+#define SERIAL_8O1      (HARDSER_STOP_BIT_1 | HARDSER_PARITY_ODD | HARDSER_DATA_8)
+#define SERIAL_7O2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_ODD | HARDSER_DATA_7)
+#define SERIAL_8O2      (HARDSER_STOP_BIT_2 | HARDSER_PARITY_ODD | HARDSER_DATA_8)
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str);
+    size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = 10);
+    size_t print(int n, int base = 10);
+    size_t print(unsigned int n, int base = 10);
+    size_t print(long n, int base = 10);
+    size_t print(unsigned long n, int base = 10);
+    size_t print(long long n, int base = 10);
+    size_t print(unsigned long long n, int base = 10);
+    size_t print(double n, int digits = 2);
+
+    size_t println(void);
+    template<typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template<typename T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    size_t printNumber(unsigned long long n, int base, bool negative);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+    size_t readBytes(uint8_t *buffer, size_t length);
+    void setTimeout(unsigned long timeout) { _timeout = timeout; }
+
+protected:
+    unsigned long _timeout = 1000;
+};
+
+class HardwareSerial : public Stream {
+public:
+    virtual void begin(unsigned long baud) = 0;
+    virtual void begin(unsigned long baud, uint16_t config) = 0;
+    virtual void end() {}
+    virtual int availableForWrite() { return 0; }
+    virtual operator bool() { return true; }
+    using Print::write;
+};
+
+// Hardware UART. The firmware side sees the Arduino API; the host side moves
+// bytes in and out through the host* calls. Both rings default to the size of
+// the SAMD core's (SERIAL_BUFFER_SIZE): an RX byte arriving to a full ring is
+// dropped and counted, as on the board. setFIFOSize() resizes the RX ring the
+// way the RP2040 core does, so the same class stands in for the SYS MCU UART.
+class Uart : public HardwareSerial {
+public:
+    static const size_t BUFFER_SIZE = 350;
+
+    explicit Uart(const char *name);
+
+    void begin(unsigned long baud) override;
+    void begin(unsigned long baud, uint16_t config) override;
+    void end() override;
+    int available() override;
+    int peek() override;
+    int read() override;
+    void flush() override;
+    size_t write(uint8_t c) override;
+    int availableForWrite() override;
+    using Print::write;
+
+    // RP2040 core pin/FIFO setup (pins are ignored)
+    bool setRX(uint32_t pin) { (void)pin; return true; }
+    bool setTX(uint32_t pin) { (void)pin; return true; }
+    bool setFIFOSize(size_t size);
+
+    // Host side
+    size_t hostInject(const uint8_t *data, size_t len);    // Bytes arrive on RX (runs the RX hook per byte)
+    size_t hostTxAvailable() const;
+    size_t hostRxFree() const { return _rx.data.size() - _rx.count; }
+    size_t hostTxRead(uint8_t *buffer, size_t max);         // Bytes the firmware has transmitted
+    void hostTxDiscard(bool discard) { _txDiscard = discard; }  // No peer attached: drop TX bytes
+    void hostSetTxSize(size_t size);    // Stand in for a core whose write() blocks instead of filling up
+    void setRxHook(void (*hook)(void)) { _rxHook = hook; }
+    unsigned long getBaud() const { return _baud; }
+    uint16_t getConfig() const { return _config; }
+    uint32_t getRxOverflowCount() const { return _rxOverflow; }
+    const char *getName() const { return _name; }
+
+private:
+    struct Ring {
+        std::vector<uint8_t> data = std::vector<uint8_t>(BUFFER_SIZE);
+        size_t head = 0;
+        size_t tail = 0;
+        size_t count = 0;
+        bool put(uint8_t c);
+        int get();
+        int peek() const;
+    };
+
+    const char *_name;
+    unsigned long _baud = 0;
+    uint16_t _config = SERIAL_8N1;
+    Ring _rx;
+    Ring _tx;
+    bool _txDiscard = false;
+    uint32_t _rxOverflow = 0;
+    void (*_rxHook)(void) = nullptr;
+};
+
+// USB CDC console: output goes to the host stdout (silenced with setEcho(false))
+class Serial_ : public Stream {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    operator bool() { return true; }
+
+    void setEcho(bool echo) { _echo = echo; }
+    bool getEcho() const { return _echo; }
+
+private:
+    bool _echo = true;
+};
+
+extern Serial_ Serial;
+extern Uart Serial1;
+extern Uart Serial2;
+extern Uart Serial3;
+extern Uart Serial4;
+extern Uart Serial5;
+
+// Same hook the board variant calls from the Serial1 RX interrupt
+extern void Serial1_rxHook(void) __attribute__((weak));
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Arduino.h"
+
+#define MSBFIRST    1
+#define LSBFIRST    0
+
+#define SPI_MODE0   0x02
+#define SPI_MODE1   0x00
+#define SPI_MODE2   0x03
+#define SPI_MODE3   0x01
+
+class SPISettings {
+public:
+    SPISettings() {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock = 4000000;
+    uint8_t bitOrder = MSBFIRST;
+    uint8_t dataMode = SPI_MODE0;
+};
+
+// No devices sit on the host bus: transfers clock out and read back 0x00.
+// The onboard drivers are replaced by mocks in the native build, so this
+// only has to keep the device libraries compiling.
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings settings) { (void)settings; }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t data) { (void)data; return 0; }
+    uint16_t transfer16(uint16_t data) { (void)data; return 0; }
+    void transfer(void *buf, size_t count) { memset(buf, 0, count); }
+};
+
+extern SPIClass SPI;
+extern SPIClass SPI1;
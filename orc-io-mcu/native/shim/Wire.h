@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Arduino.h"
+
+// No devices sit on the host bus: every address NACKs (endTransmission()
+// returns 2) and reads return nothing. The onboard drivers are replaced by
+// mocks in the native build, so this only has to keep the libraries compiling.
+class TwoWire : public Stream {
+public:
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t clock) { (void)clock; }
+    void beginTransmission(uint8_t address) { (void)address; }
+    uint8_t endTransmission(bool stopBit = true) { (void)stopBit; return 2; }
+    uint8_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true) {
+        (void)address; (void)quantity; (void)stopBit;
+        return 0;
+    }
+    size_t write(uint8_t data) override { (void)data; return 1; }
+    size_t write(const uint8_t *data, size_t quantity) override { (void)data; return quantity; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+extern TwoWire Wire;
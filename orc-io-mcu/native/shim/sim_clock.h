@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+// Simulated time base behind millis()/micros()/delay() in the native build.
+//
+// In simulated mode (the default) time only moves when the host advances it:
+// delay() advances it, and the native main loop jumps straight to the next
+// scheduler deadline when nothing is due. Callbacks therefore take zero
+// simulated time, so an hour of firmware time runs in well under a minute.
+// Realtime mode follows the host monotonic clock instead.
+//
+// On a 64-bit host unsigned long is 64 bits, so micros() and millis() do not
+// wrap here. The firmware's wrap-safe (long)(a - b) comparisons only hold when
+// both sides wrap at the same width, so the clock is deliberately not
+// truncated to 32 bits.
+namespace SimClock {
+    uint64_t now();                     // Microseconds since start (64-bit, never wraps)
+    void advance(uint64_t us);
+    void advanceTo(uint64_t us);        // No-op when us is in the past
+    void setRealtime(bool realtime);
+    bool isRealtime();
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host pin table behind pinMode()/digitalWrite()/digitalRead()/analogRead().
+// Simulations drive inputs and inspect outputs through these calls.
+#define SIM_NUM_PINS    128
+
+namespace SimPins {
+    void setInput(uint32_t pin, int level);         // Level seen by digitalRead()
+    void setAnalog(uint32_t pin, int value);        // Value seen by analogRead()
+    int getOutput(uint32_t pin);                    // Last digitalWrite()/analogWrite()
+    uint32_t getMode(uint32_t pin);
+
+    // Run the handler registered with attachInterrupt(), as if the edge occurred
+    bool fireInterrupt(uint32_t pin);
+}
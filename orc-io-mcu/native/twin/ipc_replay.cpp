@@ -0,0 +1,402 @@
+#include "ipc_replay.h"
+
+#include "sys_init.h"
+#include "drivers/ipc/ipc_crc16.h"
+#include "virtual_link.h"
+#include "sys/sys_twin.h"
+
+#include <chrono>
+
+void setup();
+void loop();
+
+namespace {
+    const uint64_t REPLAY_SYS_TICK_US = 1000;       // Longest the SYS loop sleeps between link events
+    const uint64_t REPLAY_DRAIN_US = 200000;        // Time left for the target to answer the last frame
+    const size_t REPLAY_TX_SIZE = 65536;            // Replay side of the link: holds a burst of frames
+    const uint64_t REPLAY_HELLO_WAIT_US = 5000000;  // IO MCU broadcasts HELLO every 2 s until acknowledged
+
+    // Frames the replay target sends back, decoded and counted by type
+    class FrameCounter {
+    public:
+        uint32_t count[256] = {};
+        uint32_t frames = 0;
+        uint32_t errors = 0;
+
+        void feed(uint8_t byte) {
+            if (byte == IPC_START_BYTE) {
+                if (_len > 0) finish();
+                _len = 0;
+                _escape = false;
+                return;
+            }
+            if (byte == IPC_ESCAPE_BYTE) {
+                _escape = true;
+                return;
+            }
+            if (_escape) {
+                byte ^= IPC_ESCAPE_XOR;
+                _escape = false;
+            }
+            if (_len < sizeof(_buf)) _buf[_len++] = byte;
+        }
+
+    private:
+        uint8_t _buf[IPC_MAX_PAYLOAD_SIZE + 5];
+        size_t _len = 0;
+        bool _escape = false;
+
+        void finish() {
+            uint16_t length = _len >= 2 ? (uint16_t)((_buf[0] << 8) | _buf[1]) : 0;
+            uint16_t crc = _len >= 5 ? (uint16_t)((_buf[_len - 2] << 8) | _buf[_len - 1]) : 0;
+            if (_len < 5 || (size_t)length + 4 != _len || ipc_crc16_update(IPC_CRC16_INIT, _buf, _len - 2) != crc) {
+                errors++;
+                return;
+            }
+            count[_buf[2]]++;
+            frames++;
+        }
+    };
+
+    // Frame as the firmware puts it on the wire: START, stuffed LENGTH/TYPE/PAYLOAD/CRC, END
+    void writeFrame(Uart& uart, const CaptureFrame& frame) {
+        uint8_t header[3] = {
+            (uint8_t)((frame.payload.size() + 1) >> 8),
+            (uint8_t)((frame.payload.size() + 1) & 0xFF),
+            frame.messageType
+        };
+        uint16_t crc = ipc_crc16_update(IPC_CRC16_INIT, header, sizeof(header));
+        crc = ipc_crc16_update(crc, frame.payload.data(), frame.payload.size());
+        uint8_t trailer[2] = {(uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)};
+
+        auto putStuffed = [&uart](const uint8_t* data, size_t len) {
+            for (size_t i = 0; i < len; i++) {
+                if (data[i] == IPC_START_BYTE || data[i] == IPC_ESCAPE_BYTE) {
+                    uart.write((uint8_t)IPC_ESCAPE_BYTE);
+                    uart.write((uint8_t)(data[i] ^ IPC_ESCAPE_XOR));
+                } else {
+                    uart.write(data[i]);
+                }
+            }
+        };
+        uart.write((uint8_t)IPC_START_BYTE);
+        putStuffed(header, sizeof(header));
+        putStuffed(frame.payload.data(), frame.payload.size());
+        putStuffed(trailer, sizeof(trailer));
+        uart.write((uint8_t)IPC_END_BYTE);
+    }
+
+    const char* directionName(uint8_t flags) {
+        return (flags & IPC_CAPTURE_TX) ? "SYS->IO" : "IO->SYS";
+    }
+
+    void printTypeName(char* buf, size_t size, uint8_t messageType) {
+        const char* name = ipcMessageName(messageType);
+        if (name) snprintf(buf, size, "%s", name);
+        else snprintf(buf, size, "0x%02X", messageType);
+    }
+}
+
+#define IPC_MSG_NAME(m)     case IPC_MSG_##m: return #m
+
+const char* ipcMessageName(uint8_t messageType) {
+    switch (messageType) {
+        IPC_MSG_NAME(PING);
+        IPC_MSG_NAME(PONG);
+        IPC_MSG_NAME(HELLO);
+        IPC_MSG_NAME(HELLO_ACK);
+        IPC_MSG_NAME(ERROR);
+        IPC_MSG_NAME(TASK_STATS_REQ);
+        IPC_MSG_NAME(TASK_STATS);
+        IPC_MSG_NAME(BAUD_SWITCH);
+        IPC_MSG_NAME(BAUD_SWITCH_ACK);
+        IPC_MSG_NAME(LINK_TEST);
+        IPC_MSG_NAME(INDEX_SYNC_REQ);
+        IPC_MSG_NAME(INDEX_SYNC_DATA);
+        IPC_MSG_NAME(INDEX_ADD);
+        IPC_MSG_NAME(INDEX_REMOVE);
+        IPC_MSG_NAME(INDEX_UPDATE);
+        IPC_MSG_NAME(SENSOR_READ_REQ);
+        IPC_MSG_NAME(SENSOR_DATA);
+        IPC_MSG_NAME(SENSOR_STREAM);
+        IPC_MSG_NAME(SENSOR_BATCH);
+        IPC_MSG_NAME(SENSOR_BULK_READ_REQ);
+        IPC_MSG_NAME(SENSOR_DELTA_REQ);
+        IPC_MSG_NAME(SENSOR_DELTA);
+        IPC_MSG_NAME(BULK_CREDIT);
+        IPC_MSG_NAME(ADC_CAPTURE_ARM);
+        IPC_MSG_NAME(ADC_CAPTURE_REQ);
+        IPC_MSG_NAME(ADC_CAPTURE_STATUS);
+        IPC_MSG_NAME(ADC_CAPTURE_DATA);
+        IPC_MSG_NAME(CONTROL_WRITE);
+        IPC_MSG_NAME(CONTROL_ACK);
+        IPC_MSG_NAME(CONTROL_READ);
+        IPC_MSG_NAME(CONTROL_DATA);
+        IPC_MSG_NAME(DEVICE_CREATE);
+        IPC_MSG_NAME(DEVICE_DELETE);
+        IPC_MSG_NAME(DEVICE_CONFIG);
+        IPC_MSG_NAME(DEVICE_QUERY);
+        IPC_MSG_NAME(DEVICE_STATUS);
+        IPC_MSG_NAME(DEVICE_CONTROL);
+        IPC_MSG_NAME(FAULT_NOTIFY);
+        IPC_MSG_NAME(MESSAGE_NOTIFY);
+        IPC_MSG_NAME(FAULT_CLEAR);
+        IPC_MSG_NAME(CONFIG_READ);
+        IPC_MSG_NAME(CONFIG_WRITE);
+        IPC_MSG_NAME(CONFIG_DATA);
+        IPC_MSG_NAME(CONFIG_ANALOG_INPUT);
+        IPC_MSG_NAME(CONFIG_ANALOG_OUTPUT);
+        IPC_MSG_NAME(CONFIG_RTD);
+        IPC_MSG_NAME(CONFIG_GPIO);
+        IPC_MSG_NAME(CONFIG_DIGITAL_OUTPUT);
+        IPC_MSG_NAME(CONFIG_STEPPER);
+        IPC_MSG_NAME(CONFIG_DCMOTOR);
+        IPC_MSG_NAME(CONFIG_COMPORT);
+        IPC_MSG_NAME(CONFIG_TEMP_CONTROLLER);
+        IPC_MSG_NAME(CONFIG_PH_CONTROLLER);
+        IPC_MSG_NAME(CONFIG_FLOW_CONTROLLER);
+        IPC_MSG_NAME(CONFIG_DO_CONTROLLER);
+        IPC_MSG_NAME(CONFIG_PRESSURE_CTRL);
+        IPC_MSG_NAME(CONFIG_BEGIN);
+        IPC_MSG_NAME(CONFIG_BATCH);
+        IPC_MSG_NAME(CONFIG_COMMIT);
+        IPC_MSG_NAME(CONFIG_RESULT);
+        default: return nullptr;
+    }
+}
+
+bool loadCapture(const char* path, Capture& capture) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return false;
+    }
+    IPC_CaptureFileHeader_t& h = capture.header;
+    memset(&h, 0, sizeof(h));
+    // Older/newer headers differ only in length: read the common part, skip the rest
+    bool ok = fread(&h, 1, 8, f) == 8 && h.magic == IPC_CAPTURE_MAGIC && h.headerSize >= 8;
+    if (ok) {
+        size_t common = min((size_t)h.headerSize, sizeof(h)) - 8;
+        ok = fread((uint8_t*)&h + 8, 1, common, f) == common && fseek(f, h.headerSize, SEEK_SET) == 0;
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: not an IPC capture file\n", path);
+        fclose(f);
+        return false;
+    }
+
+    capture.frames.clear();
+    capture.frames.reserve(h.recordCount);
+    uint64_t time = 0;
+    uint32_t lastRaw = h.startMicros;
+    for (uint32_t i = 0; i < h.recordCount; i++) {
+        IPC_CaptureRecord_t rec;
+        if (fread(&rec, sizeof(rec), 1, f) != 1) break;
+        CaptureFrame frame;
+        time += (uint32_t)(rec.timeUs - lastRaw);   // micros() wraps every ~71 minutes
+        lastRaw = rec.timeUs;
+        frame.timeUs = time;
+        frame.flags = rec.flags;
+        frame.messageType = rec.messageType;
+        frame.payload.resize(rec.length);
+        if (rec.length && fread(frame.payload.data(), 1, rec.length, f) != rec.length) break;
+        capture.frames.push_back(std::move(frame));
+    }
+    fclose(f);
+    if (capture.frames.size() != h.recordCount) {
+        fprintf(stderr, "%s: truncated, %zu of %lu records\n", path, capture.frames.size(), (unsigned long)h.recordCount);
+    }
+    return true;
+}
+
+void printCaptureTimeline(const Capture& capture, bool showPayload) {
+    const IPC_CaptureFileHeader_t& h = capture.header;
+    printf("IPC capture v%u: protocol v%08lX, %lu baud, %zu records (%lu overwritten, %lu missed)\n",
+           h.version, (unsigned long)h.protocolVersion, (unsigned long)h.baudRate, capture.frames.size(),
+           (unsigned long)h.overwritten, (unsigned long)h.missed);
+    printf("%14s %12s  %-8s %-26s %6s\n", "Time (s)", "Delta (us)", "Dir", "Message", "Bytes");
+
+    uint32_t count[2][256] = {};
+    uint64_t bytes[2][256] = {};
+    uint32_t rejected = 0;
+    uint64_t last = capture.frames.empty() ? 0 : capture.frames.front().timeUs;
+    for (const CaptureFrame& frame : capture.frames) {
+        char name[40];
+        printTypeName(name, sizeof(name), frame.messageType);
+        if (frame.flags & IPC_CAPTURE_ERROR) {
+            char rejectedName[48];
+            snprintf(rejectedName, sizeof(rejectedName), "REJECTED (%s?)", name);
+            strcpy(name, rejectedName);
+            rejected++;
+        } else {
+            int dir = (frame.flags & IPC_CAPTURE_TX) ? 1 : 0;
+            count[dir][frame.messageType]++;
+            bytes[dir][frame.messageType] += frame.payload.size();
+        }
+        printf("%14.6f %12llu  %-8s %-26s %6zu", frame.timeUs / 1e6, (unsigned long long)(frame.timeUs - last),
+               directionName(frame.flags), name, frame.payload.size());
+        if (showPayload) {
+            printf("  ");
+            for (size_t i = 0; i < frame.payload.size() && i < 24; i++) printf("%02X ", frame.payload[i]);
+            if (frame.payload.size() > 24) printf("...");
+        }
+        printf("\n");
+        last = frame.timeUs;
+    }
+
+    double span = capture.frames.size() > 1 ? (capture.frames.back().timeUs - capture.frames.front().timeUs) / 1e6 : 0;
+    printf("\n%.3f s, %zu frames, %lu rejected\n", span, capture.frames.size(), (unsigned long)rejected);
+    printf("%-8s %-26s %8s %10s %10s\n", "Dir", "Message", "Frames", "Bytes", "Frames/s");
+    for (int dir = 0; dir < 2; dir++) {
+        for (int t = 0; t < 256; t++) {
+            if (!count[dir][t]) continue;
+            char name[40];
+            printTypeName(name, sizeof(name), (uint8_t)t);
+            printf("%-8s %-26s %8lu %10llu %10.1f\n", directionName(dir ? IPC_CAPTURE_TX : 0), name,
+                   (unsigned long)count[dir][t], (unsigned long long)bytes[dir][t], span > 0 ? count[dir][t] / span : 0);
+        }
+    }
+}
+
+int runReplay(const Capture& capture, const ReplayOptions& opt) {
+    const bool intoIo = opt.target == REPLAY_INTO_IO;
+    const uint8_t replayDir = intoIo ? IPC_CAPTURE_TX : 0;
+    Uart& target = intoIo ? Serial1 : SysSerial1;
+
+    // The frames the target would have received, and what it sent back at the
+    // time. The replay wire runs at one rate, so link rate changes are left out.
+    std::vector<const CaptureFrame*> frames;
+    uint32_t capturedReplies[256] = {};
+    for (const CaptureFrame& frame : capture.frames) {
+        if (frame.flags & IPC_CAPTURE_ERROR) continue;
+        if (frame.messageType == IPC_MSG_BAUD_SWITCH || frame.messageType == IPC_MSG_BAUD_SWITCH_ACK ||
+            frame.messageType == IPC_MSG_LINK_TEST) continue;
+        if ((frame.flags & IPC_CAPTURE_TX) == replayDir) frames.push_back(&frame);
+        else capturedReplies[frame.messageType]++;
+    }
+    if (frames.empty()) {
+        fprintf(stderr, "Nothing to replay into the %s MCU\n", intoIo ? "IO" : "SYS");
+        return 1;
+    }
+
+    SimClock::setRealtime(opt.realtime);
+    Serial.setEcho(opt.verbose);
+    if (intoIo) setup();
+    else SysTwin::begin(nullptr, opt.verbose);
+
+    Uart peer("Replay");
+    peer.hostSetTxSize(REPLAY_TX_SIZE);
+    peer.setFIFOSize(REPLAY_TX_SIZE);
+    VirtualWire in(peer, target, intoIo ? "->IO" : "->SYS");
+    VirtualWire out(target, peer, intoIo ? "IO->" : "SYS->");
+    uint32_t baud = opt.baud ? opt.baud : (capture.header.baudRate ? capture.header.baudRate : 2000000);
+    in.setBaud(baud);
+    out.setBaud(baud);
+    FrameCounter replies;
+
+    // The IO MCU ignores a HELLO_ACK it has not asked for, so the captured
+    // traffic starts when the firmware's first HELLO is seen. A capture taken
+    // mid-session has no HELLO_ACK of its own: one is made up to connect.
+    bool started = !intoIo;
+    uint64_t startUs = SimClock::now();
+    const uint64_t helloDeadline = startUs + REPLAY_HELLO_WAIT_US;
+    const uint64_t firstUs = frames.front()->timeUs;
+    auto dueAt = [&](size_t i) -> uint64_t {
+        return startUs + (uint64_t)((frames[i]->timeUs - firstUs) / opt.speed);
+    };
+    auto wallStart = std::chrono::steady_clock::now();
+    size_t next = 0;
+    uint64_t doneAt = UINT64_MAX;
+
+    while (true) {
+        uint64_t now = SimClock::now();
+        if (!started) {
+            if (replies.count[IPC_MSG_HELLO] > 0) {
+                if (frames.front()->messageType != IPC_MSG_HELLO_ACK) {
+                    CaptureFrame ack;
+                    IPC_HelloAck_t payload = {};
+                    payload.protocolVersion = IPC_PROTOCOL_VERSION;
+                    ack.messageType = IPC_MSG_HELLO_ACK;
+                    ack.payload.assign((const uint8_t*)&payload, (const uint8_t*)&payload + sizeof(payload));
+                    writeFrame(peer, ack);
+                }
+                started = true;
+                startUs = now;
+            } else if (now >= helloDeadline) {
+                fprintf(stderr, "IO MCU sent no HELLO, nothing replayed\n");
+                return 1;
+            }
+        }
+        while (started && next < frames.size() && (opt.speed > 0 ? dueAt(next) <= now : peer.hostTxAvailable() == 0)) {
+            writeFrame(peer, *frames[next++]);
+        }
+        in.service(now);
+        out.service(now);
+        if (intoIo) loop();
+        else SysTwin::update();
+        in.service(now);
+        out.service(now);
+        while (peer.available()) replies.feed((uint8_t)peer.read());
+
+        if (next == frames.size() && doneAt == UINT64_MAX && peer.hostTxAvailable() == 0 &&
+            in.nextEventUs(now) == UINT64_MAX) {
+            doneAt = now + REPLAY_DRAIN_US;
+        }
+        if (now >= doneAt) break;
+        if (opt.realtime) continue;
+
+        uint64_t wake = min(doneAt, now + REPLAY_SYS_TICK_US);
+        if (intoIo) {
+            unsigned long ioDue;
+            if (!tasks.getNextDeadline(&ioDue)) continue;      // Posted event: collect it first
+            if ((long)(ioDue - micros()) <= 0) continue;
+            wake = min(doneAt, (uint64_t)ioDue);
+        }
+        if (started && opt.speed > 0 && next < frames.size()) wake = min(wake, dueAt(next));
+        wake = min(wake, in.nextEventUs(now));
+        wake = min(wake, out.nextEventUs(now));
+        SimClock::advanceTo(max(wake, now + 1));
+    }
+    replies.feed(IPC_END_BYTE);     // Close a frame cut off by the end of the run
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double simSeconds = (SimClock::now() - startUs) / 1e6;
+    double capturedSeconds = (frames.back()->timeUs - firstUs) / 1e6;
+    uint64_t payloadBytes = 0;
+    for (const CaptureFrame* frame : frames) payloadBytes += frame->payload.size();
+
+    Serial.setEcho(true);
+    char speed[24];
+    if (opt.speed > 0) snprintf(speed, sizeof(speed), "%gx", opt.speed);
+    else snprintf(speed, sizeof(speed), "back to back");
+    Serial.printf("\n=== Replay into the %s MCU: %zu frames, %llu payload bytes, speed %s, %lu baud ===\n",
+                  intoIo ? "IO" : "SYS", frames.size(), (unsigned long long)payloadBytes, speed, (unsigned long)baud);
+    Serial.printf("Captured span %.3f s, replayed in %.3f s simulated, %.3f s host (%.1f us host per frame)\n",
+                  capturedSeconds, simSeconds, wallSeconds, wallSeconds * 1e6 / frames.size());
+    if (intoIo) {
+        Serial.printf("IO IPC: rx %lu, tx %lu, rx errors %lu, CRC errors %lu, RX overflows %lu\n",
+                      (unsigned long)ipcDriver.rxPacketCount, (unsigned long)ipcDriver.txPacketCount,
+                      (unsigned long)ipcDriver.rxErrorCount, (unsigned long)ipcDriver.crcErrorCount,
+                      (unsigned long)in.rxOverflows());
+    } else {
+        SysTwin::LinkStats sys;
+        SysTwin::getLinkStats(&sys);
+        Serial.printf("SYS IPC: rx %lu, tx %lu, rx errors %lu, CRC errors %lu, RX overflows %lu\n",
+                      (unsigned long)sys.rxPackets, (unsigned long)sys.txPackets, (unsigned long)sys.rxErrors,
+                      (unsigned long)sys.crcErrors, (unsigned long)in.rxOverflows());
+    }
+
+    // Same traffic in, same frames out? Differences in replies point at a
+    // behaviour change; traffic the target originates from its own inputs
+    // (SENSOR_DATA from live sensors, CONTROL_WRITE from SYS users) will differ.
+    Serial.printf("\n%-26s %10s %10s\n", "From target", "Captured", "Replayed");
+    for (int t = 0; t < 256; t++) {
+        if (!capturedReplies[t] && !replies.count[t]) continue;
+        char name[40];
+        printTypeName(name, sizeof(name), (uint8_t)t);
+        Serial.printf("%-26s %10lu %10lu%s\n", name, (unsigned long)capturedReplies[t], (unsigned long)replies.count[t],
+                      capturedReplies[t] != replies.count[t] ? "  *" : "");
+    }
+    if (replies.errors) Serial.printf("Undecodable replies: %lu\n", (unsigned long)replies.errors);
+    return 0;
+}
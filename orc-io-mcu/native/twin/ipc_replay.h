@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "../../../orc-sys-mcu/src/utils/ipcCaptureFormat.h"
+
+// Host side of the SYS MCU IPC capture (.icap, see ipcCaptureFormat.h):
+// decode a capture into a timeline, or replay one direction of it into the
+// IO MCU firmware or the SYS MCU IPC stack on the simulated clock.
+
+struct CaptureFrame {
+    uint64_t timeUs;            // Since capture start, unwrapped
+    uint8_t flags;              // IPC_CAPTURE_*
+    uint8_t messageType;
+    std::vector<uint8_t> payload;
+};
+
+struct Capture {
+    IPC_CaptureFileHeader_t header;
+    std::vector<CaptureFrame> frames;
+};
+
+enum ReplayTarget : uint8_t {
+    REPLAY_INTO_IO,             // Captured SYS -> IO frames drive the IO MCU firmware
+    REPLAY_INTO_SYS             // Captured IO -> SYS frames drive the SYS MCU IPC stack
+};
+
+struct ReplayOptions {
+    ReplayTarget target = REPLAY_INTO_IO;
+    double speed = 1.0;         // 1 = captured timing, N = N times faster, 0 = back to back
+    uint32_t baud = 0;          // 0 = the capture's baud rate
+    bool realtime = false;
+    bool verbose = false;
+};
+
+const char* ipcMessageName(uint8_t messageType);     // nullptr if unknown
+
+bool loadCapture(const char* path, Capture& capture);
+void printCaptureTimeline(const Capture& capture, bool showPayload);
+int runReplay(const Capture& capture, const ReplayOptions& opt);
@@ -0,0 +1,3 @@
+#pragma once
+
+class Adafruit_NeoPixel {};
@@ -0,0 +1,46 @@
+#pragma once
+
+// SYS MCU (RP2040 core) view of the native shim: the IO MCU shim plus the few
+// core types the SYS headers use. Only SYS MCU sources of the twin see this
+// directory (see native/twin/twin_build.py).
+#include_next <Arduino.h>
+
+#include <string>
+
+// Minimal Arduino String, enough for the declarations in the SYS headers
+class String {
+public:
+    String() {}
+    String(const char *s) : _s(s ? s : "") {}
+    String(const std::string &s) : _s(s) {}
+    String(int n) : _s(std::to_string(n)) {}
+    String(unsigned int n) : _s(std::to_string(n)) {}
+    String(long n) : _s(std::to_string(n)) {}
+    String(unsigned long n) : _s(std::to_string(n)) {}
+
+    const char *c_str() const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+    String &operator+=(const String &rhs) { _s += rhs._s; return *this; }
+    String operator+(const String &rhs) const { return String(_s + rhs._s); }
+    bool operator==(const String &rhs) const { return _s == rhs._s; }
+    bool operator!=(const String &rhs) const { return _s != rhs._s; }
+
+private:
+    std::string _s;
+};
+
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _b{a, b, c, d} {}
+    uint8_t operator[](int i) const { return _b[i]; }
+    uint8_t &operator[](int i) { return _b[i]; }
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _b[0], _b[1], _b[2], _b[3]);
+        return String(buf);
+    }
+
+private:
+    uint8_t _b[4] = {0, 0, 0, 0};
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// JSON persistence (ioConfig load/save) is compiled out of host builds
@@ -0,0 +1,3 @@
+#pragma once
+
+// No flash filesystem on the host: ioConfig runs on its defaults
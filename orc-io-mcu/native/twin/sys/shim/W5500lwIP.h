@@ -0,0 +1,4 @@
+#pragma once
+
+// Network stack is not part of the twin: type only, for the SYS headers
+class Wiznet5500lwIP {};
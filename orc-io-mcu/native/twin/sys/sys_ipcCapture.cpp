@@ -0,0 +1,2 @@
+// SYS MCU source, built unchanged into the twin
+#include "../../../../orc-sys-mcu/src/utils/ipcCapture.cpp"
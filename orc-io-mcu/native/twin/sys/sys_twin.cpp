@@ -0,0 +1,154 @@
+// SYS MCU glue for the IPC twin: the globals sys_init.cpp and the managers
+// outside the IPC stack would provide on the RP2040
+#include "../../../../orc-sys-mcu/src/sys_init.h"
+#include "sys_twin.h"
+
+Uart SysSerial1("SYS Serial1");
+IPCProtocol ipc(&Serial1);          // Serial1 is SysSerial1 in SYS sources (twin_build.py)
+
+StatusVariables status;             // sysStatus in the twin (twin_build.py)
+bool statusLocked = false;
+bool ioConfigChanged = false;
+
+extern bool ipcReady;
+
+static bool sysVerbose = false;
+static SysTwin::TxnObserver sysObserver = nullptr;
+
+static_assert(IPC_TXN_COMPLETE == (int)SysTwin::TXN_COMPLETE && IPC_TXN_CANCELLED == (int)SysTwin::TXN_CANCELLED,
+              "SysTwin::TxnResult out of step with IPC_TxnResult");
+
+void log(uint8_t logLevel, bool logToSD, const char* format, ...) {
+    (void)logToSD;
+    if (!sysVerbose && (logLevel == LOG_DEBUG || logLevel == LOG_INFO)) return;
+    char buf[DEBUG_PRINTF_BUFFER_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    Serial.printf("[SYS %lu.%03lu] %s", millis() / 1000, millis() % 1000, buf);
+}
+
+static void sysTxnObserver(uint8_t reqType, IPC_TxnResult result, uint32_t latencyUs) {
+    if (sysObserver) sysObserver(reqType, (SysTwin::TxnResult)result, latencyUs);
+}
+
+void SysTwin::begin(TxnObserver observer, bool verbose) {
+    sysVerbose = verbose;
+    sysObserver = observer;
+    // The RP2040 core blocks in write() until the FIFO drains; the host UART
+    // takes the whole frame and the link paces it out at the line rate
+    SysSerial1.hostSetTxSize(IPC_TX_RING_SIZE);
+    loadIOConfig();
+    setIpcTransactionObserver(sysTxnObserver);
+    init_ipcManager();
+}
+
+void SysTwin::update() {
+    manageIPC();
+}
+
+bool SysTwin::ready() {
+    return ipcReady;
+}
+
+bool SysTwin::sendControlWrite(uint32_t seq) {
+    if (seq & 1) {
+        return sendAnalogOutputCommand(8, AOUT_CMD_SET_VALUE, (float)(seq % 10240));
+    }
+    return sendDigitalOutputCommand(21, DOUT_CMD_SET_STATE, (seq & 2) != 0, 0.0f);
+}
+
+bool SysTwin::requestBulkPoll() {
+    return objectCache.requestBulkUpdate(0, MAX_CACHED_OBJECTS);
+}
+
+void SysTwin::getLinkStats(LinkStats *stats) {
+    IPC_Statistics_t s;
+    ipc.getStatistics(&s);
+    stats->rxPackets = s.rxPacketCount;
+    stats->txPackets = s.txPacketCount;
+    stats->rxErrors = s.rxErrorCount;
+    stats->crcErrors = s.crcErrorCount;
+    stats->txQueueFull = s.txQueueFullCount;
+    IPC_LinkStats_t link;
+    ipc.getLinkStats(&link);
+    stats->rttP50Us = link.rttP50Us;
+    stats->rttP90Us = link.rttP90Us;
+    stats->rttMaxUs = link.rttMaxUs;
+    stats->rttSamples = link.rttSamples;
+    stats->rxUtilPeakPermille = link.rxUtilPeakPermille;
+    stats->txUtilPeakPermille = link.txUtilPeakPermille;
+    IpcBaudInfo_t baud;
+    getIpcBaudInfo(&baud);
+    stats->baudRate = baud.baudRate;
+    stats->baudSwitches = baud.switches;
+    stats->baudFailures = baud.failures;
+    stats->baudFallbacks = baud.fallbacks;
+}
+
+uint8_t SysTwin::cachedObjectCount() {
+    return objectCache.getValidCount();
+}
+
+uint32_t SysTwin::configDigest(uint32_t *sections, uint8_t sectionCount) {
+    const IPC_ConfigDigest_t *digest = ipcConfigDigest();
+    for (uint8_t i = 0; i < sectionCount && i < IPC_CONFIG_SECTION_COUNT; i++) sections[i] = digest->section[i];
+    return digest->overall;
+}
+
+void SysTwin::setAdcCalibration(uint8_t index, float scale) {
+    ioConfig.adcInputs[index].cal.scale = scale;
+}
+
+static bool fileCaptureWriter(void *context, const uint8_t *data, size_t length) {
+    return fwrite(data, 1, length, (FILE *)context) == length;
+}
+
+bool SysTwin::captureStart(uint32_t bufferSize) {
+    return ipcCaptureStart(bufferSize);
+}
+
+bool SysTwin::captureSave(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = ipcCaptureExport(fileCaptureWriter, f);
+    return fclose(f) == 0 && ok;
+}
+
+bool SysTwin::adcCaptureArm(uint8_t channelMask, uint16_t rateHz, uint16_t preScans, uint16_t lengthScans,
+                            uint8_t trigger, uint8_t triggerChannel, float level) {
+    AdcCaptureRequest_t req = {};
+    req.channelMask = channelMask;
+    req.sampleRateHz = rateHz;
+    req.preTriggerScans = preScans;
+    req.lengthScans = lengthScans;
+    req.trigger = trigger;
+    req.triggerChannel = triggerChannel;
+    req.triggerLevel = level;
+    return ::adcCaptureArm(&req);
+}
+
+bool SysTwin::adcCaptureReady() {
+    AdcCaptureInfo_t info;
+    adcCaptureGetInfo(&info);
+    return info.phase == ADC_CAP_READY || info.phase == ADC_CAP_FAILED;
+}
+
+void SysTwin::adcCaptureResult(AdcCaptureResult *result) {
+    AdcCaptureInfo_t info;
+    adcCaptureGetInfo(&info);
+    result->phase = info.phase;
+    result->flags = info.status.flags;
+    result->lengthScans = info.status.lengthScans;
+    result->scanPeriodNs = info.status.scanPeriodNs;
+    result->missedSamples = info.status.missedSamples;
+    result->samplesRead = info.samplesRead;
+}
+
+bool SysTwin::adcCaptureSave(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) return false;
+    bool ok = adcCaptureExportCsv(fileCaptureWriter, f);
+    return fclose(f) == 0 && ok;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+
+// SYS MCU half of the IPC twin. Implemented in sys_twin.cpp against the SYS
+// headers; this interface only uses plain types so the IO MCU side (twin_main)
+// can include it next to its own IPC headers.
+
+class Uart;
+extern Uart SysSerial1;     // SYS end of the inter-MCU UART
+
+namespace SysTwin {
+    // Mirrors IPC_TxnResult (ipcManager.h)
+    enum TxnResult : uint8_t { TXN_COMPLETE, TXN_FAILED, TXN_REFUSED, TXN_TIMEOUT, TXN_CANCELLED };
+    typedef void (*TxnObserver)(uint8_t reqType, TxnResult result, uint32_t latencyUs);
+
+    struct LinkStats {
+        uint32_t rxPackets;
+        uint32_t txPackets;
+        uint32_t rxErrors;
+        uint32_t crcErrors;
+        uint32_t txQueueFull;
+        uint32_t rttP50Us;      // SYS PING round trips (IPC_LinkStats_t)
+        uint32_t rttP90Us;
+        uint32_t rttMaxUs;
+        uint16_t rttSamples;
+        uint16_t rxUtilPeakPermille;
+        uint16_t txUtilPeakPermille;
+        uint32_t baudRate;      // Negotiated link rate (v2.14)
+        uint16_t baudSwitches;
+        uint16_t baudFailures;
+        uint16_t baudFallbacks;
+    };
+
+    void begin(TxnObserver observer, bool verbose);    // Default ioConfig, init_ipcManager()
+    void update();                                      // manageIPC()
+    bool ready();                                       // Handshake and config push complete
+    bool sendControlWrite(uint32_t seq);                // Alternates digital and analogue output writes
+    bool requestBulkPoll();                             // SENSOR_BULK_READ_REQ of 0-99, false while the window is full
+    void getLinkStats(LinkStats *stats);
+    uint8_t cachedObjectCount();
+
+    // Configuration digest of the last push (IPC_ConfigDigest_t); returns the
+    // overall hash, fills sectionCount per-section hashes
+    uint32_t configDigest(uint32_t *sections, uint8_t sectionCount);
+    void setAdcCalibration(uint8_t index, float scale);     // ioConfig only, pushed on the next handshake
+
+    // IPC capture (ipcCapture.cpp), saved as an .icap file on the host
+    bool captureStart(uint32_t bufferSize);
+    bool captureSave(const char *path);
+
+    // ADC burst capture (adcCapture.cpp), exported as CSV on the host
+    struct AdcCaptureResult {
+        uint8_t phase;          // AdcCapturePhase
+        uint8_t flags;          // IPC_ADC_CAPTURE_FLAG_*
+        uint16_t lengthScans;
+        uint32_t scanPeriodNs;
+        uint32_t missedSamples;
+        uint32_t samplesRead;
+    };
+    bool adcCaptureArm(uint8_t channelMask, uint16_t rateHz, uint16_t preScans, uint16_t lengthScans,
+                       uint8_t trigger, uint8_t triggerChannel, float level);
+    bool adcCaptureReady();
+    void adcCaptureResult(AdcCaptureResult *result);
+    bool adcCaptureSave(const char *path);
+}
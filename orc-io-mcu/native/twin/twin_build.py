@@ -0,0 +1,32 @@
+# PlatformIO pre-script for [env:twin]: the SYS MCU sources under
+# native/twin/sys/ compile against the SYS headers, with Serial1 renamed to
+# the SYS end of the virtual link (SysSerial1) and the SYS status global to
+# sysStatus (the IO MCU's TMC5130 library has its own global 'status').
+# Everything else in the twin builds exactly as [env:native].
+Import("env")
+
+import os
+
+project_dir = env.subst("$PROJECT_DIR")
+twin_sys_dir = os.path.join(project_dir, "native", "twin", "sys")
+sys_mcu_dir = os.path.normpath(os.path.join(project_dir, "..", "orc-sys-mcu"))
+
+SYS_CPPPATH = [
+    os.path.join(twin_sys_dir, "shim"),
+    os.path.join(sys_mcu_dir, "src"),
+    os.path.join(sys_mcu_dir, "lib", "IPCprotocol"),
+    os.path.join(sys_mcu_dir, "lib", "MCP79410"),
+]
+
+
+def sys_mcu_source(env, node):
+    if not os.path.normpath(node.srcnode().get_abspath()).startswith(twin_sys_dir + os.sep):
+        return node
+    return env.Object(
+        node,
+        CPPPATH=SYS_CPPPATH + env.get("CPPPATH", []),
+        CPPDEFINES=env.get("CPPDEFINES", []) + [("Serial1", "SysSerial1"), ("status", "sysStatus")],
+    )
+
+
+env.AddBuildMiddleware(sys_mcu_source)
@@ -0,0 +1,573 @@
+// IPC digital twin: the IO MCU firmware (native build) and the SYS MCU IPC
+// stack (IPCProtocol, ipcManager, ObjectCache, ioConfig push) in one process,
+// on one simulated clock, joined by a byte-timed virtual UART.
+//
+//   orc-ipc-twin [--seconds N] [--baud-limit N] [--byte-error-rate P] [--drop-rate P]
+//                [--seed N] [--writes-per-s N] [--report-s N] [--realtime] [--verbose] [--poll-cost]
+//                [--bulk-poll] [--ack-limit-us N] [--corrupt-config-batch] [--reconnect]
+//                [--capture FILE [--capture-kb N]] [--adc-capture FILE [--adc-rate N]]
+//   orc-ipc-twin --timeline FILE [--payload]
+//   orc-ipc-twin --replay FILE [--into io|sys] [--speed X] [--baud N] [--realtime] [--verbose]
+//
+// The run goes through the HELLO handshake, the configuration push, the link
+// rate negotiation, sensor polling/streaming and periodic control writes, then
+// prints link throughput, protocol counters and per-request transaction
+// latency percentiles. --baud-limit makes the wire unreliable above a rate so
+// the negotiation has something to fall back from.
+// --capture records the run with the SYS MCU's IPC capture; --timeline and
+// --replay work on those files and on captures saved to SD by the SYS MCU.
+// --adc-capture puts a 50 Hz sine on ADC channel 0, arms a rising-edge burst
+// capture of channels 0-1 once the link is up and writes the block as CSV.
+// --poll-cost adds the bytes a 1 s poll would take as SENSOR_DATA and as
+// SENSOR_DELTA frames to the report.
+// --bulk-poll keeps the IO MCU's bulk lane busy with back-to-back full bulk
+// reads of objects 0-99 while the control writes run, and fails the run (exit
+// 1) if the control write ACK p99 goes over --ack-limit-us (default 10 ms).
+// --corrupt-config-batch damages the first CONFIG_BATCH frame of the boot
+// configuration push; the run fails unless the IO MCU rejects that batch and
+// applies the one the SYS MCU sends again.
+// --reconnect cuts the link twice for longer than the link timeout and checks
+// that the configuration digests converge with only the changed section
+// pushed, and nothing pushed when nothing changed.
+#include "sys_init.h"
+#include "mock_hw.h"
+#include "virtual_link.h"
+#include "sys/sys_twin.h"
+#include "ipc_replay.h"
+#include "drivers/ipc/ipc_crc16.h"
+
+#include <algorithm>
+#include <vector>
+
+void setup();
+void loop();
+
+namespace {
+    struct TwinOptions {
+        uint64_t seconds = 60;
+        uint32_t baudLimit = 0;          // 0 = every rate is clean
+        double byteErrorRate = 0;
+        double dropRate = 0;
+        uint32_t seed = 1;
+        uint32_t writesPerSecond = 10;
+        uint64_t reportSeconds = 0;
+        bool realtime = false;
+        bool verbose = false;
+        bool pollCost = false;
+        bool bulkPoll = false;
+        uint32_t ackLimitUs = 0;         // 0 = TWIN_ACK_LIMIT_US with --bulk-poll, else report only
+        bool corruptConfigBatch = false;
+        bool reconnect = false;
+        const char* capturePath = nullptr;
+        uint32_t captureKb = 48;         // SYS MCU default ring (IPC_CAPTURE_DEFAULT_SIZE)
+        const char* adcCapturePath = nullptr;
+        uint32_t adcCaptureRate = 2000;  // Scans per second
+        const char* timelinePath = nullptr;
+        bool timelinePayload = false;
+        const char* replayPath = nullptr;
+        ReplayOptions replay;
+    };
+
+    const uint64_t TWIN_ADC_PERIOD_US = 12500;     // MCP346x scan, as native_main
+    const uint64_t TWIN_SYS_TICK_US = 1000;        // Longest the SYS loop sleeps between link events
+    const double TWIN_SINE_HZ = 50.0;              // --adc-capture test signal on channel 0
+    const int32_t TWIN_SINE_AMPLITUDE = 20000;     // Codes, inside the MCP346x 16-bit range
+    const uint16_t TWIN_CAPTURE_SCANS = 1000;
+    const uint16_t TWIN_CAPTURE_PRE_SCANS = 200;
+    const uint64_t TWIN_POLL_PERIOD_US = 1000000;  // SYS MCU SENSOR_POLL_INTERVAL
+    // --bulk-poll control ACK p99 limit: two IO MCU IPC ticks. A write queued
+    // behind a whole bulk response of 0-99 would take hundreds of ms.
+    const uint32_t TWIN_ACK_LIMIT_US = 10000;
+    const uint64_t TWIN_CUT_AFTER_US = 3000000;    // --reconnect: connected time before each cut
+    const uint64_t TWIN_CUT_US = 8000000;          // Longer than the 5 s link timeout of both MCUs
+    const float TWIN_CUT_ADC_SCALE = 1.25f;        // ADC input 0 calibration set during the first cut
+
+    // Transaction latencies by request type
+    struct TxnClass {
+        std::vector<uint32_t> latencyUs;
+        uint32_t timeouts = 0;
+        uint32_t failed = 0;
+        uint32_t cancelled = 0;
+    };
+    TxnClass txnClass[256];
+    uint64_t handshakeAtUs = 0;
+    uint32_t bulkPolls = 0;
+
+    void onTransaction(uint8_t reqType, SysTwin::TxnResult result, uint32_t latencyUs) {
+        TxnClass& c = txnClass[reqType];
+        switch (result) {
+            case SysTwin::TXN_COMPLETE:  c.latencyUs.push_back(latencyUs); break;
+            case SysTwin::TXN_TIMEOUT:   c.timeouts++; break;
+            case SysTwin::TXN_CANCELLED: c.cancelled++; break;
+            default:                     c.failed++; break;
+        }
+    }
+
+    uint32_t percentile(const std::vector<uint32_t>& sorted, uint32_t percent) {
+        if (sorted.empty()) return 0;
+        size_t rank = (sorted.size() * percent + 99) / 100;
+        return sorted[rank ? rank - 1 : 0];
+    }
+
+    // Bytes one frame takes on the wire: START, stuffed LEN/TYPE/PAYLOAD/CRC, END
+    uint32_t wireBytes(uint8_t msgType, const uint8_t* payload, uint16_t len) {
+        uint8_t header[3] = {(uint8_t)((len + 1) >> 8), (uint8_t)((len + 1) & 0xFF), msgType};
+        uint32_t bytes = 2;
+        uint16_t crc = IPC_CRC16_INIT;
+        auto put = [&](uint8_t b) { bytes += (b == IPC_START_BYTE || b == IPC_ESCAPE_BYTE) ? 2 : 1; };
+        for (uint8_t b : header) { crc = ipc_crc16_byte(crc, b); put(b); }
+        for (uint16_t i = 0; i < len; i++) { crc = ipc_crc16_byte(crc, payload[i]); put(payload[i]); }
+        put(crc >> 8);
+        put(crc & 0xFF);
+        return bytes;
+    }
+
+    // What a once a second poll of 0-99 costs as SENSOR_DATA frames (bulk read)
+    // and as SENSOR_DELTA frames (delta read), whichever way the SYS MCU is
+    // actually being fed. The delta side runs the IO encoder against its own
+    // shadow, swapped in around the measurement, so the live stream is untouched.
+    // Building a record consumes controller messages, as a real poll would, so
+    // this only runs with --poll-cost.
+    struct PollCost {
+        IPC_DeltaShadow_t shadow[MAX_NUM_OBJECTS] = {};
+        uint32_t cycles = 0;
+        uint32_t firstDelta = 0;        // Every object in full, as after a resync
+        uint64_t fullBytes = 0;
+        uint64_t deltaBytes = 0;        // Steady state, first cycle excluded
+        uint32_t deltaMax = 0;
+        uint64_t deltaRecords = 0;
+    } pollCost;
+
+    void pollCycle() {
+        uint64_t full = 0;
+        IPC_SensorData_t data;
+        for (uint16_t i = 0; i < MAX_NUM_OBJECTS; i++) {
+            if (ipc_buildSensorData(i, 0, &data)) full += wireBytes(IPC_MSG_SENSOR_DATA, (const uint8_t*)&data, sizeof(data));
+        }
+
+        static IPC_DeltaShadow_t live[MAX_NUM_OBJECTS];
+        memcpy(live, ipcDriver.deltaShadow, sizeof(live));
+        memcpy(ipcDriver.deltaShadow, pollCost.shadow, sizeof(live));
+        // Framed as ipc_sendDeltaFrame() does: a header per frame, the last one FINAL
+        static uint8_t frame[IPC_MAX_PAYLOAD_SIZE];
+        uint32_t delta = 0;
+        uint16_t pos = sizeof(IPC_SensorDeltaHeader_t);
+        uint8_t records = 0;
+        uint32_t recordTotal = 0;
+        for (uint16_t i = 0; i <= MAX_NUM_OBJECTS; i++) {
+            bool last = i == MAX_NUM_OBJECTS;
+            if (last || records == 255 || IPC_MAX_PAYLOAD_SIZE - pos < IPC_DELTA_MAX_RECORD_SIZE) {
+                IPC_SensorDeltaHeader_t header = {};
+                header.recordCount = records;
+                memcpy(frame, &header, sizeof(header));
+                delta += wireBytes(IPC_MSG_SENSOR_DELTA, frame, pos);
+                pos = sizeof(IPC_SensorDeltaHeader_t);
+                records = 0;
+                if (last) break;
+            }
+            uint16_t written = ipc_encodeSensorDelta(i, &frame[pos], IPC_MAX_PAYLOAD_SIZE - pos);
+            if (written) {
+                pos += written;
+                records++;
+                recordTotal++;
+            }
+        }
+        memcpy(pollCost.shadow, ipcDriver.deltaShadow, sizeof(live));
+        memcpy(ipcDriver.deltaShadow, live, sizeof(live));
+
+        if (pollCost.cycles++ == 0) {
+            pollCost.firstDelta = delta;
+            return;
+        }
+        pollCost.fullBytes += full;
+        pollCost.deltaBytes += delta;
+        pollCost.deltaRecords += recordTotal;
+        pollCost.deltaMax = max(pollCost.deltaMax, delta);
+    }
+
+    void printPollCost() {
+        if (pollCost.cycles < 2) return;
+        double n = pollCost.cycles - 1;
+        Serial.printf("Poll cycle (0-99, %u s): SENSOR_DATA %.0f B, SENSOR_DELTA %.0f B (%.1f%%, max %lu B, "
+                      "%.1f records), first delta %lu B\n\n",
+                      (unsigned)(TWIN_POLL_PERIOD_US / 1000000), pollCost.fullBytes / n, pollCost.deltaBytes / n,
+                      100.0 * pollCost.deltaBytes / (pollCost.fullBytes ? pollCost.fullBytes : 1),
+                      (unsigned long)pollCost.deltaMax, pollCost.deltaRecords / n, (unsigned long)pollCost.firstDelta);
+    }
+
+    // Drift the simulated plant so the IO MCU has changes to report
+    void plantStep(std::mt19937& rng, bool sine, uint64_t nowUs) {
+        std::uniform_int_distribution<int32_t> step(-200, 200);
+        for (int i = 0; i < 8; i++) MockHw::adcRaw[i] = constrain(MockHw::adcRaw[i] + step(rng), 0, 8388607);
+        if (sine) MockHw::adcRaw[0] = lround(TWIN_SINE_AMPLITUDE * sin(2 * M_PI * TWIN_SINE_HZ * nowUs * 1e-6));
+        for (int i = 0; i < 3; i++) MockHw::rtdCelsius[i] += step(rng) * 0.0005f;
+        MockHw::adcDataReady();
+    }
+
+    void printLinkLine(const VirtualWire& w, double seconds) {
+        const VirtualWire::Stats& s = w.stats();
+        Serial.printf("%-8s %10llu %10.0f %8llu %9.1f %6.1f %9llu %7llu %8llu %8lu\n", w.name(),
+                      (unsigned long long)s.bytes, s.bytes / seconds, (unsigned long long)s.frames,
+                      s.frames / seconds, 100.0 * s.busyUs / (seconds * 1e6),
+                      (unsigned long long)s.corrupted, (unsigned long long)s.dropped,
+                      (unsigned long long)s.mismatched, (unsigned long)w.rxOverflows());
+    }
+
+    void printReport(const TwinOptions& opt, const VirtualWire& toIo, const VirtualWire& toSys, double seconds) {
+        Serial.printf("\n=== IPC twin: %.1f s simulated, 8N1, baud limit %lu, byte error rate %g, drop rate %g ===\n",
+                      seconds, (unsigned long)opt.baudLimit, opt.byteErrorRate, opt.dropRate);
+        if (handshakeAtUs) Serial.printf("Handshake + config push complete at %.1f ms\n", handshakeAtUs / 1000.0);
+        else Serial.println("Handshake + config push did not complete");
+        Serial.printf("SYS object cache: %u valid objects\n\n", SysTwin::cachedObjectCount());
+
+        Serial.printf("%-8s %10s %10s %8s %9s %6s %9s %7s %8s %8s\n",
+                      "Link", "Bytes", "Bytes/s", "Frames", "Frames/s", "Util%", "Corrupted", "Dropped", "Mismatch", "RX ovfl");
+        printLinkLine(toIo, seconds);
+        printLinkLine(toSys, seconds);
+
+        SysTwin::LinkStats sys;
+        SysTwin::getLinkStats(&sys);
+        Serial.printf("\nSYS IPC: rx %lu, tx %lu, rx errors %lu, CRC errors %lu, TX full %lu\n",
+                      (unsigned long)sys.rxPackets, (unsigned long)sys.txPackets, (unsigned long)sys.rxErrors,
+                      (unsigned long)sys.crcErrors, (unsigned long)sys.txQueueFull);
+        Serial.printf("IO IPC:  rx %lu, tx %lu, rx errors %lu, CRC errors %lu\n",
+                      (unsigned long)ipcDriver.rxPacketCount, (unsigned long)ipcDriver.txPacketCount,
+                      (unsigned long)ipcDriver.rxErrorCount, (unsigned long)ipcDriver.crcErrorCount);
+        Serial.printf("SYS baud: %lu (%u switches, %u failed, %u fallbacks)\n",
+                      (unsigned long)sys.baudRate, sys.baudSwitches, sys.baudFailures, sys.baudFallbacks);
+        Serial.printf("IO baud:  %lu (%u switches, %u reverted)\n",
+                      (unsigned long)ipcDriver.baudRate, ipcDriver.baudSwitches, ipcDriver.baudReverts);
+
+        // What each MCU's own link telemetry reports (last 32 PINGs, 1 s windows)
+        const IPC_LinkStats_t* io = ipc_getLinkStats();
+        Serial.printf("SYS RTT: p50 %lu us, p90 %lu us, max %lu us (%u samples), peak util RX %.1f%% TX %.1f%%\n",
+                      (unsigned long)sys.rttP50Us, (unsigned long)sys.rttP90Us, (unsigned long)sys.rttMaxUs,
+                      sys.rttSamples, sys.rxUtilPeakPermille / 10.0, sys.txUtilPeakPermille / 10.0);
+        Serial.printf("IO RTT:  p50 %lu us, p90 %lu us, max %lu us (%u samples), peak util RX %.1f%% TX %.1f%%\n\n",
+                      (unsigned long)io->rttP50Us, (unsigned long)io->rttP90Us, (unsigned long)io->rttMaxUs,
+                      io->rttSamples, io->rxUtilPeakPermille / 10.0, io->txUtilPeakPermille / 10.0);
+        printPollCost();
+
+        Serial.printf("%-18s %8s %8s %8s %8s %8s %8s %7s %6s\n",
+                      "Transaction", "Done", "p50 us", "p90 us", "p99 us", "Max us", "Timeouts", "Failed", "Cancel");
+        uint32_t totalTimeouts = 0;
+        for (int t = 0; t < 256; t++) {
+            TxnClass& c = txnClass[t];
+            if (c.latencyUs.empty() && !c.timeouts && !c.failed && !c.cancelled) continue;
+            std::sort(c.latencyUs.begin(), c.latencyUs.end());
+            char other[24];
+            const char* name = ipcMessageName((uint8_t)t);
+            if (!name) {
+                snprintf(other, sizeof(other), "0x%02X", t);
+                name = other;
+            }
+            Serial.printf("%-18s %8lu %8lu %8lu %8lu %8lu %8lu %7lu %6lu\n", name,
+                          (unsigned long)c.latencyUs.size(), (unsigned long)percentile(c.latencyUs, 50),
+                          (unsigned long)percentile(c.latencyUs, 90), (unsigned long)percentile(c.latencyUs, 99),
+                          (unsigned long)(c.latencyUs.empty() ? 0 : c.latencyUs.back()),
+                          (unsigned long)c.timeouts, (unsigned long)c.failed, (unsigned long)c.cancelled);
+            totalTimeouts += c.timeouts;
+        }
+        Serial.printf("Total timeouts: %lu\n", (unsigned long)totalTimeouts);
+    }
+
+    // Control ACK latency against --ack-limit-us. The CONTROL_WRITE class is
+    // sorted by printReport().
+    bool checkAckLatency(const TwinOptions& opt) {
+        const TxnClass& c = txnClass[IPC_MSG_CONTROL_WRITE];
+        uint32_t p99 = percentile(c.latencyUs, 99);
+        Serial.printf("\nControl ACK%s: p50 %lu us, p90 %lu us, p99 %lu us, max %lu us (%u writes, %lu bulk polls)\n",
+                      opt.bulkPoll ? " under bulk poll" : "",
+                      (unsigned long)percentile(c.latencyUs, 50), (unsigned long)percentile(c.latencyUs, 90),
+                      (unsigned long)p99, (unsigned long)(c.latencyUs.empty() ? 0 : c.latencyUs.back()),
+                      (unsigned)c.latencyUs.size(), (unsigned long)bulkPolls);
+        uint32_t limit = opt.ackLimitUs ? opt.ackLimitUs : (opt.bulkPoll ? TWIN_ACK_LIMIT_US : 0);
+        if (!limit) return true;
+        // A lost ACK times out on a noisy wire; on a clean one it is a failure
+        bool lossy = opt.byteErrorRate > 0 || opt.dropRate > 0;
+        bool pass = !c.latencyUs.empty() && (lossy || !c.timeouts) && !c.failed && p99 <= limit;
+        Serial.printf("Control ACK p99 limit %lu us: %s\n", (unsigned long)limit, pass ? "pass" : "FAIL");
+        return pass;
+    }
+
+    // --corrupt-config-batch: one batch refused, the resend applied in full
+    bool checkConfigResend(const VirtualWire& toIo) {
+        const TxnClass& c = txnClass[IPC_MSG_CONFIG_COMMIT];
+        const IPC_ConfigStage_t& stage = ipcDriver.configStage;
+        bool pass = handshakeAtUs && c.failed == 1 && c.latencyUs.size() == 1 && !c.timeouts &&
+                    stage.status == IPC_CONFIG_BATCH_APPLIED && stage.appliedCount == stage.recordCount &&
+                    stage.recordCount > 0 && toIo.stats().corrupted == 1;
+        Serial.printf("\nConfig batch resend: %lu refused, %lu applied, IO applied %u/%u records: %s\n",
+                      (unsigned long)c.failed, (unsigned long)c.latencyUs.size(),
+                      stage.appliedCount, stage.recordCount, pass ? "pass" : "FAIL");
+        return pass;
+    }
+
+    // --reconnect: state at each of the three handshakes (boot, after the cut
+    // with a changed ADC calibration, after the cut with no change)
+    struct Reconnect {
+        uint8_t cuts = 0;
+        bool cut = false;
+        bool wasReady = false;
+        uint64_t nextUs = 0;            // Next cut or restore (0 = none)
+        uint8_t handshakes = 0;
+        size_t commits[3] = {};         // CONFIG_COMMITs applied so far
+        uint16_t pushedRecords[3] = {}; // Last batch the IO MCU applied
+        uint16_t pushedSections[3] = {};
+        uint32_t digest[3] = {};
+        bool converged[3] = {};         // SYS and IO digests equal, every section
+        uint8_t cached[3] = {};         // Valid objects in the SYS cache
+        float adcScale[3] = {};         // IO MCU ADC input 0 calibration
+    } reconnect;
+
+    void reconnectHandshake(uint8_t n) {
+        Reconnect& r = reconnect;
+        uint32_t sys[IPC_CONFIG_SECTION_COUNT];
+        IPC_ConfigDigest_t io;
+        r.digest[n] = SysTwin::configDigest(sys, IPC_CONFIG_SECTION_COUNT);
+        ipc_getConfigDigest(&io);
+        r.converged[n] = io.overall == r.digest[n] && memcmp(io.section, sys, sizeof(sys)) == 0;
+        r.commits[n] = txnClass[IPC_MSG_CONFIG_COMMIT].latencyUs.size();
+        r.pushedRecords[n] = ipcDriver.configStage.recordCount;
+        r.pushedSections[n] = ipcDriver.configStage.sectionMask;
+        r.cached[n] = SysTwin::cachedObjectCount();
+        AnalogInput_t* adc = (AnalogInput_t*)objIndex[0].obj;
+        r.adcScale[n] = (adc && adc->cal) ? adc->cal->scale : 0;
+    }
+
+    void reconnectStep(uint64_t now, VirtualWire& toIo, VirtualWire& toSys) {
+        Reconnect& r = reconnect;
+        bool ready = SysTwin::ready();
+        if (ready && !r.wasReady && r.handshakes < 3) {
+            reconnectHandshake(r.handshakes++);
+            if (r.cuts < 2) r.nextUs = now + TWIN_CUT_AFTER_US;
+        }
+        r.wasReady = ready;
+        if (!r.nextUs || now < r.nextUs) return;
+        r.cut = !r.cut;
+        toIo.setCut(r.cut);
+        toSys.setCut(r.cut);
+        if (r.cut) {
+            if (++r.cuts == 1) SysTwin::setAdcCalibration(0, TWIN_CUT_ADC_SCALE);
+            r.nextUs = now + TWIN_CUT_US;
+        } else {
+            r.nextUs = 0;
+        }
+    }
+
+    bool checkReconnect() {
+        const Reconnect& r = reconnect;
+        const TxnClass& c = txnClass[IPC_MSG_CONFIG_COMMIT];
+        Serial.println();
+        for (uint8_t i = 0; i < r.handshakes; i++) {
+            bool pushed = i == 0 || r.commits[i] > r.commits[i - 1];
+            Serial.printf("Handshake %u: %s, digest %08lX %s, %u objects cached, ADC 0 scale %.3f\n", i + 1,
+                          pushed ? "config pushed" : "nothing pushed", (unsigned long)r.digest[i],
+                          r.converged[i] ? "matches IO" : "DIFFERS from IO", r.cached[i], r.adcScale[i]);
+            if (pushed) Serial.printf("             %u records, sections 0x%04X\n", r.pushedRecords[i], r.pushedSections[i]);
+        }
+        bool pass = r.handshakes == 3 && !c.failed && !c.timeouts &&
+                    r.converged[0] && r.converged[1] && r.converged[2] &&
+                    // First cut: only the ADC section is pushed and applied
+                    r.commits[1] == r.commits[0] + 1 && r.pushedSections[1] == (1u << IPC_CONFIG_SECTION_ADC) &&
+                    r.pushedRecords[1] < r.pushedRecords[0] && r.adcScale[1] == TWIN_CUT_ADC_SCALE &&
+                    r.digest[1] != r.digest[0] &&
+                    // Second cut: nothing to push
+                    r.commits[2] == r.commits[1] && r.digest[2] == r.digest[1] &&
+                    // The cache is kept across both reconnects
+                    r.cached[1] > 0 && r.cached[2] > 0;
+        Serial.printf("Reconnect digest convergence: %s\n", r.handshakes < 3 ? "INCOMPLETE (run longer)" : pass ? "pass" : "FAIL");
+        return pass;
+    }
+
+    void usage(const char* prog) {
+        fprintf(stderr, "usage: %s [--seconds N] [--baud-limit N] [--byte-error-rate P] [--drop-rate P] [--seed N]\n"
+                        "          [--writes-per-s N] [--report-s N] [--realtime] [--verbose] [--poll-cost]\n"
+                        "          [--bulk-poll] [--ack-limit-us N] [--corrupt-config-batch] [--reconnect]\n"
+                        "          [--capture FILE [--capture-kb N]] [--adc-capture FILE [--adc-rate N]]\n"
+                        "       %s --timeline FILE [--payload]\n"
+                        "       %s --replay FILE [--into io|sys] [--speed X] [--baud N] [--realtime] [--verbose]\n",
+                prog, prog, prog);
+    }
+
+    bool parseArgs(int argc, char** argv, TwinOptions& opt) {
+        for (int i = 1; i < argc; i++) {
+            bool hasValue = i + 1 < argc;
+            if (strcmp(argv[i], "--seconds") == 0 && hasValue) opt.seconds = strtoull(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--baud-limit") == 0 && hasValue) opt.baudLimit = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--baud") == 0 && hasValue) opt.replay.baud = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--byte-error-rate") == 0 && hasValue) opt.byteErrorRate = atof(argv[++i]);
+            else if (strcmp(argv[i], "--drop-rate") == 0 && hasValue) opt.dropRate = atof(argv[++i]);
+            else if (strcmp(argv[i], "--seed") == 0 && hasValue) opt.seed = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--writes-per-s") == 0 && hasValue) opt.writesPerSecond = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--report-s") == 0 && hasValue) opt.reportSeconds = strtoull(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--realtime") == 0) opt.realtime = true;
+            else if (strcmp(argv[i], "--verbose") == 0) opt.verbose = true;
+            else if (strcmp(argv[i], "--poll-cost") == 0) opt.pollCost = true;
+            else if (strcmp(argv[i], "--bulk-poll") == 0) opt.bulkPoll = true;
+            else if (strcmp(argv[i], "--corrupt-config-batch") == 0) opt.corruptConfigBatch = true;
+            else if (strcmp(argv[i], "--reconnect") == 0) opt.reconnect = true;
+            else if (strcmp(argv[i], "--ack-limit-us") == 0 && hasValue) opt.ackLimitUs = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--capture") == 0 && hasValue) opt.capturePath = argv[++i];
+            else if (strcmp(argv[i], "--capture-kb") == 0 && hasValue) opt.captureKb = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--adc-capture") == 0 && hasValue) opt.adcCapturePath = argv[++i];
+            else if (strcmp(argv[i], "--adc-rate") == 0 && hasValue) opt.adcCaptureRate = strtoul(argv[++i], nullptr, 10);
+            else if (strcmp(argv[i], "--timeline") == 0 && hasValue) opt.timelinePath = argv[++i];
+            else if (strcmp(argv[i], "--payload") == 0) opt.timelinePayload = true;
+            else if (strcmp(argv[i], "--replay") == 0 && hasValue) opt.replayPath = argv[++i];
+            else if (strcmp(argv[i], "--speed") == 0 && hasValue) opt.replay.speed = atof(argv[++i]);
+            else if (strcmp(argv[i], "--into") == 0 && hasValue) {
+                const char* target = argv[++i];
+                if (strcmp(target, "io") == 0) opt.replay.target = REPLAY_INTO_IO;
+                else if (strcmp(target, "sys") == 0) opt.replay.target = REPLAY_INTO_SYS;
+                else return false;
+            }
+            else return false;
+        }
+        return opt.replay.speed >= 0;
+    }
+
+    // --timeline / --replay: work on a capture instead of running the twin
+    int runCaptureTool(TwinOptions& opt) {
+        Capture capture;
+        if (!loadCapture(opt.timelinePath ? opt.timelinePath : opt.replayPath, capture)) return 1;
+        if (opt.timelinePath) {
+            printCaptureTimeline(capture, opt.timelinePayload);
+            return 0;
+        }
+        opt.replay.realtime = opt.realtime;
+        opt.replay.verbose = opt.verbose;
+        return runReplay(capture, opt.replay);
+    }
+}
+
+int main(int argc, char** argv) {
+    TwinOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (opt.timelinePath || opt.replayPath) return runCaptureTool(opt);
+
+    Serial.setEcho(opt.verbose);
+    SimClock::setRealtime(opt.realtime);
+
+    VirtualWire toIo(SysSerial1, Serial1, "SYS->IO");
+    VirtualWire toSys(Serial1, SysSerial1, "IO->SYS");
+    toIo.setBaudLimit(opt.baudLimit);     // Line rate follows each side's UART
+    toSys.setBaudLimit(opt.baudLimit);
+    toIo.setErrors(opt.byteErrorRate, opt.dropRate, opt.seed);
+    toSys.setErrors(opt.byteErrorRate, opt.dropRate, opt.seed + 1);
+    if (opt.corruptConfigBatch) toIo.corruptFrames(IPC_MSG_CONFIG_BATCH, 1);
+    std::mt19937 plantRng(opt.seed);
+
+    setup();                                        // IO MCU firmware
+    SysTwin::begin(onTransaction, opt.verbose);     // SYS MCU IPC stack
+    if (opt.capturePath && !SysTwin::captureStart(opt.captureKb * 1024)) return 1;
+
+    const uint64_t startUs = SimClock::now();
+    const uint64_t endUs = startUs + opt.seconds * 1000000ULL;
+    const uint64_t writePeriodUs = opt.writesPerSecond ? 1000000ULL / opt.writesPerSecond : 0;
+    uint64_t nextAdcUs = startUs + TWIN_ADC_PERIOD_US;
+    uint64_t nextWriteUs = startUs;
+    uint64_t nextReportUs = opt.reportSeconds ? startUs + opt.reportSeconds * 1000000ULL : UINT64_MAX;
+    uint64_t nextSysUs = startUs;
+    uint64_t nextPollUs = 0;
+    uint32_t writeSeq = 0;
+    bool adcCaptureArmed = false;
+
+    while (true) {
+        uint64_t now = SimClock::now();
+        if (now >= endUs) break;
+
+        toIo.service(now);
+        toSys.service(now);
+        loop();
+        SysTwin::update();
+        if (now >= nextSysUs) nextSysUs = now + TWIN_SYS_TICK_US;
+        toIo.service(now);
+        toSys.service(now);
+
+        if (!handshakeAtUs && SysTwin::ready()) {
+            handshakeAtUs = now - startUs;
+            if (opt.pollCost) nextPollUs = now;
+        }
+        if (nextPollUs && now >= nextPollUs) {
+            pollCycle();
+            nextPollUs += TWIN_POLL_PERIOD_US;
+        }
+        if (opt.adcCapturePath && !adcCaptureArmed && SysTwin::ready()) {
+            // Trigger at the sine's zero crossing, in channel 0's unit
+            float level = adcDriver.pipeline.offset[0];
+            adcCaptureArmed = SysTwin::adcCaptureArm(0x03, opt.adcCaptureRate, TWIN_CAPTURE_PRE_SCANS,
+                                                     TWIN_CAPTURE_SCANS, IPC_ADC_TRIG_RISING, 0, level);
+        }
+        if (now >= nextAdcUs) {
+            plantStep(plantRng, opt.adcCapturePath != nullptr, now);
+            nextAdcUs += MockHw::adcScanPeriodUs ? MockHw::adcScanPeriodUs : TWIN_ADC_PERIOD_US;     // Capture scan while armed
+        }
+        if (opt.reconnect) reconnectStep(now, toIo, toSys);
+        if (opt.bulkPoll && SysTwin::ready() && SysTwin::requestBulkPoll()) bulkPolls++;
+        if (writePeriodUs && SysTwin::ready() && now >= nextWriteUs) {
+            SysTwin::sendControlWrite(writeSeq++);
+            // Jittered so writes do not phase-lock to the IO MCU's 5 ms IPC tick
+            nextWriteUs = now + writePeriodUs / 2 + plantRng() % (writePeriodUs + 1);
+        }
+        if (now >= nextReportUs) {
+            bool echo = Serial.getEcho();
+            Serial.setEcho(true);
+            Serial.printf("[twin %llu s] %s %llu B %llu frames | %s %llu B %llu frames\n",
+                          (unsigned long long)((now - startUs) / 1000000ULL),
+                          toIo.name(), (unsigned long long)toIo.stats().bytes, (unsigned long long)toIo.stats().frames,
+                          toSys.name(), (unsigned long long)toSys.stats().bytes, (unsigned long long)toSys.stats().frames);
+            Serial.setEcho(echo);
+            nextReportUs += opt.reportSeconds * 1000000ULL;
+        }
+        if (opt.realtime) continue;
+
+        // Jump to the next thing that can happen: a byte boundary on either
+        // wire, an IO MCU deadline, a SYS loop tick, the plant or a write.
+        // A posted event hides the deadline until the next loop() collects it.
+        unsigned long ioDue;
+        if (!tasks.getNextDeadline(&ioDue)) {
+            loop();
+            if (!tasks.getNextDeadline(&ioDue)) ioDue = (unsigned long)endUs;
+        }
+        if ((long)(ioDue - micros()) <= 0) continue;
+        uint64_t next = min((uint64_t)ioDue, nextSysUs);
+        next = min(next, toIo.nextEventUs(now));
+        next = min(next, toSys.nextEventUs(now));
+        next = min(next, nextAdcUs);
+        if (nextPollUs) next = min(next, nextPollUs);
+        if (reconnect.nextUs) next = min(next, reconnect.nextUs);
+        if (writePeriodUs && SysTwin::ready()) next = min(next, nextWriteUs);
+        next = min(next, endUs);
+        SimClock::advanceTo(next);
+    }
+
+    Serial.setEcho(true);
+    printReport(opt, toIo, toSys, (SimClock::now() - startUs) / 1e6);
+    bool ackPass = (opt.bulkPoll || opt.ackLimitUs) ? checkAckLatency(opt) : true;
+    bool configPass = opt.corruptConfigBatch ? checkConfigResend(toIo) : true;
+    bool reconnectPass = opt.reconnect ? checkReconnect() : true;
+    if (opt.capturePath) {
+        if (!SysTwin::captureSave(opt.capturePath)) {
+            fprintf(stderr, "%s: cannot write capture\n", opt.capturePath);
+            return 1;
+        }
+        Serial.printf("IPC capture saved to %s\n", opt.capturePath);
+    }
+    if (opt.adcCapturePath) {
+        SysTwin::AdcCaptureResult r;
+        SysTwin::adcCaptureResult(&r);
+        Serial.printf("ADC capture: phase %u, flags 0x%02X, %u scans at %lu ns, %lu missed, %lu samples transferred\n",
+                      r.phase, r.flags, r.lengthScans, (unsigned long)r.scanPeriodNs,
+                      (unsigned long)r.missedSamples, (unsigned long)r.samplesRead);
+        if (!SysTwin::adcCaptureSave(opt.adcCapturePath)) {
+            fprintf(stderr, "%s: no ADC capture to write\n", opt.adcCapturePath);
+            return 1;
+        }
+        Serial.printf("ADC capture saved to %s\n", opt.adcCapturePath);
+    }
+    return (ackPass && configPass && reconnectPass) ? 0 : 1;
+}
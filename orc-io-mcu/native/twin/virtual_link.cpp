@@ -0,0 +1,141 @@
+#include "virtual_link.h"
+
+static const uint8_t WIRE_FRAME_DELIMITER = 0x7E;   // IPC START/END byte (never stuffed into a frame)
+static const uint8_t WIRE_ESCAPE = 0x7D;
+static const uint8_t WIRE_ESCAPE_XOR = 0x20;
+static const uint16_t WIRE_TYPE_POS = 2;        // LEN_H LEN_L TYPE
+static const uint32_t WIRE_BITS_PER_CHAR = 10; // 8N1
+static const uint32_t WIRE_BAUD_TOLERANCE = 50; // Sender and receiver rates within 2 % (1/50) still sample correctly
+static const double WIRE_OVER_LIMIT_ERROR_RATE = 1e-3;
+
+VirtualWire::VirtualWire(Uart &from, Uart &to, const char *name) : _from(from), _to(to), _name(name) {
+    _setRate(_baud);
+}
+
+void VirtualWire::setBaud(uint32_t baud) {
+    _fixedBaud = baud;
+    if (baud) _setRate(baud);
+}
+
+void VirtualWire::setBaudLimit(uint32_t baud) {
+    _baudLimit = baud;
+}
+
+void VirtualWire::corruptFrames(uint8_t msgType, uint32_t count) {
+    _corruptType = msgType;
+    _corruptLeft = count;
+}
+
+// Follow the framing of the byte about to be sent; in a frame picked by
+// corruptFrames() flip a bit of the first payload byte that stays clear of
+// the delimiter and escape values, so only that frame's CRC fails
+void VirtualWire::_trackFrame() {
+    if (_byte == WIRE_FRAME_DELIMITER) {
+        _framePos = 0;
+        _frameEscape = false;
+        _frameTarget = false;
+        return;
+    }
+    if (_byte == WIRE_ESCAPE) {
+        _frameEscape = true;
+        return;
+    }
+    uint8_t value = _frameEscape ? (uint8_t)(_byte ^ WIRE_ESCAPE_XOR) : _byte;
+    bool escaped = _frameEscape;
+    _frameEscape = false;
+    if (_framePos == WIRE_TYPE_POS && _corruptLeft && value == _corruptType) {
+        _frameTarget = true;
+    } else if (_frameTarget && _framePos > WIRE_TYPE_POS && !escaped) {
+        uint8_t damaged = _byte ^ 0x01;
+        if (damaged != WIRE_FRAME_DELIMITER && damaged != WIRE_ESCAPE) {
+            _byte = damaged;
+            _frameTarget = false;
+            _corruptLeft--;
+            _stats.corrupted++;
+        }
+    }
+    _framePos++;
+}
+
+void VirtualWire::_setRate(uint32_t baud) {
+    _baud = baud ? baud : 1;
+    _charUs = (uint64_t)WIRE_BITS_PER_CHAR * 1000000ULL / _baud;
+    _charRem = 0;
+}
+
+void VirtualWire::setErrors(double byteErrorRate, double dropRate, uint32_t seed) {
+    _errorRate = byteErrorRate;
+    _dropRate = dropRate;
+    _rng.seed(seed);
+}
+
+// Character time in whole microseconds; the remainder is carried so that
+// e.g. 921600 baud averages 10.85 us per byte rather than rounding to 10
+uint64_t VirtualWire::_charTime() {
+    _charRem += (uint64_t)WIRE_BITS_PER_CHAR * 1000000ULL % _baud;
+    uint64_t extra = _charRem / _baud;
+    _charRem %= _baud;
+    return _charUs + extra;
+}
+
+void VirtualWire::service(uint64_t nowUs) {
+    while (true) {
+        if (_inFlight) {
+            if (_arriveAt > nowUs) return;
+            _inFlight = false;
+            _lineFreeAt = _arriveAt;
+
+            if (_cut || (_dropRate > 0 && _uniform(_rng) < _dropRate)) {
+                _stats.dropped++;
+                continue;
+            }
+            uint8_t byte = _byte;
+            if (!_fixedBaud) {
+                uint32_t rxBaud = _to.getBaud();
+                if (rxBaud == 0) {
+                    _stats.mismatched++;    // Receiver UART closed
+                    continue;
+                }
+                uint32_t diff = rxBaud > _byteBaud ? rxBaud - _byteBaud : _byteBaud - rxBaud;
+                if (diff > _byteBaud / WIRE_BAUD_TOLERANCE) {
+                    byte = (uint8_t)_rng();
+                    _stats.mismatched++;
+                    _to.hostInject(&byte, 1);
+                    _stats.bytes++;
+                    continue;
+                }
+            }
+            double errorRate = _errorRate;
+            if (_baudLimit && _byteBaud > _baudLimit && errorRate < WIRE_OVER_LIMIT_ERROR_RATE) {
+                errorRate = WIRE_OVER_LIMIT_ERROR_RATE;
+            }
+            if (errorRate > 0 && _uniform(_rng) < errorRate) {
+                byte ^= (uint8_t)(1u << (_rng() & 7));
+                _stats.corrupted++;
+            }
+            _to.hostInject(&byte, 1);
+            _stats.bytes++;
+            continue;
+        }
+
+        // Line idle: start the next byte, back to back if it was already waiting
+        if (_from.hostTxAvailable() == 0) return;
+        uint64_t start = _lineFreeAt > nowUs ? _lineFreeAt : nowUs;
+        if (start > nowUs) return;
+        _from.hostTxRead(&_byte, 1);
+        if (!_fixedBaud && _from.getBaud() && _from.getBaud() != _baud) _setRate(_from.getBaud());
+        _byteBaud = _baud;
+        if (_byte == WIRE_FRAME_DELIMITER) _stats.frames = ++_delimiters / 2;
+        _trackFrame();
+        uint64_t charTime = _charTime();
+        _arriveAt = start + charTime;
+        _stats.busyUs += charTime;
+        _inFlight = true;
+    }
+}
+
+uint64_t VirtualWire::nextEventUs(uint64_t nowUs) const {
+    if (_inFlight) return _arriveAt;
+    if (_from.hostTxAvailable()) return _lineFreeAt > nowUs ? _lineFreeAt : nowUs;
+    return UINT64_MAX;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <Arduino.h>
+#include <random>
+
+// One direction of the inter-MCU UART. Bytes leave the sender's TX ring one
+// character time apart (start + 8 data + stop bits at the sender's baud, or a
+// fixed one) and arrive in the receiver's RX ring, running its RX hook, when
+// the stop bit ends. A byte can be corrupted (one random bit flipped) or lost
+// on the way. A receiver at another rate than the sender gets garbage, and
+// one whose UART is closed gets nothing.
+class VirtualWire {
+public:
+    struct Stats {
+        uint64_t bytes;         // Delivered (including corrupted)
+        uint64_t frames;        // Frames sent (START and END are both 0x7E)
+        uint64_t corrupted;
+        uint64_t dropped;
+        uint64_t mismatched;    // Sent and received at different rates
+        uint64_t busyUs;        // Line time spent sending
+    };
+
+    VirtualWire(Uart &from, Uart &to, const char *name);
+
+    void setBaud(uint32_t baud);            // 0 = follow the sender's UART
+    void setErrors(double byteErrorRate, double dropRate, uint32_t seed);
+    void setBaudLimit(uint32_t baud);       // Bytes sent faster are corrupted often (0 = no limit)
+    void corruptFrames(uint8_t msgType, uint32_t count);   // Damage the next count frames of msgType (CRC fails)
+    void setCut(bool cut) { _cut = cut; }   // Line cut: every byte is lost
+
+    void service(uint64_t nowUs);           // Move bytes whose time has come
+    uint64_t nextEventUs(uint64_t nowUs) const;
+    const Stats &stats() const { return _stats; }
+    uint32_t rxOverflows() const { return _to.getRxOverflowCount(); }
+    const char *name() const { return _name; }
+
+private:
+    Uart &_from;
+    Uart &_to;
+    const char *_name;
+    uint32_t _fixedBaud = 0;    // 0 = the sender's UART rate
+    uint32_t _baudLimit = 0;
+    uint64_t _charUs = 5;       // 10 bits at 2 Mbps
+    uint32_t _baud = 2000000;   // Rate of the byte being sent
+    uint64_t _charRem = 0;      // Sub-microsecond remainder, keeps the average rate exact
+    uint64_t _lineFreeAt = 0;
+    bool _inFlight = false;
+    uint8_t _byte = 0;
+    uint32_t _byteBaud = 0;
+    uint64_t _arriveAt = 0;
+    double _errorRate = 0;
+    double _dropRate = 0;
+    bool _cut = false;
+    std::mt19937 _rng;
+    std::uniform_real_distribution<double> _uniform{0.0, 1.0};
+    Stats _stats = {};
+    uint64_t _delimiters = 0;
+    uint8_t _corruptType = 0;
+    uint32_t _corruptLeft = 0;
+    uint16_t _framePos = 0;     // Unstuffed bytes since the last delimiter
+    bool _frameEscape = false;
+    bool _frameTarget = false;  // Frame being sent is to be damaged
+    void _trackFrame();
+    uint64_t _charTime();
+    void _setRate(uint32_t baud);
+};
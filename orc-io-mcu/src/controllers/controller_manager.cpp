@@ -515,7 +515,7 @@ bool ControllerManager::createpHController(const IPC_ConfigpHController_t* confi
         }
     };
     
-    ScheduledTask* task = tasks.addTask(taskWrapper, 100);
+    ScheduledTask* task = tasks.addTask(taskWrapper, 100, true, false, "ctrl_ph");
     if (task == nullptr) {
         Serial.println("[CTRL MGR] Failed to create pH controller task");
         objIndex[config->index].valid = false;
@@ -713,7 +713,9 @@ bool ControllerManager::createFlowController(uint8_t index, const IPC_ConfigFlow
     
     // Add scheduler task (100ms = 10Hz update rate)
     flowControllerInstances[arrIdx] = ctrl->controllerInstance;
-    ScheduledTask* task = tasks.addTask(flowTaskWrappers[arrIdx], 100);
+    char taskName[SCHED_TASK_NAME_LEN];
+    snprintf(taskName, sizeof(taskName), "ctrl_flow%d", index);
+    ScheduledTask* task = tasks.addTask(flowTaskWrappers[arrIdx], 100, true, false, taskName);
     if (task == nullptr) {
         Serial.printf("[CTRL MGR] ERROR: Failed to add task for flow controller %d\n", index);
         delete ctrl->controllerInstance;
@@ -995,7 +997,9 @@ ScheduledTask* ControllerManager::addControllerTask(ManagedController* ctrl) {
     }
     
     // Add task using the non-capturing wrapper function
-    ScheduledTask* task = tasks.addTask(taskWrappers[slot], taskInterval);
+    char taskName[SCHED_TASK_NAME_LEN];
+    snprintf(taskName, sizeof(taskName), "ctrl_temp%d", ctrl->index);
+    ScheduledTask* task = tasks.addTask(taskWrappers[slot], taskInterval, true, false, taskName);
     
     if (task != nullptr) {
         Serial.printf("[CTRL MGR] Added scheduler task for controller %d (%dms interval)\n", 
@@ -1153,7 +1157,7 @@ bool ControllerManager::createDOController(const IPC_ConfigDOController_t* confi
     
     // Add scheduler task (1000ms = 1Hz update rate)
     doControllerInstance = ctrlInstance;
-    ScheduledTask* task = tasks.addTask(doControllerTaskWrapper, 1000, true);
+    ScheduledTask* task = tasks.addTask(doControllerTaskWrapper, 1000, true, false, "ctrl_do");
     
     // Update managed controller
     doController.controllerInstance = ctrlInstance;
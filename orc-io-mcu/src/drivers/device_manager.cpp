@@ -683,7 +683,9 @@ ScheduledTask* DeviceManager::addDeviceTask(ManagedDevice* dev) {
     }
     
     // Add task using the non-capturing wrapper function
-    ScheduledTask* task = tasks.addTask(taskWrappers[slot], 2000, true, false);
+    char taskName[SCHED_TASK_NAME_LEN];
+    snprintf(taskName, sizeof(taskName), "dev%d_t%d", dev->startSensorIndex, dev->type);
+    ScheduledTask* task = tasks.addTask(taskWrappers[slot], 2000, true, false, taskName);
     
     if (task == nullptr) {
         Serial.printf("[DEV MGR] ERROR: Failed to add task for slot %d\n", slot);
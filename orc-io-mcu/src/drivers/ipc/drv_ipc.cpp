@@ -1,4 +1,6 @@
 #include "drv_ipc.h"
+#include "ipc_crc16.h"
+#include "../../tasks/taskManager.h"
 
 // Global IPC driver instance
 IPC_Driver_t ipcDriver;
@@ -8,20 +10,8 @@ IPC_Driver_t ipcDriver;
 // ============================================================================
 
 uint16_t ipc_calcCRC16(const uint8_t *data, uint16_t length) {
-    uint16_t crc = 0xFFFF;  // Initial value
-    
-    for (uint16_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (uint8_t bit = 0; bit < 8; bit++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;  // Polynomial
-            } else {
-                crc = crc << 1;
-            }
-        }
-    }
-    
-    return crc;
+    // Table-driven (slice-by-4 on the M4), bit-exact with the bitwise reference
+    return ipc_crc16(data, length);
 }
 
 // ============================================================================
@@ -31,12 +21,15 @@ uint16_t ipc_calcCRC16(const uint8_t *data, uint16_t length) {
 bool ipc_init(void) {
     // Initialize structure
     memset(&ipcDriver, 0, sizeof(IPC_Driver_t));
+    ipc_clearTxQueue();  // Lay out the TX lanes
     
     // Configure UART
     ipcDriver.uart = &Serial1;
     // Note: SAME51 Serial1 uses hardware FIFO (default ~64 bytes RX buffer)
     // This should be sufficient as IPC protocol processes bytes continuously
-    ipcDriver.uart->begin(2000000);  // 2 Mbps
+    ipcDriver.baudRate = IPC_BAUD_DEFAULT;
+    ipcDriver.uart->begin(ipcDriver.baudRate);  // 2 Mbps until the SYS MCU negotiates more
+    ipcDriver.txIdleRoom = ipcDriver.uart->availableForWrite();
     
     // Set initial state
     ipcDriver.state = IPC_STATE_IDLE;
@@ -46,6 +39,7 @@ bool ipc_init(void) {
     ipcDriver.lastActivity = millis();
     ipcDriver.lastKeepalive = millis();
     ipcDriver.lastHelloBroadcast = 0;
+    ipcDriver.linkWindowStart = millis();
     
     strcpy(ipcDriver.message, "IPC initialized");
     ipcDriver.newMessage = true;
@@ -53,6 +47,13 @@ bool ipc_init(void) {
     return true;
 }
 
+// Serial1 RX interrupt hook (board variant): run ipc_update() on the next loop
+// pass instead of the next 5 ms tick, so frames are drained and answered
+// before the UART ring buffer can overflow
+void Serial1_rxHook(void) {
+    if (ipc_task) ipc_task->post();
+}
+
 void ipc_setHardwareReady(void) {
     ipcDriver.hardwareReady = true;
     Serial.println("[IPC] Hardware ready, starting HELLO broadcasts");
@@ -62,11 +63,73 @@ void ipc_setHardwareReady(void) {
 // PACKET TRANSMISSION
 // ============================================================================
 
-bool ipc_sendPacket(uint8_t msgType, const uint8_t *payload, uint16_t len) {
-    #if IPC_DEBUG_ENABLED
-    Serial.printf("[IPC TX] sendPacket called: msgType=0x%02X, len=%u\n", msgType, len);
-    #endif
+// Telemetry that may wait behind control traffic
+static uint8_t ipc_txLaneFor(uint8_t msgType) {
+    switch (msgType) {
+        case IPC_MSG_SENSOR_DATA:
+        case IPC_MSG_SENSOR_BATCH:
+        case IPC_MSG_SENSOR_DELTA:
+        case IPC_MSG_INDEX_SYNC_DATA:
+        case IPC_MSG_BULK_CREDIT:
+        case IPC_MSG_TASK_STATS:
+        case IPC_MSG_ADC_CAPTURE_DATA:
+            return IPC_TX_LANE_BULK;
+        default:
+            return IPC_TX_LANE_CONTROL;
+    }
+}
+
+// Ring bytes taken by a record (header + payload, padded to keep headers aligned)
+static inline uint16_t ipc_txRecordSize(uint16_t len) {
+    return (sizeof(IPC_TxRecord_t) + len + 3) & ~3;
+}
+
+static inline IPC_TxRecord_t *ipc_txRecordAt(IPC_TxLane_t *lane, uint16_t offset) {
+    return (IPC_TxRecord_t*)&ipcDriver.txRing[lane->base + offset];
+}
+
+// Find contiguous lane space for a record. *cost includes any space skipped
+// at the lane end when the record has to wrap to offset 0.
+static bool ipc_txRingPlace(IPC_TxLane_t *lane, uint16_t len, uint16_t *offset, uint16_t *cost) {
+    uint16_t need = ipc_txRecordSize(len);
     
+    if (lane->used == lane->size) {
+        return false;
+    }
+    
+    if (lane->head >= lane->tail) {
+        // Free space is [head, end) followed by [0, tail)
+        if (need <= lane->size - lane->head) {
+            *offset = lane->head;
+            *cost = need;
+            return true;
+        }
+        if (need <= lane->tail) {
+            *offset = 0;
+            *cost = need + (lane->size - lane->head);
+            return true;
+        }
+        return false;
+    }
+    
+    // Free space is [head, tail)
+    if (need <= lane->tail - lane->head) {
+        *offset = lane->head;
+        *cost = need;
+        return true;
+    }
+    return false;
+}
+
+static void ipc_txInitLanes(void) {
+    memset(ipcDriver.txLane, 0, sizeof(ipcDriver.txLane));
+    ipcDriver.txLane[IPC_TX_LANE_CONTROL].base = 0;
+    ipcDriver.txLane[IPC_TX_LANE_CONTROL].size = IPC_TX_CONTROL_RING_SIZE;
+    ipcDriver.txLane[IPC_TX_LANE_BULK].base = IPC_TX_CONTROL_RING_SIZE;
+    ipcDriver.txLane[IPC_TX_LANE_BULK].size = IPC_TX_RING_SIZE - IPC_TX_CONTROL_RING_SIZE;
+}
+
+uint8_t *ipc_txReserve(uint8_t msgType, uint16_t len) {
     // Check payload size
     if (len > IPC_MAX_PAYLOAD_SIZE) {
         ipcDriver.fault = true;
@@ -74,132 +137,492 @@ bool ipc_sendPacket(uint8_t msgType, const uint8_t *payload, uint16_t len) {
         #if IPC_DEBUG_ENABLED
         Serial.println("[IPC TX] ERROR: Payload too large");
         #endif
-        return false;
+        return nullptr;
     }
     
     // Check queue space
-    if (!ipc_txQueueHasSpace()) {
+    uint8_t laneId = ipc_txLaneFor(msgType);
+    IPC_TxLane_t *lane = &ipcDriver.txLane[laneId];
+    uint16_t offset, cost;
+    if (!ipc_txRingPlace(lane, len, &offset, &cost)) {
         ipcDriver.txErrorCount++;
+        lane->fullCount++;
         ipcDriver.fault = true;
         strcpy(ipcDriver.message, "IPC TX: Queue full");
         #if IPC_DEBUG_ENABLED
         Serial.println("[IPC TX] ERROR: Queue full");
         #endif
+        return nullptr;
+    }
+    
+    // Space is not visible to the encoder until committed
+    ipcDriver.txReserved = true;
+    ipcDriver.txReserveLane = laneId;
+    ipcDriver.txReserveMsgType = msgType;
+    ipcDriver.txReserveOffset = offset;
+    return (uint8_t*)(ipc_txRecordAt(lane, offset) + 1);
+}
+
+bool ipc_txCommit(uint16_t len) {
+    if (!ipcDriver.txReserved || len > IPC_MAX_PAYLOAD_SIZE) {
         return false;
     }
+    ipcDriver.txReserved = false;
     
-    // Add to queue
-    IPC_TxPacket_t *packet = &ipcDriver.txQueue[ipcDriver.txQueueHead];
-    packet->msgType = msgType;
-    packet->payloadLen = len;
-    if (len > 0 && payload != nullptr) {
-        memcpy(packet->payload, payload, len);
+    IPC_TxLane_t *lane = &ipcDriver.txLane[ipcDriver.txReserveLane];
+    uint16_t offset = ipcDriver.txReserveOffset;
+    
+    // Record placed at the lane start - mark the skipped end space for the reader
+    if (offset != lane->head) {
+        ipc_txRecordAt(lane, lane->head)->payloadLen = IPC_TX_RECORD_WRAP;
+        lane->used += lane->size - lane->head;
     }
     
-    // Advance head
-    ipcDriver.txQueueHead = (ipcDriver.txQueueHead + 1) % IPC_TX_QUEUE_SIZE;
+    IPC_TxRecord_t *record = ipc_txRecordAt(lane, offset);
+    record->payloadLen = len;
+    record->msgType = ipcDriver.txReserveMsgType;
+    record->queuedAt = micros();
+    
+    uint16_t size = ipc_txRecordSize(len);
+    lane->head = (offset + size) % lane->size;
+    lane->used += size;
+    lane->count++;
+    
+    if (lane->used > lane->highWater) {
+        lane->highWater = lane->used;
+    }
+    if (lane->count > lane->peak) {
+        lane->peak = lane->count;
+    }
+    uint16_t ringUsed = ipcDriver.txLane[IPC_TX_LANE_CONTROL].used + ipcDriver.txLane[IPC_TX_LANE_BULK].used;
+    if (ringUsed > ipcDriver.txHighWater) {
+        ipcDriver.txHighWater = ringUsed;
+    }
     
     #if IPC_DEBUG_ENABLED
-    Serial.printf("[IPC TX] Packet queued (head=%u, tail=%u)\n", ipcDriver.txQueueHead, ipcDriver.txQueueTail);
+    Serial.printf("[IPC TX] Packet queued on lane %u (%u queued, %u/%u bytes)\n",
+                  ipcDriver.txReserveLane, lane->count, lane->used, lane->size);
     #endif
     return true;
 }
 
-bool ipc_processTxQueue(void) {
-    // Check if queue is empty
-    if (ipcDriver.txQueueHead == ipcDriver.txQueueTail) {
+bool ipc_txNotifyWhenFree(uint8_t msgType, uint16_t len, IPC_TxSpaceCallback_t callback) {
+    if (callback == nullptr) {
         return false;
     }
-    
-    #if IPC_DEBUG_ENABLED
-    Serial.printf("[IPC TX] Processing TX queue (head=%u, tail=%u)\n", 
-                 ipcDriver.txQueueHead, ipcDriver.txQueueTail);
-    #endif
-    
-    // Get packet from queue
-    IPC_TxPacket_t *packet = &ipcDriver.txQueue[ipcDriver.txQueueTail];
-    
+    for (uint8_t i = 0; i < ipcDriver.txWaiterCount; i++) {
+        if (ipcDriver.txWaiters[i].callback == callback) {
+            ipcDriver.txWaiters[i].msgType = msgType;
+            ipcDriver.txWaiters[i].len = len;
+            return true;
+        }
+    }
+    if (ipcDriver.txWaiterCount >= IPC_TX_MAX_WAITERS) {
+        return false;
+    }
+    ipcDriver.txWaiters[ipcDriver.txWaiterCount].callback = callback;
+    ipcDriver.txWaiters[ipcDriver.txWaiterCount].msgType = msgType;
+    ipcDriver.txWaiters[ipcDriver.txWaiterCount].len = len;
+    ipcDriver.txWaiterCount++;
+    return true;
+}
+
+// Run waiters whose space is now available (oldest first)
+static void ipc_serviceTxWaiters(void) {
+    uint8_t i = 0;
+    while (i < ipcDriver.txWaiterCount) {
+        IPC_TxWaiter_t waiter = ipcDriver.txWaiters[i];
+        if (!ipc_txQueueHasSpace(waiter.msgType, waiter.len)) {
+            i++;
+            continue;
+        }
+        // Remove before calling - the callback may register again
+        for (uint8_t j = i; j + 1 < ipcDriver.txWaiterCount; j++) {
+            ipcDriver.txWaiters[j] = ipcDriver.txWaiters[j + 1];
+        }
+        ipcDriver.txWaiterCount--;
+        waiter.callback();
+    }
+}
+
+bool ipc_sendPacket(uint8_t msgType, const uint8_t *payload, uint16_t len) {
     #if IPC_DEBUG_ENABLED
-    Serial.printf("[IPC TX] Sending msgType=0x%02X, payloadLen=%u\n", 
-                 packet->msgType, packet->payloadLen);
+    Serial.printf("[IPC TX] sendPacket called: msgType=0x%02X, len=%u\n", msgType, len);
     #endif
     
-    // Build packet buffer
-    uint8_t txBuffer[IPC_MAX_PACKET_SIZE * 2];  // Extra space for byte stuffing
-    uint16_t bufferPos = 0;
-    
-    // Start byte
-    txBuffer[bufferPos++] = IPC_START_BYTE;
+    uint8_t *slot = ipc_txReserve(msgType, len);
+    if (slot == nullptr) {
+        return false;
+    }
+    if (len > 0 && payload != nullptr) {
+        memcpy(slot, payload, len);
+    }
+    return ipc_txCommit(len);
+}
+
+// Write one frame byte, escaping START/END/ESC. Caller guarantees *room > 0.
+// If only the escape fits, the second byte is parked for the next call.
+static inline void ipc_txPutStuffed(HardwareSerial *uart, uint8_t byte, int *room) {
+    if (byte == IPC_START_BYTE || byte == IPC_ESCAPE_BYTE) {
+        uart->write((uint8_t)IPC_ESCAPE_BYTE);
+        byte ^= IPC_ESCAPE_XOR;
+        if (--(*room) == 0) {
+            ipcDriver.txEscapedByte = byte;
+            ipcDriver.txEscapePending = true;
+            return;
+        }
+    }
+    uart->write(byte);
+    (*room)--;
+}
+
+// Baud rate change in progress and the peer is not listening at our rate
+static inline bool ipc_baudHoldsTx(void) {
+    return ipcDriver.baudState == IPC_BAUD_DRAINING ||
+           ipcDriver.baudState == IPC_BAUD_REVERTING ||
+           (ipcDriver.baudState == IPC_BAUD_VERIFY && !ipcDriver.baudTestSeen);
+}
+
+bool ipc_processTxQueue(void) {
+    IPC_TxLane_t *control = &ipcDriver.txLane[IPC_TX_LANE_CONTROL];
+    IPC_TxLane_t *bulk = &ipcDriver.txLane[IPC_TX_LANE_BULK];
     
-    // Calculate CRC over LENGTH + MSG_TYPE + PAYLOAD (NOT CRC)
-    uint8_t crcData[3 + IPC_MAX_PAYLOAD_SIZE];
-    uint16_t crcDataLen = 0;
+    // Pick the lane at a frame boundary: control first, but let one bulk frame
+    // through after a burst of control frames so telemetry is never starved
+    if (ipcDriver.txFramePos == 0) {
+        if (ipc_baudHoldsTx()) {
+            return false;
+        }
+        if (control->count > 0 &&
+            (bulk->count == 0 || ipcDriver.txControlBurst < IPC_TX_CONTROL_BURST)) {
+            ipcDriver.txActiveLane = IPC_TX_LANE_CONTROL;
+        } else if (bulk->count > 0) {
+            ipcDriver.txActiveLane = IPC_TX_LANE_BULK;
+        } else {
+            return false;  // Queue empty
+        }
+    }
     
-    // LENGTH = size of (MSG_TYPE (1) + PAYLOAD (N))
-    // NOTE: Length field itself and CRC are NOT included in length value
-    uint16_t totalLength = 1 + packet->payloadLen;
+    IPC_TxLane_t *lane = &ipcDriver.txLane[ipcDriver.txActiveLane];
+    IPC_TxRecord_t *packet = ipc_txRecordAt(lane, lane->tail);
+    if (packet->payloadLen == IPC_TX_RECORD_WRAP) {
+        // Skip unused space at the lane end
+        lane->used -= lane->size - lane->tail;
+        lane->tail = 0;
+        packet = ipc_txRecordAt(lane, 0);
+    }
+    const uint8_t *payload = (const uint8_t*)(packet + 1);
+    HardwareSerial *uart = ipcDriver.uart;
     
-    // LENGTH (big-endian)
-    crcData[crcDataLen++] = (totalLength >> 8) & 0xFF;
-    crcData[crcDataLen++] = totalLength & 0xFF;
+    // Unstuffed frame layout: START | LEN_H LEN_L | MSG_TYPE | PAYLOAD | CRC_H CRC_L | END
+    // LENGTH = size of (MSG_TYPE (1) + PAYLOAD (N)); CRC covers LENGTH + MSG_TYPE + PAYLOAD
+    const uint16_t payloadPos = 4;
+    const uint16_t crcPos = payloadPos + packet->payloadLen;
+    const uint16_t endPos = crcPos + 2;
     
-    // MSG_TYPE
-    crcData[crcDataLen++] = packet->msgType;
+    // Never block: only write what the UART TX buffer can take right now
+    int room = uart->availableForWrite();
+    if (room <= 0) {
+        return false;
+    }
+    const int startRoom = room;
     
-    // PAYLOAD
-    if (packet->payloadLen > 0) {
-        memcpy(&crcData[crcDataLen], packet->payload, packet->payloadLen);
-        crcDataLen += packet->payloadLen;
+    if (ipcDriver.txEscapePending) {
+        uart->write(ipcDriver.txEscapedByte);
+        ipcDriver.txEscapePending = false;
+        room--;
     }
     
-    // Calculate CRC
-    uint16_t crc = ipc_calcCRC16(crcData, crcDataLen);
+    uint16_t pos = ipcDriver.txFramePos;
+    uint16_t crc = ipcDriver.txCrc;
     
-    // Add LENGTH, MSG_TYPE, PAYLOAD, CRC with byte stuffing
-    for (uint16_t i = 0; i < crcDataLen; i++) {
-        uint8_t byte = crcData[i];
-        if (byte == IPC_START_BYTE || byte == IPC_ESCAPE_BYTE) {
-            txBuffer[bufferPos++] = IPC_ESCAPE_BYTE;
-            txBuffer[bufferPos++] = byte ^ IPC_ESCAPE_XOR;
+    // START + header
+    while (pos < payloadPos && room > 0) {
+        if (pos == 0) {
+            uart->write((uint8_t)IPC_START_BYTE);
+            room--;
+            crc = IPC_CRC16_INIT;
         } else {
-            txBuffer[bufferPos++] = byte;
+            uint16_t totalLength = 1 + packet->payloadLen;
+            uint8_t byte = (pos == 1) ? (uint8_t)(totalLength >> 8) :
+                           (pos == 2) ? (uint8_t)(totalLength & 0xFF) : packet->msgType;
+            crc = ipc_crc16_byte(crc, byte);
+            ipc_txPutStuffed(uart, byte, &room);
         }
+        pos++;
     }
     
-    // Add CRC (big-endian) with byte stuffing
-    uint8_t crcBytes[2];
-    crcBytes[0] = (crc >> 8) & 0xFF;
-    crcBytes[1] = crc & 0xFF;
-    
-    for (uint8_t i = 0; i < 2; i++) {
-        uint8_t byte = crcBytes[i];
-        if (byte == IPC_START_BYTE || byte == IPC_ESCAPE_BYTE) {
-            txBuffer[bufferPos++] = IPC_ESCAPE_BYTE;
-            txBuffer[bufferPos++] = byte ^ IPC_ESCAPE_XOR;
-        } else {
-            txBuffer[bufferPos++] = byte;
+    // Payload straight from the ring, CRC folded in as each byte is stuffed
+    if (pos >= payloadPos && pos < crcPos) {
+        const uint8_t *src = &payload[pos - payloadPos];
+        while (pos < crcPos && room > 0) {
+            uint8_t byte = *src++;
+            crc = ipc_crc16_byte(crc, byte);
+            ipc_txPutStuffed(uart, byte, &room);
+            pos++;
         }
     }
     
+    // CRC (big-endian)
+    while (pos >= crcPos && pos < endPos && room > 0) {
+        uint8_t byte = (pos == crcPos) ? (uint8_t)(crc >> 8) : (uint8_t)(crc & 0xFF);
+        ipc_txPutStuffed(uart, byte, &room);
+        pos++;
+    }
+    
     // End byte
-    txBuffer[bufferPos++] = IPC_END_BYTE;
+    if (pos == endPos && room > 0) {
+        uart->write((uint8_t)IPC_END_BYTE);
+        room--;
+        pos++;
+    }
     
-    // Packet sent successfully (debug logging removed for clarity)
+    ipcDriver.txWireBytes += startRoom - room;
     
-    // Send packet
-    ipcDriver.uart->write(txBuffer, bufferPos);
+    if (pos <= endPos || ipcDriver.txEscapePending) {
+        // UART buffer full - resume from here on the next call
+        ipcDriver.txFramePos = pos;
+        ipcDriver.txCrc = crc;
+        return false;
+    }
+    
+    ipcDriver.txFramePos = 0;
     
     // Update statistics
     ipcDriver.txPacketCount++;
     // NOTE: Do NOT update lastActivity here - only RX should update it
     // Otherwise timeout detection won't work (sending keeps connection "alive")
     
-    // Advance tail
-    ipcDriver.txQueueTail = (ipcDriver.txQueueTail + 1) % IPC_TX_QUEUE_SIZE;
+    // Queue latency (commit to last byte handed to the UART)
+    uint32_t latency = micros() - packet->queuedAt;
+    if (latency > lane->latencyMaxUs) {
+        lane->latencyMaxUs = latency;
+    }
+    lane->latencyAvgUs = lane->latencyAvgUs - (lane->latencyAvgUs >> 4) + (latency >> 4);
+    
+    if (ipcDriver.txActiveLane == IPC_TX_LANE_CONTROL) {
+        ipcDriver.txControlBurst = (bulk->count > 0) ? ipcDriver.txControlBurst + 1 : 0;
+    } else {
+        ipcDriver.txControlBurst = 0;
+    }
+    
+    // Accepted baud rate change: nothing else goes out at the old rate
+    if (packet->msgType == IPC_MSG_BAUD_SWITCH_ACK && ipcDriver.baudState == IPC_BAUD_ACK_QUEUED &&
+        ((const IPC_BaudSwitchAck_t*)payload)->accepted) {
+        ipcDriver.baudState = IPC_BAUD_DRAINING;
+    }
+    
+    // Release the record (it stays owned by the encoder until the last byte is written)
+    uint16_t size = ipc_txRecordSize(packet->payloadLen);
+    lane->tail = (lane->tail + size) % lane->size;
+    lane->used -= size;
+    lane->count--;
+    
+    // Empty - restart at offset 0 so the next records get the longest contiguous run
+    if (lane->count == 0) {
+        lane->head = 0;
+        lane->tail = 0;
+        lane->used = 0;
+    }
     
     return true;
 }
 
+// ============================================================================
+// BULK RESPONSE STREAMING
+// ============================================================================
+
+bool ipc_queueBulkResponse(uint16_t transactionId, uint16_t startIndex, uint16_t count,
+                           uint8_t mode, bool resync) {
+    if (ipcDriver.bulkQueueCount >= IPC_BULK_QUEUE_SIZE) {
+        return false;
+    }
+    
+    uint8_t slot = (ipcDriver.bulkQueueHead + ipcDriver.bulkQueueCount) % IPC_BULK_QUEUE_SIZE;
+    IPC_BulkCursor_t *cursor = &ipcDriver.bulkQueue[slot];
+    cursor->transactionId = transactionId;
+    cursor->startIndex = startIndex;
+    cursor->nextIndex = startIndex;
+    cursor->endIndex = startIndex + count;
+    cursor->mode = mode;
+    cursor->resync = resync;
+    ipcDriver.bulkQueueCount++;
+    
+    // Resync: forget what was sent so every object in range is encoded in full
+    if (mode == IPC_BULK_MODE_DELTA && resync) {
+        memset(&ipcDriver.deltaShadow[startIndex], 0, count * sizeof(IPC_DeltaShadow_t));
+    }
+    
+    return true;
+}
+
+// Pack changed objects into one SENSOR_DELTA frame, advancing the cursor
+// Records are encoded directly into the reserved TX slot
+static bool ipc_sendDeltaFrame(IPC_BulkCursor_t *cursor) {
+    uint8_t *frame = ipc_txReserve(IPC_MSG_SENSOR_DELTA, IPC_MAX_PAYLOAD_SIZE);
+    if (frame == nullptr) {
+        return false;
+    }
+    
+    uint16_t pos = sizeof(IPC_SensorDeltaHeader_t);
+    uint16_t index = cursor->nextIndex;
+    uint8_t records = 0;
+    
+    while (index < cursor->endIndex && records < 255 &&
+           (IPC_MAX_PAYLOAD_SIZE - pos) >= IPC_DELTA_MAX_RECORD_SIZE) {
+        uint16_t written = ipc_encodeSensorDelta(index, &frame[pos], IPC_MAX_PAYLOAD_SIZE - pos);
+        if (written > 0) {
+            pos += written;
+            records++;
+        }
+        index++;
+    }
+    
+    IPC_SensorDeltaHeader_t header;
+    header.transactionId = cursor->transactionId;
+    header.sequence = ipcDriver.deltaSequence;
+    header.flags = (index >= cursor->endIndex) ? IPC_DELTA_FLAG_FINAL : 0;
+    if (cursor->resync) header.flags |= IPC_DELTA_FLAG_FULL;
+    header.startIndex = cursor->startIndex;
+    header.count = cursor->endIndex - cursor->startIndex;
+    header.recordCount = records;
+    memcpy(frame, &header, sizeof(header));
+    
+    ipc_txCommit(pos);
+    
+    ipcDriver.deltaSequence++;
+    cursor->nextIndex = index;
+    return true;
+}
+
+void ipc_serviceBulkResponse(void) {
+    while (ipcDriver.bulkQueueCount > 0) {
+        IPC_BulkCursor_t *cursor = &ipcDriver.bulkQueue[ipcDriver.bulkQueueHead];
+        
+        // Emit frames only while the bulk lane has room (control traffic has its own lane)
+        uint8_t msgType = (cursor->mode == IPC_BULK_MODE_DELTA) ? IPC_MSG_SENSOR_DELTA : IPC_MSG_SENSOR_DATA;
+        uint16_t frameLen = (cursor->mode == IPC_BULK_MODE_DELTA) ? IPC_MAX_PAYLOAD_SIZE
+                                                                  : sizeof(IPC_SensorData_t);
+        while (cursor->nextIndex < cursor->endIndex) {
+            if (!ipc_txQueueHasSpace(msgType, frameLen)) {
+                return;  // Resume on next ipc_update()
+            }
+            if (cursor->mode == IPC_BULK_MODE_DELTA) {
+                if (!ipc_sendDeltaFrame(cursor)) {
+                    return;
+                }
+            } else {
+                // Unused indices are skipped (no response, as before)
+                ipc_sendSensorData(cursor->nextIndex, cursor->transactionId);
+                cursor->nextIndex++;
+            }
+        }
+        
+        // Range complete - pop it and return the window slot
+        if (!ipc_txQueueHasSpace(IPC_MSG_BULK_CREDIT, sizeof(IPC_BulkCredit_t))) {
+            return;
+        }
+        uint16_t transactionId = cursor->transactionId;
+        ipcDriver.bulkQueueHead = (ipcDriver.bulkQueueHead + 1) % IPC_BULK_QUEUE_SIZE;
+        ipcDriver.bulkQueueCount--;
+        ipc_sendBulkCredit(transactionId, IPC_BULK_CREDIT_DONE);
+    }
+}
+
+bool ipc_sendBulkCredit(uint16_t transactionId, uint8_t status) {
+    IPC_BulkCredit_t credit;
+    credit.transactionId = transactionId;
+    credit.status = status;
+    credit.credit = IPC_BULK_QUEUE_SIZE - ipcDriver.bulkQueueCount;
+    
+    return ipc_sendPacket(IPC_MSG_BULK_CREDIT, (uint8_t*)&credit, sizeof(credit));
+}
+
+void ipc_clearBulkQueue(void) {
+    ipcDriver.bulkQueueHead = 0;
+    ipcDriver.bulkQueueCount = 0;
+}
+
+// ============================================================================
+// SENSOR STREAM SUBSCRIPTIONS
+// ============================================================================
+
+// Due objects are packed into one SENSOR_DELTA frame per call, so a push costs
+// a few bytes per object rather than a full SENSOR_DATA frame
+void ipc_serviceSensorStream(void) {
+    if (ipcDriver.streamCount == 0 || ipcDriver.connectionState != IPC_CONN_CONNECTED) {
+        return;
+    }
+    if (!ipc_txQueueHasSpace(IPC_MSG_SENSOR_DELTA, IPC_MAX_PAYLOAD_SIZE)) {
+        return;  // Resume from streamScanPos on next ipc_update()
+    }
+    uint8_t *frame = ipc_txReserve(IPC_MSG_SENSOR_DELTA, IPC_MAX_PAYLOAD_SIZE);
+    if (frame == nullptr) {
+        return;
+    }
+    
+    uint32_t now = millis();
+    uint16_t pos = sizeof(IPC_SensorDeltaHeader_t);
+    uint8_t records = 0;
+    
+    // Round-robin so a full frame does not always favour low indices
+    for (uint16_t scanned = 0; scanned < MAX_NUM_OBJECTS; scanned++) {
+        if (records == 255 || (IPC_MAX_PAYLOAD_SIZE - pos) < IPC_DELTA_MAX_RECORD_SIZE) {
+            break;  // Frame full - the rest goes out on the next ipc_update()
+        }
+        
+        uint16_t index = ipcDriver.streamScanPos;
+        ipcDriver.streamScanPos = (ipcDriver.streamScanPos + 1) % MAX_NUM_OBJECTS;
+        
+        IPC_StreamEntry_t *entry = &ipcDriver.stream[index];
+        if (!entry->subscribed) {
+            continue;
+        }
+        
+        uint32_t elapsed = now - entry->lastSent;
+        if (entry->primed && elapsed < entry->minIntervalMs) {
+            continue;
+        }
+        
+        // First push and heartbeat go out even if nothing moved (keeps the
+        // SYS MCU cache from going stale); removals are sent once
+        bool heartbeat = !entry->primed ||
+                         (entry->maxIntervalMs != 0 && elapsed >= entry->maxIntervalMs);
+        uint16_t written = ipc_encodeSensorStream(index, entry, heartbeat, &frame[pos],
+                                                  IPC_MAX_PAYLOAD_SIZE - pos);
+        if (written == 0) {
+            continue;
+        }
+        
+        pos += written;
+        records++;
+        entry->primed = true;
+        entry->lastSent = now;
+    }
+    
+    if (records == 0) {
+        return;  // Reserved slot is simply not committed
+    }
+    
+    IPC_SensorDeltaHeader_t header;
+    header.transactionId = IPC_TXN_NONE;
+    header.sequence = ipcDriver.deltaSequence;
+    header.flags = 0;  // Not FINAL: unsent objects are not confirmed
+    header.startIndex = 0;
+    header.count = 0;
+    header.recordCount = records;
+    memcpy(frame, &header, sizeof(header));
+    
+    ipc_txCommit(pos);
+    ipcDriver.deltaSequence++;
+}
+
+void ipc_clearSensorStreams(void) {
+    memset(ipcDriver.stream, 0, sizeof(ipcDriver.stream));
+    ipcDriver.streamCount = 0;
+    ipcDriver.streamScanPos = 0;
+}
+
 // ============================================================================
 // PACKET RECEPTION
 // ============================================================================
@@ -240,8 +663,14 @@ void ipc_processRxByte(uint8_t byte) {
                 return;
             }
             
-            // Handle end byte
+            // Handle end byte. Back-to-back flags are one frame boundary: an
+            // END taken for a START (after line noise or a baud rate change)
+            // must not shift every following frame by one flag.
             if (byte == IPC_END_BYTE && !ipcDriver.escapeNext) {
+                if (ipcDriver.rxBufferPos == 0) {
+                    ipcDriver.rxStartTime = now;
+                    return;
+                }
                 ipcDriver.state = IPC_STATE_PROCESSING;
                 return;
             }
@@ -340,6 +769,185 @@ void ipc_processReceivedPacket(void) {
     ipcDriver.state = IPC_STATE_IDLE;
 }
 
+// ============================================================================
+// LINK QUALITY
+// ============================================================================
+
+// Rates over the window just ended, RTT percentiles over the sample ring
+static void ipc_closeLinkWindow(uint32_t now) {
+    IPC_LinkStats_t *link = &ipcDriver.link;
+    uint32_t elapsed = now - ipcDriver.linkWindowStart;
+    
+    link->rxBytesPerSec = (ipcDriver.rxWireBytes - ipcDriver.linkWindowRxBytes) * 1000ULL / elapsed;
+    link->txBytesPerSec = (ipcDriver.txWireBytes - ipcDriver.linkWindowTxBytes) * 1000ULL / elapsed;
+    link->rxFramesPerSec = (ipcDriver.rxPacketCount - ipcDriver.linkWindowRxFrames) * 1000ULL / elapsed;
+    link->txFramesPerSec = (ipcDriver.txPacketCount - ipcDriver.linkWindowTxFrames) * 1000ULL / elapsed;
+    link->rxUtilPermille = link->rxBytesPerSec * 10000ULL / ipcDriver.baudRate;  // 10 bits per byte
+    link->txUtilPermille = link->txBytesPerSec * 10000ULL / ipcDriver.baudRate;
+    if (link->rxUtilPermille > link->rxUtilPeakPermille) link->rxUtilPeakPermille = link->rxUtilPermille;
+    if (link->txUtilPermille > link->txUtilPeakPermille) link->txUtilPeakPermille = link->txUtilPermille;
+    
+    link->rxFrames = ipcDriver.rxPacketCount;
+    link->rxErrors = ipcDriver.rxErrorCount;
+    link->crcErrors = ipcDriver.crcErrorCount;
+    uint32_t seen = ipcDriver.rxPacketCount + ipcDriver.rxErrorCount;
+    link->rxErrorPpm = seen ? (uint32_t)(ipcDriver.rxErrorCount * 1000000ULL / seen) : 0;
+    link->baudRate = ipcDriver.baudRate;
+    link->txQueueHighWater = ipcDriver.txHighWater;
+    link->txQueueSize = IPC_TX_RING_SIZE;
+    link->rxBacklogHighWater = ipcDriver.rxBacklogHighWater;
+    
+    // Insertion sort of at most IPC_RTT_SAMPLES values, once per window
+    uint32_t sorted[IPC_RTT_SAMPLES];
+    uint8_t n = ipcDriver.rttCount;
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t v = ipcDriver.rttSample[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    link->rttSamples = n;
+    link->rttP50Us = n ? sorted[(n - 1) / 2] : 0;
+    link->rttP90Us = n ? sorted[(n - 1) * 9 / 10] : 0;
+    link->rttMaxUs = n ? sorted[n - 1] : 0;
+    
+    ipcDriver.linkWindowStart = now;
+    ipcDriver.linkWindowRxBytes = ipcDriver.rxWireBytes;
+    ipcDriver.linkWindowTxBytes = ipcDriver.txWireBytes;
+    ipcDriver.linkWindowRxFrames = ipcDriver.rxPacketCount;
+    ipcDriver.linkWindowTxFrames = ipcDriver.txPacketCount;
+}
+
+void ipc_linkPing(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_Ping_t)) {
+        ipcDriver.pingEcho = 0;  // Plain keepalive
+        return;
+    }
+    const IPC_Ping_t *ping = (const IPC_Ping_t*)payload;
+    ipcDriver.pingEcho = ping->timestampUs;
+    ipcDriver.peerLink = ping->link;
+    ipcDriver.peerLinkTime = millis();
+}
+
+void ipc_linkPong(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_Pong_t)) {
+        return;
+    }
+    const IPC_Pong_t *pong = (const IPC_Pong_t*)payload;
+    if (pong->echoTimestampUs != 0) {
+        ipcDriver.rttSample[ipcDriver.rttNext] = micros() - pong->echoTimestampUs;
+        ipcDriver.rttNext = (ipcDriver.rttNext + 1) % IPC_RTT_SAMPLES;
+        if (ipcDriver.rttCount < IPC_RTT_SAMPLES) ipcDriver.rttCount++;
+    }
+    ipcDriver.peerLink = pong->link;
+    ipcDriver.peerLinkTime = millis();
+}
+
+const IPC_LinkStats_t *ipc_getLinkStats(void) {
+    return &ipcDriver.link;
+}
+
+// ============================================================================
+// BAUD RATE CHANGE
+// ============================================================================
+
+// Re-open Serial1 at another rate. Callers make sure the TX buffer has
+// drained; anything half received at the old rate is dropped.
+static void ipc_applyBaud(uint32_t baud) {
+    ipcDriver.uart->flush();
+    ipcDriver.uart->end();
+    ipcDriver.uart->begin(baud);
+    ipcDriver.baudRate = baud;
+    ipcDriver.txIdleRoom = ipcDriver.uart->availableForWrite();
+    ipc_clearRxBuffer();
+    ipcDriver.state = IPC_STATE_IDLE;
+}
+
+static bool ipc_baudSupported(uint32_t baud) {
+    for (uint8_t i = 0; i < IPC_BAUD_RATE_COUNT; i++) {
+        if (ipc_baudRates[i] == baud) {
+            return (IPC_BAUD_SUPPORTED & (1u << i)) != 0;
+        }
+    }
+    return false;
+}
+
+void ipc_baudSwitch(const IPC_BaudSwitch_t *request) {
+    IPC_BaudSwitchAck_t *ack = (IPC_BaudSwitchAck_t*)ipc_txReserve(IPC_MSG_BAUD_SWITCH_ACK, sizeof(IPC_BaudSwitchAck_t));
+    if (ack == nullptr) {
+        return;  // SYS MCU times out and stays at the current rate
+    }
+    bool accepted = ipc_baudSupported(request->baudRate) && request->baudRate != ipcDriver.baudRate &&
+                    ipcDriver.baudState == IPC_BAUD_IDLE;
+    ack->baudRate = request->baudRate;
+    ack->accepted = accepted;
+    ipc_txCommit(sizeof(IPC_BaudSwitchAck_t));
+    
+    if (!accepted) {
+        Serial.printf("[IPC] Refused link rate %lu baud\n", request->baudRate);
+        return;
+    }
+    ipcDriver.baudTarget = request->baudRate;
+    ipcDriver.baudState = IPC_BAUD_ACK_QUEUED;
+    Serial.printf("[IPC] Switching link to %lu baud (%s)\n", request->baudRate,
+                  request->reason == IPC_BAUD_REASON_FALLBACK ? "error rate fallback" : "negotiated");
+}
+
+bool ipc_baudLinkTest(const IPC_LinkTest_t *test) {
+    if (ipcDriver.baudState == IPC_BAUD_IDLE && (test->flags & IPC_LINK_TEST_COMMIT) &&
+        test->baudRate == ipcDriver.baudRate) {
+        return true;  // Commit resent because our echo was lost
+    }
+    if (ipcDriver.baudState != IPC_BAUD_VERIFY || test->baudRate != ipcDriver.baudRate) {
+        return false;  // Not switching, or a test from an abandoned switch
+    }
+    ipcDriver.baudTestSeen = true;  // SYS MCU is listening at the new rate
+    if (test->flags & IPC_LINK_TEST_COMMIT) {
+        ipcDriver.baudState = IPC_BAUD_IDLE;
+        ipcDriver.baudSwitches++;
+        Serial.printf("[IPC] Link running at %lu baud\n", ipcDriver.baudRate);
+    }
+    return true;
+}
+
+// Baud rate change steps that wait on the UART or the clock
+static void ipc_serviceBaudSwitch(uint32_t now) {
+    bool drained = ipcDriver.txFramePos == 0 && !ipcDriver.txEscapePending &&
+                   ipcDriver.uart->availableForWrite() >= ipcDriver.txIdleRoom;
+    
+    switch (ipcDriver.baudState) {
+        case IPC_BAUD_DRAINING:
+            if (drained) {
+                ipcDriver.baudPrevious = ipcDriver.baudRate;
+                ipc_applyBaud(ipcDriver.baudTarget);
+                ipcDriver.baudSwitchTime = now;
+                ipcDriver.baudTestSeen = false;
+                ipcDriver.baudState = IPC_BAUD_VERIFY;
+            }
+            break;
+            
+        case IPC_BAUD_VERIFY:
+            if (now - ipcDriver.baudSwitchTime > IPC_BAUD_VERIFY_MS) {
+                ipcDriver.baudState = IPC_BAUD_REVERTING;
+            }
+            break;
+            
+        case IPC_BAUD_REVERTING:
+            if (drained) {
+                ipc_applyBaud(ipcDriver.baudPrevious);
+                ipcDriver.baudState = IPC_BAUD_IDLE;
+                ipcDriver.baudReverts++;
+                Serial.printf("[IPC] Link test not committed, back to %lu baud\n", ipcDriver.baudRate);
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
 // ============================================================================
 // UPDATE FUNCTION
 // ============================================================================
@@ -362,8 +970,13 @@ void ipc_update(void) {
     }
     
     // Process RX bytes
+    int backlog = ipcDriver.uart->available();
+    if (backlog > ipcDriver.rxBacklogHighWater) {
+        ipcDriver.rxBacklogHighWater = backlog;
+    }
     while (ipcDriver.uart->available()) {
         uint8_t byte = ipcDriver.uart->read();
+        ipcDriver.rxWireBytes++;
         ipc_processRxByte(byte);
         
         // If we're in PROCESSING state, handle the packet
@@ -378,31 +991,38 @@ void ipc_update(void) {
         }
     }
     
-    // Process TX queue
-    if (ipc_txQueueCount() > 0) {
-        ipc_processTxQueue();
+    // Generate pending bulk response frames into free TX slots
+    ipc_serviceBulkResponse();
+    
+    // Push changed values for subscribed objects
+    ipc_serviceSensorStream();
+    
+    // Process TX queue within a per-call time budget so bulk responses are
+    // spread across scheduler cycles instead of stalling other tasks.
+    // Frames stream into the UART buffer as it drains; a partial frame resumes next call.
+    // Stop as soon as the UART buffer is full rather than spinning out the budget.
+    uint32_t txStart = micros();
+    while (ipc_txQueueCount() > 0) {
+        if (!ipc_processTxQueue()) {
+            break;
+        }
+        ipc_serviceBulkResponse();
+        if ((micros() - txStart) >= IPC_TX_BUDGET_US) {
+            break;
+        }
     }
     
-    // Set bulkJustFinished flag when counter reaches 0
-    // Counter is now managed by bulk handler itself (decrements when each bulk completes)
-    static uint8_t lastBulkCounter = 0;
-    if (ipcDriver.bulkResponseInProgress == 0 && lastBulkCounter > 0 && !ipcDriver.bulkJustFinished) {
-        // Counter just reached zero
-        ipcDriver.bulkJustFinished = true;
-        Serial.println("[IPC] Bulk cycle complete, waiting one update cycle before processing ACKs");
-        Serial.flush();
+    // Producers deferred on TX space
+    if (ipcDriver.txWaiterCount > 0) {
+        ipc_serviceTxWaiters();
     }
-    lastBulkCounter = ipcDriver.bulkResponseInProgress;
     
-    // Process deferred ACKs
-    if (ipcDriver.deferredAckCount > 0) {
-        ipc_processDeferredAcks();
+    if (ipcDriver.baudState != IPC_BAUD_IDLE) {
+        ipc_serviceBaudSwitch(now);
     }
     
-    // Clear grace period flag AFTER attempting to process ACKs
-    if (ipcDriver.bulkJustFinished) {
-        ipcDriver.bulkJustFinished = false;
-        Serial.println("[IPC] Bulk grace period cleared");
+    if (now - ipcDriver.linkWindowStart >= IPC_LINK_WINDOW_MS) {
+        ipc_closeLinkWindow(now);
     }
     
     // Send keepalive ping if connected
@@ -425,8 +1045,17 @@ void ipc_update(void) {
                 Serial.printf("[IPC] Connection timeout (%lu ms since last activity), returning to disconnected state\n", timeSinceActivity);
                 ipcDriver.connectionState = IPC_CONN_DISCONNECTED;
                 ipcDriver.connected = false;
+                ipc_clearBulkQueue();              // Peer is gone, drop stale bulk responses
+                ipc_clearSensorStreams();
                 ipcDriver.lastHelloBroadcast = 0;  // Reset to trigger immediate broadcast
                 ipcDriver.lastActivity = now;      // Reset activity timestamp for fresh start
+                
+                // The handshake always runs at the default rate
+                ipcDriver.baudState = IPC_BAUD_IDLE;
+                if (ipcDriver.baudRate != IPC_BAUD_DEFAULT) {
+                    ipc_applyBaud(IPC_BAUD_DEFAULT);
+                    Serial.printf("[IPC] Link back to %lu baud\n", ipcDriver.baudRate);
+                }
             }
         }
     }
@@ -437,11 +1066,19 @@ void ipc_update(void) {
 // ============================================================================
 
 bool ipc_sendPing(void) {
-    return ipc_sendPacket(IPC_MSG_PING, nullptr, 0);
+    IPC_Ping_t *ping = (IPC_Ping_t*)ipc_txReserve(IPC_MSG_PING, sizeof(IPC_Ping_t));
+    if (ping == nullptr) return false;
+    ping->link = ipcDriver.link;
+    ping->timestampUs = micros() | 1;  // 0 means no timestamp
+    return ipc_txCommit(sizeof(IPC_Ping_t));
 }
 
 bool ipc_sendPong(void) {
-    return ipc_sendPacket(IPC_MSG_PONG, nullptr, 0);
+    IPC_Pong_t *pong = (IPC_Pong_t*)ipc_txReserve(IPC_MSG_PONG, sizeof(IPC_Pong_t));
+    if (pong == nullptr) return false;
+    pong->echoTimestampUs = ipcDriver.pingEcho;
+    pong->link = ipcDriver.link;
+    return ipc_txCommit(sizeof(IPC_Pong_t));
 }
 
 bool ipc_sendHello(void) {
@@ -449,11 +1086,19 @@ bool ipc_sendHello(void) {
     hello.protocolVersion = IPC_PROTOCOL_VERSION;
     hello.firmwareVersion = 0x00010000;  // v1.0.0 - TODO: Get from build system
     strcpy(hello.deviceName, "SAME51-IO-MCU");
+    hello.bulkWindow = IPC_BULK_QUEUE_SIZE;
+    ipc_getConfigDigest(&hello.configDigest);  // SYS MCU only re-pushes sections that differ
+    hello.baudRates = IPC_BAUD_SUPPORTED;
     
     return ipc_sendPacket(IPC_MSG_HELLO, (uint8_t*)&hello, sizeof(hello));
 }
 
 bool ipc_sendError(uint8_t errorCode, const char *message) {
+    if (ipc_configCapture(IPC_CONFIG_REC_ERROR)) {
+        Serial.printf("[IPC] Config record %u: %s\n", ipcDriver.configStage.current, message);
+        return true;
+    }
+    
     IPC_Error_t error;
     error.errorCode = errorCode;
     strncpy(error.message, message, sizeof(error.message) - 1);
@@ -464,105 +1109,56 @@ bool ipc_sendError(uint8_t errorCode, const char *message) {
 
 bool ipc_sendControlAckWithTxn(uint16_t transactionId, uint16_t index, uint8_t objectType,
                                 uint8_t command, bool success, uint8_t errorCode, const char *message) {
-    // ALWAYS defer config ACKs to avoid race condition with bulk requests
-    // The deferred queue will send them when it's truly safe (counter=0 AND no new requests starting)
-    
-    if (ipcDriver.deferredAckCount < 10) {
-        IPC_DeferredAck_t *ack = &ipcDriver.deferredAcks[ipcDriver.deferredAckCount++];
-        ack->transactionId = transactionId;
-        ack->index = index;
-        ack->objectType = objectType;
-        ack->command = command;
-        ack->success = success;
-        ack->errorCode = errorCode;
-        strncpy(ack->message, message, sizeof(ack->message) - 1);
-        ack->message[sizeof(ack->message) - 1] = '\0';
-        
-        // Store timestamp for delay calculation (rollover-safe)
-        ipcDriver.ackQueuedAt = millis();
-        
-        return true;  // Queued for later
-    } else {
-        Serial.println("[IPC] ERROR: Deferred ACK queue full! ACK will be lost!");
-        return false;  // Queue full - ACK lost
-    }
-}
-
-void ipc_processDeferredAcks(void) {
-    // Only process when bulk response counter is 0 AND TX queue is empty
-    // This ensures all bulk packets are transmitted before ACKs are sent
-    if (ipcDriver.bulkResponseInProgress > 0) {
-        return;
+    if (ipc_configCapture(success ? IPC_CONFIG_REC_OK : IPC_CONFIG_REC_FAILED)) {
+        return true;
     }
     
-    uint8_t queueCount = ipc_txQueueCount();
-    if (queueCount > 0) {
-        return;
+    // Control lane - goes out ahead of any queued bulk telemetry
+    IPC_ControlAck_t *ack = (IPC_ControlAck_t*)ipc_txReserve(IPC_MSG_CONTROL_ACK, sizeof(IPC_ControlAck_t));
+    if (ack == nullptr) {
+        Serial.println("[IPC] ERROR: TX control queue full! ACK will be lost!");
+        return false;
     }
     
-    // Don't process ACKs if bulk just finished - wait for next cycle
-    if (ipcDriver.bulkJustFinished) {
-        return;
-    }
+    ack->transactionId = transactionId;
+    ack->index = index;
+    ack->objectType = objectType;
+    ack->command = command;
+    ack->success = success;
+    ack->errorCode = errorCode;
+    strncpy(ack->message, message, sizeof(ack->message) - 1);
+    ack->message[sizeof(ack->message) - 1] = '\0';
     
-    // Don't process ACKs if still in time-based blocking period (rollover-safe)
-    if (ipcDriver.deferredAckCount > 0) {
-        uint32_t now = millis();
-        uint32_t elapsed = now - ipcDriver.ackQueuedAt;  // Rollover-safe subtraction
-        const uint32_t DELAY_MS = 20;
-        
-        if (elapsed < DELAY_MS) {
-            return;
-        }
-    }
-    
-    // Send all deferred ACKs
-    while (ipcDriver.deferredAckCount > 0) {
-        IPC_DeferredAck_t *ack = &ipcDriver.deferredAcks[0];
-        
-        IPC_ControlAck_t packet;
-        packet.transactionId = ack->transactionId;
-        packet.index = ack->index;
-        packet.objectType = ack->objectType;
-        packet.command = ack->command;
-        packet.success = ack->success;
-        packet.errorCode = ack->errorCode;
-        strncpy(packet.message, ack->message, sizeof(packet.message) - 1);
-        packet.message[sizeof(packet.message) - 1] = '\0';
-        
-        if (ipc_sendPacket(IPC_MSG_CONTROL_ACK, (uint8_t*)&packet, sizeof(packet))) {
-            // Shift queue down
-            for (uint8_t i = 0; i < ipcDriver.deferredAckCount - 1; i++) {
-                ipcDriver.deferredAcks[i] = ipcDriver.deferredAcks[i + 1];
-            }
-            ipcDriver.deferredAckCount--;
-        } else {
-            // TX queue full, try again next update
-            break;
-        }
-    }
+    return ipc_txCommit(sizeof(IPC_ControlAck_t));
 }
 
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
 
-bool ipc_txQueueHasSpace(void) {
-    uint8_t nextHead = (ipcDriver.txQueueHead + 1) % IPC_TX_QUEUE_SIZE;
-    return (nextHead != ipcDriver.txQueueTail);
+bool ipc_txQueueHasSpace(uint8_t msgType, uint16_t len) {
+    uint16_t offset, cost;
+    return len <= IPC_MAX_PAYLOAD_SIZE &&
+           ipc_txRingPlace(&ipcDriver.txLane[ipc_txLaneFor(msgType)], len, &offset, &cost);
 }
 
-uint8_t ipc_txQueueCount(void) {
-    if (ipcDriver.txQueueHead >= ipcDriver.txQueueTail) {
-        return ipcDriver.txQueueHead - ipcDriver.txQueueTail;
-    } else {
-        return IPC_TX_QUEUE_SIZE - ipcDriver.txQueueTail + ipcDriver.txQueueHead;
-    }
+uint16_t ipc_txQueueCount(void) {
+    return ipcDriver.txLane[IPC_TX_LANE_CONTROL].count + ipcDriver.txLane[IPC_TX_LANE_BULK].count;
+}
+
+uint16_t ipc_txQueueFree(uint8_t msgType) {
+    IPC_TxLane_t *lane = &ipcDriver.txLane[ipc_txLaneFor(msgType)];
+    return lane->size - lane->used;
 }
 
 void ipc_clearTxQueue(void) {
-    ipcDriver.txQueueHead = 0;
-    ipcDriver.txQueueTail = 0;
+    ipc_txInitLanes();
+    ipcDriver.txReserved = false;
+    
+    // Abandon any partly written frame (peer resyncs on the next START byte)
+    ipcDriver.txFramePos = 0;
+    ipcDriver.txEscapePending = false;
+    ipcDriver.txControlBurst = 0;
 }
 
 void ipc_clearRxBuffer(void) {
@@ -586,7 +1182,25 @@ void ipc_printStats(void) {
     Serial.printf("RX Errors: %u\n", ipcDriver.rxErrorCount);
     Serial.printf("TX Errors: %u\n", ipcDriver.txErrorCount);
     Serial.printf("CRC Errors: %u\n", ipcDriver.crcErrorCount);
-    Serial.printf("TX Queue: %u/%u\n", ipc_txQueueCount(), IPC_TX_QUEUE_SIZE);
+    for (uint8_t i = 0; i < IPC_TX_LANE_COUNT; i++) {
+        IPC_TxLane_t *lane = &ipcDriver.txLane[i];
+        Serial.printf("TX %s: %u packets, %u/%u bytes (peak %u packets, %u bytes, %u full)\n",
+                      i == IPC_TX_LANE_CONTROL ? "Control" : "Bulk", lane->count, lane->used,
+                      lane->size, lane->peak, lane->highWater, lane->fullCount);
+        Serial.printf("   Latency: avg %u us, max %u us\n", lane->latencyAvgUs, lane->latencyMaxUs);
+    }
+    const IPC_LinkStats_t *link = &ipcDriver.link;
+    Serial.printf("Link: RX %lu B/s (%u.%u%%, peak %u.%u%%), TX %lu B/s (%u.%u%%, peak %u.%u%%), %lu errors ppm\n",
+                  link->rxBytesPerSec, link->rxUtilPermille / 10, link->rxUtilPermille % 10,
+                  link->rxUtilPeakPermille / 10, link->rxUtilPeakPermille % 10,
+                  link->txBytesPerSec, link->txUtilPermille / 10, link->txUtilPermille % 10,
+                  link->txUtilPeakPermille / 10, link->txUtilPeakPermille % 10, link->rxErrorPpm);
+    Serial.printf("RTT: p50 %lu us, p90 %lu us, max %lu us (%u samples), RX backlog peak %u bytes\n",
+                  link->rttP50Us, link->rttP90Us, link->rttMaxUs, link->rttSamples, link->rxBacklogHighWater);
+    Serial.printf("Baud: %lu (%u switches, %u reverted)\n",
+                  ipcDriver.baudRate, ipcDriver.baudSwitches, ipcDriver.baudReverts);
+    Serial.printf("Bulk Queue: %u/%u\n", ipcDriver.bulkQueueCount, IPC_BULK_QUEUE_SIZE);
+    Serial.printf("Streamed Objects: %u\n", ipcDriver.streamCount);
     Serial.printf("Last Activity: %u ms ago\n", millis() - ipcDriver.lastActivity);
     if (ipcDriver.newMessage) {
         Serial.printf("Last Message: %s\n", ipcDriver.message);
@@ -8,6 +8,25 @@
 // Non-blocking UART communication between SAME51 and RP2040
 // ============================================================================
 
+// TX queue: variable-length records in a byte ring (same RAM as 8 fixed 1 KB slots)
+// split into a control lane (ACK/PONG/ERROR/FAULT...) and a bulk telemetry lane
+#define IPC_TX_RING_SIZE        (IPC_TX_QUEUE_SIZE * (IPC_MAX_PAYLOAD_SIZE + 4))
+#define IPC_TX_CONTROL_RING_SIZE 2048   // Control lane share of the ring (rest is bulk)
+#define IPC_TX_CONTROL_BURST    8       // Control frames sent back-to-back before one bulk frame
+#define IPC_TX_RECORD_WRAP      0xFFFF  // Record header payloadLen marking a skip to ring start
+#define IPC_TX_MAX_WAITERS      4       // Producers waiting on TX space (ipc_txNotifyWhenFree)
+
+// Bulk sensor response streaming
+#define IPC_BULK_QUEUE_SIZE     4     // Outstanding bulk/delta ranges (advertised to SYS MCU as bulkWindow)
+#define IPC_TX_BUDGET_US        1000  // Max time spent writing frames per ipc_update() call
+
+// Link rates Serial1 can run (bit n = ipc_baudRates[n]): its SERCOM is clocked
+// at 48 MHz with 16x oversampling, so 3 Mbps is the ceiling
+#define IPC_BAUD_SUPPORTED      0x03
+
+// Sensor stream subscriptions
+#define IPC_STREAM_MIN_INTERVAL_MS  10    // Lower bound applied to requested minIntervalMs
+
 // IPC driver state machine
 enum IPC_State : uint8_t {
     IPC_STATE_IDLE,
@@ -24,22 +43,123 @@ enum IPC_ConnectionState : uint8_t {
     IPC_CONN_CONNECTED         // Connected and operational
 };
 
-// TX packet queue entry
-struct IPC_TxPacket_t {
+// Link baud rate change (see IPC_BaudSwitch_t)
+enum IPC_BaudState : uint8_t {
+    IPC_BAUD_IDLE,             // Running at baudRate
+    IPC_BAUD_ACK_QUEUED,       // BAUD_SWITCH_ACK queued
+    IPC_BAUD_DRAINING,         // ACK written, TX held until the UART has sent it, then switch
+    IPC_BAUD_VERIFY,           // At the new rate: TX held until the first LINK_TEST, waiting for the commit
+    IPC_BAUD_REVERTING         // No commit in time: TX held until the UART drains, then switch back
+};
+
+// TX priority lanes (control is always dequeued first)
+enum IPC_TxLane : uint8_t {
+    IPC_TX_LANE_CONTROL,
+    IPC_TX_LANE_BULK,
+    IPC_TX_LANE_COUNT
+};
+
+// TX ring record header (payload follows, record padded to 4 bytes)
+struct IPC_TxRecord_t {
+    uint16_t payloadLen;      // IPC_TX_RECORD_WRAP = rest of ring unused, continue at 0
     uint8_t msgType;
-    uint16_t payloadLen;
-    uint8_t payload[IPC_MAX_PAYLOAD_SIZE];
+    uint8_t reserved;
+    uint32_t queuedAt;        // micros() at commit (queue latency statistics)
+};
+
+// One TX lane: a byte ring within ipcDriver.txRing
+struct IPC_TxLane_t {
+    uint16_t base;            // Offset of this lane in txRing
+    uint16_t size;            // Lane size in bytes
+    uint16_t head;            // Write offset (lane relative)
+    uint16_t tail;            // Read offset (record being encoded)
+    uint16_t used;            // Bytes in use, including skipped space at the lane end
+    uint16_t count;           // Records queued
+    
+    // Statistics
+    uint16_t highWater;       // Peak bytes in use
+    uint16_t peak;            // Peak records queued
+    uint32_t fullCount;       // Reservations refused for lack of space
+    uint32_t latencyAvgUs;    // Commit to last byte written (moving average)
+    uint32_t latencyMaxUs;
+};
+
+// Called once when the TX ring can take the requested payload
+typedef void (*IPC_TxSpaceCallback_t)(void);
+
+struct IPC_TxWaiter_t {
+    IPC_TxSpaceCallback_t callback;
+    uint8_t msgType;          // Selects the lane
+    uint16_t len;
 };
 
-// Deferred ACK queue entry (for config messages during bulk responses)
-struct IPC_DeferredAck_t {
+// Bulk response encoding
+enum IPC_BulkMode : uint8_t {
+    IPC_BULK_MODE_FULL,       // One IPC_SensorData_t frame per object
+    IPC_BULK_MODE_DELTA       // Changed objects packed into IPC_MSG_SENSOR_DELTA frames
+};
+
+// Bulk sensor response cursor (resumed on each ipc_update call)
+struct IPC_BulkCursor_t {
     uint16_t transactionId;
-    uint16_t index;           // Changed from uint8_t to match IPC_ControlAck_t
+    uint16_t startIndex;      // First object index of the request
+    uint16_t nextIndex;       // Next object index to emit
+    uint16_t endIndex;        // One past the last object index
+    uint8_t mode;             // IPC_BulkMode
+    bool resync;              // Delta mode: send every object in full
+};
+
+// Per-object state last sent in a SENSOR_DELTA record
+struct IPC_DeltaShadow_t {
+    bool valid;               // Object has been sent since last resync
     uint8_t objectType;
-    uint8_t command;
-    bool success;
-    uint8_t errorCode;
-    char message[100];
+    uint8_t flags;
+    uint8_t valueCount;
+    float value;
+    float additionalValues[4];
+    uint16_t unitCrc;
+    uint16_t extraUnitsCrc;
+    uint16_t msgCrc;
+};
+
+// Per-object sensor stream subscription
+// What was last pushed is the object's delta shadow (shared with SENSOR_DELTA_REQ)
+struct IPC_StreamEntry_t {
+    bool subscribed;
+    bool primed;              // At least one push has been sent
+    uint16_t minIntervalMs;
+    uint16_t maxIntervalMs;
+    float deadband;
+    float deadbandRel;
+    uint32_t lastSent;        // millis() of last push
+};
+
+// Configuration batch being received / applied (CONFIG_BEGIN .. CONFIG_COMMIT)
+struct IPC_ConfigStage_t {
+    bool open;                // CONFIG_BEGIN received, records being staged
+    bool applying;            // Records being applied - handler replies are captured
+    bool resultPending;       // CONFIG_RESULT waiting for TX space
+    bool recording;           // A configuration record (batched or standalone) is being applied
+    uint8_t recordResult;     // Worst IPC_CONFIG_REC_xxx reported for it
+    uint8_t status;           // IPC_CONFIG_BATCH_xxx
+    uint16_t transactionId;
+    uint16_t expectedRecords; // From CONFIG_BEGIN
+    uint16_t sectionMask;     // Sections the batch replaces (from CONFIG_BEGIN)
+    uint16_t recordCount;     // Records staged
+    uint16_t length;          // Bytes staged
+    uint16_t current;         // Record being applied
+    uint16_t appliedCount;
+    uint8_t recordStatus[IPC_CONFIG_MAX_RECORDS];
+    uint8_t records[IPC_CONFIG_STAGING_SIZE];
+};
+
+#define IPC_CONFIG_DIGEST_ENTRIES   128   // Objects tracked by the configuration digest
+
+// Hash of the configuration last applied to one object (see ipc_config_digest.h)
+struct IPC_ConfigDigestEntry_t {
+    uint8_t section;          // IPC_ConfigSection
+    uint8_t key;              // Object index
+    uint32_t hash;
 };
 
 // IPC driver structure
@@ -69,18 +189,58 @@ struct IPC_Driver_t {
     uint8_t rxMsgType;
     uint8_t rxPayload[IPC_MAX_PAYLOAD_SIZE];
     
-    // TX queue
-    IPC_TxPacket_t txQueue[IPC_TX_QUEUE_SIZE];
-    uint8_t txQueueHead;
-    uint8_t txQueueTail;
-    bool txInProgress;
-    uint8_t bulkResponseInProgress;  // Reference count for bulk requests (0 = none, >0 = in progress or queued)
-    bool bulkJustFinished;  // Set when counter reaches 0, cleared next update cycle (prevents race)
+    // TX queue (byte ring of IPC_TxRecord_t + payload, one region per lane)
+    uint8_t txRing[IPC_TX_RING_SIZE] __attribute__((aligned(4)));
+    IPC_TxLane_t txLane[IPC_TX_LANE_COUNT];
+    bool txReserved;           // Space handed out by ipc_txReserve(), not yet committed
+    uint8_t txReserveLane;
+    uint8_t txReserveMsgType;
+    uint16_t txReserveOffset;  // Where the reserved record starts (lane relative)
+    
+    // TX backpressure
+    IPC_TxWaiter_t txWaiters[IPC_TX_MAX_WAITERS];
+    uint8_t txWaiterCount;
     
-    // Deferred ACK queue (sent after bulk responses complete)
-    IPC_DeferredAck_t deferredAcks[10];  // Small queue for config ACKs
-    uint8_t deferredAckCount;
-    uint32_t ackQueuedAt;  // Timestamp (millis) when ACK was queued (for delay calculation)
+    // Frame encoder (streams the tail record of one lane into the UART TX buffer, resumable)
+    uint8_t txActiveLane;      // Lane of the frame being written
+    uint8_t txControlBurst;    // Consecutive control frames sent while bulk was waiting
+    uint16_t txFramePos;       // Next unstuffed frame byte (0 = START not yet written)
+    uint16_t txCrc;            // Running CRC over LENGTH + MSG_TYPE + PAYLOAD
+    bool txEscapePending;      // Escape sequence split across calls
+    uint8_t txEscapedByte;     // Second half of the split escape sequence
+    
+    // Bulk response cursors (FIFO, head is the range currently streaming)
+    IPC_BulkCursor_t bulkQueue[IPC_BULK_QUEUE_SIZE];
+    uint8_t bulkQueueHead;
+    uint8_t bulkQueueCount;
+    
+    // Delta encoder state (indexed by object index)
+    IPC_DeltaShadow_t deltaShadow[MAX_NUM_OBJECTS];
+    uint16_t deltaSequence;    // Next SENSOR_DELTA frame sequence number
+    
+    // Sensor stream subscriptions (indexed by object index)
+    IPC_StreamEntry_t stream[MAX_NUM_OBJECTS];
+    uint16_t streamCount;      // Number of subscribed objects
+    uint16_t streamScanPos;    // Round-robin scan position
+    
+    // Index sync position (resumed when TX space frees)
+    uint16_t indexSyncNext;    // Next object index to send
+    uint16_t indexSyncPacket;  // Next INDEX_SYNC_DATA packet number
+    
+    // Configuration batch staging
+    IPC_ConfigStage_t configStage;
+    
+    // Scheduler task statistics page waiting for TX space
+    IPC_TaskStatsReq_t taskStatsReq;
+    bool taskStatsPending;
+    
+    // ADC capture chunk waiting for TX space
+    IPC_AdcCaptureReq_t adcCaptureReq;
+    bool adcCapturePending;
+    
+    // Applied configuration, reported in HELLO / HELLO_ACK
+    IPC_ConfigDigestEntry_t configDigest[IPC_CONFIG_DIGEST_ENTRIES];
+    uint8_t configDigestCount;
     
     // Statistics
     uint32_t rxPacketCount;
@@ -88,6 +248,35 @@ struct IPC_Driver_t {
     uint32_t rxErrorCount;
     uint32_t txErrorCount;
     uint32_t crcErrorCount;
+    uint32_t rxWireBytes;      // Bytes read from / written to the UART
+    uint32_t txWireBytes;
+    uint16_t txHighWater;      // Peak bytes in use over both TX lanes
+    uint16_t rxBacklogHighWater;
+    
+    // Link quality (see IPC_LinkStats_t)
+    uint32_t baudRate;
+    uint32_t rttSample[IPC_RTT_SAMPLES];  // Ring of PING round trips (us)
+    uint8_t rttCount;
+    uint8_t rttNext;
+    uint32_t pingEcho;         // Timestamp of the last PING, echoed by ipc_sendPong()
+    uint32_t linkWindowStart;  // millis() at the start of the rate window
+    uint32_t linkWindowRxBytes;  // Counters at the start of the window
+    uint32_t linkWindowTxBytes;
+    uint32_t linkWindowRxFrames;
+    uint32_t linkWindowTxFrames;
+    IPC_LinkStats_t link;      // This side, updated at the end of each window
+    IPC_LinkStats_t peerLink;  // SYS MCU's view from its last PING/PONG
+    uint32_t peerLinkTime;     // millis() when peerLink arrived (0 = never)
+    
+    // Baud rate change (led by the SYS MCU)
+    IPC_BaudState baudState;
+    uint32_t baudTarget;       // Rate accepted from BAUD_SWITCH
+    uint32_t baudPrevious;     // Rate to return to without a commit
+    uint32_t baudSwitchTime;   // millis() when the UART switched
+    bool baudTestSeen;         // A LINK_TEST arrived at the new rate
+    uint16_t baudSwitches;     // Switches committed
+    uint16_t baudReverts;      // Switches abandoned (no commit)
+    int txIdleRoom;            // availableForWrite() of the empty UART TX buffer
     
     // Fault/message tracking
     bool fault;
@@ -125,6 +314,7 @@ void ipc_update(void);
 
 /**
  * @brief Send a packet with specified message type and payload
+ * Sensor telemetry goes to the bulk lane, everything else to the control lane.
  * @param msgType Message type (IPC_MsgType enum)
  * @param payload Pointer to payload data (can be NULL if len=0)
  * @param len Payload length in bytes
@@ -133,25 +323,125 @@ void ipc_update(void);
 bool ipc_sendPacket(uint8_t msgType, const uint8_t *payload, uint16_t len);
 
 /**
- * @brief Send a packet (internal use - processes TX queue)
- * @return true if packet sent
+ * @brief Reserve contiguous TX ring space so a producer can serialize in place
+ * The record is published by ipc_txCommit(); only the committed length is
+ * kept. A reservation that is never committed is discarded by the next
+ * reserve. Do not queue other packets between reserve and commit.
+ * @param msgType Message type (selects the lane)
+ * @param len Maximum payload length that will be written
+ * @return Pointer to the payload buffer, or nullptr if no room / len too large
+ */
+uint8_t *ipc_txReserve(uint8_t msgType, uint16_t len);
+
+/**
+ * @brief Publish the record obtained from ipc_txReserve()
+ * @param len Payload length actually written
+ * @return true if packet queued
+ */
+bool ipc_txCommit(uint16_t len);
+
+/**
+ * @brief Register a one-shot callback for when the TX queue can take len bytes
+ * Lets producers defer work instead of failing with "Queue full". Callbacks
+ * run from ipc_update(); registering the same callback again updates len.
+ * @param msgType Message type the producer will send (selects the lane)
+ * @param len Payload length the producer needs
+ * @param callback Function to call once space is available
+ * @return true if registered, false if the waiter table is full
+ */
+bool ipc_txNotifyWhenFree(uint8_t msgType, uint16_t len, IPC_TxSpaceCallback_t callback);
+
+/**
+ * @brief Stream the next queued packet into the UART TX buffer (internal use)
+ * Control lane first; after IPC_TX_CONTROL_BURST control frames a waiting
+ * bulk frame is let through. A frame in progress is always finished first.
+ * Framing, byte stuffing and CRC are produced on the fly from the ring record.
+ * Only writes what the UART can accept without blocking; a partly written
+ * frame is resumed on the next call.
+ * @return true if a complete frame was written by this call
  */
 bool ipc_processTxQueue(void);
 
+/**
+ * @brief Queue a bulk sensor response range
+ * Frames are generated incrementally by ipc_serviceBulkResponse()
+ * @param transactionId Transaction ID from SENSOR_BULK_READ_REQ / SENSOR_DELTA_REQ
+ * @param startIndex First object index
+ * @param count Number of object indices (already clamped)
+ * @param mode IPC_BULK_MODE_FULL or IPC_BULK_MODE_DELTA
+ * @param resync Delta mode: discard sent state and send every object in full
+ * @return true if range queued, false if bulk queue full
+ */
+bool ipc_queueBulkResponse(uint16_t transactionId, uint16_t startIndex, uint16_t count,
+                           uint8_t mode, bool resync);
+
+/**
+ * @brief Emit pending bulk sensor frames into the bulk TX lane (called from ipc_update)
+ */
+void ipc_serviceBulkResponse(void);
+
+/**
+ * @brief Report a finished or refused bulk/delta range to the SYS MCU
+ * Queued on the bulk lane, so it follows the last data frame of the range.
+ * @param transactionId Transaction ID of the range request
+ * @param status IPC_BULK_CREDIT_DONE or IPC_BULK_CREDIT_REFUSED
+ * @return true if packet queued successfully
+ */
+bool ipc_sendBulkCredit(uint16_t transactionId, uint8_t status);
+
+/**
+ * @brief Drop all pending bulk response ranges
+ */
+void ipc_clearBulkQueue(void);
+
+/**
+ * @brief Push SENSOR_DATA for subscribed objects that changed or are due a heartbeat
+ * (called from ipc_update). Pushes are queued on the bulk TX lane.
+ */
+void ipc_serviceSensorStream(void);
+
+/**
+ * @brief Cancel all sensor stream subscriptions
+ */
+void ipc_clearSensorStreams(void);
+
 // ============================================================================
 // HELPER FUNCTIONS FOR COMMON OPERATIONS
 // ============================================================================
 
 /**
  * @brief Send PING keepalive message
+ * Carries micros() for the round trip and this side's link statistics.
  */
 bool ipc_sendPing(void);
 
 /**
  * @brief Send PONG response
+ * Echoes the timestamp of the last PING received.
  */
 bool ipc_sendPong(void);
 
+/**
+ * @brief Take a PONG: one round-trip sample and the SYS MCU's link view
+ */
+void ipc_linkPong(const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief Take a PING: remember its timestamp for the PONG and the SYS MCU's link view
+ */
+void ipc_linkPing(const uint8_t *payload, uint16_t len);
+
+/**
+ * @brief Take a BAUD_SWITCH: answer it and, if accepted, switch once the ACK has been sent
+ */
+void ipc_baudSwitch(const IPC_BaudSwitch_t *request);
+
+/**
+ * @brief Take a LINK_TEST at the new rate: release TX, keep the rate on the commit
+ * @return true if the test belongs to the switch in progress and should be echoed
+ */
+bool ipc_baudLinkTest(const IPC_LinkTest_t *test);
+
 /**
  * @brief Send HELLO handshake
  */
@@ -166,7 +456,8 @@ bool ipc_sendError(uint8_t errorCode, const char *message);
 
 /**
  * @brief Send complete object index synchronization
- * @return true if all packets queued successfully
+ * Packets that do not fit in the TX queue are sent as space frees up
+ * @return true if the sync was started
  */
 bool ipc_sendIndexSync(void);
 
@@ -182,6 +473,16 @@ bool ipc_sendIndexAdd(uint16_t index);
  */
 bool ipc_sendIndexRemove(uint16_t index);
 
+/**
+ * @brief Fill a SENSOR_DATA payload from the object at index
+ * Note: clears the controller newMessage flag once the message is captured
+ * @param index Object index
+ * @param transactionId Transaction ID to echo (IPC_TXN_NONE for pushed data)
+ * @param data Payload to fill
+ * @return true if the index holds a reportable object
+ */
+bool ipc_buildSensorData(uint16_t index, uint16_t transactionId, IPC_SensorData_t *data);
+
 /**
  * @brief Send sensor data for a specific object
  * @param index Object index
@@ -190,6 +491,30 @@ bool ipc_sendIndexRemove(uint16_t index);
  */
 bool ipc_sendSensorData(uint16_t index, uint16_t transactionId);
 
+/**
+ * @brief Append a SENSOR_DELTA record for index if it changed since last sent
+ * Updates the delta shadow for the object when a record is written.
+ * @param index Object index
+ * @param buf Output buffer
+ * @param space Bytes available in buf (must be >= IPC_DELTA_MAX_RECORD_SIZE)
+ * @return Number of bytes written (0 if unchanged or not an object)
+ */
+uint16_t ipc_encodeSensorDelta(uint16_t index, uint8_t *buf, uint16_t space);
+
+/**
+ * @brief Append a SENSOR_DELTA record for a streamed object if it is due
+ * Values are compared with the delta shadow through the subscription deadband;
+ * flag, type and string changes always produce a record.
+ * @param index Object index
+ * @param entry Stream subscription for the object
+ * @param heartbeat Write the record even if nothing moved
+ * @param buf Output buffer
+ * @param space Bytes available in buf (must be >= IPC_DELTA_MAX_RECORD_SIZE)
+ * @return Number of bytes written (0 if nothing to push)
+ */
+uint16_t ipc_encodeSensorStream(uint16_t index, const IPC_StreamEntry_t *entry, bool heartbeat,
+                                uint8_t *buf, uint16_t space);
+
 /**
  * @brief Send batch sensor data
  * @param indices Array of object indices
@@ -208,7 +533,7 @@ bool ipc_sendFault(uint16_t index, uint8_t severity, const char *message);
 
 /**
  * @brief Send enhanced control acknowledgment with error codes
- * If bulk response is in progress, ACK is queued and sent later
+ * Queued on the control lane, ahead of any bulk telemetry
  * @param index Object index
  * @param objectType Object type
  * @param command Command that was executed
@@ -221,7 +546,7 @@ bool ipc_sendControlAck(uint16_t index, uint8_t objectType, uint8_t command,
 
 /**
  * @brief Send control ACK with transaction ID (for config messages)
- * If bulk response is in progress, ACK is queued and sent later
+ * Queued on the control lane, ahead of any bulk telemetry
  * @param transactionId Transaction ID from config message
  * @param index Object index
  * @param objectType Object type
@@ -234,10 +559,51 @@ bool ipc_sendControlAckWithTxn(uint16_t transactionId, uint16_t index, uint8_t o
                                 uint8_t command, bool success, uint8_t errorCode, const char *message);
 
 /**
- * @brief Process deferred ACK queue (called from ipc_update)
- * Sends queued ACKs when bulk response is complete
+ * @brief Record a handler reply as the status of the configuration record being applied
+ * The status decides whether the record counts towards the configuration
+ * digest. While a configuration batch is applied, per-object ACKs, errors and
+ * device status are also folded into the single CONFIG_RESULT instead of being sent.
+ * @param recordStatus IPC_CONFIG_REC_xxx (the worst status reported is kept)
+ * @return true if the reply was captured and must not be sent
  */
-void ipc_processDeferredAcks(void);
+bool ipc_configCapture(uint8_t recordStatus);
+
+/**
+ * @brief Send the CONFIG_RESULT for the last committed batch (if still pending)
+ * Retried from ipc_update() if the control lane is full.
+ */
+void ipc_sendConfigResult(void);
+
+/**
+ * @brief Send the TASK_STATS page requested by the last TASK_STATS_REQ (if still pending)
+ * Retried from ipc_update() if the bulk lane is full.
+ */
+void ipc_sendTaskStats(void);
+
+/**
+ * @brief Send the ADC_CAPTURE_DATA chunk requested by the last READ (if still pending)
+ * Retried when bulk lane space frees.
+ */
+void ipc_sendAdcCaptureData(void);
+
+/**
+ * @brief Digest of the configuration currently applied (for HELLO / HELLO_ACK)
+ * @param digest Filled with the per-section and overall digest
+ */
+void ipc_getConfigDigest(IPC_ConfigDigest_t *digest);
+
+/**
+ * @brief Forget the applied configuration of one object
+ * @param section IPC_ConfigSection
+ * @param key Object index
+ */
+void ipc_configDigestRemove(uint8_t section, uint8_t key);
+
+/**
+ * @brief Forget the applied configuration of whole sections
+ * @param sectionMask Bit per IPC_ConfigSection
+ */
+void ipc_configDigestClear(uint16_t sectionMask);
 
 /**
  * @brief Send device status message
@@ -269,9 +635,16 @@ void ipc_handle_ping(const uint8_t *payload, uint16_t len);
 void ipc_handle_pong(const uint8_t *payload, uint16_t len);
 void ipc_handle_hello(const uint8_t *payload, uint16_t len);
 void ipc_handle_hello_ack(const uint8_t *payload, uint16_t len);
+void ipc_handle_task_stats_req(const uint8_t *payload, uint16_t len);
+void ipc_handle_adc_capture_arm(const uint8_t *payload, uint16_t len);
+void ipc_handle_adc_capture_req(const uint8_t *payload, uint16_t len);
+void ipc_handle_baud_switch(const uint8_t *payload, uint16_t len);
+void ipc_handle_link_test(const uint8_t *payload, uint16_t len);
 void ipc_handle_index_sync_req(const uint8_t *payload, uint16_t len);
 void ipc_handle_sensor_read_req(const uint8_t *payload, uint16_t len);
 void ipc_handle_sensor_bulk_read_req(const uint8_t *payload, uint16_t len);
+void ipc_handle_sensor_stream(const uint8_t *payload, uint16_t len);
+void ipc_handle_sensor_delta_req(const uint8_t *payload, uint16_t len);
 void ipc_handle_control_write(const uint8_t *payload, uint16_t len);
 void ipc_handle_control_loop_write(const uint8_t *payload, uint16_t len);
 void ipc_handle_digital_output_control(const uint8_t *payload, uint16_t len);
@@ -299,6 +672,9 @@ void ipc_handle_config_ph_controller(const uint8_t *payload, uint16_t len);
 void ipc_handle_config_flow_controller(const uint8_t *payload, uint16_t len);
 void ipc_handle_config_do_controller(const uint8_t *payload, uint16_t len);
 void ipc_handle_config_pressure_ctrl(const uint8_t *payload, uint16_t len);
+void ipc_handle_config_begin(const uint8_t *payload, uint16_t len);
+void ipc_handle_config_batch(const uint8_t *payload, uint16_t len);
+void ipc_handle_config_commit(const uint8_t *payload, uint16_t len);
 
 // Controller control handlers
 void ipc_handle_temp_controller_control(const uint8_t *payload, uint16_t len);
@@ -311,19 +687,28 @@ void ipc_handle_do_controller_control(const uint8_t *payload, uint16_t len);
 // ============================================================================
 
 /**
- * @brief Check if TX queue has space
- * @return true if space available
+ * @brief Check if the TX queue can take a packet
+ * @param msgType Message type (selects the lane)
+ * @param len Payload length in bytes
+ * @return true if ipc_txReserve(msgType, len) would succeed
  */
-bool ipc_txQueueHasSpace(void);
+bool ipc_txQueueHasSpace(uint8_t msgType, uint16_t len);
 
 /**
- * @brief Get number of packets in TX queue
+ * @brief Get number of packets in TX queue (all lanes)
  * @return Number of queued packets
  */
-uint8_t ipc_txQueueCount(void);
+uint16_t ipc_txQueueCount(void);
+
+/**
+ * @brief Get free TX space in the lane used for msgType
+ * @param msgType Message type (selects the lane)
+ * @return Free bytes (not necessarily contiguous)
+ */
+uint16_t ipc_txQueueFree(uint8_t msgType);
 
 /**
- * @brief Clear TX queue
+ * @brief Clear TX queue (waiters are kept and fire on the next update)
  */
 void ipc_clearTxQueue(void);
 
@@ -342,3 +727,8 @@ bool ipc_isConnected(void);
  * @brief Print IPC statistics to Serial
  */
 void ipc_printStats(void);
+
+/**
+ * @brief Link statistics from the last completed window
+ */
+const IPC_LinkStats_t *ipc_getLinkStats(void);
@@ -1,4 +1,5 @@
 #include "drv_ipc.h"
+#include "ipc_config_digest.h"
 #include "../../sys_init.h"
 #include "../onboard/drv_rtd.h"  // For RTD configuration
 #include "../onboard/drv_gpio.h" // For GPIO configuration
@@ -12,9 +13,18 @@
 // MESSAGE HANDLER DISPATCHER
 // ============================================================================
 
+static uint8_t ipc_applyConfigRecord(uint8_t msgType, const uint8_t *payload, uint16_t len);
+
 void ipc_handleMessage(uint8_t msgType, const uint8_t *payload, uint16_t len) {
     // Message dispatcher (debug logging in individual handlers)
     
+    // Standalone configuration messages go through the same path as batch
+    // records so the configuration digest follows them
+    if (!ipcDriver.configStage.recording && ipc_configSection(msgType) != IPC_CONFIG_SECTION_NONE) {
+        ipc_applyConfigRecord(msgType, payload, len);
+        return;
+    }
+    
     switch (msgType) {
         case IPC_MSG_PING:
             ipc_handle_ping(payload, len);
@@ -24,6 +34,26 @@ void ipc_handleMessage(uint8_t msgType, const uint8_t *payload, uint16_t len) {
             ipc_handle_pong(payload, len);
             break;
             
+        case IPC_MSG_TASK_STATS_REQ:
+            ipc_handle_task_stats_req(payload, len);
+            break;
+            
+        case IPC_MSG_ADC_CAPTURE_ARM:
+            ipc_handle_adc_capture_arm(payload, len);
+            break;
+            
+        case IPC_MSG_ADC_CAPTURE_REQ:
+            ipc_handle_adc_capture_req(payload, len);
+            break;
+            
+        case IPC_MSG_BAUD_SWITCH:
+            ipc_handle_baud_switch(payload, len);
+            break;
+            
+        case IPC_MSG_LINK_TEST:
+            ipc_handle_link_test(payload, len);
+            break;
+            
         case IPC_MSG_HELLO:
             ipc_handle_hello(payload, len);
             break;
@@ -44,6 +74,14 @@ void ipc_handleMessage(uint8_t msgType, const uint8_t *payload, uint16_t len) {
             ipc_handle_sensor_bulk_read_req(payload, len);
             break;
             
+        case IPC_MSG_SENSOR_STREAM:
+            ipc_handle_sensor_stream(payload, len);
+            break;
+            
+        case IPC_MSG_SENSOR_DELTA_REQ:
+            ipc_handle_sensor_delta_req(payload, len);
+            break;
+            
         case IPC_MSG_CONTROL_WRITE:
             ipc_handle_control_write(payload, len);
             break;
@@ -124,6 +162,18 @@ void ipc_handleMessage(uint8_t msgType, const uint8_t *payload, uint16_t len) {
             ipc_handle_config_pressure_ctrl(payload, len);
             break;
             
+        case IPC_MSG_CONFIG_BEGIN:
+            ipc_handle_config_begin(payload, len);
+            break;
+            
+        case IPC_MSG_CONFIG_BATCH:
+            ipc_handle_config_batch(payload, len);
+            break;
+            
+        case IPC_MSG_CONFIG_COMMIT:
+            ipc_handle_config_commit(payload, len);
+            break;
+            
         default:
             // Unknown message type - debug log what we received
             Serial.printf("[IPC] ERROR: Received unknown message type 0x%02X (len=%d)\n", msgType, len);
@@ -140,7 +190,8 @@ void ipc_handle_ping(const uint8_t *payload, uint16_t len) {
     #if IPC_DEBUG_ENABLED
     Serial.println("[IPC] Received PING, sending PONG");
     #endif
-    // Respond with PONG
+    // Respond with PONG (echoes the PING timestamp for the SYS MCU's round trip)
+    ipc_linkPing(payload, len);
     ipc_sendPong();
     ipcDriver.connected = true;
     // lastActivity already updated by ipc_processReceivedPacket()
@@ -151,10 +202,191 @@ void ipc_handle_pong(const uint8_t *payload, uint16_t len) {
     Serial.println("[IPC] Received PONG");
     #endif
     // PONG received, connection is alive
+    ipc_linkPong(payload, len);
     ipcDriver.connected = true;
     // lastActivity already updated by ipc_processReceivedPacket()
 }
 
+void ipc_handle_baud_switch(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_BaudSwitch_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "BAUD_SWITCH: Invalid payload size");
+        return;
+    }
+    ipc_baudSwitch((const IPC_BaudSwitch_t*)payload);
+}
+
+void ipc_handle_link_test(const uint8_t *payload, uint16_t len) {
+    if (len != sizeof(IPC_LinkTest_t)) {
+        return;  // Corrupt test - the SYS MCU sees no echo and abandons the switch
+    }
+    if (ipc_baudLinkTest((const IPC_LinkTest_t*)payload)) {
+        ipc_sendPacket(IPC_MSG_LINK_TEST, payload, len);  // Echo as received
+    }
+}
+
+void ipc_handle_task_stats_req(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_TaskStatsReq_t)) {
+        Serial.println("[IPC] ERROR: Invalid TASK_STATS_REQ size");
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "TASK_STATS_REQ: Invalid payload size");
+        return;
+    }
+    
+    // A newer request replaces one still waiting for TX space
+    memcpy(&ipcDriver.taskStatsReq, payload, sizeof(IPC_TaskStatsReq_t));
+    ipcDriver.taskStatsPending = true;
+    ipc_sendTaskStats();
+}
+
+void ipc_sendTaskStats(void) {
+    if (!ipcDriver.taskStatsPending) {
+        return;
+    }
+    
+    const IPC_TaskStatsReq_t *req = &ipcDriver.taskStatsReq;
+    size_t total = tasks.getTaskCount();
+    if (total > 255) total = 255;
+    uint8_t count = 0;
+    if (req->startTask < total) {
+        count = min((size_t)IPC_TASK_STATS_PER_FRAME, total - req->startTask);
+    }
+    
+    // task[] is trimmed to the entries actually sent
+    uint16_t len = sizeof(IPC_TaskStats_t) - (IPC_TASK_STATS_PER_FRAME - count) * sizeof(IPC_TaskStatsEntry_t);
+    IPC_TaskStats_t *stats = (IPC_TaskStats_t*)ipc_txReserve(IPC_MSG_TASK_STATS, len);
+    if (stats == nullptr) {
+        ipc_txNotifyWhenFree(IPC_MSG_TASK_STATS, len, ipc_sendTaskStats);
+        return;
+    }
+    
+    static_assert(IPC_TASK_HIST_BUCKETS == SCHED_HIST_BUCKETS, "Task histogram layout mismatch");
+    
+    stats->transactionId = req->transactionId;
+    stats->totalTasks = (uint8_t)total;
+    stats->startTask = req->startTask;
+    stats->count = count;
+    stats->reserved = 0;
+    stats->idlePermille = (uint16_t)(tasks.getIdlePercent() * 10.0f);
+    stats->uptimeMs = millis();
+    
+    const ScheduledTask *task = tasks.getTask(req->startTask);
+    for (uint8_t i = 0; i < count && task; i++, task = tasks.nextTask(task)) {
+        IPC_TaskStatsEntry_t *entry = &stats->task[i];
+        
+        strncpy(entry->name, task->getName(), IPC_TASK_NAME_LEN);
+        if (entry->name[0] == '\0') {
+            snprintf(entry->name, IPC_TASK_NAME_LEN, "task%u", req->startTask + i);
+        }
+        entry->intervalUs = task->getIntervalMicros();
+        entry->budgetUs = task->getBudget();
+        entry->execCount = task->getExecCount();
+        entry->overrunCount = task->getOverrunCount();
+        entry->missedPeriods = task->getMissedPeriods();
+        entry->avgExecUs = (uint32_t)task->getAverageExecTime();
+        entry->maxExecUs = task->getMaxExecTime();
+        entry->maxLatenessUs = task->getMaxLateness();
+        entry->cpuPermille = (uint16_t)(task->getCpuUsagePercent() * 10.0f);
+        entry->flags = (task->isHighPriority() ? IPC_TASK_FLAG_HIGH_PRIORITY : 0) |
+                       (task->isPaused() ? IPC_TASK_FLAG_PAUSED : 0) |
+                       (task->getTimingMode() == TIMING_FIXED_RATE ? IPC_TASK_FLAG_FIXED_RATE : 0) |
+                       (task->isEventDriven() ? IPC_TASK_FLAG_EVENT : 0);
+        entry->reserved = 0;
+        memcpy(entry->execHist, task->getExecHistogram(), sizeof(entry->execHist));
+        memcpy(entry->latenessHist, task->getLatenessHistogram(), sizeof(entry->latenessHist));
+    }
+    ipc_txCommit(len);
+    ipcDriver.taskStatsPending = false;
+    
+    // Reset once the last page has been captured so all pages cover the same window
+    if ((req->flags & IPC_TASK_STATS_REQ_RESET) && req->startTask + count >= total) {
+        tasks.resetAllStats();
+    }
+}
+
+static void ipc_sendAdcCaptureStatus(uint16_t transactionId, uint8_t extraFlags) {
+    IPC_AdcCaptureStatus_t status;
+    ADC_captureGetStatus(&status);
+    status.transactionId = transactionId;
+    status.flags |= extraFlags;
+    ipc_sendPacket(IPC_MSG_ADC_CAPTURE_STATUS, (const uint8_t*)&status, sizeof(status));
+}
+
+void ipc_handle_adc_capture_arm(const uint8_t *payload, uint16_t len) {
+    if (len != sizeof(IPC_AdcCaptureArm_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "ADC_CAPTURE_ARM: Invalid payload size");
+        return;
+    }
+    const IPC_AdcCaptureArm_t *arm = (const IPC_AdcCaptureArm_t*)payload;
+    
+    // A new capture invalidates any chunk still waiting to go out
+    ipcDriver.adcCapturePending = false;
+    bool armed = ADC_captureArm(arm);
+    if (armed) {
+        Serial.printf("[IPC] ADC capture armed: mask 0x%02X, %u Hz, %u/%u scans, trigger %u on ch %u\n",
+                      arm->channelMask, arm->sampleRateHz, arm->preTriggerScans, arm->lengthScans,
+                      arm->trigger, arm->triggerChannel);
+    }
+    ipc_sendAdcCaptureStatus(arm->transactionId, armed ? 0 : IPC_ADC_CAPTURE_FLAG_REFUSED);
+}
+
+void ipc_handle_adc_capture_req(const uint8_t *payload, uint16_t len) {
+    if (len != sizeof(IPC_AdcCaptureReq_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "ADC_CAPTURE_REQ: Invalid payload size");
+        return;
+    }
+    const IPC_AdcCaptureReq_t *req = (const IPC_AdcCaptureReq_t*)payload;
+    
+    switch (req->op) {
+        case IPC_ADC_CAPTURE_OP_READ:
+            // A newer request replaces one still waiting for TX space
+            ipcDriver.adcCaptureReq = *req;
+            ipcDriver.adcCapturePending = true;
+            ipc_sendAdcCaptureData();
+            break;
+            
+        case IPC_ADC_CAPTURE_OP_ABORT:
+            ipcDriver.adcCapturePending = false;
+            ADC_captureAbort();
+            ipc_sendAdcCaptureStatus(req->transactionId, 0);
+            break;
+            
+        default:
+            ipc_sendAdcCaptureStatus(req->transactionId, 0);
+            break;
+    }
+}
+
+void ipc_sendAdcCaptureData(void) {
+    if (!ipcDriver.adcCapturePending) {
+        return;
+    }
+    
+    // Reserve for a full chunk, then trim to what the block still holds
+    const uint16_t headerLen = sizeof(IPC_AdcCaptureData_t) - sizeof(((IPC_AdcCaptureData_t*)0)->sample);
+    const uint16_t maxLen = sizeof(IPC_AdcCaptureData_t);
+    IPC_AdcCaptureData_t *data = (IPC_AdcCaptureData_t*)ipc_txReserve(IPC_MSG_ADC_CAPTURE_DATA, maxLen);
+    if (data == nullptr) {
+        ipc_txNotifyWhenFree(IPC_MSG_ADC_CAPTURE_DATA, maxLen, ipc_sendAdcCaptureData);
+        return;
+    }
+    
+    const IPC_AdcCaptureReq_t *req = &ipcDriver.adcCaptureReq;
+    data->transactionId = req->transactionId;
+    data->offset = req->offset;
+    data->count = ADC_captureRead(req->offset, data->sample, IPC_ADC_CAPTURE_CHUNK_SAMPLES);
+    ipc_txCommit(headerLen + data->count * sizeof(int16_t));
+    ipcDriver.adcCapturePending = false;
+}
+
+// The SYS MCU decides what to re-push from our digest; this is only logged
+static void ipc_logConfigDigest(const IPC_ConfigDigest_t *local, const IPC_ConfigDigest_t *sys) {
+    if (local->overall == sys->overall) {
+        Serial.printf("[IPC] Configuration digest %08lX matches SYS MCU\n", local->overall);
+    } else {
+        Serial.printf("[IPC] Configuration digest %08lX, SYS MCU last pushed %08lX\n",
+                     local->overall, sys->overall);
+    }
+}
+
 void ipc_handle_hello(const uint8_t *payload, uint16_t len) {
     if (len < sizeof(IPC_Hello_t)) {
         ipc_sendError(IPC_ERR_PARSE_FAIL, "HELLO: Invalid payload size");
@@ -180,8 +412,15 @@ void ipc_handle_hello(const uint8_t *payload, uint16_t len) {
     ack.firmwareVersion = 0x00010000;  // v1.0.0
     ack.maxObjectCount = MAX_NUM_OBJECTS;
     ack.currentObjectCount = numObjects;
+    ack.bulkWindow = IPC_BULK_QUEUE_SIZE;
+    ipc_getConfigDigest(&ack.configDigest);
+    ack.baudRates = IPC_BAUD_SUPPORTED;
     
     ipc_sendPacket(IPC_MSG_HELLO_ACK, (uint8_t*)&ack, sizeof(ack));
+    ipc_logConfigDigest(&ack.configDigest, &hello->configDigest);
+    
+    // New session - SYS MCU re-subscribes once its config push is complete
+    ipc_clearSensorStreams();
     
     Serial.printf("[IPC] ✓ Handshake complete! Sent HELLO_ACK (%u/%u objects)\n",
                  numObjects, MAX_NUM_OBJECTS);
@@ -223,6 +462,13 @@ void ipc_handle_hello_ack(const uint8_t *payload, uint16_t len) {
     ipcDriver.connectionState = IPC_CONN_CONNECTED;
     ipcDriver.connected = true;
     
+    IPC_ConfigDigest_t digest;
+    ipc_getConfigDigest(&digest);
+    ipc_logConfigDigest(&digest, &ack->configDigest);
+    
+    // New session - SYS MCU re-subscribes once its config push is complete
+    ipc_clearSensorStreams();
+    
     // Reset keepalive timer to prevent immediate PING
     ipcDriver.lastKeepalive = millis();
     
@@ -242,22 +488,27 @@ void ipc_handle_index_sync_req(const uint8_t *payload, uint16_t len) {
     ipc_sendIndexSync();
 }
 
-bool ipc_sendIndexSync(void) {
-    Serial.printf("[IPC] ipc_sendIndexSync() called: numObjects=%u\n", numObjects);
-    
-    if (numObjects == 0) {
-        Serial.println("[IPC] ERROR: No objects to sync - aborting");
-        return false;
-    }
-    
-    const uint8_t entriesPerPacket = 10;
-    uint16_t totalPackets = (numObjects + entriesPerPacket - 1) / entriesPerPacket;
-    uint16_t packetNum = 0;
-    
-    Serial.printf("[IPC] Sending %u index sync packets (%u entries per packet)\n", totalPackets, entriesPerPacket);
-    
-    for (uint16_t i = 0; i < numObjects; i += entriesPerPacket) {
-        IPC_IndexSync_t syncData;
+#define IPC_INDEX_SYNC_ENTRIES  10  // Entries per INDEX_SYNC_DATA packet
+
+// Emit index sync packets from the saved position. If the TX queue fills up,
+// the rest is sent from ipc_update() once space frees (no packets are dropped).
+static void ipc_continueIndexSync(void) {
+    uint16_t totalPackets = (numObjects + IPC_INDEX_SYNC_ENTRIES - 1) / IPC_INDEX_SYNC_ENTRIES;
+    
+    while (ipcDriver.indexSyncNext < numObjects) {
+        if (!ipc_txQueueHasSpace(IPC_MSG_INDEX_SYNC_DATA, sizeof(IPC_IndexSync_t))) {
+            ipc_txNotifyWhenFree(IPC_MSG_INDEX_SYNC_DATA, sizeof(IPC_IndexSync_t), ipc_continueIndexSync);
+            Serial.printf("[IPC] Index sync deferred at packet %u/%u (TX queue full)\n",
+                         ipcDriver.indexSyncPacket, totalPackets);
+            return;
+        }
+        
+        uint16_t i = ipcDriver.indexSyncNext;
+        uint16_t packetNum = ipcDriver.indexSyncPacket;
+        const uint8_t entriesPerPacket = IPC_INDEX_SYNC_ENTRIES;
+        
+        // Build in place in the TX queue
+        IPC_IndexSync_t &syncData = *(IPC_IndexSync_t*)ipc_txReserve(IPC_MSG_INDEX_SYNC_DATA, sizeof(IPC_IndexSync_t));
         syncData.packetNum = packetNum;
         syncData.totalPackets = totalPackets;
         syncData.entryCount = 0;
@@ -340,18 +591,36 @@ bool ipc_sendIndexSync(void) {
                                    (syncData.entryCount * sizeof(IPC_IndexEntry_t));
             Serial.printf("[IPC] Sending INDEX_SYNC_DATA packet %u/%u (entries=%u, size=%u)\n", 
                          packetNum, totalPackets, syncData.entryCount, payloadSize);
-            ipc_sendPacket(IPC_MSG_INDEX_SYNC_DATA, (uint8_t*)&syncData, payloadSize);
+            ipc_txCommit(payloadSize);
         } else {
             Serial.printf("[IPC] Skipping packet %u (no entries)\n", packetNum);
         }
         
-        packetNum++;
+        ipcDriver.indexSyncPacket++;
+        ipcDriver.indexSyncNext += entriesPerPacket;
     }
     
     // Index sync complete - connection already established
     // Update activity to ensure timeout doesn't fire immediately
     ipcDriver.lastActivity = millis();
     Serial.println("[IPC] ✓ Index sync complete, connection fully established");
+}
+
+bool ipc_sendIndexSync(void) {
+    Serial.printf("[IPC] ipc_sendIndexSync() called: numObjects=%u\n", numObjects);
+    
+    if (numObjects == 0) {
+        Serial.println("[IPC] ERROR: No objects to sync - aborting");
+        return false;
+    }
+    
+    Serial.printf("[IPC] Sending %u index sync packets (%u entries per packet)\n",
+                 (numObjects + IPC_INDEX_SYNC_ENTRIES - 1) / IPC_INDEX_SYNC_ENTRIES, IPC_INDEX_SYNC_ENTRIES);
+    
+    // Restart from the first object (a sync already in progress starts over)
+    ipcDriver.indexSyncNext = 0;
+    ipcDriver.indexSyncPacket = 0;
+    ipc_continueIndexSync();
     
     return true;
 }
@@ -428,6 +697,7 @@ void ipc_handle_sensor_bulk_read_req(const uint8_t *payload, uint16_t len) {
         Serial.printf("[IPC] ERROR: Invalid bulk read range: start=%d, count=%d\n", 
                      req->startIndex, req->count);
         ipc_sendError(IPC_ERR_INDEX_INVALID, "Invalid bulk read range");
+        ipc_sendBulkCredit(transactionId, IPC_BULK_CREDIT_REFUSED);
         return;
     }
     
@@ -437,61 +707,245 @@ void ipc_handle_sensor_bulk_read_req(const uint8_t *payload, uint16_t len) {
         count = MAX_NUM_OBJECTS - req->startIndex;
     }
     
-    // Don't start bulk response if deferred ACKs are waiting - process them first
-    if (ipcDriver.deferredAckCount > 0) {
-        Serial.printf("[IPC] BULK DEFERRED: %d ACKs waiting, delaying bulk response\n", 
-                     ipcDriver.deferredAckCount);
-        // Don't send error - just skip this bulk request, SYS MCU will retry
+    // Queue the range - frames are generated by ipc_update() as TX space frees up,
+    // so the scheduler loop is never blocked for the wire time of the whole response
+    if (!ipc_queueBulkResponse(transactionId, req->startIndex, count, IPC_BULK_MODE_FULL, false)) {
+        Serial.printf("[IPC] BULK REJECTED: Bulk queue full (TXN=%u), %d ranges pending\n", 
+                     transactionId, ipcDriver.bulkQueueCount);
+        // SYS MCU overran the window - free its slot so it can retry
+        ipc_sendBulkCredit(transactionId, IPC_BULK_CREDIT_REFUSED);
+        return;
+    }
+}
+
+void ipc_handle_sensor_stream(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_SensorStreamReq_t)) {
+        Serial.println("[IPC] ERROR: Invalid SENSOR_STREAM size");
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "SENSOR_STREAM: Invalid payload size");
         return;
     }
     
-    // CRITICAL: Don't start new bulk response if one is already in progress
-    // This prevents overlapping requests from sending duplicate data with different transaction IDs
-    if (ipcDriver.bulkResponseInProgress > 0) {
-        Serial.printf("[IPC] BULK REJECTED: Response already in progress (TXN=%u), counter=%d\n", 
-                     transactionId, ipcDriver.bulkResponseInProgress);
-        // Don't send error - just skip this request, SYS MCU will retry
+    IPC_SensorStreamReq_t *req = (IPC_SensorStreamReq_t*)payload;
+    
+    // count = 0 cancels all subscriptions
+    if (req->count == 0) {
+        ipc_clearSensorStreams();
+        ipc_sendControlAckWithTxn(req->transactionId, req->startIndex, 0, 0, true,
+                                  IPC_ERR_NONE, "Sensor stream cancelled");
         return;
     }
     
-    // Increment counter BEFORE queueing packets to prevent ACKs from being injected
-    ipcDriver.bulkResponseInProgress++;
-    // Queue sensor responses in batches to avoid queue overflow
-    // Process in chunks of 6 packets (TX queue size is 8, leave 2 for safety)
-    uint16_t sentCount = 0;
-    const uint16_t BATCH_SIZE = 6;
+    if (req->startIndex >= MAX_NUM_OBJECTS ||
+        (req->maxIntervalMs != 0 && req->maxIntervalMs < req->minIntervalMs) ||
+        !(req->deadband >= 0.0f) || !(req->deadbandRel >= 0.0f)) {
+        Serial.printf("[IPC] ERROR: Invalid stream request: start=%d, count=%d, min=%u, max=%u\n",
+                     req->startIndex, req->count, req->minIntervalMs, req->maxIntervalMs);
+        ipc_sendControlAckWithTxn(req->transactionId, req->startIndex, 0, 0, false,
+                                  IPC_ERR_PARAM_INVALID, "Invalid stream parameters");
+        return;
+    }
     
-    for (uint16_t batchStart = 0; batchStart < count; batchStart += BATCH_SIZE) {
-        // Queue up to BATCH_SIZE packets
-        uint16_t batchEnd = (batchStart + BATCH_SIZE < count) ? (batchStart + BATCH_SIZE) : count;
-        
-        for (uint16_t i = batchStart; i < batchEnd; i++) {
-            uint16_t index = req->startIndex + i;
-            
-            // Send sensor data with transaction ID
-            if (ipc_sendSensorData(index, transactionId)) {
-                sentCount++;
-            }
+    // Clamp count to valid range
+    uint16_t count = req->count;
+    if (req->startIndex + count > MAX_NUM_OBJECTS) {
+        count = MAX_NUM_OBJECTS - req->startIndex;
+    }
+    
+    uint16_t minInterval = req->minIntervalMs;
+    if (minInterval < IPC_STREAM_MIN_INTERVAL_MS) {
+        minInterval = IPC_STREAM_MIN_INTERVAL_MS;
+    }
+    
+    for (uint16_t i = req->startIndex; i < req->startIndex + count; i++) {
+        IPC_StreamEntry_t *entry = &ipcDriver.stream[i];
+        if (!entry->subscribed) {
+            ipcDriver.streamCount++;
         }
-        
-        // Drain TX queue completely before queueing next batch
-        while (ipc_txQueueCount() > 0) {
-            ipc_processTxQueue();
-            delayMicroseconds(100);
+        entry->subscribed = true;
+        entry->primed = false;  // Push current state on next scan
+        entry->minIntervalMs = minInterval;
+        entry->maxIntervalMs = req->maxIntervalMs;
+        entry->deadband = req->deadband;
+        entry->deadbandRel = req->deadbandRel;
+    }
+    
+    Serial.printf("[IPC] Sensor stream: indices %u-%u (min %u ms, max %u ms, deadband %.3f / %.2f%%)\n",
+                 req->startIndex, req->startIndex + count - 1, minInterval,
+                 req->maxIntervalMs, req->deadband, req->deadbandRel * 100.0f);
+    
+    ipc_sendControlAckWithTxn(req->transactionId, req->startIndex, 0, 0, true,
+                              IPC_ERR_NONE, "Sensor stream active");
+}
+
+void ipc_handle_sensor_delta_req(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_SensorDeltaReq_t)) {
+        Serial.println("[IPC] ERROR: Invalid SENSOR_DELTA_REQ size");
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "SENSOR_DELTA_REQ: Invalid payload size");
+        return;
+    }
+    
+    IPC_SensorDeltaReq_t *req = (IPC_SensorDeltaReq_t*)payload;
+    
+    // Validate range
+    if (req->startIndex >= MAX_NUM_OBJECTS || req->count == 0) {
+        Serial.printf("[IPC] ERROR: Invalid delta read range: start=%d, count=%d\n", 
+                     req->startIndex, req->count);
+        ipc_sendError(IPC_ERR_INDEX_INVALID, "Invalid delta read range");
+        ipc_sendBulkCredit(req->transactionId, IPC_BULK_CREDIT_REFUSED);
+        return;
+    }
+    
+    // Clamp count to valid range
+    uint16_t count = req->count;
+    if (req->startIndex + count > MAX_NUM_OBJECTS) {
+        count = MAX_NUM_OBJECTS - req->startIndex;
+    }
+    
+    bool resync = (req->flags & IPC_DELTA_REQ_RESYNC) != 0;
+    if (!ipc_queueBulkResponse(req->transactionId, req->startIndex, count, IPC_BULK_MODE_DELTA, resync)) {
+        Serial.printf("[IPC] DELTA REJECTED: Bulk queue full (TXN=%u), %d ranges pending\n", 
+                     req->transactionId, ipcDriver.bulkQueueCount);
+        ipc_sendBulkCredit(req->transactionId, IPC_BULK_CREDIT_REFUSED);
+        return;
+    }
+}
+
+// Append a length-prefixed string (max - 1 characters) to a delta record
+static uint16_t ipc_deltaPutString(uint8_t *buf, const char *str, size_t max) {
+    uint8_t len = (uint8_t)strnlen(str, max - 1);
+    buf[0] = len;
+    memcpy(&buf[1], str, len);
+    return 1 + len;
+}
+
+// Stream deadband: the larger of the absolute band and the relative band
+// scaled by the value SYS MCU holds. NaN transitions always count as moved.
+static bool ipc_streamValueMoved(float current, float held, const IPC_StreamEntry_t *entry) {
+    float band = (held < 0.0f ? -held : held) * entry->deadbandRel;
+    if (band < entry->deadband) band = entry->deadband;
+    float delta = current - held;
+    if (delta < 0.0f) delta = -delta;
+    return (delta > band) || (current != current) != (held != held);
+}
+
+// Shared by polled and streamed records. Without a stream entry values are
+// compared exactly (a cache mirror); with one they pass through its deadband.
+static uint16_t ipc_encodeDeltaRecord(uint16_t index, uint8_t *buf, uint16_t space,
+                                      const IPC_StreamEntry_t *entry, bool force) {
+    if (index >= MAX_NUM_OBJECTS || space < IPC_DELTA_MAX_RECORD_SIZE) {
+        return 0;
+    }
+    
+    IPC_DeltaShadow_t *shadow = &ipcDriver.deltaShadow[index];
+    
+    IPC_SensorData_t data;
+    if (!ipc_buildSensorData(index, IPC_TXN_NONE, &data)) {
+        // Object removed since last sent - tell SYS MCU once
+        if (!shadow->valid) {
+            return 0;
+        }
+        shadow->valid = false;
+        buf[0] = (uint8_t)index;
+        buf[1] = 0;
+        buf[2] = IPC_DELTA_FIELD_REMOVED;
+        return 3;
+    }
+    
+    uint8_t valueCount = (data.valueCount <= 4) ? data.valueCount : 4;
+    
+    // String changes are tracked by CRC rather than keeping copies
+    uint16_t unitCrc = ipc_calcCRC16((const uint8_t*)data.unit, strnlen(data.unit, sizeof(data.unit)));
+    uint16_t extraUnitsCrc = ipc_calcCRC16((const uint8_t*)data.additionalUnits, valueCount * sizeof(data.additionalUnits[0]));
+    uint16_t msgCrc = ipc_calcCRC16((const uint8_t*)data.message, strnlen(data.message, sizeof(data.message)));
+    
+    uint8_t fields = valueCount;
+    if (!shadow->valid || shadow->objectType != data.objectType) fields |= IPC_DELTA_FIELD_TYPE;
+    if (!shadow->valid || shadow->unitCrc != unitCrc) fields |= IPC_DELTA_FIELD_UNIT;
+    if (valueCount > 0 && (!shadow->valid || shadow->valueCount != valueCount ||
+                           shadow->extraUnitsCrc != extraUnitsCrc)) {
+        fields |= IPC_DELTA_FIELD_EXTRA_UNITS;
+    }
+    if (!shadow->valid || shadow->msgCrc != msgCrc) fields |= IPC_DELTA_FIELD_MSG;
+    
+    // Skip unchanged objects
+    bool changed = force ||
+                   (fields & ~IPC_DELTA_FIELD_VALUES_MASK) != 0 ||
+                   shadow->flags != data.flags ||
+                   shadow->valueCount != valueCount;
+    if (!changed && entry == nullptr) {
+        changed = memcmp(&shadow->value, &data.value, sizeof(float)) != 0 ||
+                  memcmp(shadow->additionalValues, data.additionalValues, valueCount * sizeof(float)) != 0;
+    } else if (!changed) {
+        changed = ipc_streamValueMoved(data.value, shadow->value, entry);
+        for (uint8_t i = 0; !changed && i < valueCount; i++) {
+            changed = ipc_streamValueMoved(data.additionalValues[i], shadow->additionalValues[i], entry);
         }
-        
-        // CRITICAL: Wait for UART hardware to finish transmitting
-        // ipc_processTxQueue() only moves data to UART buffer, doesn't wait for transmission
-        ipcDriver.uart->flush();  // Wait for UART TX complete
+    }
+    if (!changed) {
+        return 0;
     }
     
-    // Decrement counter now that THIS bulk request is complete
-    if (ipcDriver.bulkResponseInProgress > 0) {
-        ipcDriver.bulkResponseInProgress--;
+    uint16_t pos = 0;
+    buf[pos++] = (uint8_t)index;
+    buf[pos++] = data.flags;
+    buf[pos++] = fields;
+    if (fields & IPC_DELTA_FIELD_TYPE) {
+        buf[pos++] = data.objectType;
+    }
+    memcpy(&buf[pos], &data.value, sizeof(float));
+    pos += sizeof(float);
+    memcpy(&buf[pos], data.additionalValues, valueCount * sizeof(float));
+    pos += valueCount * sizeof(float);
+    if (fields & IPC_DELTA_FIELD_UNIT) {
+        pos += ipc_deltaPutString(&buf[pos], data.unit, sizeof(data.unit));
+    }
+    if (fields & IPC_DELTA_FIELD_EXTRA_UNITS) {
+        for (uint8_t i = 0; i < valueCount; i++) {
+            pos += ipc_deltaPutString(&buf[pos], data.additionalUnits[i], sizeof(data.additionalUnits[i]));
+        }
+    }
+    if (fields & IPC_DELTA_FIELD_MSG) {
+        pos += ipc_deltaPutString(&buf[pos], data.message, sizeof(data.message));
     }
+    
+    // Record what SYS MCU now holds
+    shadow->valid = true;
+    shadow->objectType = data.objectType;
+    shadow->flags = data.flags;
+    shadow->valueCount = valueCount;
+    shadow->value = data.value;
+    memcpy(shadow->additionalValues, data.additionalValues, sizeof(shadow->additionalValues));
+    shadow->unitCrc = unitCrc;
+    shadow->extraUnitsCrc = extraUnitsCrc;
+    shadow->msgCrc = msgCrc;
+    
+    return pos;
+}
+
+uint16_t ipc_encodeSensorDelta(uint16_t index, uint8_t *buf, uint16_t space) {
+    return ipc_encodeDeltaRecord(index, buf, space, nullptr, false);
+}
+
+uint16_t ipc_encodeSensorStream(uint16_t index, const IPC_StreamEntry_t *entry, bool heartbeat,
+                                uint8_t *buf, uint16_t space) {
+    return ipc_encodeDeltaRecord(index, buf, space, entry, heartbeat);
 }
 
 bool ipc_sendSensorData(uint16_t index, uint16_t transactionId) {
+    // Serialize straight into the TX queue slot
+    uint8_t *slot = ipc_txReserve(IPC_MSG_SENSOR_DATA, sizeof(IPC_SensorData_t));
+    if (slot == nullptr) {
+        Serial.printf("[IPC] DEBUG: Failed to send packet for index %d - TX queue full?\n", index);
+        return false;
+    }
+    if (!ipc_buildSensorData(index, transactionId, (IPC_SensorData_t*)slot)) {
+        return false;
+    }
+    
+    return ipc_txCommit(sizeof(IPC_SensorData_t));
+}
+
+bool ipc_buildSensorData(uint16_t index, uint16_t transactionId, IPC_SensorData_t *out) {
     if (index >= MAX_NUM_OBJECTS) {
         return false;
     }
@@ -505,7 +959,7 @@ bool ipc_sendSensorData(uint16_t index, uint16_t transactionId) {
         return false;
     }
     
-    IPC_SensorData_t data;
+    IPC_SensorData_t &data = *out;
     memset(&data, 0, sizeof(data));
     
     data.transactionId = transactionId;  // Echo transaction ID from request
@@ -874,13 +1328,7 @@ bool ipc_sendSensorData(uint16_t index, uint16_t transactionId) {
             return false;
     }
     
-    bool sent = ipc_sendPacket(IPC_MSG_SENSOR_DATA, (uint8_t*)&data, sizeof(data));
-    if (sent) {
-        //Serial.printf("[IPC] ✓ Sent %s: %.2f %s\n", objIndex[index].name, data.value, data.unit);
-    } else {
-        Serial.printf("[IPC] DEBUG: Failed to send packet for index %d - TX queue full?\n", index);
-    }
-    return sent;
+    return true;
 }
 
 bool ipc_sendSensorBatch(const uint16_t *indices, uint8_t count) {
@@ -1448,7 +1896,7 @@ void ipc_handle_control_read(const uint8_t *payload, uint16_t len) {
 }
 
 // Enhanced acknowledgment with error codes (for output control)
-// Uses deferred queue system - no blocking delays
+// Sent on the control TX lane - no blocking delays
 bool ipc_sendControlAck(uint16_t index, uint8_t objectType, uint8_t command,
                           bool success, uint8_t errorCode, const char *message) {
     // Delegate to transaction ID version with txn=0 (no transaction tracking)
@@ -1525,6 +1973,11 @@ void ipc_handle_device_delete(const uint8_t *payload, uint16_t len) {
     
     // Delete device through Device Manager
     bool success = DeviceManager::deleteDevice(req->startIndex);
+    if (success) {
+        // Its creation record and any pressure calibration no longer apply
+        ipc_configDigestRemove(IPC_CONFIG_SECTION_DEVICE, req->startIndex);
+        ipc_configDigestClear(1u << IPC_CONFIG_SECTION_PRESSURE_CTRL);
+    }
     
     // Send status response
     ipc_sendDeviceStatus(req->startIndex, !success, success, 0, nullptr,
@@ -1712,6 +2165,10 @@ void ipc_handle_device_control(const uint8_t *payload, uint16_t len) {
 bool ipc_sendDeviceStatus(uint8_t startIndex, bool active, bool fault,
                           uint8_t objectCount, const uint8_t *sensorIndices,
                           const char *message) {
+    if (ipc_configCapture((active && !fault) ? IPC_CONFIG_REC_OK : IPC_CONFIG_REC_FAILED)) {
+        return true;
+    }
+    
     IPC_DeviceStatus_t status;
     status.startIndex = startIndex;
     status.active = active;
@@ -1778,12 +2235,16 @@ void ipc_handle_config_write(const uint8_t *payload, uint16_t len) {
  * @brief Handle analog input (ADC) configuration
  */
 void ipc_handle_config_analog_input(const uint8_t *payload, uint16_t len) {
-    if (len != sizeof(IPC_ConfigAnalogInput_t)) {
+    if (len != sizeof(IPC_ConfigAnalogInput_t) && len != IPC_CONFIG_ANALOG_INPUT_V1_SIZE) {
         ipc_sendError(IPC_ERR_PARSE_FAIL, "Invalid ADC config message size");
         return;
     }
     
-    const IPC_ConfigAnalogInput_t *cfg = (const IPC_ConfigAnalogInput_t*)payload;
+    // Pre-v2.16 senders stop before the filter fields: zero-filled = no filter
+    IPC_ConfigAnalogInput_t cfgCopy;
+    memset(&cfgCopy, 0, sizeof(cfgCopy));
+    memcpy(&cfgCopy, payload, len);
+    const IPC_ConfigAnalogInput_t *cfg = &cfgCopy;
     
     // Validate index
     if (cfg->index >= MAX_NUM_OBJECTS || !objIndex[cfg->index].valid) {
@@ -1801,9 +2262,23 @@ void ipc_handle_config_analog_input(const uint8_t *payload, uint16_t len) {
         sensor->cal->scale = cfg->calScale;
         sensor->cal->offset = cfg->calOffset;
         sensor->cal->timestamp = millis();
+
+        // Fold the new unit and calibration into the conversion coefficients
+        ADC_configure(cfg->index);
+
+        // Restart the filter only when it changes, so a unit or calibration
+        // update does not throw away the filter history
+        if (cfg->index < ADC_NUM_CHANNELS) {
+            ADCFilter_t *filter = &adcDriver.pipeline.filter[cfg->index];
+            if (filter->type != cfg->filterType ||
+                filter->length != ADC_filterLength(cfg->filterType, cfg->filterLength)) {
+                ADC_setFilter(cfg->index, cfg->filterType, cfg->filterLength);
+            }
+        }
         
-        Serial.printf("[IPC] ✓ ADC[%d]: %s, cal=(%.3f, %.3f)\n",
-                     cfg->index, sensor->unit, sensor->cal->scale, sensor->cal->offset);
+        Serial.printf("[IPC] ✓ ADC[%d]: %s, cal=(%.3f, %.3f), filter %s/%u\n",
+                     cfg->index, sensor->unit, sensor->cal->scale, sensor->cal->offset,
+                     ADC_filterName(cfg->filterType), ADC_filterLength(cfg->filterType, cfg->filterLength));
         
         // Send ACK with transaction ID
         ipc_sendControlAckWithTxn(cfg->transactionId, cfg->index, OBJ_T_ANALOG_INPUT, 
@@ -1893,9 +2368,13 @@ void ipc_handle_config_rtd(const uint8_t *payload, uint16_t len) {
             // Configure sensor type (PT100 or PT1000)
             RtdSensorType sensorType = (cfg->nominalOhms == 1000) ? PT1000 : PT100;
             setRtdSensorType(&rtd_interface[rtdIdx], sensorType);
+
+            // Sample period (0 from pre-v2.15 senders = default)
+            setRtdSamplePeriod(&rtd_interface[rtdIdx], cfg->samplePeriodMs);
             
-            Serial.printf("[IPC] ✓ RTD[%d]: %s, %d-wire, PT%d, cal=(%.3f, %.3f)\n",
-                         cfg->index, sensor->unit, cfg->wireConfig, cfg->nominalOhms, 
+            Serial.printf("[IPC] ✓ RTD[%d]: %s, %d-wire, PT%d, %u ms, cal=(%.3f, %.3f)\n",
+                         cfg->index, sensor->unit, cfg->wireConfig, cfg->nominalOhms,
+                         rtd_interface[rtdIdx].samplePeriodMs,
                          sensor->cal->scale, sensor->cal->offset);
         } else {
             Serial.printf("[IPC] ✓ RTD[%d]: %s (no driver)\n",
@@ -2272,7 +2751,6 @@ void ipc_handle_config_temp_controller(const uint8_t *payload, uint16_t len) {
     }
     
     // Send acknowledgment with transaction ID
-    // Uses deferred queue if bulk response is in progress - no blocking
     ipc_sendControlAckWithTxn(cfg->transactionId, cfg->index, OBJ_T_TEMPERATURE_CONTROL,
                               0, success, success ? CTRL_ERR_NONE : CTRL_ERR_DRIVER_FAULT, ackMsg);
 }
@@ -2333,6 +2811,279 @@ void ipc_handle_config_pressure_ctrl(const uint8_t *payload, uint16_t len) {
                              0, true, CTRL_ERR_NONE, "Pressure controller config updated");
 }
 
+// ============================================================================
+// CONFIGURATION BATCH HANDLERS
+// ============================================================================
+// CONFIG_BEGIN opens a batch, CONFIG_BATCH frames are checked and copied into
+// ipcDriver.configStage, and CONFIG_COMMIT applies every record in one pass
+// through the same handlers as the standalone messages. Their replies are
+// captured by ipc_configCapture() and returned in one CONFIG_RESULT.
+// Every configuration record applied, batched or standalone, also updates the
+// configuration digest the SYS MCU compares on reconnect.
+
+static IPC_ConfigDigestEntry_t* ipc_configDigestFind(uint8_t section, uint8_t key) {
+    for (uint8_t i = 0; i < ipcDriver.configDigestCount; i++) {
+        IPC_ConfigDigestEntry_t *entry = &ipcDriver.configDigest[i];
+        if (entry->section == section && entry->key == key) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+void ipc_configDigestRemove(uint8_t section, uint8_t key) {
+    IPC_ConfigDigestEntry_t *entry = ipc_configDigestFind(section, key);
+    if (entry != nullptr) {
+        *entry = ipcDriver.configDigest[--ipcDriver.configDigestCount];
+    }
+}
+
+void ipc_configDigestClear(uint16_t sectionMask) {
+    uint8_t i = 0;
+    while (i < ipcDriver.configDigestCount) {
+        if (sectionMask & (1u << ipcDriver.configDigest[i].section)) {
+            ipcDriver.configDigest[i] = ipcDriver.configDigest[--ipcDriver.configDigestCount];
+        } else {
+            i++;
+        }
+    }
+}
+
+void ipc_getConfigDigest(IPC_ConfigDigest_t *digest) {
+    memset(digest, 0, sizeof(*digest));
+    for (uint8_t i = 0; i < ipcDriver.configDigestCount; i++) {
+        digest->section[ipcDriver.configDigest[i].section] += ipcDriver.configDigest[i].hash;
+    }
+    ipc_configDigestFinish(digest);
+}
+
+bool ipc_configCapture(uint8_t recordStatus) {
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    if (!stage->recording) {
+        return false;
+    }
+    
+    if (recordStatus > stage->recordResult) {
+        stage->recordResult = recordStatus;
+    }
+    return stage->applying;
+}
+
+/**
+ * @brief Apply one configuration record and track it in the configuration digest
+ * A record that fails is dropped from the digest, so the SYS MCU sends it
+ * again on the next reconnect.
+ * @return IPC_CONFIG_REC_xxx
+ */
+static uint8_t ipc_applyConfigRecord(uint8_t msgType, const uint8_t *payload, uint16_t len) {
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    uint8_t section = ipc_configSection(msgType);
+    if (section == IPC_CONFIG_SECTION_NONE) {
+        return IPC_CONFIG_REC_UNSUPPORTED;
+    }
+    
+    stage->recording = true;
+    stage->recordResult = IPC_CONFIG_REC_OK;
+    ipc_handleMessage(msgType, payload, len);
+    stage->recording = false;
+    
+    uint8_t key = ipc_configRecordKey(payload, len);
+    if (section == IPC_CONFIG_SECTION_DEVICE) {
+        // A (re)created device starts from default pressure calibration
+        ipc_configDigestClear(1u << IPC_CONFIG_SECTION_PRESSURE_CTRL);
+    }
+    
+    if (stage->recordResult != IPC_CONFIG_REC_OK) {
+        ipc_configDigestRemove(section, key);
+        return stage->recordResult;
+    }
+    
+    IPC_ConfigDigestEntry_t *entry = ipc_configDigestFind(section, key);
+    if (entry == nullptr && ipcDriver.configDigestCount < IPC_CONFIG_DIGEST_ENTRIES) {
+        entry = &ipcDriver.configDigest[ipcDriver.configDigestCount++];
+        entry->section = section;
+        entry->key = key;
+    }
+    if (entry != nullptr) {
+        entry->hash = ipc_configRecordHash(msgType, payload, len);
+    }
+    return IPC_CONFIG_REC_OK;
+}
+
+void ipc_handle_config_begin(const uint8_t *payload, uint16_t len) {
+    if (len != sizeof(IPC_ConfigBegin_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "Invalid CONFIG_BEGIN message size");
+        return;
+    }
+    
+    const IPC_ConfigBegin_t *begin = (const IPC_ConfigBegin_t*)payload;
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    
+    if (stage->open) {
+        Serial.printf("[IPC] Config batch %u abandoned (new batch %u)\n",
+                     stage->transactionId, begin->transactionId);
+    }
+    
+    // Staging a batch never changes the running configuration, so an unfinished
+    // one is simply replaced
+    stage->open = true;
+    stage->applying = false;
+    stage->resultPending = false;  // Result of an earlier batch is no longer wanted
+    stage->status = IPC_CONFIG_BATCH_APPLIED;
+    stage->transactionId = begin->transactionId;
+    stage->expectedRecords = begin->recordCount;
+    stage->sectionMask = begin->sectionMask;
+    stage->recordCount = 0;
+    stage->length = 0;
+    stage->appliedCount = 0;
+    
+    if (begin->recordCount > IPC_CONFIG_MAX_RECORDS || begin->totalBytes > IPC_CONFIG_STAGING_SIZE) {
+        Serial.printf("[IPC] Config batch %u too large (%u records, %u bytes)\n",
+                     begin->transactionId, begin->recordCount, begin->totalBytes);
+        stage->status = IPC_CONFIG_BATCH_MALFORMED;
+    }
+}
+
+void ipc_handle_config_batch(const uint8_t *payload, uint16_t len) {
+    if (len < sizeof(IPC_ConfigBatchHeader_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "Invalid CONFIG_BATCH message size");
+        return;
+    }
+    
+    const IPC_ConfigBatchHeader_t *hdr = (const IPC_ConfigBatchHeader_t*)payload;
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    
+    // Frames of an abandoned or already rejected batch are dropped; the
+    // rejection is reported when its COMMIT arrives
+    if (!stage->open || hdr->transactionId != stage->transactionId ||
+        stage->status != IPC_CONFIG_BATCH_APPLIED) {
+        return;
+    }
+    
+    if (hdr->firstRecord != stage->recordCount) {
+        Serial.printf("[IPC] Config batch %u: expected record %u, got %u\n",
+                     stage->transactionId, stage->recordCount, hdr->firstRecord);
+        stage->status = IPC_CONFIG_BATCH_INCOMPLETE;
+        return;
+    }
+    
+    // Walk the records before copying so a bad frame leaves nothing staged
+    const uint8_t *records = payload + sizeof(IPC_ConfigBatchHeader_t);
+    uint16_t bytes = len - sizeof(IPC_ConfigBatchHeader_t);
+    uint16_t pos = 0;
+    for (uint8_t i = 0; i < hdr->recordCount; i++) {
+        if (pos + sizeof(IPC_ConfigRecord_t) > bytes) {
+            pos = 0xFFFF;
+            break;
+        }
+        const IPC_ConfigRecord_t *rec = (const IPC_ConfigRecord_t*)(records + pos);
+        pos += sizeof(IPC_ConfigRecord_t);
+        if (pos + rec->length > bytes) {
+            pos = 0xFFFF;
+            break;
+        }
+        pos += rec->length;
+    }
+    
+    if (pos != bytes ||
+        stage->recordCount + hdr->recordCount > IPC_CONFIG_MAX_RECORDS ||
+        stage->length + bytes > IPC_CONFIG_STAGING_SIZE) {
+        Serial.printf("[IPC] Config batch %u: malformed frame at record %u\n",
+                     stage->transactionId, hdr->firstRecord);
+        stage->status = IPC_CONFIG_BATCH_MALFORMED;
+        return;
+    }
+    
+    memcpy(&stage->records[stage->length], records, bytes);
+    stage->length += bytes;
+    stage->recordCount += hdr->recordCount;
+}
+
+void ipc_handle_config_commit(const uint8_t *payload, uint16_t len) {
+    if (len != sizeof(IPC_ConfigCommit_t)) {
+        ipc_sendError(IPC_ERR_PARSE_FAIL, "Invalid CONFIG_COMMIT message size");
+        return;
+    }
+    
+    const IPC_ConfigCommit_t *commit = (const IPC_ConfigCommit_t*)payload;
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    
+    if (!stage->open || commit->transactionId != stage->transactionId) {
+        // BEGIN was lost - report the whole batch as not applied
+        stage->transactionId = commit->transactionId;
+        stage->recordCount = 0;
+        stage->status = IPC_CONFIG_BATCH_INCOMPLETE;
+    } else if (stage->status == IPC_CONFIG_BATCH_APPLIED &&
+               (stage->recordCount != commit->recordCount || stage->recordCount != stage->expectedRecords)) {
+        stage->status = IPC_CONFIG_BATCH_INCOMPLETE;
+    }
+    stage->open = false;
+    stage->resultPending = true;
+    
+    uint16_t reported = (commit->recordCount < IPC_CONFIG_MAX_RECORDS) ? commit->recordCount : IPC_CONFIG_MAX_RECORDS;
+    
+    if (stage->status != IPC_CONFIG_BATCH_APPLIED) {
+        stage->recordCount = reported;
+        stage->appliedCount = 0;
+        memset(stage->recordStatus, IPC_CONFIG_REC_NOT_APPLIED, reported);
+        Serial.printf("[IPC] Config batch %u rejected (status %u), nothing applied\n",
+                     stage->transactionId, stage->status);
+        ipc_sendConfigResult();
+        return;
+    }
+    
+    // The batch carries the complete contents of its sections - objects it
+    // leaves out are no longer part of the pushed configuration
+    ipc_configDigestClear(stage->sectionMask);
+    
+    // Apply every record in one pass
+    uint32_t start = millis();
+    uint16_t pos = 0;
+    stage->appliedCount = 0;
+    for (uint16_t i = 0; i < stage->recordCount; i++) {
+        const IPC_ConfigRecord_t *rec = (const IPC_ConfigRecord_t*)&stage->records[pos];
+        const uint8_t *data = &stage->records[pos + sizeof(IPC_ConfigRecord_t)];
+        pos += sizeof(IPC_ConfigRecord_t) + rec->length;
+        
+        stage->current = i;
+        stage->applying = true;
+        stage->recordStatus[i] = ipc_applyConfigRecord(rec->msgType, data, rec->length);
+        stage->applying = false;
+        
+        if (stage->recordStatus[i] == IPC_CONFIG_REC_OK) {
+            stage->appliedCount++;
+        }
+    }
+    
+    Serial.printf("[IPC] ✓ Config batch %u: %u/%u records applied in %lu ms\n",
+                 stage->transactionId, stage->appliedCount, stage->recordCount, millis() - start);
+    
+    ipc_sendConfigResult();
+}
+
+void ipc_sendConfigResult(void) {
+    IPC_ConfigStage_t *stage = &ipcDriver.configStage;
+    if (!stage->resultPending) {
+        return;
+    }
+    
+    // recordStatus is trimmed to the number of records in the batch
+    uint16_t len = sizeof(IPC_ConfigResult_t) - IPC_CONFIG_MAX_RECORDS + stage->recordCount;
+    IPC_ConfigResult_t *result = (IPC_ConfigResult_t*)ipc_txReserve(IPC_MSG_CONFIG_RESULT, len);
+    if (result == nullptr) {
+        ipc_txNotifyWhenFree(IPC_MSG_CONFIG_RESULT, len, ipc_sendConfigResult);
+        return;
+    }
+    
+    result->transactionId = stage->transactionId;
+    result->status = stage->status;
+    result->recordCount = stage->recordCount;
+    result->appliedCount = stage->appliedCount;
+    memcpy(result->recordStatus, stage->recordStatus, stage->recordCount);
+    ipc_txCommit(len);
+    stage->resultPending = false;
+}
+
 // ============================================================================
 // pH CONTROLLER HANDLERS
 // ============================================================================
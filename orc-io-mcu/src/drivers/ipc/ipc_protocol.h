@@ -9,7 +9,7 @@
 // ============================================================================
 
 // Protocol version
-#define IPC_PROTOCOL_VERSION    0x00020600  // v2.6.0 - Added transaction IDs
+#define IPC_PROTOCOL_VERSION    0x00021200  // v2.18.0 - Compact sensor stream
 
 // Debug configuration
 #define IPC_DEBUG_ENABLED       0  // Set to 1 to enable verbose debug output
@@ -23,7 +23,7 @@
 // Buffer sizes
 #define IPC_MAX_PAYLOAD_SIZE    1024
 #define IPC_RX_BUFFER_SIZE      1280  // Max packet size with stuffing
-#define IPC_TX_QUEUE_SIZE       8
+#define IPC_TX_QUEUE_SIZE       8     // TX ring size in max-size packets (see IPC_TX_RING_SIZE)
 #define IPC_MAX_PACKET_SIZE     (IPC_MAX_PAYLOAD_SIZE + 8)  // Payload + overhead
 
 // Timing
@@ -45,6 +45,11 @@ enum IPC_MsgType : uint8_t {
     IPC_MSG_HELLO           = 0x02,  // Initial handshake
     IPC_MSG_HELLO_ACK       = 0x03,  // Handshake acknowledgment
     IPC_MSG_ERROR           = 0x04,  // Error notification
+    IPC_MSG_TASK_STATS_REQ  = 0x05,  // Request a page of the scheduler task table
+    IPC_MSG_TASK_STATS      = 0x06,  // Scheduler task statistics page
+    IPC_MSG_BAUD_SWITCH     = 0x07,  // Change the link baud rate (SYS MCU -> IO MCU)
+    IPC_MSG_BAUD_SWITCH_ACK = 0x08,  // Baud rate change accepted or refused
+    IPC_MSG_LINK_TEST       = 0x09,  // Test pattern at the new baud rate, echoed back
     
     // Object Index Management (0x10-0x1F)
     IPC_MSG_INDEX_SYNC_REQ  = 0x10,  // Request full index sync
@@ -56,9 +61,16 @@ enum IPC_MsgType : uint8_t {
     // Sensor Data (0x20-0x2F)
     IPC_MSG_SENSOR_READ_REQ       = 0x20,  // Request sensor reading
     IPC_MSG_SENSOR_DATA           = 0x21,  // Sensor data response
-    IPC_MSG_SENSOR_STREAM         = 0x22,  // Continuous sensor streaming (not implemented yet)
+    IPC_MSG_SENSOR_STREAM         = 0x22,  // Subscribe to pushed sensor updates (range of indices)
     IPC_MSG_SENSOR_BATCH          = 0x23,  // Batch sensor data (multiple sensors)
     IPC_MSG_SENSOR_BULK_READ_REQ  = 0x24,  // Request bulk sensor reading (range of indices)
+    IPC_MSG_SENSOR_DELTA_REQ      = 0x25,  // Request changed objects in range (delta-encoded)
+    IPC_MSG_SENSOR_DELTA          = 0x26,  // Delta-encoded sensor batch (variable length)
+    IPC_MSG_BULK_CREDIT           = 0x27,  // Bulk/delta range finished or refused (returns window credit)
+    IPC_MSG_ADC_CAPTURE_ARM       = 0x28,  // Arm an ADC burst capture
+    IPC_MSG_ADC_CAPTURE_REQ       = 0x29,  // Capture status / chunk read / abort
+    IPC_MSG_ADC_CAPTURE_STATUS    = 0x2A,  // Capture state
+    IPC_MSG_ADC_CAPTURE_DATA      = 0x2B,  // Chunk of captured samples
     
     // Control Data (0x30-0x3F)
     IPC_MSG_CONTROL_WRITE   = 0x30,  // Write control value/setpoint
@@ -79,7 +91,7 @@ enum IPC_MsgType : uint8_t {
     IPC_MSG_MESSAGE_NOTIFY  = 0x51,  // General message notification
     IPC_MSG_FAULT_CLEAR     = 0x52,  // Clear fault
     
-    // Configuration (0x60-0x6F)
+    // Configuration (0x60-0x7F)
     IPC_MSG_CONFIG_READ           = 0x60,  // Read configuration
     IPC_MSG_CONFIG_WRITE          = 0x61,  // Write configuration
     IPC_MSG_CONFIG_DATA           = 0x62,  // Configuration data
@@ -96,6 +108,10 @@ enum IPC_MsgType : uint8_t {
     IPC_MSG_CONFIG_FLOW_CONTROLLER = 0x6E,  // Configure flow controller (feed/waste pumps)
     IPC_MSG_CONFIG_DO_CONTROLLER  = 0x70,  // Configure DO controller
     IPC_MSG_CONFIG_PRESSURE_CTRL  = 0x6F,  // Configure pressure controller
+    IPC_MSG_CONFIG_BEGIN          = 0x71,  // Start a configuration batch
+    IPC_MSG_CONFIG_BATCH          = 0x72,  // Packed configuration records
+    IPC_MSG_CONFIG_COMMIT         = 0x73,  // Apply the staged batch
+    IPC_MSG_CONFIG_RESULT         = 0x74,  // Batch result with per-record status
 };
 
 // ============================================================================
@@ -123,10 +139,40 @@ enum IPC_ErrorCode : uint8_t {
 
 // Handshake messages ----------------------------------------------------
 
+// Configuration sections covered by the handshake digest (one per record type)
+enum IPC_ConfigSection : uint8_t {
+    IPC_CONFIG_SECTION_ADC = 0,
+    IPC_CONFIG_SECTION_DAC,
+    IPC_CONFIG_SECTION_RTD,
+    IPC_CONFIG_SECTION_GPIO,
+    IPC_CONFIG_SECTION_DIGITAL_OUTPUT,
+    IPC_CONFIG_SECTION_STEPPER,
+    IPC_CONFIG_SECTION_DCMOTOR,
+    IPC_CONFIG_SECTION_COMPORT,
+    IPC_CONFIG_SECTION_DEVICE,
+    IPC_CONFIG_SECTION_PRESSURE_CTRL,
+    IPC_CONFIG_SECTION_TEMP_CTRL,
+    IPC_CONFIG_SECTION_PH_CTRL,
+    IPC_CONFIG_SECTION_FLOW_CTRL,
+    IPC_CONFIG_SECTION_DO_CTRL,
+    IPC_CONFIG_SECTION_COUNT
+};
+
+#define IPC_CONFIG_SECTION_NONE     0xFF
+#define IPC_CONFIG_SECTIONS_ALL     ((1u << IPC_CONFIG_SECTION_COUNT) - 1)
+
+struct IPC_ConfigDigest_t {
+    uint32_t overall;                            // Hash of the section digests (0 = nothing configured)
+    uint32_t section[IPC_CONFIG_SECTION_COUNT];  // Per-section content hash (0 = section empty)
+} __attribute__((packed));
+
 struct IPC_Hello_t {
     uint32_t protocolVersion;  // Protocol version (e.g., 0x00010000 = v1.0.0)
     uint32_t firmwareVersion;  // Firmware version
     char deviceName[32];       // Device identifier
+    uint8_t bulkWindow;        // Bulk/delta ranges the sender can queue (0 = accepts none)
+    IPC_ConfigDigest_t configDigest;  // IO MCU: applied configuration, SYS MCU: last pushed configuration
+    uint8_t baudRates;         // Supported link rates, bit n = ipc_baudRates[n]
 } __attribute__((packed));
 
 struct IPC_HelloAck_t {
@@ -134,6 +180,9 @@ struct IPC_HelloAck_t {
     uint32_t firmwareVersion;
     uint16_t maxObjectCount;   // Max objects supported
     uint16_t currentObjectCount;
+    uint8_t bulkWindow;        // Bulk/delta ranges the sender can queue (0 = accepts none)
+    IPC_ConfigDigest_t configDigest;  // IO MCU: applied configuration, SYS MCU: last pushed configuration
+    uint8_t baudRates;         // Supported link rates, bit n = ipc_baudRates[n]
 } __attribute__((packed));
 
 struct IPC_Error_t {
@@ -141,6 +190,94 @@ struct IPC_Error_t {
     char message[100];         // Error description
 } __attribute__((packed));
 
+// Link quality (v2.13) ---------------------------------------------------
+
+// PING carries the sender's micros() and its view of the link. PONG echoes that
+// timestamp, so the sender can time the round trip, and carries the responder's
+// view. Rates cover the last IPC_LINK_WINDOW_MS; byte counts are wire bytes
+// (framing and stuffing included) and utilisation assumes 10 bits per byte.
+// A PING/PONG without payload is still accepted as a plain keepalive.
+#define IPC_RTT_SAMPLES             32    // Round trips behind the RTT figures
+#define IPC_LINK_WINDOW_MS          1000  // Rate measurement window
+
+struct IPC_LinkStats_t {
+    uint32_t rttP50Us;         // Over the last IPC_RTT_SAMPLES round trips (0 = no sample yet)
+    uint32_t rttP90Us;
+    uint32_t rttMaxUs;
+    uint32_t rxBytesPerSec;
+    uint32_t txBytesPerSec;
+    uint32_t rxFrames;         // Valid frames received since statistics reset
+    uint32_t rxErrors;         // Rejected frames (CRC, length, overflow) since reset
+    uint32_t crcErrors;
+    uint32_t rxErrorPpm;       // rxErrors per million frames received since reset
+    uint32_t baudRate;
+    uint16_t rttSamples;       // Samples behind the RTT figures
+    uint16_t rxFramesPerSec;
+    uint16_t txFramesPerSec;
+    uint16_t rxUtilPermille;   // Share of the link bandwidth used (0.1 %)
+    uint16_t txUtilPermille;
+    uint16_t rxUtilPeakPermille;  // Busiest window since reset
+    uint16_t txUtilPeakPermille;
+    uint16_t txQueueHighWater; // Peak TX queue bytes in use
+    uint16_t txQueueSize;      // TX queue bytes
+    uint16_t rxBacklogHighWater;  // Most bytes waiting in the UART RX buffer at one update
+} __attribute__((packed));
+
+struct IPC_Ping_t {
+    uint32_t timestampUs;      // Sender micros(), echoed in PONG
+    IPC_LinkStats_t link;      // Sender's view of the link
+} __attribute__((packed));
+
+struct IPC_Pong_t {
+    uint32_t echoTimestampUs;  // From the PING being answered
+    IPC_LinkStats_t link;      // Responder's view of the link
+} __attribute__((packed));
+
+// Link baud rate (v2.14) -------------------------------------------------
+
+// HELLO / HELLO_ACK always run at IPC_BAUD_DEFAULT and advertise the rates each
+// side supports. Once connected the SYS MCU picks the highest common rate and
+// sends BAUD_SWITCH, then holds its TX. The IO MCU answers BAUD_SWITCH_ACK at
+// the old rate, switches once the ACK has left the UART and holds its TX until
+// the first LINK_TEST arrives at the new rate. The SYS MCU switches on the ACK
+// and, after IPC_BAUD_SETTLE_MS, sends IPC_LINK_TEST_FRAMES test patterns; each
+// is echoed back and compared before the next. The last one carries
+// IPC_LINK_TEST_COMMIT and is resent until its echo arrives. An IO MCU that has
+// not seen the commit IPC_BAUD_VERIFY_MS after switching returns to the
+// previous rate, and so does a SYS MCU whose test fails or whose commit is not
+// echoed. Both return to IPC_BAUD_DEFAULT when the connection is lost.
+#define IPC_BAUD_DEFAULT            2000000   // Handshake rate, always supported
+#define IPC_BAUD_RATE_COUNT         4
+#define IPC_BAUD_SETTLE_MS          10        // SYS MCU wait before the first LINK_TEST (IO MCU switches on its next update)
+#define IPC_BAUD_VERIFY_MS          250       // IO MCU: switch to commit, else revert
+#define IPC_LINK_TEST_FRAMES        4
+#define IPC_LINK_TEST_SIZE          256       // Pattern bytes: every byte value once, stuffing included
+#define IPC_LINK_TEST_COMMIT        0x01      // IPC_LinkTest_t flags: last test, keep the new rate
+
+static const uint32_t ipc_baudRates[IPC_BAUD_RATE_COUNT] = { 2000000, 3000000, 4000000, 6000000 };
+
+enum IPC_BaudReason : uint8_t {
+    IPC_BAUD_REASON_NEGOTIATED = 0,  // Highest common rate after the handshake
+    IPC_BAUD_REASON_FALLBACK   = 1   // Error rate over the threshold at the current rate
+};
+
+struct IPC_BaudSwitch_t {
+    uint32_t baudRate;         // One of ipc_baudRates
+    uint8_t reason;            // IPC_BaudReason
+} __attribute__((packed));
+
+struct IPC_BaudSwitchAck_t {
+    uint32_t baudRate;         // As requested
+    uint8_t accepted;          // 0 = unsupported or busy, rate unchanged
+} __attribute__((packed));
+
+struct IPC_LinkTest_t {
+    uint32_t baudRate;         // Rate being verified
+    uint8_t sequence;          // 0 .. IPC_LINK_TEST_FRAMES - 1
+    uint8_t flags;             // IPC_LINK_TEST_COMMIT
+    uint8_t pattern[IPC_LINK_TEST_SIZE];
+} __attribute__((packed));
+
 // Object Index messages -------------------------------------------------
 
 struct IPC_IndexEntry_t {
@@ -191,6 +328,22 @@ struct IPC_SensorBulkReadReq_t {
     uint16_t count;          // Number of consecutive indices to read
 } __attribute__((packed));
 
+// Sensor stream subscription (SYS -> IO)
+// IO MCU pushes SENSOR_DELTA records (header transactionId = IPC_TXN_NONE, no FINAL)
+// for each subscribed object when a value moves from the one last sent by more than
+// max(deadband, deadbandRel * |last sent|), its flags or strings change (rate-limited
+// to minIntervalMs), and at least every maxIntervalMs. Several objects share a frame.
+// Acknowledged with IPC_MSG_CONTROL_ACK carrying the request transaction ID.
+struct IPC_SensorStreamReq_t {
+    uint16_t transactionId;  // Request transaction ID (echoed in CONTROL_ACK)
+    uint16_t startIndex;     // Starting index
+    uint16_t count;          // Number of consecutive indices (0 = cancel all subscriptions)
+    uint16_t minIntervalMs;  // Minimum time between pushes for one object
+    uint16_t maxIntervalMs;  // Heartbeat interval (0 = push on change only)
+    float deadband;          // Absolute change in any value required to push
+    float deadbandRel;       // Change relative to the last sent value (0.01 = 1%)
+} __attribute__((packed));
+
 struct IPC_SensorData_t {
     uint16_t transactionId;  // Transaction ID from request (for response matching)
     uint16_t index;
@@ -218,6 +371,192 @@ struct IPC_SensorBatch_t {
     IPC_SensorBatchEntry_t sensors[20];  // Up to 20 sensors per batch
 } __attribute__((packed));
 
+// Delta-encoded sensor batch
+// Request: IPC_SensorDeltaReq_t. Response: one or more IPC_MSG_SENSOR_DELTA frames,
+// each an IPC_SensorDeltaHeader_t followed by recordCount variable-length records.
+// Only objects that changed since they were last sent are included. The frame with
+// IPC_DELTA_FLAG_FINAL set closes the transaction and confirms every object in
+// [startIndex, startIndex + count) that was not sent is unchanged.
+//
+// Record layout:
+//   uint8_t index
+//   uint8_t flags                    IPC_SENSOR_FLAG_xxx
+//   uint8_t fields                   IPC_DELTA_FIELD_xxx (bits 0-2: additional value count)
+//   [uint8_t objectType]             if IPC_DELTA_FIELD_TYPE
+//   float value                      unless IPC_DELTA_FIELD_REMOVED
+//   float additionalValues[n]
+//   [uint8_t len, char unit[len]]    if IPC_DELTA_FIELD_UNIT
+//   [n x (uint8_t len, char[len])]   if IPC_DELTA_FIELD_EXTRA_UNITS
+//   [uint8_t len, char msg[len]]     if IPC_DELTA_FIELD_MSG
+struct IPC_SensorDeltaReq_t {
+    uint16_t transactionId;  // Request transaction ID (echoed in all response frames)
+    uint16_t startIndex;     // Starting index
+    uint16_t count;          // Number of consecutive indices
+    uint8_t flags;           // IPC_DELTA_REQ_xxx
+} __attribute__((packed));
+
+struct IPC_SensorDeltaHeader_t {
+    uint16_t transactionId;  // Transaction ID from request
+    uint16_t sequence;       // Per-link frame counter (gap = lost frame, request resync)
+    uint8_t flags;           // IPC_DELTA_FLAG_xxx
+    uint8_t startIndex;      // Requested range (for FINAL frame)
+    uint8_t count;
+    uint8_t recordCount;     // Records following this header
+} __attribute__((packed));
+
+#define IPC_DELTA_REQ_RESYNC        (1 << 0)  // Forget sent state, send every object in full
+
+#define IPC_DELTA_FLAG_FINAL        (1 << 0)  // Last frame for this transaction
+#define IPC_DELTA_FLAG_FULL         (1 << 1)  // Response to a resync request
+
+#define IPC_DELTA_FIELD_VALUES_MASK 0x07      // Number of additional values (0-4)
+#define IPC_DELTA_FIELD_TYPE        (1 << 3)  // objectType byte present
+#define IPC_DELTA_FIELD_UNIT        (1 << 4)  // Primary unit string present
+#define IPC_DELTA_FIELD_EXTRA_UNITS (1 << 5)  // Additional unit strings present
+#define IPC_DELTA_FIELD_MSG         (1 << 6)  // Message string present
+#define IPC_DELTA_FIELD_REMOVED     (1 << 7)  // Object no longer exists (no further fields)
+
+#define IPC_DELTA_MAX_RECORD_SIZE   (3 + 1 + 4 + 16 + 8 + 4 * 8 + 100)
+
+// Bulk request window
+// The IO MCU queues up to bulkWindow (from HELLO/HELLO_ACK) SENSOR_BULK_READ_REQ and
+// SENSOR_DELTA_REQ ranges. Each range ends with exactly one BULK_CREDIT, sent after
+// its last data frame, which completes the transaction and frees its window slot.
+// A request that cannot be queued is answered with IPC_BULK_CREDIT_REFUSED.
+struct IPC_BulkCredit_t {
+    uint16_t transactionId;  // Transaction ID of the bulk/delta request
+    uint8_t status;          // IPC_BULK_CREDIT_xxx
+    uint8_t credit;          // Free range slots on the IO MCU after this one
+} __attribute__((packed));
+
+#define IPC_BULK_CREDIT_DONE        0  // All frames for the range have been sent
+#define IPC_BULK_CREDIT_REFUSED     1  // Range was not queued (invalid or no free slot)
+
+// Scheduler diagnostics --------------------------------------------------
+
+// TASK_STATS_REQ asks for a page of the IO MCU scheduler task table starting at
+// startTask; the reply carries up to IPC_TASK_STATS_PER_FRAME entries and the
+// total task count, so the SYS MCU requests the next page until it has them all.
+#define IPC_TASK_NAME_LEN           16
+#define IPC_TASK_HIST_BUCKETS       16    // log2 buckets: [0] = 0 us, [n] = 2^(n-1)..2^n - 1 us, last open-ended
+#define IPC_TASK_STATS_PER_FRAME    8
+
+#define IPC_TASK_STATS_REQ_RESET    (1 << 0)  // Reset all task statistics after this page is captured
+
+struct IPC_TaskStatsReq_t {
+    uint16_t transactionId;
+    uint8_t startTask;       // First task table entry wanted
+    uint8_t flags;           // IPC_TASK_STATS_REQ_xxx
+} __attribute__((packed));
+
+#define IPC_TASK_FLAG_HIGH_PRIORITY (1 << 0)
+#define IPC_TASK_FLAG_PAUSED        (1 << 1)
+#define IPC_TASK_FLAG_FIXED_RATE    (1 << 2)
+#define IPC_TASK_FLAG_EVENT         (1 << 3)   // Event-driven (interval is a fallback)
+
+struct IPC_TaskStatsEntry_t {
+    char name[IPC_TASK_NAME_LEN];
+    uint32_t intervalUs;
+    uint32_t budgetUs;       // Execution time above this counts as an overrun (0 = no budget)
+    uint32_t execCount;
+    uint32_t overrunCount;
+    uint32_t missedPeriods;  // Fixed-rate periods skipped to catch up
+    uint32_t avgExecUs;
+    uint32_t maxExecUs;
+    uint32_t maxLatenessUs;  // Worst start delay behind the deadline
+    uint16_t cpuPermille;    // CPU share over the last 10 s window (0.1 %)
+    uint8_t flags;           // IPC_TASK_FLAG_xxx
+    uint8_t reserved;
+    uint16_t execHist[IPC_TASK_HIST_BUCKETS];      // Execution time histogram
+    uint16_t latenessHist[IPC_TASK_HIST_BUCKETS];  // Start lateness histogram
+} __attribute__((packed));
+
+struct IPC_TaskStats_t {
+    uint16_t transactionId;  // From TASK_STATS_REQ
+    uint8_t totalTasks;      // Tasks in the table
+    uint8_t startTask;       // Table index of task[0]
+    uint8_t count;           // Entries in this frame (frame is trimmed to count)
+    uint8_t reserved;
+    uint16_t idlePermille;   // Time spent idle (WFI) over the last 10 s window (0.1 %)
+    uint32_t uptimeMs;
+    IPC_TaskStatsEntry_t task[IPC_TASK_STATS_PER_FRAME];
+} __attribute__((packed));
+
+// ADC burst capture (v2.17) ----------------------------------------------
+
+// ADC_CAPTURE_ARM switches the MCP346x to a fast scan of the selected channels
+// and records raw codes into a RAM ring on the IO MCU until the trigger has
+// fired and lengthScans scans (preTriggerScans of them from before the
+// trigger) are held. The SYS MCU polls with ADC_CAPTURE_REQ STATUS, then reads
+// the block with READ requests, one ADC_CAPTURE_DATA chunk per request.
+// Samples are scan-interleaved: scan s, k-th enabled channel (ascending) is
+// sample s * channels + k. The normal scan resumes when the capture completes.
+#define IPC_ADC_CAPTURE_MAX_SAMPLES     16384   // IO MCU ring, lengthScans * channels must fit
+#define IPC_ADC_CAPTURE_MAX_RATE        8000    // Conversions per second (rate * channels)
+#define IPC_ADC_CAPTURE_CHUNK_SAMPLES   504     // Samples per ADC_CAPTURE_DATA frame
+
+#define IPC_ADC_TRIG_IMMEDIATE      0   // Trigger as soon as the pre-trigger scans are in
+#define IPC_ADC_TRIG_RISING         1   // Trigger channel crosses triggerLevel upwards
+#define IPC_ADC_TRIG_FALLING        2   // ... downwards
+#define IPC_ADC_TRIG_EITHER         3   // Either direction
+
+struct IPC_AdcCaptureArm_t {
+    uint16_t transactionId;
+    uint8_t channelMask;     // Bit n = ADC channel n
+    uint8_t trigger;         // IPC_ADC_TRIG_*
+    uint8_t triggerChannel;  // 0-7, must be in channelMask unless IMMEDIATE
+    uint8_t reserved;
+    uint16_t sampleRateHz;   // Scans per second wanted (clamped to IPC_ADC_CAPTURE_MAX_RATE / channels)
+    uint16_t preTriggerScans;
+    uint16_t lengthScans;    // Total scans, pre-trigger included
+    uint32_t triggerTimeoutMs;  // Trigger anyway after this long (0 = wait for the trigger)
+    float triggerLevel;      // In the trigger channel's configured unit
+} __attribute__((packed));
+
+#define IPC_ADC_CAPTURE_OP_STATUS   0   // Reply ADC_CAPTURE_STATUS
+#define IPC_ADC_CAPTURE_OP_READ     1   // Reply ADC_CAPTURE_DATA from sample offset
+#define IPC_ADC_CAPTURE_OP_ABORT    2   // Stop, release the block, reply ADC_CAPTURE_STATUS
+
+struct IPC_AdcCaptureReq_t {
+    uint16_t transactionId;
+    uint8_t op;              // IPC_ADC_CAPTURE_OP_*
+    uint8_t reserved;
+    uint32_t offset;         // READ: first sample wanted
+} __attribute__((packed));
+
+#define IPC_ADC_CAPTURE_IDLE        0   // No capture (or aborted)
+#define IPC_ADC_CAPTURE_ARMED       1   // Filling the pre-trigger scans / waiting for the trigger
+#define IPC_ADC_CAPTURE_TRIGGERED   2   // Filling the post-trigger scans
+#define IPC_ADC_CAPTURE_COMPLETE    3   // Block ready to read
+#define IPC_ADC_CAPTURE_FAILED      4   // ADC could not be switched to the capture scan
+
+#define IPC_ADC_CAPTURE_FLAG_REFUSED    (1 << 0)  // ARM rejected (bad mask, length or trigger channel)
+#define IPC_ADC_CAPTURE_FLAG_TIMEOUT    (1 << 1)  // Triggered by triggerTimeoutMs, not the level
+#define IPC_ADC_CAPTURE_FLAG_OVERRUN    (1 << 2)  // Conversions were missed (see missedSamples)
+#define IPC_ADC_CAPTURE_FLAG_CLAMPED    (1 << 3)  // sampleRateHz was above the limit
+
+struct IPC_AdcCaptureStatus_t {
+    uint16_t transactionId;  // From ADC_CAPTURE_ARM / ADC_CAPTURE_REQ
+    uint8_t state;           // IPC_ADC_CAPTURE_*
+    uint8_t flags;           // IPC_ADC_CAPTURE_FLAG_*
+    uint8_t channelMask;
+    uint8_t channels;        // Channels per scan
+    uint16_t preTriggerScans;   // Scans before the trigger scan
+    uint16_t lengthScans;
+    uint16_t scansCaptured;  // Scans held so far
+    uint32_t scanPeriodNs;   // Measured scan period (0 until two scans are in)
+    uint32_t missedSamples;  // Conversions lost and filled with the channel's previous code
+    float gain[8];           // value = code * gain + offset, per channel, at arm time
+    float offset[8];
+} __attribute__((packed));
+
+struct IPC_AdcCaptureData_t {
+    uint16_t transactionId;  // From ADC_CAPTURE_REQ READ
+    uint16_t count;          // Samples in this frame (frame is trimmed to count, 0 past the end)
+    uint32_t offset;         // Sample index of sample[0]
+    int16_t sample[IPC_ADC_CAPTURE_CHUNK_SAMPLES];  // Raw MCP346x codes, unfiltered
+} __attribute__((packed));
+
 // Control Data messages -------------------------------------------------
 
 // Control loop parameter types (for PID controllers, sequencers, etc.)
@@ -539,10 +878,74 @@ struct IPC_ConfigWrite_t {
     char message[100];
 } __attribute__((packed));
 
+// Configuration batch (v2.10) -------------------------------------------
+// A full configuration push is one transaction: CONFIG_BEGIN, one or more
+// CONFIG_BATCH frames of packed records, then CONFIG_COMMIT. The IO MCU stages
+// the records and applies all of them in one pass on commit, then answers with
+// a single CONFIG_RESULT carrying a status byte per record. A batch with a
+// missing or malformed frame is rejected as a whole (nothing is applied).
+// Each record is an IPC_ConfigRecord_t header followed by the payload of the
+// standalone message (CONFIG_* or DEVICE_CREATE) it replaces.
+
+#define IPC_CONFIG_MAX_RECORDS      96    // Records per batch (full config is ~85)
+#define IPC_CONFIG_STAGING_SIZE     4096  // Record bytes per batch, headers included
+
+struct IPC_ConfigBegin_t {
+    uint16_t transactionId;  // Batch transaction ID (echoed in CONFIG_RESULT)
+    uint16_t recordCount;    // Records that will follow
+    uint16_t totalBytes;     // Record bytes that will follow, headers included
+    uint16_t sectionMask;    // Sections this batch replaces (bit = IPC_ConfigSection)
+} __attribute__((packed));
+
+struct IPC_ConfigBatchHeader_t {
+    uint16_t transactionId;
+    uint16_t firstRecord;    // Sequence number of the first record in this frame
+    uint8_t recordCount;     // Records following this header
+} __attribute__((packed));
+
+struct IPC_ConfigRecord_t {
+    uint8_t msgType;         // IPC_MSG_CONFIG_* / IPC_MSG_DEVICE_CREATE
+    uint16_t length;         // Payload bytes following this header
+} __attribute__((packed));
+
+struct IPC_ConfigCommit_t {
+    uint16_t transactionId;
+    uint16_t recordCount;    // Records sent (must match CONFIG_BEGIN)
+} __attribute__((packed));
+
+struct IPC_ConfigResult_t {
+    uint16_t transactionId;
+    uint8_t status;          // IPC_CONFIG_BATCH_xxx
+    uint16_t recordCount;    // Records in the batch
+    uint16_t appliedCount;   // Records applied without error
+    uint8_t recordStatus[IPC_CONFIG_MAX_RECORDS];  // IPC_CONFIG_REC_xxx, in record order
+} __attribute__((packed));
+
+#define IPC_CONFIG_BATCH_APPLIED    0  // All records were applied (see recordStatus)
+#define IPC_CONFIG_BATCH_INCOMPLETE 1  // Frame missing or out of sequence - nothing applied
+#define IPC_CONFIG_BATCH_MALFORMED  2  // Bad record or batch too large - nothing applied
+
+#define IPC_CONFIG_REC_OK           0  // Applied
+#define IPC_CONFIG_REC_FAILED       1  // Handler rejected the configuration
+#define IPC_CONFIG_REC_ERROR        2  // Invalid payload or object index
+#define IPC_CONFIG_REC_UNSUPPORTED  3  // Message type not allowed in a batch
+#define IPC_CONFIG_REC_NOT_APPLIED  4  // Batch was rejected
+
 // ============================================================================
 // OBJECT CONFIGURATION MESSAGES
 // ============================================================================
 
+/**
+ * @brief Analog input filters (v2.16), run on the IO MCU at the ADC scan rate
+ * Senders older than v2.16 omit filterType/filterLength: no filter.
+ */
+#define IPC_ADC_FILTER_NONE             0
+#define IPC_ADC_FILTER_MOVING_AVERAGE   1   // Mean of the last N samples (N <= 32)
+#define IPC_ADC_FILTER_IIR              2   // Single pole, time constant N samples (N <= 32)
+#define IPC_ADC_FILTER_MEDIAN           3   // Median of the last N samples (N <= 15)
+#define IPC_ADC_FILTER_CIC              4   // 3rd order CIC, decimates by N (N <= 16)
+#define IPC_CONFIG_ANALOG_INPUT_V1_SIZE 20  // Pre-v2.16 IPC_ConfigAnalogInput_t
+
 /**
  * @brief Analog Input (ADC) configuration
  * Message type: IPC_MSG_CONFIG_ANALOG_INPUT
@@ -553,6 +956,8 @@ struct IPC_ConfigAnalogInput_t {
     char unit[8];            // Unit string (e.g., "mV", "V", "A")
     float calScale;          // Calibration scale factor
     float calOffset;         // Calibration offset
+    uint8_t filterType;      // IPC_ADC_FILTER_* (v2.16)
+    uint8_t filterLength;    // Window / IIR time constant / CIC decimation, in samples
 } __attribute__((packed));
 
 /**
@@ -580,7 +985,7 @@ struct IPC_ConfigRTD_t {
     float calScale;          // Calibration scale
     float calOffset;         // Calibration offset
     uint16_t nominalOhms;    // 100 (PT100) or 1000 (PT1000)
-    uint8_t _padding2[2];    // Alignment padding
+    uint16_t samplePeriodMs; // 17-60000 ms, 0 = default 200 ms (v2.15, was padding)
 } __attribute__((packed));
 
 /**
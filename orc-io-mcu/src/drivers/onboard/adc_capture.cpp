@@ -0,0 +1,272 @@
+#include "adc_capture.h"
+#include "drv_adc.h"
+
+int16_t adcCaptureRing[IPC_ADC_CAPTURE_MAX_SAMPLES];
+
+// DMCLK = MCLK / 4 with AMCLK = MCLK. A SCAN conversion starts from a fresh
+// MUX setting, so the sinc3 filter has to settle: about 3 OSR periods each.
+#define ADC_CAPTURE_DMCLK_HZ        (ADC_CAPTURE_MCLK_HZ / 4)
+#define ADC_CAPTURE_SETTLE_FACTOR   3
+#define ADC_CAPTURE_TIMER_MAX       0xFFFFFFUL
+
+// Oversampling ratio of each MCP346X_OSR_*_bm code (code = bm >> 2)
+static const uint32_t osrRatio[16] = {
+    32, 64, 128, 256, 512, 1024, 2048, 4096,
+    8192, 16384, 20480, 24576, 40960, 49152, 81920, 98304
+};
+
+struct ADCCapture_t {
+    uint8_t state;              // IPC_ADC_CAPTURE_*
+    uint8_t flags;              // IPC_ADC_CAPTURE_FLAG_*
+    uint8_t mask;
+    uint8_t channels;
+    uint8_t lastChannel;        // Highest channel: its conversion closes a scan
+    uint8_t rank[ADC_NUM_CHANNELS];     // Position of each channel within a scan
+    uint8_t seen;               // Channels stored for the scan in progress
+    bool synced;                // First scan boundary seen since arming
+    int16_t lastCode[ADC_NUM_CHANNELS];
+
+    uint8_t trigger;
+    uint8_t triggerChannel;
+    int32_t triggerCode;
+    bool above;                 // Trigger channel was at or above triggerCode last scan
+
+    uint16_t preScans;
+    uint16_t lengthScans;       // Ring size in scans
+    uint16_t slot;              // Ring scan being filled
+    uint16_t held;              // Scans in the ring
+    uint16_t postLeft;          // Post-trigger scans still to fill
+    uint16_t start;             // First scan of the frozen block
+    uint32_t scans;             // Scans completed since arming
+
+    uint32_t armedMs;
+    uint32_t timeoutMs;
+    uint32_t firstScanUs;
+    uint32_t lastScanUs;
+    uint32_t missed;
+    float gain[ADC_NUM_CHANNELS];       // Conversion at arm time, for the SYS MCU
+    float offset[ADC_NUM_CHANNELS];
+};
+
+static ADCCapture_t capture;
+static uint8_t frozenMask;      // Inputs left out of the capture scan
+
+// Inputs outside the capture scan are not converted and hold their last
+// value: flag them fault (controllers check it, the SYS MCU gets
+// IPC_SENSOR_FLAG_FAULT) until the normal scan is back
+static void setFrozen(uint8_t mask) {
+    uint8_t changed = mask ^ frozenMask;
+    for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+        if (!(changed & (1 << i))) continue;
+        bool frozen = mask & (1 << i);
+        AnalogInput_t *input = adcDriver.inputObj[i];
+        input->fault = frozen;
+        input->newMessage = true;
+        strcpy(input->message, frozen ? "Not sampled during ADC capture, value frozen" : "Sampling resumed");
+    }
+    frozenMask = mask;
+}
+
+// Back to the normal scan. The inputs stay flagged if that failed.
+static void restoreScan(void) {
+    if (ADC_restoreScan()) setFrozen(0);
+}
+
+void ADC_captureTiming(uint8_t channels, uint32_t rateHz, uint8_t *osr, uint32_t *timer) {
+    uint32_t scanCycles = ADC_CAPTURE_DMCLK_HZ / (rateHz ? rateHz : 1);
+    uint8_t code = 0;
+    for (uint8_t i = 15; i > 0; i--) {
+        if (channels * osrRatio[i] * ADC_CAPTURE_SETTLE_FACTOR <= scanCycles) {
+            code = i;
+            break;
+        }
+    }
+    uint32_t convCycles = channels * osrRatio[code] * ADC_CAPTURE_SETTLE_FACTOR;
+    uint32_t delay = scanCycles > convCycles ? scanCycles - convCycles : 0;
+    *osr = code << 2;
+    *timer = min(delay, ADC_CAPTURE_TIMER_MAX);
+}
+
+uint32_t ADC_captureScanPeriodUs(uint8_t channels, uint8_t osr, uint32_t timer) {
+    uint64_t cycles = (uint64_t)channels * osrRatio[(osr >> 2) & 0x0F] * ADC_CAPTURE_SETTLE_FACTOR + timer;
+    return (uint32_t)(cycles * 1000000ULL / ADC_CAPTURE_DMCLK_HZ);
+}
+
+bool ADC_captureArm(const IPC_AdcCaptureArm_t *arm) {
+    uint8_t channels = __builtin_popcount(arm->channelMask);
+    if (channels == 0 || arm->lengthScans == 0 || arm->preTriggerScans >= arm->lengthScans ||
+        (uint32_t)arm->lengthScans * channels > IPC_ADC_CAPTURE_MAX_SAMPLES || arm->trigger > IPC_ADC_TRIG_EITHER) {
+        return false;
+    }
+    if (arm->trigger != IPC_ADC_TRIG_IMMEDIATE &&
+        (arm->triggerChannel >= ADC_NUM_CHANNELS || !(arm->channelMask & (1 << arm->triggerChannel)))) {
+        return false;
+    }
+
+    memset(&capture, 0, sizeof(capture));
+    capture.mask = arm->channelMask;
+    capture.channels = channels;
+    for (uint8_t ch = 0, k = 0; ch < ADC_NUM_CHANNELS; ch++) {
+        if (!(capture.mask & (1 << ch))) continue;
+        capture.rank[ch] = k++;
+        capture.lastChannel = ch;
+    }
+    memcpy(capture.gain, adcDriver.pipeline.gain, sizeof(capture.gain));
+    memcpy(capture.offset, adcDriver.pipeline.offset, sizeof(capture.offset));
+
+    // Level in the channel's unit back to a raw code (value = code * gain + offset)
+    capture.trigger = arm->trigger;
+    if (arm->trigger != IPC_ADC_TRIG_IMMEDIATE) {
+        capture.triggerChannel = arm->triggerChannel;
+        float gain = capture.gain[arm->triggerChannel];
+        float code = gain != 0.0f ? (arm->triggerLevel - capture.offset[arm->triggerChannel]) / gain : 0.0f;
+        capture.triggerCode = (int32_t)lroundf(constrain(code, -32768.0f, 32767.0f));
+    }
+
+    capture.preScans = arm->preTriggerScans;
+    capture.lengthScans = arm->lengthScans;
+    capture.timeoutMs = arm->triggerTimeoutMs;
+
+    uint32_t rate = arm->sampleRateHz;
+    uint32_t maxRate = IPC_ADC_CAPTURE_MAX_RATE / channels;
+    if (rate == 0 || rate > maxRate) {
+        if (rate > maxRate) capture.flags |= IPC_ADC_CAPTURE_FLAG_CLAMPED;
+        rate = maxRate;
+    }
+    uint8_t osr;
+    uint32_t timer;
+    ADC_captureTiming(channels, rate, &osr, &timer);
+
+    capture.armedMs = millis();
+    capture.state = IPC_ADC_CAPTURE_ARMED;
+    setFrozen(~capture.mask & ((1 << ADC_NUM_CHANNELS) - 1));
+    if (!ADC_setCaptureScan(capture.mask, osr, timer)) {
+        capture.state = IPC_ADC_CAPTURE_FAILED;
+        restoreScan();
+        return false;
+    }
+    return true;
+}
+
+void ADC_captureAbort(void) {
+    if (ADC_captureRunning()) {
+        restoreScan();
+    }
+    capture.state = IPC_ADC_CAPTURE_IDLE;
+    capture.held = 0;
+}
+
+bool ADC_captureRunning(void) {
+    return capture.state == IPC_ADC_CAPTURE_ARMED || capture.state == IPC_ADC_CAPTURE_TRIGGERED;
+}
+
+static bool triggerFired(void) {
+    bool wasAbove = capture.above;
+    bool above = capture.lastCode[capture.triggerChannel] >= capture.triggerCode;
+    capture.above = above;
+
+    if (capture.scans < capture.preScans) return false;      // Pre-trigger history not full yet
+    if (capture.trigger == IPC_ADC_TRIG_IMMEDIATE) return true;
+    if (capture.scans > 0) {                                 // Needs a previous scan to cross from
+        if ((capture.trigger & IPC_ADC_TRIG_RISING) && above && !wasAbove) return true;
+        if ((capture.trigger & IPC_ADC_TRIG_FALLING) && !above && wasAbove) return true;
+    }
+
+    if (capture.timeoutMs && millis() - capture.armedMs >= capture.timeoutMs) {
+        capture.flags |= IPC_ADC_CAPTURE_FLAG_TIMEOUT;
+        return true;
+    }
+    return false;
+}
+
+// The scan in the current slot is done: fill any conversion that was missed,
+// then run the trigger and advance the ring
+static void scanComplete(uint32_t timeUs) {
+    uint8_t missing = capture.mask & ~capture.seen;
+    if (missing) {
+        int16_t *scan = &adcCaptureRing[(uint32_t)capture.slot * capture.channels];
+        for (uint8_t ch = 0; ch < ADC_NUM_CHANNELS; ch++) {
+            if (!(missing & (1 << ch))) continue;
+            scan[capture.rank[ch]] = capture.lastCode[ch];
+            capture.missed++;
+        }
+        capture.flags |= IPC_ADC_CAPTURE_FLAG_OVERRUN;
+    }
+    capture.seen = 0;
+
+    if (capture.scans == 0) capture.firstScanUs = timeUs;
+    capture.lastScanUs = timeUs;
+
+    if (capture.state == IPC_ADC_CAPTURE_ARMED && triggerFired()) {
+        capture.state = IPC_ADC_CAPTURE_TRIGGERED;
+        capture.postLeft = capture.lengthScans - capture.preScans;
+        capture.start = (capture.slot + capture.lengthScans - capture.preScans) % capture.lengthScans;
+    }
+    capture.scans++;
+    if (capture.held < capture.lengthScans) capture.held++;
+    capture.slot = (capture.slot + 1 == capture.lengthScans) ? 0 : capture.slot + 1;
+
+    if (capture.state == IPC_ADC_CAPTURE_TRIGGERED && --capture.postLeft == 0) {
+        capture.state = IPC_ADC_CAPTURE_COMPLETE;
+        restoreScan();
+    }
+}
+
+void ADC_captureInput(uint8_t channel, int32_t code, uint32_t timeUs) {
+    if (!ADC_captureRunning() || channel >= ADC_NUM_CHANNELS) return;
+    uint8_t bit = 1 << channel;
+    if (!(capture.mask & bit)) return;
+
+    // Conversions of the scan that was running when armed are skipped
+    if (!capture.synced) {
+        if (capture.rank[channel] != 0) return;
+        capture.synced = true;
+    }
+
+    // Scans run in ascending channel order: a channel at or below one already
+    // stored starts the next scan, so the end of this one was lost
+    if (capture.seen & ~(bit - 1)) {
+        scanComplete(capture.lastScanUs);
+        if (!ADC_captureRunning()) return;
+    }
+
+    int16_t sample = (int16_t)constrain(code, -32768, 32767);
+    adcCaptureRing[(uint32_t)capture.slot * capture.channels + capture.rank[channel]] = sample;
+    capture.lastCode[channel] = sample;
+    capture.seen |= bit;
+    if (channel == capture.lastChannel) {
+        scanComplete(timeUs);
+    }
+}
+
+void ADC_captureGetStatus(IPC_AdcCaptureStatus_t *status) {
+    status->state = capture.state;
+    status->flags = capture.flags;
+    status->channelMask = capture.mask;
+    status->channels = capture.channels;
+    status->preTriggerScans = capture.preScans;
+    status->lengthScans = capture.lengthScans;
+    status->scansCaptured = capture.held;
+    status->scanPeriodNs = 0;
+    if (capture.scans > 1) {
+        uint64_t spanNs = (uint64_t)(capture.lastScanUs - capture.firstScanUs) * 1000ULL;
+        status->scanPeriodNs = (uint32_t)(spanNs / (capture.scans - 1));
+    }
+    status->missedSamples = capture.missed;
+    memcpy(status->gain, capture.gain, sizeof(status->gain));
+    memcpy(status->offset, capture.offset, sizeof(status->offset));
+}
+
+uint16_t ADC_captureRead(uint32_t offset, void *dst, uint16_t maxCount) {
+    if (capture.state != IPC_ADC_CAPTURE_COMPLETE) return 0;
+    uint32_t total = (uint32_t)capture.lengthScans * capture.channels;
+    if (offset >= total) return 0;
+    uint16_t count = min((uint32_t)maxCount, total - offset);
+
+    // Block starts at scan 'start' and may wrap the ring
+    uint32_t pos = ((uint32_t)capture.start * capture.channels + offset) % total;
+    uint32_t first = min((uint32_t)count, total - pos);
+    memcpy(dst, &adcCaptureRing[pos], first * sizeof(int16_t));
+    memcpy((uint8_t*)dst + first * sizeof(int16_t), adcCaptureRing, (count - first) * sizeof(int16_t));
+    return count;
+}
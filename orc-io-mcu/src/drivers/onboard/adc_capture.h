@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../ipc/ipc_protocol.h"
+
+// ADC burst capture (IPC v2.17, see IPC_AdcCaptureArm_t).
+//
+// Arming switches the MCP346x from the normal slow scan to a fast continuous
+// scan of the capture channels, paced to the requested rate with the SCAN
+// TIMER, and every conversion read by ADC_update() is also stored here as a
+// raw 16-bit code. The ring holds lengthScans scans: while armed it keeps the
+// newest ones so the pre-trigger history is there when the trigger fires, then
+// fills the post-trigger scans and freezes. The normal scan is restored as
+// soon as the block is complete (or the capture is aborted).
+//
+// Inputs outside the channel mask are not converted while a capture runs, so
+// their value freezes. They are flagged fault, with a message saying why,
+// from arming until the normal scan is back.
+//
+// Everything runs in the ADC task; the IPC handlers only read the frozen block.
+
+#define ADC_CAPTURE_MCLK_HZ     4915200UL   // Nominal MCP346x internal clock; the real scan period is measured
+
+// Ring, in samples (scan-interleaved, see IPC_AdcCaptureArm_t)
+extern int16_t adcCaptureRing[IPC_ADC_CAPTURE_MAX_SAMPLES];
+
+// Start a capture, replacing any capture in progress. Returns false (and
+// leaves the previous block untouched) if the request is invalid, or false
+// with the state FAILED if the ADC could not be switched to the capture scan.
+bool ADC_captureArm(const IPC_AdcCaptureArm_t *arm);
+void ADC_captureAbort(void);
+bool ADC_captureRunning(void);          // Armed or triggered: ADC_update() feeds ADC_captureInput()
+
+// One conversion from the MCP346x; timeUs is the data-ready time
+void ADC_captureInput(uint8_t channel, int32_t code, uint32_t timeUs);
+
+void ADC_captureGetStatus(IPC_AdcCaptureStatus_t *status);     // transactionId is left to the caller
+
+// Copy up to maxCount samples of a complete block from sample offset, oldest
+// first, to dst (need not be aligned). Returns the number copied (0 past the
+// end or with no complete block).
+uint16_t ADC_captureRead(uint32_t offset, void *dst, uint16_t maxCount);
+
+// Scan timing for a capture: the OSR (MCP346X_OSR_*_bm) and TIMER delay
+// that give the requested scan rate with the most oversampling, and the scan
+// period those settings give at the nominal clock
+void ADC_captureTiming(uint8_t channels, uint32_t rateHz, uint8_t *osr, uint32_t *timer);
+uint32_t ADC_captureScanPeriodUs(uint8_t channels, uint8_t osr, uint32_t timer);
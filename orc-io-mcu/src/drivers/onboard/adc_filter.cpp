@@ -0,0 +1,121 @@
+#include "adc_filter.h"
+
+#include <string.h>
+
+// Next ring position without a compare-and-branch
+static inline uint8_t ringNext(uint8_t pos, uint8_t length) {
+    uint8_t next = pos + 1;
+    return next * (uint8_t)(next < length);
+}
+
+static bool kernelNone(ADCFilter_t *f, int32_t x, float *out) {
+    (void)f;
+    *out = (float)x;
+    return true;
+}
+
+static bool kernelMovingAverage(ADCFilter_t *f, int32_t x, float *out) {
+    f->sum += x - f->ring[f->pos];
+    f->ring[f->pos] = x;
+    f->pos = ringNext(f->pos, f->length);
+    *out = (float)f->sum * f->invLength;
+    return true;
+}
+
+static bool kernelIIR(ADCFilter_t *f, int32_t x, float *out) {
+    f->iir += ((float)x - f->iir) * f->invLength;
+    *out = f->iir;
+    return true;
+}
+
+// Rank selection: the element with exactly N/2 smaller ones (ties broken by
+// position) is the median. Ranks are a permutation of 0..N-1, so exactly one
+// element is picked and the select is a multiply. Fixed N^2 compares, no
+// data-dependent branches
+static bool kernelMedian(ADCFilter_t *f, int32_t x, float *out) {
+    const uint8_t n = f->length;
+    f->ring[f->pos] = x;
+    f->pos = ringNext(f->pos, n);
+
+    int32_t median = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        const int32_t v = f->ring[i];
+        uint8_t rank = 0;
+        for (uint8_t j = 0; j < n; j++) {
+            const int32_t w = f->ring[j];
+            rank += (uint8_t)(w < v) + (uint8_t)((w == v) & (j < i));
+        }
+        median += v * (int32_t)(rank == n / 2);
+    }
+
+    *out = (float)median;
+    return true;
+}
+
+static bool kernelCIC(ADCFilter_t *f, int32_t x, float *out) {
+    f->integrator[0] += (uint32_t)x;
+    f->integrator[1] += f->integrator[0];
+    f->integrator[2] += f->integrator[1];
+    f->pos = ringNext(f->pos, f->length);
+    if (f->pos != 0) return false;      // Decimation phase, not data
+
+    uint32_t y = f->integrator[2];
+    for (int s = 0; s < ADC_FILTER_CIC_ORDER; s++) {
+        uint32_t delayed = f->comb[s];
+        f->comb[s] = y;
+        y -= delayed;
+    }
+    *out = (float)(int32_t)y * f->invLength;
+    return true;
+}
+
+static const ADCFilterKernel steadyKernels[ADC_FILTER_TYPE_COUNT] = {
+    kernelNone, kernelMovingAverage, kernelIIR, kernelMedian, kernelCIC
+};
+
+// First code after a reset: fill the history as if the input had always been x
+static bool kernelPrime(ADCFilter_t *f, int32_t x, float *out) {
+    for (uint8_t i = 0; i < f->length; i++) f->ring[i] = x;
+    f->sum = x * (int32_t)f->length;
+    f->iir = (float)x;
+    if (f->type == ADC_FILTER_CIC) {
+        // Flush the combs with a constant input, ending on a decimation boundary
+        for (int n = 0; n < ADC_FILTER_CIC_ORDER * f->length; n++) {
+            float discard;
+            kernelCIC(f, x, &discard);
+        }
+    }
+    f->kernel = f->steady;
+    // The primed output is x, for CIC too although its decimation phase has
+    // only just restarted: the previous filter's value must not hold over
+    if (!f->kernel(f, x, out)) *out = (float)x;
+    return true;
+}
+
+uint8_t ADC_filterLength(uint8_t type, uint8_t length) {
+    if (type == ADC_FILTER_NONE || type >= ADC_FILTER_TYPE_COUNT) return 1;
+    uint8_t limit = ADC_FILTER_MAX_LENGTH;
+    if (type == ADC_FILTER_MEDIAN) limit = ADC_FILTER_MEDIAN_MAX;
+    if (type == ADC_FILTER_CIC) limit = ADC_FILTER_CIC_MAX;
+    if (length < 1) length = 1;
+    if (length > limit) length = limit;
+    return length;
+}
+
+void ADC_filterConfigure(ADCFilter_t *f, uint8_t type, uint8_t length) {
+    if (type >= ADC_FILTER_TYPE_COUNT) type = ADC_FILTER_NONE;
+    memset(f, 0, sizeof(*f));
+    f->type = type;
+    f->length = ADC_filterLength(type, length);
+    f->invLength = 1.0f / f->length;
+    if (type == ADC_FILTER_CIC) {
+        f->invLength = 1.0f / ((float)f->length * f->length * f->length);
+    }
+    f->steady = steadyKernels[type];
+    f->kernel = kernelPrime;
+}
+
+const char *ADC_filterName(uint8_t type) {
+    static const char *names[ADC_FILTER_TYPE_COUNT] = {"none", "average", "iir", "median", "cic"};
+    return type < ADC_FILTER_TYPE_COUNT ? names[type] : "none";
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+
+// Per-channel digital filters for the MCP346x results, run on the raw codes
+// as each channel converts (full scan rate). Every filter keeps its history
+// in a fixed-size ring and its kernel has no data-dependent branches, so the
+// cost per sample is constant. The kernel is picked when the channel is
+// configured (ADC_filterConfigure), not per sample.
+//
+//   Moving average  Mean of the last N codes (running sum)
+//   IIR             Single pole, y += (x - y) / N: time constant N samples
+//   Median          Median of the last N codes (N <= ADC_FILTER_MEDIAN_MAX)
+//   CIC             3rd order CIC decimator, one output every N codes
+//                   (N <= ADC_FILTER_CIC_MAX), the value holds in between
+//
+// After a reset the first code primes the history as if the input had
+// always been at that value, so a filter never ramps up from zero.
+
+#define ADC_FILTER_MAX_LENGTH   32
+#define ADC_FILTER_MEDIAN_MAX   15      // N^2 compares per code
+#define ADC_FILTER_CIC_MAX      16      // Gain N^3 must fit 17-bit codes in 32 bits
+#define ADC_FILTER_CIC_ORDER    3
+
+enum ADCFilterType : uint8_t {
+    ADC_FILTER_NONE = 0,
+    ADC_FILTER_MOVING_AVERAGE,
+    ADC_FILTER_IIR,
+    ADC_FILTER_MEDIAN,
+    ADC_FILTER_CIC,
+    ADC_FILTER_TYPE_COUNT
+};
+
+struct ADCFilter_t;
+
+// Feeds one raw code, returns true when *out holds a new filtered code
+typedef bool (*ADCFilterKernel)(ADCFilter_t *f, int32_t x, float *out);
+
+struct ADCFilter_t {
+    ADCFilterKernel kernel;     // Priming kernel until the first code, then steady
+    ADCFilterKernel steady;
+    uint8_t type;
+    uint8_t length;             // N, clamped to the type's limit
+    uint8_t pos;                // Ring write position / CIC decimation phase
+    float invLength;            // 1 / N (CIC: 1 / N^3)
+    float iir;
+    int32_t sum;
+    int32_t ring[ADC_FILTER_MAX_LENGTH];
+    uint32_t integrator[ADC_FILTER_CIC_ORDER];  // Wrap-around arithmetic, as CIC needs
+    uint32_t comb[ADC_FILTER_CIC_ORDER];
+};
+
+// Select a filter and reset its history. Unknown types select ADC_FILTER_NONE
+void ADC_filterConfigure(ADCFilter_t *f, uint8_t type, uint8_t length);
+
+// Effective length after clamping (1 for ADC_FILTER_NONE)
+uint8_t ADC_filterLength(uint8_t type, uint8_t length);
+
+static inline bool ADC_filterInput(ADCFilter_t *f, int32_t x, float *out) {
+    return f->kernel(f, x, out);
+}
+
+const char *ADC_filterName(uint8_t type);
@@ -0,0 +1,37 @@
+#include "adc_pipeline.h"
+
+float ADC_unitPerLsb(const char *unit) {
+    if (strcmp(unit, "mA") == 0) return ADC_mA_PER_LSB;
+    if (strcmp(unit, "V") == 0) return ADC_V_PER_LSB;
+    if (strcmp(unit, "uV") == 0) return ADC_uV_PER_LSB;    // Changed from µV to uV
+    return ADC_mV_PER_LSB;                                  // "mV" and the default
+}
+
+void ADC_pipelineConfigure(ADCPipeline_t *pipe, uint8_t channel, const char *unit, const Calibrate_t *cal) {
+    if (channel >= ADC_NUM_CHANNELS) return;
+    float perLsb = ADC_unitPerLsb(unit);
+    pipe->gain[channel] = cal->scale * perLsb;
+    pipe->offset[channel] = cal->offset * perLsb;
+}
+
+void ADC_pipelineSetFilter(ADCPipeline_t *pipe, uint8_t channel, uint8_t type, uint8_t length) {
+    if (channel >= ADC_NUM_CHANNELS) return;
+    ADC_filterConfigure(&pipe->filter[channel], type, length);
+}
+
+void ADC_pipelineConvert(ADCPipeline_t *pipe, const int32_t *raw, uint16_t fresh) {
+    while (fresh) {
+        int ch = __builtin_ctz(fresh);
+        fresh &= fresh - 1;
+        if (ch >= ADC_NUM_CHANNELS) break;
+        ADC_filterInput(&pipe->filter[ch], raw[ch], &pipe->code[ch]);
+    }
+
+    const float *gain = pipe->gain;
+    const float *offset = pipe->offset;
+    const float *code = pipe->code;
+    float *value = pipe->value;
+    for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+        value[i] = code[i] * gain[i] + offset[i];
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../objects.h"
+#include "adc_filter.h"
+
+// MCP346x result conversion, shared by drv_adc and the native mock.
+//
+// Each channel that has converted goes through its filter (adc_filter.h),
+// then every channel is scaled to engineering units. The unit string and calibration of each channel are folded into one gain
+// and offset when the channel is configured, so converting a scan is a
+// single multiply-add per channel with no string compares:
+//   value = (raw * cal.scale + cal.offset) * unitPerLsb = raw * gain + offset
+// Coefficients and results are kept as arrays (one entry per channel) so the
+// loop runs straight over contiguous memory.
+
+#define ADC_NUM_CHANNELS    8
+
+#define ADC_V_DIV_RATIO     5.024
+#define ADC_uV_PER_LSB      314.0     //MCP346X_uV_PER_LSB * ADC_V_DIV_RATIO
+#define ADC_mV_PER_LSB      0.314     //ADC_uV_PER_LSB / 1000
+#define ADC_V_PER_LSB       0.000314  //ADC_uV_PER_LSB / 1000000
+#define ADC_mA_PER_LSB      0.001308333   //ADC_uV_PER_LSB / 240000
+
+struct ADCPipeline_t {
+    float gain[ADC_NUM_CHANNELS];       // cal.scale * unit per LSB
+    float offset[ADC_NUM_CHANNELS];     // cal.offset * unit per LSB
+    float code[ADC_NUM_CHANNELS];       // Filtered raw codes
+    float value[ADC_NUM_CHANNELS];      // Last converted scan
+    ADCFilter_t filter[ADC_NUM_CHANNELS];
+};
+
+float ADC_unitPerLsb(const char *unit);     // "mV", "mA", "V" or "uV"; anything else is mV
+
+// Re-resolve one channel after its unit or calibration changed
+void ADC_pipelineConfigure(ADCPipeline_t *pipe, uint8_t channel, const char *unit, const Calibrate_t *cal);
+
+// Select a channel's filter (ADCFilterType) and restart it
+void ADC_pipelineSetFilter(ADCPipeline_t *pipe, uint8_t channel, uint8_t type, uint8_t length);
+
+// Filter the channels flagged in fresh (bit n = channel n has a new code in
+// raw[n]), then convert every channel into pipe->value
+void ADC_pipelineConvert(ADCPipeline_t *pipe, const int32_t *raw, uint16_t fresh);
@@ -3,13 +3,67 @@
 AnalogInput_t adcInput[8];
 ADCDriver_t adcDriver;
 
+// Normal scan settings, restored after a burst capture
+static uint8_t scanOsr;
+static uint32_t scanTimer;
+
+// Conversions read by queued bus transactions, in order, until the ADC task takes them
+struct ADCConversion_t {
+    uint8_t channel;
+    int32_t code;
+    uint32_t timeUs;        // Data-ready time
+};
+
+static ADCConversion_t adcFifo[ADC_FIFO_SIZE];
+static volatile uint16_t fifoHead;
+static volatile uint16_t fifoTail;
+
+// ADCDATA read: command byte, then the 4 data bytes (32-bit with channel ID)
+static const uint8_t adcReadTx[5] = {MCP346X_ADDRESS_bm | MCP346X_ADCDATA_bm | MCP346X_INC_READ_bm, 0, 0, 0, 0};
+static uint8_t adcReadRx[5];
+static SPIBusTransaction adcRead;
+
+// Result read done (data-ready or DMA interrupt): decode into the FIFO and wake the ADC task
+static void ADC_readCompleteISR(SPIBusTransaction *txn) {
+    if (txn->state != SPIBUS_TXN_DONE) return;
+    if ((uint16_t)(fifoHead - fifoTail) >= ADC_FIFO_SIZE) {
+        adcDriver.fifoOverflows++;
+        return;
+    }
+    ADCConversion_t *conv = &adcFifo[fifoHead & (ADC_FIFO_SIZE - 1)];
+    conv->code = MCP346x::decode_adc_data(&adcReadRx[1], &conv->channel);
+    conv->timeUs = txn->queuedUs;
+    fifoHead++;
+    if (analog_input_task) analog_input_task->post();
+}
+
+// MCP346x data-ready IRQ: queue the result read on the shared bus. The bus
+// runs it as soon as it is free, so a slow register access elsewhere on the
+// bus delays the read but never blocks this interrupt.
+static void ADC_dataReadyISR(void) {
+    adcDriver.dataReadyUs = micros();
+    if (!spiBus.queue(&adcRead)) adcDriver.readOverruns++;
+}
+
 bool ADC_init(void) {
     adcDriver.adc = new MCP346x(PIN_ADC_CS, PIN_ADC_IRQ, &SPI);
+    adcDriver.adc->set_data_ready_callback(ADC_dataReadyISR);
+    adcDriver.busDevice = spiBus.addDevice("adc", PIN_ADC_CS, SPISettings(MCP346x_SPI_CLK_FREQ_MHz, MSBFIRST, SPI_MODE0));
+    adcDriver.adc->set_bus(&spiBus, adcDriver.busDevice);
+    adcRead.device = adcDriver.busDevice;
+    adcRead.tx = adcReadTx;
+    adcRead.rx = adcReadRx;
+    adcRead.length = sizeof(adcReadTx);
+    adcRead.callback = ADC_readCompleteISR;
+    scanOsr = adcDriver.adc->descriptor.config.osr;
+    scanTimer = adcDriver.adc->descriptor.config.timer;
     for (int i = 0; i < 8; i++) {
         adcDriver.inputObj[i] = &adcInput[i];
         adcDriver.inputObj[i]->value = 0;
         adcDriver.inputObj[i]->cal = &calTable[i + CAL_ADC_PTR];
         strcpy(adcDriver.inputObj[i]->unit, "mV");
+        ADC_configure(i);
+        ADC_setFilter(i, ADC_FILTER_NONE, 1);
 
         // Add to object index (fixed indices 0-7)
         objIndex[0 + i].type = OBJ_T_ANALOG_INPUT;
@@ -38,31 +92,64 @@ bool ADC_init(void) {
 }
 
 void ADC_update(void) {
-    if (adcDriver.adc->read_adc() == false) return;
-    if (!adcDriver.adc->descriptor.new_data) {
-        adcDriver.ready = false;
-        adcDriver.newMessage = true;
-        sprintf(adcDriver.message, "ADC not ready");
-        return;  // No new data available from ADC, so return false and wait for next time
+    if (fifoTail == fifoHead) return;   // Fallback run, nothing converted
+
+    // Drain in order: every conversion reaches the capture with its own time.
+    // A channel seen twice (the task ran late) flushes the pipeline first so
+    // its filter still gets every sample.
+    MCP346x::device_descriptor *desc = &adcDriver.adc->descriptor;
+    uint16_t fresh = 0;     // Channels converted since the last update
+    bool capture = ADC_captureRunning();
+    uint16_t head = fifoHead;
+    while (fifoTail != head) {
+        ADCConversion_t *conv = &adcFifo[fifoTail & (ADC_FIFO_SIZE - 1)];
+        uint8_t ch = conv->channel;
+        if (fresh & (1 << ch)) {
+            ADC_pipelineConvert(&adcDriver.pipeline, desc->results, fresh);
+            fresh = 0;
+        }
+        desc->results[ch] = conv->code;
+        desc->microvolts[ch] = (float)conv->code * MCP346X_uV_PER_LSB;
+        fresh |= 1 << ch;
+        if (capture) ADC_captureInput(ch, conv->code, conv->timeUs);
+        fifoTail++;
     }
-    adcDriver.adc->descriptor.new_data = 0;
     adcDriver.ready = true;
-    for (int i = 0; i < 8; i++) {
-        // Scale and offset raw value so we don't get issues if units change
-        float result = adcDriver.adc->descriptor.results[i] * adcDriver.inputObj[i]->cal->scale + adcDriver.inputObj[i]->cal->offset;
-        // Check for the unit and convert accordingly
-        if (strcmp(adcDriver.inputObj[i]->unit, "mV") == 0) {
-            adcDriver.inputObj[i]->value = result * ADC_mV_PER_LSB;
-        } else if (strcmp(adcDriver.inputObj[i]->unit, "mA") == 0) {
-            adcDriver.inputObj[i]->value = result * ADC_mA_PER_LSB;
-        } else if (strcmp(adcDriver.inputObj[i]->unit, "V") == 0) {
-            adcDriver.inputObj[i]->value = result * ADC_V_PER_LSB;
-        } else if (strcmp(adcDriver.inputObj[i]->unit, "uV") == 0) {  // Changed from µV to uV
-            adcDriver.inputObj[i]->value = result * ADC_uV_PER_LSB;
-        } else {
-            adcDriver.inputObj[i]->value = result * ADC_mV_PER_LSB;   // Default to mV
-        }
-        //Serial.printf("ADC channel %d raw: %i, calculated: %0.3f%s\n", i, adcDriver.adc->descriptor.results[i], adcDriver.inputObj[i]->value, adcDriver.inputObj[i]->unit);
+    ADC_pipelineConvert(&adcDriver.pipeline, desc->results, fresh);
+    for (int i = 0; i < ADC_NUM_CHANNELS; i++) {
+        adcDriver.inputObj[i]->value = adcDriver.pipeline.value[i];
     }
-    return;
-}
\ No newline at end of file
+}
+
+void ADC_configure(uint8_t channel) {
+    if (channel >= ADC_NUM_CHANNELS) return;
+    AnalogInput_t *input = adcDriver.inputObj[channel];
+    ADC_pipelineConfigure(&adcDriver.pipeline, channel, input->unit, input->cal);
+}
+
+void ADC_setFilter(uint8_t channel, uint8_t type, uint8_t length) {
+    ADC_pipelineSetFilter(&adcDriver.pipeline, channel, type, length);
+}
+
+bool ADC_setCaptureScan(uint8_t channelMask, uint8_t osr, uint32_t timer) {
+    MCP346x::config_type *config = &adcDriver.adc->descriptor.config;
+    config->osr = osr;
+    config->timer = timer;
+    config->scan_channels = channelMask;
+    if (!adcDriver.adc->write_config()) return false;
+    return adcDriver.adc->start_continuous_adc(channelMask);
+}
+
+bool ADC_restoreScan(void) {
+    MCP346x::config_type *config = &adcDriver.adc->descriptor.config;
+    config->osr = scanOsr;
+    config->timer = scanTimer;
+    config->scan_channels = MCP346X_SCAN_ALL_CH;
+    bool ok = adcDriver.adc->write_config() && adcDriver.adc->start_continuous_adc(MCP346X_SCAN_ALL_CH);
+    if (!ok) {
+        adcDriver.fault = true;
+        adcDriver.newMessage = true;
+        strcpy(adcDriver.message, "ADC failed to restore the normal scan");
+    }
+    return ok;
+}
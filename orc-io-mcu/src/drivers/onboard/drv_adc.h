@@ -3,12 +3,8 @@
 #include "sys_init.h"
 
 #include "MCP346x.h"
-
-#define ADC_V_DIV_RATIO     5.024
-#define ADC_uV_PER_LSB      314.0     //MCP346X_uV_PER_LSB * ADC_V_DIV_RATIO
-#define ADC_mV_PER_LSB      0.314     //ADC_uV_PER_LSB / 1000
-#define ADC_V_PER_LSB       0.000314  //ADC_uV_PER_LSB / 1000000
-#define ADC_mA_PER_LSB      0.001308333   //ADC_uV_PER_LSB / 240000
+#include "adc_pipeline.h"
+#include "adc_capture.h"
 
 struct ADCDriver_t {
     AnalogInput_t *inputObj[8];
@@ -17,10 +13,25 @@ struct ADCDriver_t {
     bool newMessage;
     char message[100];
     MCP346x *adc;
+    ADCPipeline_t pipeline;
+    volatile uint32_t dataReadyUs;      // micros() of the last data-ready IRQ
+    uint8_t busDevice;                  // On spiBus
+    volatile uint32_t readOverruns;     // Data-ready with the previous result read still pending
+    volatile uint32_t fifoOverflows;    // Conversions dropped before ADC_update() took them
 };
 
+#define ADC_FIFO_SIZE   64              // Conversions held between ADC task runs (power of two)
+
 extern AnalogInput_t adcInput[8];
 extern ADCDriver_t adcDriver;
 
 bool ADC_init(void);
-void ADC_update(void);
\ No newline at end of file
+void ADC_update(void);
+void ADC_configure(uint8_t channel);    // Call after a channel's unit or calibration changes
+void ADC_setFilter(uint8_t channel, uint8_t type, uint8_t length);   // ADCFilterType, restarts the filter
+
+// Burst capture scan (adc_capture.h): channelMask only, OSR (MCP346X_OSR_*_bm)
+// and SCAN TIMER delay in DMCLK periods. ADC_restoreScan() returns to the
+// normal scan of all channels.
+bool ADC_setCaptureScan(uint8_t channelMask, uint8_t osr, uint32_t timer);
+bool ADC_restoreScan(void);
\ No newline at end of file
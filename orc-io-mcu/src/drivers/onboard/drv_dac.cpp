@@ -5,6 +5,7 @@ DACDriver_t dacDriver;
 
 bool DAC_init(void) {
     dacDriver.dac = new MCP48FEBxx(PIN_DAC_CS, PIN_DAC_SYNC, &SPI);
+    dacDriver.dac->setBus(&spiBus, spiBus.addDevice("dac", PIN_DAC_CS));
     if (!dacDriver.dac->begin()) {
         dacDriver.newMessage = true;
         sprintf(dacDriver.message, "DAC initialisation failed");
@@ -23,6 +23,7 @@ bool init_rtdDriver(void) {
     for (int i = 0; i < NUM_MAX31865_INTERFACES; i++) {
         pinMode(rtdCSPins[i], OUTPUT);
         digitalWrite(rtdCSPins[i], HIGH);
+        pinMode(rtdDRDYPins[i], INPUT);
     }
 
     // Initialise config
@@ -34,6 +35,10 @@ bool init_rtdDriver(void) {
         rtd_interface[i].wires = MAX31865_3WIRE;
         rtd_interface[i].sensorType = PT100;
         rtd_interface[i].cal = &calTable[i + CAL_RTD_PTR];
+        rtd_interface[i].state = RTD_STATE_IDLE;
+        rtd_interface[i].samplePeriodMs = 0;
+        rtd_interface[i].samples = 0;
+        rtd_interface[i].drdyTimeouts = 0;
         
         // Initialize temperature sensor object
         rtd_sensor[i].temperature = 0;
@@ -52,8 +57,8 @@ bool init_rtdDriver(void) {
     // Initialise temperature sensors
     for (int i = 0; i < NUM_MAX31865_INTERFACES; i++) {
         if (!initTemperatureSensor(&rtd_interface[i])) return false;
-        rtd_interface[i].sensor->autoConvert(true);
         //rtd_interface[i].sensor->enable50Hz(true);
+        setRtdSamplePeriod(&rtd_interface[i], RTD_DEFAULT_PERIOD_MS);
     }
     return true;
 }
@@ -63,6 +68,9 @@ bool initTemperatureSensor(RTDDriver_t *sensorObj) {
     rtdSensorCount ++;
     // Initialise the temperature sensor hardware
     sensorObj->sensor = new MAX31865(sensorObj->cs_pin, &SPI);
+    char name[SPIBUS_NAME_LEN];
+    snprintf(name, sizeof(name), "rtd%d", rtdSensorCount);
+    sensorObj->sensor->setBus(&spiBus, spiBus.addDevice(name, sensorObj->cs_pin));
     return sensorObj->sensor->begin(sensorObj->wires);
 }
 
@@ -70,49 +78,55 @@ bool readRtdSensors(void) {
     if (rtdSensorCount == 0) {
         return false;
     }
+    bool ok = true;
     for (int i = 0; i < rtdSensorCount; i++) {
         if (!readRtdSensor(&rtd_interface[i])) {
             rtd_interface[i].temperatureObj->fault = true;
-            return false;
+            ok = false;
+            continue;
         }
         rtd_interface[i].temperatureObj->fault = false;
     }
-    return true;
+    return ok;
 }
 
-bool readRtdSensor(RTDDriver_t *sensorObj) {
-    if (sensorObj == NULL || sensorObj->sensor == NULL || sensorObj->temperatureObj == NULL) {
-        return false;
+static void reportRtdFault(RTDDriver_t *sensorObj, uint8_t fault) {
+    sensorObj->temperatureObj->newMessage = true;
+    char buf[100];
+    snprintf(buf, 20, "RTD Fault 0x%02x ", fault);
+    strcpy(sensorObj->temperatureObj->message, buf);
+
+    if (fault & MAX31865_FAULT_HIGHTHRESH) {
+        strcat(sensorObj->temperatureObj->message, "| RTD High Threshold ");
+    }
+    if (fault & MAX31865_FAULT_LOWTHRESH) {
+        strcat(sensorObj->temperatureObj->message, "| RTD Low Threshold ");
+    }
+    if (fault & MAX31865_FAULT_REFINLOW) {
+        strcat(sensorObj->temperatureObj->message, "| REFIN- > 0.85 x Bias "); 
     }
-    uint8_t fault = sensorObj->sensor->readFault();
-    if (fault) {
-        sensorObj->temperatureObj->newMessage = true;
-        char buf[100];
-        snprintf(buf, 20, "RTD Fault 0x%02x ", fault);
-        strcpy(sensorObj->temperatureObj->message, buf);
+    if (fault & MAX31865_FAULT_REFINHIGH) {
+        strcat(sensorObj->temperatureObj->message, "| REFIN- < 0.85 x Bias - FORCE- open "); 
+    }
+    if (fault & MAX31865_FAULT_RTDINLOW) {
+        strcat(sensorObj->temperatureObj->message, "| RTDIN- < 0.85 x Bias - FORCE- open "); 
+    }
+    if (fault & MAX31865_FAULT_OVUV) {
+        strcat(sensorObj->temperatureObj->message, "| Under/Over voltage");
+    }
+}
 
-        if (fault & MAX31865_FAULT_HIGHTHRESH) {
-            strcat(sensorObj->temperatureObj->message, "| RTD High Threshold ");
-        }
-        if (fault & MAX31865_FAULT_LOWTHRESH) {
-            strcat(sensorObj->temperatureObj->message, "| RTD Low Threshold ");
-        }
-        if (fault & MAX31865_FAULT_REFINLOW) {
-            strcat(sensorObj->temperatureObj->message, "| REFIN- > 0.85 x Bias "); 
-        }
-        if (fault & MAX31865_FAULT_REFINHIGH) {
-            strcat(sensorObj->temperatureObj->message, "| REFIN- < 0.85 x Bias - FORCE- open "); 
-        }
-        if (fault & MAX31865_FAULT_RTDINLOW) {
-            strcat(sensorObj->temperatureObj->message, "| RTDIN- < 0.85 x Bias - FORCE- open "); 
-        }
-        if (fault & MAX31865_FAULT_OVUV) {
-            strcat(sensorObj->temperatureObj->message, "| Under/Over voltage");
-        }
+// Convert a raw RTD register value and publish it
+static void storeRtdReading(RTDDriver_t *sensorObj, uint16_t raw) {
+    if (raw & 0x0001) {
+        // Fault flag set during this conversion
+        uint8_t fault = sensorObj->sensor->readFault(MAX31865_FAULT_NONE);
+        if (fault) reportRtdFault(sensorObj, fault);
         sensorObj->sensor->clearFault();
     }
-    // Read temperature from MAX31865 (always returns Celsius)
-    float tempCelsius = sensorObj->sensor->temperature(rtdRefs[sensorObj->sensorType].R_nom, rtdRefs[sensorObj->sensorType].R_ref);
+
+    // Convert the 15-bit code (always Celsius)
+    float tempCelsius = sensorObj->sensor->calculateTemperature(raw >> 1, rtdRefs[sensorObj->sensorType].R_nom, rtdRefs[sensorObj->sensorType].R_ref);
     
     // Apply calibration (scale and offset) to the Celsius reading
     tempCelsius = (tempCelsius * sensorObj->cal->scale) + sensorObj->cal->offset;
@@ -131,6 +145,129 @@ bool readRtdSensor(RTDDriver_t *sensorObj) {
     }
     
     sensorObj->temperatureObj->temperature = finalTemperature;
+    sensorObj->samples++;
+}
+
+static bool rtdAutoMode(const RTDDriver_t *sensorObj) {
+    return sensorObj->samplePeriodMs < RTD_ONESHOT_MIN_PERIOD_MS;
+}
+
+// DRDY goes low when a result is waiting and high again once it is read
+static bool rtdResultReady(RTDDriver_t *sensorObj, uint32_t now) {
+    if (sensorObj->drdy_pin >= 0 && digitalRead(sensorObj->drdy_pin) == LOW) return true;
+    if (now - sensorObj->stateTime < RTD_CONVERSION_TIMEOUT_MS) return false;
+    sensorObj->drdyTimeouts++;
+    return true;
+}
+
+static void enterRtdState(RTDDriver_t *sensorObj, RtdState state, uint32_t now) {
+    sensorObj->state = state;
+    sensorObj->stateTime = now;
+}
+
+// Put the chip in the mode the sample period needs and restart sampling
+static void restartRtdAcquisition(RTDDriver_t *sensorObj) {
+    uint32_t now = millis();
+    sensorObj->nextSample = now;
+    sensorObj->lastFaultCheck = now;
+    sensorObj->sensor->clearFault();
+    if (rtdAutoMode(sensorObj)) {
+        sensorObj->sensor->autoConvert(true);
+        enterRtdState(sensorObj, RTD_STATE_AUTO, now);
+    } else {
+        sensorObj->sensor->autoConvert(false);
+        enterRtdState(sensorObj, RTD_STATE_IDLE, now);
+    }
+}
+
+// Leave the fault cycle (or bias settling) for the conversion that follows
+static void startRtdConversion(RTDDriver_t *sensorObj, uint32_t now) {
+    if (rtdAutoMode(sensorObj)) {
+        sensorObj->sensor->autoConvert(true);
+        enterRtdState(sensorObj, RTD_STATE_AUTO, now);
+    } else {
+        sensorObj->sensor->startOneShot();
+        enterRtdState(sensorObj, RTD_STATE_CONVERTING, now);
+    }
+}
+
+static bool rtdSampleDue(RTDDriver_t *sensorObj, uint32_t now) {
+    if ((int32_t)(now - sensorObj->nextSample) < 0) return false;
+    sensorObj->nextSample += sensorObj->samplePeriodMs;
+    if ((int32_t)(now - sensorObj->nextSample) >= 0) {
+        // Fell behind by a whole period: resynchronise instead of bursting
+        sensorObj->nextSample = now + sensorObj->samplePeriodMs;
+    }
+    return true;
+}
+
+bool readRtdSensor(RTDDriver_t *sensorObj) {
+    if (sensorObj == NULL || sensorObj->sensor == NULL || sensorObj->temperatureObj == NULL) {
+        return false;
+    }
+    uint32_t now = millis();
+    bool faultCheckDue = now - sensorObj->lastFaultCheck >= RTD_FAULT_CHECK_MS;
+
+    switch (sensorObj->state) {
+        case RTD_STATE_IDLE:
+            if (!rtdSampleDue(sensorObj, now)) break;
+            sensorObj->sensor->clearFault();
+            sensorObj->sensor->enableBias(true);
+            enterRtdState(sensorObj, RTD_STATE_BIAS_SETTLING, now);
+            break;
+
+        case RTD_STATE_BIAS_SETTLING:
+            if (now - sensorObj->stateTime < RTD_BIAS_SETTLE_MS) break;
+            if (faultCheckDue) {
+                sensorObj->sensor->startFaultCycle();
+                enterRtdState(sensorObj, RTD_STATE_FAULT_CYCLE, now);
+            } else {
+                startRtdConversion(sensorObj, now);
+            }
+            break;
+
+        case RTD_STATE_FAULT_CYCLE: {
+            if (!sensorObj->sensor->faultCycleDone() && now - sensorObj->stateTime < RTD_FAULT_CYCLE_TIMEOUT_MS) break;
+            sensorObj->lastFaultCheck = now;
+            uint8_t fault = sensorObj->sensor->readFault(MAX31865_FAULT_NONE);
+            if (fault) reportRtdFault(sensorObj, fault);
+            sensorObj->sensor->clearFault();
+            startRtdConversion(sensorObj, now);
+            break;
+        }
+
+        case RTD_STATE_CONVERTING: {
+            if (!rtdResultReady(sensorObj, now)) break;
+            uint16_t raw = sensorObj->sensor->readRTDraw();
+            sensorObj->sensor->enableBias(false);   // Reduce self-heating until the next sample
+            enterRtdState(sensorObj, RTD_STATE_IDLE, now);
+            storeRtdReading(sensorObj, raw);
+            break;
+        }
+
+        case RTD_STATE_AUTO:
+            if (faultCheckDue) {
+                // Interrupts auto conversion, which restarts once the cycle is done
+                sensorObj->sensor->startFaultCycle();
+                enterRtdState(sensorObj, RTD_STATE_FAULT_CYCLE, now);
+                break;
+            }
+            if ((int32_t)(now - sensorObj->nextSample) < 0 || !rtdResultReady(sensorObj, now)) break;
+            rtdSampleDue(sensorObj, now);
+            sensorObj->stateTime = now;
+            storeRtdReading(sensorObj, sensorObj->sensor->readRTDraw());
+            break;
+    }
+    return true;
+}
+
+bool setRtdSamplePeriod(RTDDriver_t *sensorObj, uint16_t periodMs) {
+    if (sensorObj->sensor == NULL) return false;
+    if (periodMs == 0) periodMs = RTD_DEFAULT_PERIOD_MS;
+    periodMs = constrain(periodMs, RTD_MIN_PERIOD_MS, RTD_MAX_PERIOD_MS);
+    if (periodMs == sensorObj->samplePeriodMs) return true;
+    sensorObj->samplePeriodMs = periodMs;
+    restartRtdAcquisition(sensorObj);
     return true;
 }
 
@@ -7,12 +7,39 @@
 #define NUM_MAX31865_INTERFACES 3
 
 // Driver file for MAX31865 RTD sensor interfaces over SPI
+//
+// Each chip runs its own acquisition state machine, serviced by RTD_manage()
+// every RTD_TICK_MS. A service call only does a few register accesses, the
+// waits (bias settling, conversion, fault cycle) pass between calls:
+//   One-shot (period >= RTD_ONESHOT_MIN_PERIOD_MS): bias on, settle, 1-shot,
+//     collect on DRDY, bias off again to limit self-heating
+//   Auto-convert (shorter periods): bias stays on, the chip converts every
+//     16.7 ms (60 Hz filter) and the newest result is collected on DRDY
+// The fault detection cycle runs every RTD_FAULT_CHECK_MS.
+
+#define RTD_TICK_MS                 5       // RTD_manage() period
+#define RTD_DEFAULT_PERIOD_MS       200
+#define RTD_MIN_PERIOD_MS           17      // One auto-convert result per 16.7 ms
+#define RTD_MAX_PERIOD_MS           60000
+#define RTD_ONESHOT_MIN_PERIOD_MS   100     // Bias settle + 1-shot conversion + margin
+#define RTD_BIAS_SETTLE_MS          10
+#define RTD_CONVERSION_TIMEOUT_MS   70      // 1-shot: 52 ms (60 Hz) or 62.5 ms (50 Hz), then read without DRDY
+#define RTD_FAULT_CYCLE_TIMEOUT_MS  5       // Automatic fault detection takes < 1 ms
+#define RTD_FAULT_CHECK_MS          1000
 
 enum RtdSensorType {
     PT100,
     PT1000 
 };
 
+enum RtdState : uint8_t {
+    RTD_STATE_IDLE,             // One-shot: waiting for the next sample
+    RTD_STATE_BIAS_SETTLING,    // One-shot: bias on, waiting RTD_BIAS_SETTLE_MS
+    RTD_STATE_FAULT_CYCLE,      // Automatic fault detection running
+    RTD_STATE_CONVERTING,       // One-shot: conversion started, waiting for DRDY
+    RTD_STATE_AUTO              // Auto-convert: collecting results on DRDY
+};
+
 // Driver struct - contains interface parameters and sensor object
 struct RTDDriver_t {
     TemperatureSensor_t *temperatureObj;
@@ -22,6 +49,15 @@ struct RTDDriver_t {
     MAX31865 *sensor;
     max31865_numwires_t wires;
     RtdSensorType sensorType;
+
+    // Acquisition state machine
+    RtdState state;
+    uint16_t samplePeriodMs;
+    uint32_t stateTime;         // millis() the current state was entered
+    uint32_t nextSample;        // millis() the next sample is due
+    uint32_t lastFaultCheck;
+    uint32_t samples;
+    uint32_t drdyTimeouts;      // Results read without seeing DRDY
 };
 
 extern TemperatureSensor_t rtd_sensor[3];
@@ -29,8 +65,9 @@ extern RTDDriver_t rtd_interface[3];
 
 bool init_rtdDriver(void);                                // Initialises the CS pins and temperature objects
 bool initTemperatureSensor(RTDDriver_t *sensorObj);       // Initialises the RTD sensor - requires the library instance and the temperarure object
-bool readRtdSensors(void);                                // Loop function for periodic sensor reading
-bool readRtdSensor(RTDDriver_t *sensorObj);               // Loop function for periodic sensor reading (individual sensor)
+bool readRtdSensors(void);                                // Services every sensor's state machine, never blocks
+bool readRtdSensor(RTDDriver_t *sensorObj);               // Services one sensor's state machine
+bool setRtdSamplePeriod(RTDDriver_t *sensorObj, uint16_t periodMs);   // RTD_MIN_PERIOD_MS..RTD_MAX_PERIOD_MS, 0 = default
 bool setRtdSensorType(RTDDriver_t *sensorObj, RtdSensorType sensorType);  // PT100 or PT1000
 bool setRtdWires(RTDDriver_t *sensorObj, max31865_numwires_t wires);      // MAX31865_2WIRE, MAX31865_3WIRE or MAX31865_4WIRE
 
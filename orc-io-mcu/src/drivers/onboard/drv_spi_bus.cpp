@@ -0,0 +1,38 @@
+#include "drv_spi_bus.h"
+
+#if SPIBUS_DMA
+SPIBus spiBus(&SPI, SERCOM6, SERCOM6_DMAC_ID_RX, SERCOM6_DMAC_ID_TX);
+#else
+SPIBus spiBus(&SPI);
+#endif
+SPIBus spiBus1(&SPI1);      // Single device, lock only for the statistics
+
+bool spiBus_init(void) {
+    spiBus1.begin();
+    if (!spiBus.begin()) {
+        Serial.println("SPI bus: DMA channels unavailable, queued transfers run synchronously");
+        return false;
+    }
+    return true;
+}
+
+static void printBus(const char *label, SPIBus *bus) {
+    uint16_t util = bus->getUtilisation();
+    uint16_t peak = bus->getPeakUtilisation();
+    Serial.printf("%s: %u.%u%% busy (peak %u.%u%%), %lu us total, DMA %s, queue peak %u, %lu lock timeouts\n",
+                  label, util / 10, util % 10, peak / 10, peak % 10, bus->getBusyUs(),
+                  bus->dmaEnabled() ? "on" : "off", bus->getQueuePeak(), bus->getLockTimeouts());
+    for (uint8_t i = 0; i < bus->getDeviceCount(); i++) {
+        const SPIBusDeviceStats *dev = bus->getDeviceStats(i);
+        Serial.printf("   %-8s queued %lu (%lu bytes), locked %lu, busy %lu us, max wait %lu us, "
+                      "deferred %lu, refused %lu, aborted %lu\n",
+                      dev->name, dev->queuedTransactions, dev->queuedBytes, dev->lockedTransactions,
+                      dev->busyUs, dev->maxWaitUs, dev->deferred, dev->refused, dev->aborted);
+    }
+}
+
+void spiBus_printStats(void) {
+    Serial.println("\n=== SPI Bus Statistics ===");
+    printBus("SPI", &spiBus);
+    printBus("SPI1", &spiBus1);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "sys_init.h"
+
+#include "SPIBus.h"
+
+// SPI (SERCOM6) is shared by the ADC, DAC and the three PT100 front-ends;
+// SPI1 (SERCOM7) only carries the stepper driver. The ADC result reads are
+// queued transactions (on DMA with -DSPIBUS_DMA=1), everything else runs
+// under the bus lock.
+extern SPIBus spiBus;
+extern SPIBus spiBus1;
+
+// Call once the CS pins are high and before any driver on the buses starts
+bool spiBus_init(void);
+void spiBus_printStats(void);
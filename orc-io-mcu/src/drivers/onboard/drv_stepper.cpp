@@ -7,6 +7,7 @@ StepperDevice_t stepperDevice;
 
 bool stepper_init(void) {
     stepperDriver.stepper = new TMC5130(PIN_STP_CS, &SPI1);
+    stepperDriver.stepper->setBus(&spiBus1, spiBus1.addDevice("stepper", PIN_STP_CS));
     stepperDriver.device = &stepperDevice;
     stepperDriver.ready = false;
     stepperDriver.fault = false;
@@ -20,6 +20,7 @@ void modbusDebugMonitor() {
 void debugTaskCallback() {
   // Add calls to debug functions here
   //modbusDebugMonitor();
+  //spiBus_printStats();
 }
 
 // <---------------------------------------------------------------------------
@@ -52,6 +53,7 @@ void setup() {
   }
 
   Serial.println("Starting IO MCU (ATSAME51N20A)...");
+  spiBus_init();    // Before the drivers register their devices on it
 
   Serial.print("Initialising ADC interface... ");
   ADC_init();
@@ -163,19 +165,33 @@ void setup() {
   Serial.printf("Found %d objects ready for IPC\n", objectCount);
 
   Serial.print("Adding tasks to scheduler... ");
-  analog_input_task = tasks.addTask(ADC_update, 10, true, false);
-  analog_output_task = tasks.addTask(DAC_update, 100, true, false);
-  output_task = tasks.addTask(output_update, 100, true, false);
-  gpio_task = tasks.addTask(gpio_update, 100, true, true);
-  modbus_task = tasks.addTask(modbus_manage, 10, true, true);
-  ipc_task = tasks.addTask(ipc_update, 5, true, true);
-  RTDsensor_task = tasks.addTask(RTD_manage, 200, true, false);
-  stepper_task = tasks.addTask(stepper_update, 1000, true, false);
-  motor_task = tasks.addTask(motor_update, 10, true, false);
-  pwrSensor_task = tasks.addTask(pwrSensor_update, 1000, true, false);
+  // ADC runs on the MCP346x data-ready IRQ, the 100ms fallback covers a lost edge
+  analog_input_task = tasks.addEventTask(ADC_update, "adc", false, 100);
+  analog_output_task = tasks.addTask(DAC_update, 100, true, false, "dac");
+  output_task = tasks.addTask(output_update, 100, true, false, "outputs");
+  gpio_task = tasks.addTask(gpio_update, 100, true, true, "gpio");
+  modbus_task = tasks.addTask(modbus_manage, 10, true, true, "modbus");
+  ipc_task = tasks.addTask(ipc_update, 5, true, true, "ipc");   // Also posted by the Serial1 RX interrupt
+  RTDsensor_task = tasks.addTask(RTD_manage, RTD_TICK_MS, true, false, "rtd");   // Services the RTD state machines, samples at their own period
+  stepper_task = tasks.addTask(stepper_update, 1000, true, false, "stepper");
+  motor_task = tasks.addTask(motor_update, 10, true, false, "motor");
+  pwrSensor_task = tasks.addTask(pwrSensor_update, 1000, true, false, "pwr_sensor");
+
+  // Fast control-path tasks hold their period instead of drifting on late runs
+  modbus_task->setTiming(TIMING_FIXED_RATE, CATCHUP_SKIP);
+  ipc_task->setTiming(TIMING_FIXED_RATE, CATCHUP_SKIP);
+  motor_task->setTiming(TIMING_FIXED_RATE, CATCHUP_SKIP);
+
+  // Overrun budgets (tasks without one are never counted as overrunning).
+  // The ADC task must be done with a scan well before the next data-ready
+  // edge 12.5 ms later; its 100 ms fallback interval says nothing about that.
+  analog_input_task->setBudget(2000);
+  modbus_task->setBudget(10000);
+  ipc_task->setBudget(5000);
+  motor_task->setBudget(10000);
 
   // Debug task
-  DEBUG_TASK = tasks.addTask(debugTaskCallback, 2000, true, false);
+  DEBUG_TASK = tasks.addTask(debugTaskCallback, 2000, true, false, "debug");
   
   Serial.println("Setup done, hardware ready, waiting for System MCU to initialise...");
   
@@ -13,6 +13,7 @@
 
 // Drivers
 #include "drivers/objects.h"
+#include "drivers/onboard/drv_spi_bus.h"
 #include "drivers/onboard/drv_adc.h"
 #include "drivers/onboard/drv_dac.h"
 #include "drivers/onboard/drv_rtd.h"
@@ -0,0 +1,94 @@
+#ifndef IPC_CONFIG_DIGEST_H
+#define IPC_CONFIG_DIGEST_H
+
+#include <stdint.h>
+#include "IPCDataStructs.h"
+
+// ============================================================================
+// IPC CONFIGURATION DIGEST
+// Content hash of the configuration records (IPC_MSG_CONFIG_* and
+// IPC_MSG_DEVICE_CREATE payloads) applied on the IO MCU, exchanged in
+// HELLO / HELLO_ACK so a reconnect only re-pushes the sections that differ.
+// Record hash: FNV-1a over the message type and the payload, skipping the
+// leading transactionId. Section digest: sum of its record hashes, so it does
+// not depend on the order records were applied in.
+// Mirrored in orc-io-mcu/src/drivers/ipc/ipc_config_digest.h - keep in sync.
+// ============================================================================
+
+#define IPC_CONFIG_FNV_OFFSET   0x811C9DC5u
+#define IPC_CONFIG_FNV_PRIME    0x01000193u
+
+/**
+ * @brief Digest section of a configuration record type
+ * @return IPC_ConfigSection, or IPC_CONFIG_SECTION_NONE for other messages
+ */
+static inline uint8_t ipc_configSection(uint8_t msgType) {
+    switch (msgType) {
+        case IPC_MSG_CONFIG_ANALOG_INPUT:    return IPC_CONFIG_SECTION_ADC;
+        case IPC_MSG_CONFIG_ANALOG_OUTPUT:   return IPC_CONFIG_SECTION_DAC;
+        case IPC_MSG_CONFIG_RTD:             return IPC_CONFIG_SECTION_RTD;
+        case IPC_MSG_CONFIG_GPIO:            return IPC_CONFIG_SECTION_GPIO;
+        case IPC_MSG_CONFIG_DIGITAL_OUTPUT:  return IPC_CONFIG_SECTION_DIGITAL_OUTPUT;
+        case IPC_MSG_CONFIG_STEPPER:         return IPC_CONFIG_SECTION_STEPPER;
+        case IPC_MSG_CONFIG_DCMOTOR:         return IPC_CONFIG_SECTION_DCMOTOR;
+        case IPC_MSG_CONFIG_COMPORT:         return IPC_CONFIG_SECTION_COMPORT;
+        case IPC_MSG_DEVICE_CREATE:          return IPC_CONFIG_SECTION_DEVICE;
+        case IPC_MSG_CONFIG_PRESSURE_CTRL:   return IPC_CONFIG_SECTION_PRESSURE_CTRL;
+        case IPC_MSG_CONFIG_TEMP_CONTROLLER: return IPC_CONFIG_SECTION_TEMP_CTRL;
+        case IPC_MSG_CONFIG_PH_CONTROLLER:   return IPC_CONFIG_SECTION_PH_CTRL;
+        case IPC_MSG_CONFIG_FLOW_CONTROLLER: return IPC_CONFIG_SECTION_FLOW_CTRL;
+        case IPC_MSG_CONFIG_DO_CONTROLLER:   return IPC_CONFIG_SECTION_DO_CTRL;
+        default:                             return IPC_CONFIG_SECTION_NONE;
+    }
+}
+
+/**
+ * @brief Object a configuration record applies to
+ * Every record starts with a uint16_t transactionId followed by the object
+ * index (8 or 16-bit, little-endian), so the key is always payload byte 2.
+ */
+static inline uint8_t ipc_configRecordKey(const uint8_t *payload, uint16_t length) {
+    return (length > 2) ? payload[2] : 0;
+}
+
+/**
+ * @brief Content hash of one configuration record (never 0)
+ */
+static inline uint32_t ipc_configRecordHash(uint8_t msgType, const uint8_t *payload, uint16_t length) {
+    uint32_t hash = (IPC_CONFIG_FNV_OFFSET ^ msgType) * IPC_CONFIG_FNV_PRIME;
+    for (uint16_t i = sizeof(uint16_t); i < length; i++) {
+        hash = (hash ^ payload[i]) * IPC_CONFIG_FNV_PRIME;
+    }
+    return hash ? hash : 1;
+}
+
+/**
+ * @brief Fill in the overall digest from the section digests
+ */
+static inline void ipc_configDigestFinish(IPC_ConfigDigest_t *digest) {
+    uint32_t hash = IPC_CONFIG_FNV_OFFSET;
+    bool empty = true;
+    for (uint8_t s = 0; s < IPC_CONFIG_SECTION_COUNT; s++) {
+        uint32_t value = digest->section[s];
+        empty = empty && (value == 0);
+        for (uint8_t b = 0; b < 4; b++) {
+            hash = (hash ^ (uint8_t)(value >> (8 * b))) * IPC_CONFIG_FNV_PRIME;
+        }
+    }
+    digest->overall = empty ? 0 : (hash ? hash : 1);
+}
+
+/**
+ * @brief Bit mask of the sections whose digests differ
+ */
+static inline uint16_t ipc_configDigestDiff(const IPC_ConfigDigest_t *a, const IPC_ConfigDigest_t *b) {
+    uint16_t mask = 0;
+    for (uint8_t s = 0; s < IPC_CONFIG_SECTION_COUNT; s++) {
+        if (a->section[s] != b->section[s]) {
+            mask |= (uint16_t)(1u << s);
+        }
+    }
+    return mask;
+}
+
+#endif // IPC_CONFIG_DIGEST_H
@@ -0,0 +1,105 @@
+#ifndef IPC_CRC16_H
+#define IPC_CRC16_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// IPC CRC16-CCITT
+// Polynomial 0x1021, initial value 0xFFFF, MSB first, no final XOR.
+// Lookup tables are generated at compile time (C++11 constexpr) from the
+// polynomial, so they cannot drift from the bitwise reference.
+// Mirrored in orc-io-mcu/src/drivers/ipc/ipc_crc16.h - keep in sync.
+// ============================================================================
+
+#define IPC_CRC16_POLY          0x1021
+#define IPC_CRC16_INIT          0xFFFF
+
+// Slice-by-4 processes four bytes per step using four 256-entry tables
+// (2 KB flash total). Worth it on the Cortex-M4; the single table is used otherwise.
+#ifndef IPC_CRC16_SLICE4
+#if defined(__ARM_ARCH_7EM__)
+#define IPC_CRC16_SLICE4        1
+#else
+#define IPC_CRC16_SLICE4        0
+#endif
+#endif
+
+namespace ipc_crc16_detail {
+
+// One bit of the CRC shift register, applied k times
+constexpr uint16_t shift(uint16_t crc, int k) {
+    return k == 0 ? crc
+                  : shift((crc & 0x8000) ? (uint16_t)((crc << 1) ^ IPC_CRC16_POLY)
+                                         : (uint16_t)(crc << 1), k - 1);
+}
+
+// Table k: contribution of a byte followed by k zero bytes
+constexpr uint16_t entry(uint16_t i, int k) {
+    return k == 0 ? shift((uint16_t)(i << 8), 8)
+                  : (uint16_t)((entry(i, k - 1) << 8) ^ entry(entry(i, k - 1) >> 8, 0));
+}
+
+template <uint16_t... I> struct Seq {};
+template <uint16_t N, uint16_t... I> struct MakeSeq : MakeSeq<N - 1, N - 1, I...> {};
+template <uint16_t... I> struct MakeSeq<0, I...> { typedef Seq<I...> type; };
+
+template <int K, typename S> struct Table;
+template <int K, uint16_t... I> struct Table<K, Seq<I...> > {
+    static constexpr uint16_t data[sizeof...(I)] = { entry(I, K)... };
+};
+template <int K, uint16_t... I> constexpr uint16_t Table<K, Seq<I...> >::data[sizeof...(I)];
+
+typedef MakeSeq<256>::type Bytes;
+
+}  // namespace ipc_crc16_detail
+
+#define IPC_CRC16_T0 (ipc_crc16_detail::Table<0, ipc_crc16_detail::Bytes>::data)
+#define IPC_CRC16_T1 (ipc_crc16_detail::Table<1, ipc_crc16_detail::Bytes>::data)
+#define IPC_CRC16_T2 (ipc_crc16_detail::Table<2, ipc_crc16_detail::Bytes>::data)
+#define IPC_CRC16_T3 (ipc_crc16_detail::Table<3, ipc_crc16_detail::Bytes>::data)
+
+/**
+ * @brief Feed one byte into a running CRC
+ */
+static inline uint16_t ipc_crc16_byte(uint16_t crc, uint8_t byte) {
+    return (uint16_t)((crc << 8) ^ IPC_CRC16_T0[(uint8_t)((crc >> 8) ^ byte)]);
+}
+
+/**
+ * @brief Feed a buffer into a running CRC (one table lookup per byte)
+ */
+static inline uint16_t ipc_crc16_update(uint16_t crc, const uint8_t *data, size_t length) {
+    while (length--) {
+        crc = ipc_crc16_byte(crc, *data++);
+    }
+    return crc;
+}
+
+/**
+ * @brief Feed a buffer into a running CRC, four bytes per step
+ */
+static inline uint16_t ipc_crc16_update_slice4(uint16_t crc, const uint8_t *data, size_t length) {
+    while (length >= 4) {
+        crc = IPC_CRC16_T3[(uint8_t)((crc >> 8) ^ data[0])] ^
+              IPC_CRC16_T2[(uint8_t)(crc ^ data[1])] ^
+              IPC_CRC16_T1[data[2]] ^
+              IPC_CRC16_T0[data[3]];
+        data += 4;
+        length -= 4;
+    }
+    return ipc_crc16_update(crc, data, length);
+}
+
+/**
+ * @brief CRC16-CCITT of a complete buffer
+ */
+static inline uint16_t ipc_crc16(const uint8_t *data, size_t length) {
+#if IPC_CRC16_SLICE4
+    return ipc_crc16_update_slice4(IPC_CRC16_INIT, data, length);
+#else
+    return ipc_crc16_update(IPC_CRC16_INIT, data, length);
+#endif
+}
+
+#endif // IPC_CRC16_H
@@ -10,6 +10,7 @@
  */
 
 #include "IPCProtocol.h"
+#include "IPCCrc16.h"
 #include <Arduino.h>
 #include <string.h>
 
@@ -24,18 +25,8 @@
  * @return uint16_t CRC16 checksum
  */
 static uint16_t calculateCRC16(const uint8_t *data, uint16_t length) {
-    uint16_t crc = 0xFFFF;
-    for (uint16_t i = 0; i < length; i++) {
-        crc ^= (uint16_t)data[i] << 8;
-        for (uint8_t j = 0; j < 8; j++) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;
-            } else {
-                crc <<= 1;
-            }
-        }
-    }
-    return crc;
+    // Table-driven, bit-exact with the previous bitwise implementation
+    return ipc_crc16(data, length);
 }
 
 // =============================================================================
@@ -49,19 +40,57 @@ IPCProtocol::IPCProtocol(HardwareSerial *uart)
     , _rxPacketLength(0)
     , _rxMessageType(0)
     , _rxEscapeNext(false)
-    , _txQueueHead(0)
-    , _txQueueTail(0)
+    , _txQueueCount(0)
+    , _txReserved(false)
+    , _txReserveLane(IPC_TX_LANE_CONTROL)
+    , _txReserveType(0)
+    , _txReserveOffset(0)
+    , _txControlBurst(0)
+    , _txWaiterCount(0)
     , _handlerCount(0)
+    , _frameTap(nullptr)
     , _rxPacketCount(0)
     , _txPacketCount(0)
     , _rxErrorCount(0)
     , _crcErrorCount(0)
     , _lastRxTime(0)
     , _lastTxTime(0)
+    , _txQueueHighWater(0)
+    , _txQueuePeak(0)
+    , _txQueueFullCount(0)
+    , _rxWireBytes(0)
+    , _txWireBytes(0)
+    , _rxBacklogHighWater(0)
+    , _baudRate(IPC_BAUD_DEFAULT)
+    , _rttCount(0)
+    , _rttNext(0)
+    , _pingEcho(0)
+    , _linkWindowStart(0)
+    , _linkWindowRxBytes(0)
+    , _linkWindowTxBytes(0)
+    , _linkWindowRxFrames(0)
+    , _linkWindowTxFrames(0)
+    , _peerLinkTime(0)
+    , _peerLinkValid(false)
+    , _baudState(IPC_BAUD_IDLE)
+    , _baudResult(IPC_BAUD_RESULT_NONE)
+    , _baudTarget(0)
+    , _baudPrevious(0)
+    , _baudSwitchTime(0)
+    , _baudDeadline(0)
+    , _baudResendAt(0)
+    , _baudTestNext(0)
+    , _baudSwitches(0)
+    , _baudFailures(0)
 {
     memset(_rxBuffer, 0, sizeof(_rxBuffer));
-    memset(_txQueue, 0, sizeof(_txQueue));
+    memset(_rttSample, 0, sizeof(_rttSample));
+    memset(&_link, 0, sizeof(_link));
+    memset(&_peerLink, 0, sizeof(_peerLink));
+    memset(_txRing, 0, sizeof(_txRing));
+    memset(_txWaiters, 0, sizeof(_txWaiters));
     memset(_handlers, 0, sizeof(_handlers));
+    initTxLanes();
 }
 
 // =============================================================================
@@ -70,14 +99,21 @@ IPCProtocol::IPCProtocol(HardwareSerial *uart)
 
 void IPCProtocol::begin(uint32_t baudRate) {
     _uart->begin(baudRate);
+    _baudRate = baudRate;
+    _linkWindowStart = millis();
     _state = IPC_STATE_IDLE;
     _rxBufferIndex = 0;
     _rxPacketLength = 0;
     _rxMessageType = 0;
     _rxEscapeNext = false;
-    _txQueueHead = 0;
-    _txQueueTail = 0;
+    initTxLanes();
+    _txQueueCount = 0;
+    _txReserved = false;
+    _txControlBurst = 0;
+    _txWaiterCount = 0;
     _handlerCount = 0;
+    _baudState = IPC_BAUD_IDLE;
+    _baudTarget = 0;
 }
 
 // =============================================================================
@@ -86,15 +122,35 @@ void IPCProtocol::begin(uint32_t baudRate) {
 
 void IPCProtocol::update() {
     // Process incoming bytes
+    int backlog = _uart->available();
+    if (backlog > _rxBacklogHighWater) {
+        _rxBacklogHighWater = backlog;
+    }
     while (_uart->available()) {
         uint8_t byte = _uart->read();
+        _rxWireBytes++;
         processRxByte(byte);
     }
     
-    // Process TX queue
-    if (_txQueueHead != _txQueueTail) {
+    uint32_t now = millis();
+    if (_baudState != IPC_BAUD_IDLE) {
+        serviceBaudSwitch(now);
+    }
+    
+    // Process TX queue (held while the link rate is changing)
+    if (_txQueueCount > 0 && _baudState == IPC_BAUD_IDLE) {
         sendNextPacket();
     }
+    
+    // Producers deferred on TX space
+    if (_txWaiterCount > 0) {
+        serviceTxWaiters();
+    }
+    
+
+    if (now - _linkWindowStart >= IPC_LINK_WINDOW_MS) {
+        closeLinkWindow(now);
+    }
 }
 
 // =============================================================================
@@ -125,6 +181,11 @@ void IPCProtocol::processRxByte(uint8_t byte) {
                 _rxEscapeNext = true;
                 return;  // Don't store the escape byte
             } else if (byte == IPC_END_BYTE) {
+                if (_rxBufferIndex == 0) {
+                    // Back-to-back flags: the last one was an END taken for a
+                    // START, this one starts the frame
+                    return;
+                }
                 // Packet complete (END byte is 0x7E, same as START)
                 #if IPC_DEBUG_ENABLED
                 Serial.printf("[IPC RX] END detected, %u bytes buffered\n", _rxBufferIndex);
@@ -143,6 +204,7 @@ void IPCProtocol::processRxByte(uint8_t byte) {
             } else {
                 // Buffer overflow
                 _rxErrorCount++;
+                tapRxError();
                 _state = IPC_STATE_ERROR;
                 _state = IPC_STATE_IDLE;  // Immediately return to idle
             }
@@ -161,8 +223,9 @@ void IPCProtocol::processRxPacket() {
     if (_rxBufferIndex < 5) {
         Serial.printf("[IPC] ERROR: Packet too small (%d bytes), flushing UART buffer\n", _rxBufferIndex);
         _rxErrorCount++;
+        tapRxError();
         // Flush UART RX buffer to resync
-        while (_uart->available()) _uart->read();
+        flushRx();
         return;
     }
     
@@ -174,8 +237,9 @@ void IPCProtocol::processRxPacket() {
     if (_rxPacketLength < 1 || _rxPacketLength > (IPC_MAX_PAYLOAD_SIZE + 1)) {
         Serial.printf("[IPC] ERROR: Invalid packet length %d, flushing UART buffer\n", _rxPacketLength);
         _rxErrorCount++;
+        tapRxError();
         // Flush UART RX buffer to resync
-        while (_uart->available()) _uart->read();
+        flushRx();
         return;
     }
     
@@ -223,9 +287,9 @@ void IPCProtocol::processRxPacket() {
         }
         
         _rxErrorCount++;
+        tapRxError();
         // Flush UART RX buffer to resync - critical for recovery!
-        uint16_t flushed = 0;
-        while (_uart->available()) { _uart->read(); flushed++; }
+        uint16_t flushed = flushRx();
         if (flushed > 0) {
             Serial.printf("[IPC] Flushed %d bytes from UART to resync\n", flushed);
         }
@@ -247,8 +311,9 @@ void IPCProtocol::processRxPacket() {
         Serial.printf("[IPC] ERROR: CRC mismatch (0x%04X != 0x%04X), flushing UART buffer\n", 
                       receivedCRC, calculatedCRC);
         _crcErrorCount++;
+        tapRxError();
         // Flush UART RX buffer to resync
-        while (_uart->available()) _uart->read();
+        flushRx();
         return;
     }
     
@@ -260,99 +325,320 @@ void IPCProtocol::processRxPacket() {
     uint16_t payloadLength = _rxPacketLength - 1;
     uint8_t *payload = (payloadLength > 0) ? &_rxBuffer[3] : nullptr;
     
+    if (_frameTap) {
+        _frameTap(IPC_TAP_RX, _rxMessageType, payload, payloadLength);
+    }
     dispatchMessage(_rxMessageType, payload, payloadLength);
 }
 
+// Discard whatever is waiting in the UART (still counted as wire bytes)
+uint16_t IPCProtocol::flushRx() {
+    uint16_t flushed = 0;
+    while (_uart->available()) {
+        _uart->read();
+        flushed++;
+    }
+    _rxWireBytes += flushed;
+    return flushed;
+}
+
+// Hand a rejected frame to the tap as received (LENGTH + TYPE + PAYLOAD + CRC)
+void IPCProtocol::tapRxError() {
+    if (_frameTap) {
+        _frameTap(IPC_TAP_RX | IPC_TAP_ERROR, _rxBufferIndex > 2 ? _rxBuffer[2] : 0, _rxBuffer, _rxBufferIndex);
+    }
+}
+
 // =============================================================================
 // Transmit Functions
 // =============================================================================
 
-bool IPCProtocol::sendPacket(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength) {
-    // Check if queue is full
-    uint8_t nextTail = (_txQueueTail + 1) % IPC_TX_QUEUE_SIZE;
-    if (nextTail == _txQueueHead) {
-        return false;  // Queue full
+// Ring bytes taken by a record (header + payload, padded to keep headers aligned)
+static inline uint16_t txRecordSize(uint16_t payloadLength) {
+    return (sizeof(IPC_TxRecord_t) + payloadLength + 3) & ~3;
+}
+
+// Polling and sync requests go on the bulk lane so control writes never wait
+// behind a backlog of reads
+static inline uint8_t txLaneFor(uint8_t messageType) {
+    switch (messageType) {
+        case IPC_MSG_SENSOR_READ_REQ:
+        case IPC_MSG_SENSOR_BULK_READ_REQ:
+        case IPC_MSG_SENSOR_DELTA_REQ:
+        case IPC_MSG_INDEX_SYNC_REQ:
+        case IPC_MSG_TASK_STATS_REQ:
+            return IPC_TX_LANE_BULK;
+        default:
+            return IPC_TX_LANE_CONTROL;
+    }
+}
+
+void IPCProtocol::initTxLanes() {
+    memset(_txLane, 0, sizeof(_txLane));
+    _txLane[IPC_TX_LANE_CONTROL].base = 0;
+    _txLane[IPC_TX_LANE_CONTROL].size = IPC_TX_CONTROL_RING_SIZE;
+    _txLane[IPC_TX_LANE_BULK].base = IPC_TX_CONTROL_RING_SIZE;
+    _txLane[IPC_TX_LANE_BULK].size = IPC_TX_RING_SIZE - IPC_TX_CONTROL_RING_SIZE;
+}
+
+// Find contiguous lane space for a record. cost includes any space skipped
+// at the lane end when the record has to wrap to offset 0.
+bool IPCProtocol::placeRecord(IPC_TxLane_t &lane, uint16_t payloadLength, uint16_t &offset, uint16_t &cost) {
+    uint16_t need = txRecordSize(payloadLength);
+    
+    if (payloadLength > IPC_MAX_PAYLOAD_SIZE || lane.used == lane.size) {
+        return false;
     }
     
+    if (lane.tail >= lane.head) {
+        // Free space is [tail, end) followed by [0, head)
+        if (need <= lane.size - lane.tail) {
+            offset = lane.tail;
+            cost = need;
+            return true;
+        }
+        if (need <= lane.head) {
+            offset = 0;
+            cost = need + (lane.size - lane.tail);
+            return true;
+        }
+        return false;
+    }
+    
+    // Free space is [tail, head)
+    if (need <= lane.head - lane.tail) {
+        offset = lane.tail;
+        cost = need;
+        return true;
+    }
+    return false;
+}
+
+uint8_t* IPCProtocol::reservePacket(uint8_t messageType, uint16_t maxLength) {
     // Validate payload length
-    if (payloadLength > IPC_MAX_PAYLOAD_SIZE) {
+    if (maxLength > IPC_MAX_PAYLOAD_SIZE) {
+        return nullptr;
+    }
+    
+    uint8_t laneId = txLaneFor(messageType);
+    IPC_TxLane_t &lane = _txLane[laneId];
+    uint16_t offset, cost;
+    if (!placeRecord(lane, maxLength, offset, cost)) {
+        _txQueueFullCount++;
+        return nullptr;  // Lane full
+    }
+    
+    // Space is not visible to sendNextPacket() until committed
+    _txReserved = true;
+    _txReserveLane = laneId;
+    _txReserveType = messageType;
+    _txReserveOffset = offset;
+    return &_txRing[lane.base + offset + sizeof(IPC_TxRecord_t)];
+}
+
+bool IPCProtocol::commitPacket(uint16_t payloadLength) {
+    if (!_txReserved || payloadLength > IPC_MAX_PAYLOAD_SIZE) {
         return false;
     }
+    _txReserved = false;
     
-    // Add packet to queue
-    IPC_TxPacket_t *packet = &_txQueue[_txQueueTail];
-    packet->messageType = messageType;
-    packet->payloadLength = payloadLength;
-    if (payloadLength > 0 && payload != nullptr) {
-        memcpy(packet->payload, payload, payloadLength);
+    IPC_TxLane_t &lane = _txLane[_txReserveLane];
+    
+    // Record placed at the lane start - mark the skipped end space for the reader
+    if (_txReserveOffset != lane.tail) {
+        IPC_TxRecord_t *wrap = (IPC_TxRecord_t*)&_txRing[lane.base + lane.tail];
+        wrap->payloadLength = IPC_TX_RECORD_WRAP;
+        lane.used += lane.size - lane.tail;
     }
     
-    _txQueueTail = nextTail;
+    IPC_TxRecord_t *record = (IPC_TxRecord_t*)&_txRing[lane.base + _txReserveOffset];
+    record->payloadLength = payloadLength;
+    record->messageType = _txReserveType;
+    
+    uint16_t size = txRecordSize(payloadLength);
+    lane.tail = (_txReserveOffset + size) % lane.size;
+    lane.used += size;
+    lane.count++;
+    _txQueueCount++;
+    
+    uint16_t ringUsed = _txLane[IPC_TX_LANE_CONTROL].used + _txLane[IPC_TX_LANE_BULK].used;
+    if (ringUsed > _txQueueHighWater) _txQueueHighWater = ringUsed;
+    if (_txQueueCount > _txQueuePeak) _txQueuePeak = _txQueueCount;
     return true;
 }
 
-void IPCProtocol::sendNextPacket() {
-    if (_txQueueHead == _txQueueTail) {
-        return;  // Queue empty
+bool IPCProtocol::txQueueHasSpace(uint8_t messageType, uint16_t payloadLength) {
+    uint16_t offset, cost;
+    return placeRecord(_txLane[txLaneFor(messageType)], payloadLength, offset, cost);
+}
+
+uint16_t IPCProtocol::txQueueCount() {
+    return _txQueueCount;
+}
+
+bool IPCProtocol::notifyWhenFree(uint8_t messageType, uint16_t payloadLength, IPC_TxSpaceCallback callback) {
+    if (callback == nullptr) return false;
+    
+    for (uint8_t i = 0; i < _txWaiterCount; i++) {
+        if (_txWaiters[i].callback == callback) {
+            _txWaiters[i].messageType = messageType;
+            _txWaiters[i].length = payloadLength;
+            return true;
+        }
+    }
+    if (_txWaiterCount >= IPC_TX_MAX_WAITERS) {
+        return false;
+    }
+    _txWaiters[_txWaiterCount].callback = callback;
+    _txWaiters[_txWaiterCount].messageType = messageType;
+    _txWaiters[_txWaiterCount].length = payloadLength;
+    _txWaiterCount++;
+    return true;
+}
+
+void IPCProtocol::serviceTxWaiters() {
+    uint8_t i = 0;
+    while (i < _txWaiterCount) {
+        IPC_TxWaiter_t waiter = _txWaiters[i];
+        if (!txQueueHasSpace(waiter.messageType, waiter.length)) {
+            i++;
+            continue;
+        }
+        // Remove before calling - the callback may register again
+        for (uint8_t j = i; j + 1 < _txWaiterCount; j++) {
+            _txWaiters[j] = _txWaiters[j + 1];
+        }
+        _txWaiterCount--;
+        waiter.callback();
+    }
+}
+
+bool IPCProtocol::sendPacket(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength) {
+    uint8_t *slot = reservePacket(messageType, payloadLength);
+    if (slot == nullptr) {
+        return false;
     }
     
-    IPC_TxPacket_t *packet = &_txQueue[_txQueueHead];
+    if (payloadLength > 0 && payload != nullptr) {
+        memcpy(slot, payload, payloadLength);
+    }
+    return commitPacket(payloadLength);
+}
+
+// Append one frame byte to the UART chunk, escaping START/END/ESC.
+// The chunk is flushed whenever it cannot take an escape pair.
+void IPCProtocol::writeStuffed(uint8_t *chunk, uint8_t &chunkLen, uint8_t byte) {
+    if (chunkLen >= IPC_TX_CHUNK_SIZE - 1) {
+        _uart->write(chunk, chunkLen);
+        _txWireBytes += chunkLen;
+        chunkLen = 0;
+    }
+    if (byte == IPC_START_BYTE || byte == IPC_END_BYTE || byte == IPC_ESCAPE_BYTE) {
+        chunk[chunkLen++] = IPC_ESCAPE_BYTE;
+        chunk[chunkLen++] = byte ^ IPC_ESCAPE_XOR;
+    } else {
+        chunk[chunkLen++] = byte;
+    }
+}
+
+// Encode and write one frame. Queued packets are written straight from their
+// ring record; baud rate change frames bypass the queue.
+void IPCProtocol::writeFrame(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength) {
+    // CRC is accumulated while bytes are stuffed, and output goes to the UART
+    // in FIFO-sized chunks (one mutex round-trip per chunk instead of per byte)
+    uint8_t chunk[IPC_TX_CHUNK_SIZE];
+    uint8_t chunkLen = 0;
     
-    // Build packet in temporary buffer
-    uint8_t tempBuffer[IPC_MAX_PAYLOAD_SIZE + 5];  // LENGTH(2) + TYPE(1) + PAYLOAD + CRC(2)
-    uint16_t tempIndex = 0;
+    // Send START byte
+    chunk[chunkLen++] = IPC_START_BYTE;
     
     // LENGTH = TYPE(1) + PAYLOAD length (does NOT include LENGTH field or CRC)
-    uint16_t packetLength = 1 + packet->payloadLength;
-    tempBuffer[tempIndex++] = (packetLength >> 8) & 0xFF;
-    tempBuffer[tempIndex++] = packetLength & 0xFF;
+    uint16_t packetLength = 1 + payloadLength;
+    uint8_t header[3] = {
+        (uint8_t)((packetLength >> 8) & 0xFF),
+        (uint8_t)(packetLength & 0xFF),
+        messageType
+    };
     
-    // TYPE
-    tempBuffer[tempIndex++] = packet->messageType;
+    // CRC over LENGTH + TYPE + PAYLOAD
+    uint16_t crc = IPC_CRC16_INIT;
+    for (uint8_t i = 0; i < sizeof(header); i++) {
+        crc = ipc_crc16_byte(crc, header[i]);
+        writeStuffed(chunk, chunkLen, header[i]);
+    }
     
-    // PAYLOAD
-    if (packet->payloadLength > 0) {
-        memcpy(&tempBuffer[tempIndex], packet->payload, packet->payloadLength);
-        tempIndex += packet->payloadLength;
+    if (_frameTap) {
+        _frameTap(IPC_TAP_TX, messageType, payload, payloadLength);
+    }
+    for (uint16_t i = 0; i < payloadLength; i++) {
+        uint8_t byte = payload[i];
+        crc = ipc_crc16_byte(crc, byte);
+        writeStuffed(chunk, chunkLen, byte);
     }
     
-    // Calculate CRC over LENGTH + TYPE + PAYLOAD
-    uint16_t crc = calculateCRC16(tempBuffer, tempIndex);
-    tempBuffer[tempIndex++] = (crc >> 8) & 0xFF;
-    tempBuffer[tempIndex++] = crc & 0xFF;
+    writeStuffed(chunk, chunkLen, (crc >> 8) & 0xFF);
+    writeStuffed(chunk, chunkLen, crc & 0xFF);
     
     #if IPC_DEBUG_ENABLED
-    // Print packet being sent
-    Serial.printf("[IPC TX] Sending packet, tempBuffer (%u bytes): ", tempIndex);
-    for (uint16_t i = 0; i < tempIndex; i++) {
-        Serial.printf("%02X ", tempBuffer[i]);
-    }
-    Serial.println();
+    Serial.printf("[IPC TX] Sending packet type 0x%02X, %u byte payload, CRC 0x%04X\n",
+                  messageType, payloadLength, crc);
     #endif
     
-    // Send START byte
-    _uart->write(IPC_START_BYTE);
-    
-    // Send packet with byte stuffing
-    for (uint16_t i = 0; i < tempIndex; i++) {
-        uint8_t byte = tempBuffer[i];
-        if (byte == IPC_START_BYTE || byte == IPC_END_BYTE || byte == IPC_ESCAPE_BYTE) {
-            _uart->write(IPC_ESCAPE_BYTE);
-            _uart->write(byte ^ IPC_ESCAPE_XOR);
-        } else {
-            _uart->write(byte);
-        }
-    }
-    
     // Send END byte
-    _uart->write(IPC_END_BYTE);
+    if (chunkLen >= IPC_TX_CHUNK_SIZE) {
+        _uart->write(chunk, chunkLen);
+        _txWireBytes += chunkLen;
+        chunkLen = 0;
+    }
+    chunk[chunkLen++] = IPC_END_BYTE;
+    _uart->write(chunk, chunkLen);
+    _txWireBytes += chunkLen;
     
     // Update statistics
     _txPacketCount++;
     _lastTxTime = millis();
+}
+
+void IPCProtocol::sendNextPacket() {
+    IPC_TxLane_t &control = _txLane[IPC_TX_LANE_CONTROL];
+    IPC_TxLane_t &bulk = _txLane[IPC_TX_LANE_BULK];
+    
+    // Control first, but let one bulk frame through after a burst of control
+    // frames so polling is never starved
+    IPC_TxLane_t *lane;
+    if (control.count > 0 && (bulk.count == 0 || _txControlBurst < IPC_TX_CONTROL_BURST)) {
+        lane = &control;
+        _txControlBurst = (bulk.count > 0) ? _txControlBurst + 1 : 0;
+    } else if (bulk.count > 0) {
+        lane = &bulk;
+        _txControlBurst = 0;
+    } else {
+        return;  // Queue empty
+    }
+    
+    IPC_TxRecord_t *packet = (IPC_TxRecord_t*)&_txRing[lane->base + lane->head];
+    if (packet->payloadLength == IPC_TX_RECORD_WRAP) {
+        // Skip unused space at the lane end
+        lane->used -= lane->size - lane->head;
+        lane->head = 0;
+        packet = (IPC_TxRecord_t*)&_txRing[lane->base];
+    }
+    
+    writeFrame(packet->messageType, (const uint8_t*)(packet + 1), packet->payloadLength);
     
     // Remove packet from queue
-    _txQueueHead = (_txQueueHead + 1) % IPC_TX_QUEUE_SIZE;
+    uint16_t size = txRecordSize(packet->payloadLength);
+    lane->head = (lane->head + size) % lane->size;
+    lane->used -= size;
+    lane->count--;
+    _txQueueCount--;
+    
+    // Empty - restart at offset 0 so the next records get the longest contiguous run
+    if (lane->count == 0) {
+        lane->head = 0;
+        lane->tail = 0;
+        lane->used = 0;
+    }
 }
 
 // =============================================================================
@@ -405,34 +691,81 @@ bool IPCProtocol::registerHandler(uint8_t messageType, IPC_MessageCallback callb
 // =============================================================================
 
 bool IPCProtocol::sendPing() {
-    return sendPacket(IPC_MSG_PING, nullptr, 0);
+    IPC_Ping_t *ping = (IPC_Ping_t*)reservePacket(IPC_MSG_PING, sizeof(IPC_Ping_t));
+    if (ping == nullptr) return false;
+    ping->link = _link;
+    ping->timestampUs = micros() | 1;  // 0 means no timestamp
+    return commitPacket(sizeof(IPC_Ping_t));
 }
 
 bool IPCProtocol::sendPong() {
-    return sendPacket(IPC_MSG_PONG, nullptr, 0);
+    IPC_Pong_t *pong = (IPC_Pong_t*)reservePacket(IPC_MSG_PONG, sizeof(IPC_Pong_t));
+    if (pong == nullptr) return false;
+    pong->echoTimestampUs = _pingEcho;
+    pong->link = _link;
+    return commitPacket(sizeof(IPC_Pong_t));
+}
+
+void IPCProtocol::processPing(const uint8_t *payload, uint16_t length) {
+    if (payload == nullptr || length < sizeof(IPC_Ping_t)) {
+        _pingEcho = 0;  // Plain keepalive
+        return;
+    }
+    const IPC_Ping_t *ping = (const IPC_Ping_t*)payload;
+    _pingEcho = ping->timestampUs;
+    _peerLink = ping->link;
+    _peerLinkTime = millis();
+    _peerLinkValid = true;
+}
+
+void IPCProtocol::processPong(const uint8_t *payload, uint16_t length) {
+    if (payload == nullptr || length < sizeof(IPC_Pong_t)) {
+        return;
+    }
+    const IPC_Pong_t *pong = (const IPC_Pong_t*)payload;
+    if (pong->echoTimestampUs != 0) {
+        _rttSample[_rttNext] = micros() - pong->echoTimestampUs;
+        _rttNext = (_rttNext + 1) % IPC_RTT_SAMPLES;
+        if (_rttCount < IPC_RTT_SAMPLES) _rttCount++;
+    }
+    _peerLink = pong->link;
+    _peerLinkTime = millis();
+    _peerLinkValid = true;
 }
 
-bool IPCProtocol::sendHello(uint32_t protocolVersion, uint32_t firmwareVersion, const char* deviceName) {
-    IPC_Hello_t hello;
-    hello.protocolVersion = protocolVersion;
-    hello.firmwareVersion = firmwareVersion;
-    strncpy(hello.deviceName, deviceName, sizeof(hello.deviceName) - 1);
-    hello.deviceName[sizeof(hello.deviceName) - 1] = '\0';
+bool IPCProtocol::sendHello(uint32_t protocolVersion, uint32_t firmwareVersion, const char* deviceName,
+                            const IPC_ConfigDigest_t* configDigest, uint8_t baudRates) {
+    IPC_Hello_t *hello = (IPC_Hello_t*)reservePacket(IPC_MSG_HELLO, sizeof(IPC_Hello_t));
+    if (hello == nullptr) return false;
     
-    return sendPacket(IPC_MSG_HELLO, (uint8_t*)&hello, sizeof(hello));
+    hello->protocolVersion = protocolVersion;
+    hello->firmwareVersion = firmwareVersion;
+    strncpy(hello->deviceName, deviceName, sizeof(hello->deviceName) - 1);
+    hello->deviceName[sizeof(hello->deviceName) - 1] = '\0';
+    hello->bulkWindow = 0;  // SYS MCU does not serve bulk ranges
+    if (configDigest != nullptr) {
+        hello->configDigest = *configDigest;
+    } else {
+        memset(&hello->configDigest, 0, sizeof(hello->configDigest));
+    }
+    hello->baudRates = baudRates;
+    
+    return commitPacket(sizeof(IPC_Hello_t));
 }
 
 bool IPCProtocol::sendError(uint8_t errorCode, const char* message) {
-    IPC_Error_t error;
-    error.errorCode = errorCode;
+    IPC_Error_t *error = (IPC_Error_t*)reservePacket(IPC_MSG_ERROR, sizeof(IPC_Error_t));
+    if (error == nullptr) return false;
+    
+    error->errorCode = errorCode;
     if (message != nullptr) {
-        strncpy(error.message, message, sizeof(error.message) - 1);
-        error.message[sizeof(error.message) - 1] = '\0';
+        strncpy(error->message, message, sizeof(error->message) - 1);
+        error->message[sizeof(error->message) - 1] = '\0';
     } else {
-        error.message[0] = '\0';
+        error->message[0] = '\0';
     }
     
-    return sendPacket(IPC_MSG_ERROR, (uint8_t*)&error, sizeof(error));
+    return commitPacket(sizeof(IPC_Error_t));
 }
 
 bool IPCProtocol::sendSensorData(const IPC_SensorData_t* data) {
@@ -505,10 +838,198 @@ bool IPCProtocol::sendMessage(const Message& msg) {
     return sendPacket(msg.msgId, msg.data, msg.dataLength);
 }
 
+// =============================================================================
+// Link Baud Rate Change
+// =============================================================================
+
+bool IPCProtocol::startBaudSwitch(uint32_t baudRate, uint8_t reason) {
+    if (_baudState != IPC_BAUD_IDLE || baudRate == _baudRate) {
+        return false;
+    }
+    IPC_BaudSwitch_t request;
+    request.baudRate = baudRate;
+    request.reason = reason;
+    writeFrame(IPC_MSG_BAUD_SWITCH, (const uint8_t*)&request, sizeof(request));
+    
+    _baudTarget = baudRate;
+    _baudResult = IPC_BAUD_RESULT_NONE;
+    _baudDeadline = millis() + IPC_BAUD_ACK_TIMEOUT_MS;
+    _baudState = IPC_BAUD_SWITCH_SENT;
+    return true;
+}
+
+void IPCProtocol::setBaudRate(uint32_t baudRate) {
+    _baudState = IPC_BAUD_IDLE;
+    _baudTarget = 0;
+    if (baudRate != _baudRate) {
+        applyBaud(baudRate);
+    }
+}
+
+uint32_t IPCProtocol::getBaudRate() {
+    return _baudRate;
+}
+
+bool IPCProtocol::baudSwitchBusy() {
+    return _baudState != IPC_BAUD_IDLE;
+}
+
+void IPCProtocol::getBaudStatus(IPC_BaudStatus_t *status) {
+    if (status == nullptr) return;
+    status->baudRate = _baudRate;
+    status->targetRate = _baudTarget;
+    status->state = _baudState;
+    status->lastResult = _baudResult;
+    status->switches = _baudSwitches;
+    status->failures = _baudFailures;
+}
+
+// Re-open the UART at another rate; anything half received is dropped
+void IPCProtocol::applyBaud(uint32_t baudRate) {
+    _uart->flush();
+    _uart->end();
+    _uart->begin(baudRate);
+    _baudRate = baudRate;
+    resetRxState();
+}
+
+// Test pattern: every byte value once per frame, shifted per sequence number
+void IPCProtocol::sendLinkTest(uint8_t sequence) {
+    IPC_LinkTest_t test;
+    test.baudRate = _baudRate;
+    test.sequence = sequence;
+    test.flags = (sequence == IPC_LINK_TEST_FRAMES - 1) ? IPC_LINK_TEST_COMMIT : 0;
+    for (uint16_t i = 0; i < IPC_LINK_TEST_SIZE; i++) {
+        test.pattern[i] = (uint8_t)(i * 7 + sequence * 85);
+    }
+    writeFrame(IPC_MSG_LINK_TEST, (const uint8_t*)&test, sizeof(test));
+}
+
+void IPCProtocol::abandonBaudSwitch(uint8_t result) {
+    _baudResult = result;
+    _baudFailures++;
+    _baudTarget = 0;
+    if (result == IPC_BAUD_RESULT_REFUSED) {
+        _baudState = IPC_BAUD_IDLE;
+        return;
+    }
+    if (_baudState == IPC_BAUD_TESTING || _baudState == IPC_BAUD_COMMIT) {
+        applyBaud(_baudPrevious);
+    }
+    // The IO MCU may be at the new rate: hold TX until it has given up on the
+    // commit and switched back
+    _baudDeadline = millis() + IPC_BAUD_VERIFY_MS + IPC_BAUD_SETTLE_MS;
+    _baudState = IPC_BAUD_RECOVER;
+}
+
+void IPCProtocol::processBaudSwitchAck(const uint8_t *payload, uint16_t length) {
+    if (_baudState != IPC_BAUD_SWITCH_SENT || payload == nullptr || length < sizeof(IPC_BaudSwitchAck_t)) {
+        return;
+    }
+    const IPC_BaudSwitchAck_t *ack = (const IPC_BaudSwitchAck_t*)payload;
+    if (ack->baudRate != _baudTarget) {
+        return;
+    }
+    if (!ack->accepted) {
+        abandonBaudSwitch(IPC_BAUD_RESULT_REFUSED);
+        return;
+    }
+    // The ACK is the last frame the IO MCU sends at the old rate
+    _baudPrevious = _baudRate;
+    applyBaud(_baudTarget);
+    _baudSwitchTime = millis();
+    _baudState = IPC_BAUD_SETTLE;
+}
+
+void IPCProtocol::processLinkTest(const uint8_t *payload, uint16_t length) {
+    if (_baudState != IPC_BAUD_TESTING && _baudState != IPC_BAUD_COMMIT) {
+        return;  // Extra echo of a resent commit, or of an abandoned switch
+    }
+    const IPC_LinkTest_t *echo = (const IPC_LinkTest_t*)payload;
+    bool match = payload != nullptr && length == sizeof(IPC_LinkTest_t) &&
+                 echo->baudRate == _baudRate && echo->sequence == _baudTestNext;
+    for (uint16_t i = 0; match && i < IPC_LINK_TEST_SIZE; i++) {
+        match = echo->pattern[i] == (uint8_t)(i * 7 + _baudTestNext * 85);
+    }
+    if (!match) {
+        if (_baudState == IPC_BAUD_TESTING) {
+            abandonBaudSwitch(IPC_BAUD_RESULT_TEST_FAILED);
+        }
+        return;  // A corrupted commit echo is covered by the resend
+    }
+    
+    if (_baudState == IPC_BAUD_COMMIT) {
+        // The IO MCU has kept the new rate
+        _baudState = IPC_BAUD_IDLE;
+        _baudResult = IPC_BAUD_RESULT_OK;
+        _baudTarget = 0;
+        _baudSwitches++;
+        return;
+    }
+    
+    _baudTestNext++;
+    sendLinkTest(_baudTestNext);
+    if (_baudTestNext == IPC_LINK_TEST_FRAMES - 1) {
+        _baudResendAt = millis() + IPC_BAUD_COMMIT_RESEND_MS;
+        _baudState = IPC_BAUD_COMMIT;
+    }
+}
+
+// Baud rate change steps that wait on the clock
+void IPCProtocol::serviceBaudSwitch(uint32_t now) {
+    switch (_baudState) {
+        case IPC_BAUD_SWITCH_SENT:
+            if ((int32_t)(now - _baudDeadline) >= 0) {
+                abandonBaudSwitch(IPC_BAUD_RESULT_NO_ACK);
+            }
+            break;
+            
+        case IPC_BAUD_SETTLE:
+            if (now - _baudSwitchTime >= IPC_BAUD_SETTLE_MS) {
+                _baudTestNext = 0;
+                _baudDeadline = _baudSwitchTime + IPC_BAUD_VERIFY_MS / 2;
+                _baudState = IPC_BAUD_TESTING;
+                sendLinkTest(0);
+            }
+            break;
+            
+        case IPC_BAUD_TESTING:
+            if ((int32_t)(now - _baudDeadline) >= 0) {
+                abandonBaudSwitch(IPC_BAUD_RESULT_TEST_FAILED);
+            }
+            break;
+            
+        case IPC_BAUD_COMMIT:
+            // No echo in time: most likely the IO MCU never saw a commit and
+            // is about to revert (if it did see one, the silence fallback in
+            // ipcManager and the IO MCU's connection timeout recover the link)
+            if ((int32_t)(now - _baudDeadline) >= 0) {
+                abandonBaudSwitch(IPC_BAUD_RESULT_TEST_FAILED);
+            } else if ((int32_t)(now - _baudResendAt) >= 0) {
+                sendLinkTest(IPC_LINK_TEST_FRAMES - 1);
+                _baudResendAt = now + IPC_BAUD_COMMIT_RESEND_MS;
+            }
+            break;
+            
+        case IPC_BAUD_RECOVER:
+            if ((int32_t)(now - _baudDeadline) >= 0) {
+                _baudState = IPC_BAUD_IDLE;
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
 // =============================================================================
 // Statistics
 // =============================================================================
 
+void IPCProtocol::setFrameTap(IPC_FrameTap tap) {
+    _frameTap = tap;
+}
+
 void IPCProtocol::getStatistics(IPC_Statistics_t *stats) {
     if (stats == nullptr) return;
     
@@ -518,6 +1039,69 @@ void IPCProtocol::getStatistics(IPC_Statistics_t *stats) {
     stats->crcErrorCount = _crcErrorCount;
     stats->lastRxTime = _lastRxTime;
     stats->lastTxTime = _lastTxTime;
+    stats->txQueueHighWater = _txQueueHighWater;
+    stats->txQueuePeak = _txQueuePeak;
+    stats->txQueueFullCount = _txQueueFullCount;
+    stats->rxWireBytes = _rxWireBytes;
+    stats->txWireBytes = _txWireBytes;
+}
+
+// Rates over the window just ended, RTT percentiles over the sample ring
+void IPCProtocol::closeLinkWindow(uint32_t now) {
+    uint32_t elapsed = now - _linkWindowStart;
+    
+    _link.rxBytesPerSec = (_rxWireBytes - _linkWindowRxBytes) * 1000ULL / elapsed;
+    _link.txBytesPerSec = (_txWireBytes - _linkWindowTxBytes) * 1000ULL / elapsed;
+    _link.rxFramesPerSec = (_rxPacketCount - _linkWindowRxFrames) * 1000ULL / elapsed;
+    _link.txFramesPerSec = (_txPacketCount - _linkWindowTxFrames) * 1000ULL / elapsed;
+    _link.rxUtilPermille = _link.rxBytesPerSec * 10000ULL / _baudRate;  // 10 bits per byte
+    _link.txUtilPermille = _link.txBytesPerSec * 10000ULL / _baudRate;
+    if (_link.rxUtilPermille > _link.rxUtilPeakPermille) _link.rxUtilPeakPermille = _link.rxUtilPermille;
+    if (_link.txUtilPermille > _link.txUtilPeakPermille) _link.txUtilPeakPermille = _link.txUtilPermille;
+    
+    // CRC failures are counted apart from the other RX errors on this side
+    uint32_t errors = _rxErrorCount + _crcErrorCount;
+    uint32_t seen = _rxPacketCount + errors;
+    _link.rxFrames = _rxPacketCount;
+    _link.rxErrors = errors;
+    _link.crcErrors = _crcErrorCount;
+    _link.rxErrorPpm = seen ? (uint32_t)(errors * 1000000ULL / seen) : 0;
+    _link.baudRate = _baudRate;
+    _link.txQueueHighWater = _txQueueHighWater;
+    _link.txQueueSize = IPC_TX_RING_SIZE;
+    _link.rxBacklogHighWater = _rxBacklogHighWater;
+    
+    // Insertion sort of at most IPC_RTT_SAMPLES values, once per window
+    uint32_t sorted[IPC_RTT_SAMPLES];
+    uint8_t n = _rttCount;
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t v = _rttSample[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    _link.rttSamples = n;
+    _link.rttP50Us = n ? sorted[(n - 1) / 2] : 0;
+    _link.rttP90Us = n ? sorted[(n - 1) * 9 / 10] : 0;
+    _link.rttMaxUs = n ? sorted[n - 1] : 0;
+    
+    _linkWindowStart = now;
+    _linkWindowRxBytes = _rxWireBytes;
+    _linkWindowTxBytes = _txWireBytes;
+    _linkWindowRxFrames = _rxPacketCount;
+    _linkWindowTxFrames = _txPacketCount;
+}
+
+void IPCProtocol::getLinkStats(IPC_LinkStats_t *stats) {
+    if (stats == nullptr) return;
+    *stats = _link;
+}
+
+uint32_t IPCProtocol::getPeerLinkStats(IPC_LinkStats_t *stats) {
+    if (stats != nullptr) *stats = _peerLink;
+    return _peerLinkValid ? millis() - _peerLinkTime : UINT32_MAX;
 }
 
 void IPCProtocol::resetStatistics() {
@@ -525,6 +1109,12 @@ void IPCProtocol::resetStatistics() {
     _txPacketCount = 0;
     _rxErrorCount = 0;
     _crcErrorCount = 0;
+    _txQueueHighWater = _txLane[IPC_TX_LANE_CONTROL].used + _txLane[IPC_TX_LANE_BULK].used;
+    _txQueuePeak = _txQueueCount;
+    _txQueueFullCount = 0;
+    _rxBacklogHighWater = 0;
+    _link.rxUtilPeakPermille = 0;
+    _link.txUtilPeakPermille = 0;
 }
 
 void IPCProtocol::resetRxState() {
@@ -26,14 +26,51 @@ typedef enum {
 } IPC_State_t;
 
 // =============================================================================
-// Transmit Queue Entry
+// Transmit Queue Record
 // =============================================================================
+// The TX queue is a byte ring of variable-length records (header + payload,
+// padded to 4 bytes) using the same RAM as IPC_TX_QUEUE_SIZE fixed 1 KB slots.
+// It is split into a control lane (control writes, config, device management)
+// and a bulk lane (sensor polling and index sync requests).
+
+#define IPC_TX_RING_SIZE        (IPC_TX_QUEUE_SIZE * (IPC_MAX_PAYLOAD_SIZE + 4))
+#define IPC_TX_CONTROL_RING_SIZE 6144   // Control lane share of the ring (rest is bulk)
+#define IPC_TX_CONTROL_BURST    8       // Control frames sent back-to-back before one bulk frame
+#define IPC_TX_RECORD_WRAP      0xFFFF  // Rest of ring unused, next record at offset 0
+#define IPC_TX_MAX_WAITERS      4       // Producers waiting on TX space
 
 typedef struct {
+    uint16_t payloadLength;                 // Payload length (or IPC_TX_RECORD_WRAP)
     uint8_t messageType;                    // Message type
-    uint16_t payloadLength;                 // Payload length
-    uint8_t payload[IPC_MAX_PAYLOAD_SIZE];  // Payload data
-} IPC_TxPacket_t;
+    uint8_t reserved;
+} IPC_TxRecord_t;
+
+typedef enum {
+    IPC_TX_LANE_CONTROL = 0,  // Always dequeued first
+    IPC_TX_LANE_BULK,
+    IPC_TX_LANE_COUNT
+} IPC_TxLaneId_t;
+
+typedef struct {
+    uint16_t base;            // Offset of this lane in the TX ring
+    uint16_t size;            // Lane size in bytes
+    uint16_t head;            // Read offset (next record to send, lane relative)
+    uint16_t tail;            // Write offset
+    uint16_t used;            // Bytes in use, including skipped space at the lane end
+    uint16_t count;           // Records queued
+} IPC_TxLane_t;
+
+// =============================================================================
+// TX Space Callback
+// =============================================================================
+
+typedef void (*IPC_TxSpaceCallback)();
+
+typedef struct {
+    IPC_TxSpaceCallback callback;
+    uint8_t messageType;
+    uint16_t length;
+} IPC_TxWaiter_t;
 
 // =============================================================================
 // Message Handler Callback
@@ -50,6 +87,16 @@ typedef struct {
     IPC_MessageCallback callback;
 } IPC_MessageHandler_t;
 
+// =============================================================================
+// Frame Tap (traffic capture)
+// =============================================================================
+
+#define IPC_TAP_RX      0x00    // Frame received from the IO MCU
+#define IPC_TAP_TX      0x01    // Frame handed to the UART
+#define IPC_TAP_ERROR   0x02    // RX frame rejected (size, length or CRC); payload is the raw buffer
+
+typedef void (*IPC_FrameTap)(uint8_t flags, uint8_t messageType, const uint8_t *payload, uint16_t length);
+
 // =============================================================================
 // Statistics Structure
 // =============================================================================
@@ -61,13 +108,52 @@ typedef struct {
     uint32_t crcErrorCount;   // CRC errors
     uint32_t lastRxTime;      // Last RX timestamp (ms)
     uint32_t lastTxTime;      // Last TX timestamp (ms)
+    uint16_t txQueueHighWater;  // Peak TX ring bytes in use
+    uint16_t txQueuePeak;       // Peak packets queued
+    uint32_t txQueueFullCount;  // Packets refused for lack of TX space
+    uint32_t rxWireBytes;       // Bytes read from the UART (framing and stuffing included)
+    uint32_t txWireBytes;       // Bytes written to the UART
 } IPC_Statistics_t;
 
+// =============================================================================
+// Link Baud Rate Change (see IPC_BaudSwitch_t)
+// =============================================================================
+
+#define IPC_BAUD_ACK_TIMEOUT_MS     100   // BAUD_SWITCH to BAUD_SWITCH_ACK
+#define IPC_BAUD_COMMIT_RESEND_MS   20    // Commit LINK_TEST resent until its echo arrives
+
+typedef enum {
+    IPC_BAUD_IDLE = 0,        // Running at the current rate
+    IPC_BAUD_SWITCH_SENT,     // BAUD_SWITCH sent, TX held until the ACK
+    IPC_BAUD_SETTLE,          // Switched, giving the IO MCU IPC_BAUD_SETTLE_MS to follow
+    IPC_BAUD_TESTING,         // LINK_TEST frames in flight
+    IPC_BAUD_COMMIT,          // Commit sent, waiting for its echo
+    IPC_BAUD_RECOVER          // Switch abandoned, TX held until the IO MCU has reverted too
+} IPC_BaudState_t;
+
+typedef enum {
+    IPC_BAUD_RESULT_NONE = 0,
+    IPC_BAUD_RESULT_OK,           // Switched and committed
+    IPC_BAUD_RESULT_REFUSED,      // IO MCU does not support the rate
+    IPC_BAUD_RESULT_NO_ACK,       // No BAUD_SWITCH_ACK in time
+    IPC_BAUD_RESULT_TEST_FAILED   // Test pattern lost or corrupted at the new rate
+} IPC_BaudResult_t;
+
+typedef struct {
+    uint32_t baudRate;        // Current link rate
+    uint32_t targetRate;      // Rate being switched to (0 = none)
+    uint8_t state;            // IPC_BaudState_t
+    uint8_t lastResult;       // IPC_BaudResult_t of the last switch
+    uint16_t switches;        // Switches committed
+    uint16_t failures;        // Switches refused or abandoned
+} IPC_BaudStatus_t;
+
 // =============================================================================
 // IPCProtocol Class
 // =============================================================================
 
 #define IPC_MAX_HANDLERS 32  // Maximum number of message handlers
+#define IPC_TX_CHUNK_SIZE 32  // Encoder output chunk (matches RP2040 UART TX FIFO depth)
 
 class IPCProtocol {
 public:
@@ -79,9 +165,9 @@ public:
     
     /**
      * @brief Initialize IPC protocol
-     * @param baudRate UART baud rate (default 2000000 = 2 Mbps, tested up to 3 Mbps)
+     * @param baudRate UART baud rate (handshake rate, see startBaudSwitch())
      */
-    void begin(uint32_t baudRate = 2000000);
+    void begin(uint32_t baudRate = IPC_BAUD_DEFAULT);
     
     /**
      * @brief Update function - call regularly from task
@@ -97,6 +183,48 @@ public:
      */
     bool sendPacket(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength);
     
+    /**
+     * @brief Reserve contiguous TX ring space for in-place serialization
+     * The record is published by commitPacket(); only the committed length is
+     * kept. A reservation that is never committed is discarded by the next
+     * reserve. Do not queue other packets between reserve and commit.
+     * @param messageType Message type (selects the TX lane)
+     * @param maxLength Maximum payload length that will be written
+     * @return Pointer to the payload buffer, or nullptr if no room / too large
+     */
+    uint8_t* reservePacket(uint8_t messageType, uint16_t maxLength);
+    
+    /**
+     * @brief Publish the record obtained from reservePacket()
+     * @param payloadLength Payload length actually written
+     * @return true if packet was queued successfully
+     */
+    bool commitPacket(uint16_t payloadLength);
+    
+    /**
+     * @brief Check if a packet would fit in its TX lane
+     * @param messageType Message type (selects the TX lane)
+     * @param payloadLength Payload length in bytes
+     * @return true if reservePacket(messageType, payloadLength) would succeed
+     */
+    bool txQueueHasSpace(uint8_t messageType, uint16_t payloadLength);
+    
+    /**
+     * @brief Get number of packets waiting in the TX queue
+     */
+    uint16_t txQueueCount();
+    
+    /**
+     * @brief Register a one-shot callback for when the TX queue can take a packet
+     * Lets producers defer instead of failing on a full queue. Callbacks run
+     * from update(); registering the same callback again updates the request.
+     * @param messageType Message type the producer will send
+     * @param payloadLength Payload length the producer needs
+     * @param callback Function to call once space is available
+     * @return true if registered, false if the waiter table is full
+     */
+    bool notifyWhenFree(uint8_t messageType, uint16_t payloadLength, IPC_TxSpaceCallback callback);
+    
     /**
      * @brief Register a message handler
      * @param messageType Message type to handle
@@ -105,12 +233,57 @@ public:
      */
     bool registerHandler(uint8_t messageType, IPC_MessageCallback callback);
     
+    /**
+     * @brief Observe every frame on the link (traffic capture)
+     * Called from update() for each valid RX frame before it is dispatched,
+     * each rejected RX frame, and each TX frame as it is encoded.
+     * @param tap Tap function, or nullptr to remove it
+     */
+    void setFrameTap(IPC_FrameTap tap);
+    
     /**
      * @brief Get statistics
      * @param stats Pointer to statistics structure
      */
     void getStatistics(IPC_Statistics_t *stats);
     
+    /**
+     * @brief Get link quality from the last IPC_LINK_WINDOW_MS window
+     * Rates, utilisation, error ratio, queue high-water marks and the RTT
+     * distribution of the PINGs this side sent.
+     * @param stats Pointer to link statistics structure
+     */
+    void getLinkStats(IPC_LinkStats_t *stats);
+    
+    /**
+     * @brief Get the IO MCU's view of the link, from its last PING or PONG
+     * @param stats Pointer to link statistics structure
+     * @return Age of the figures in ms, or UINT32_MAX if none has arrived
+     */
+    uint32_t getPeerLinkStats(IPC_LinkStats_t *stats);
+    
+    /**
+     * @brief Start a coordinated baud rate change with the IO MCU
+     * BAUD_SWITCH is sent at once; queued packets are held until the new rate
+     * is committed or the switch is abandoned. Progress runs from update().
+     * @param baudRate One of ipc_baudRates
+     * @param reason IPC_BaudReason (logged by the IO MCU)
+     * @return false if a switch is in progress or the rate is already in use
+     */
+    bool startBaudSwitch(uint32_t baudRate, uint8_t reason);
+    
+    /**
+     * @brief Change the local rate at once, without the IO MCU (link lost)
+     */
+    void setBaudRate(uint32_t baudRate);
+    
+    void processBaudSwitchAck(const uint8_t *payload, uint16_t length);  // From the BAUD_SWITCH_ACK handler
+    void processLinkTest(const uint8_t *payload, uint16_t length);       // From the LINK_TEST handler: echo check
+    
+    uint32_t getBaudRate();
+    bool baudSwitchBusy();
+    void getBaudStatus(IPC_BaudStatus_t *status);
+    
     /**
      * @brief Reset statistics counters
      */
@@ -124,9 +297,12 @@ public:
     void resetRxState();
     
     // Helper functions for common messages
-    bool sendPing();
-    bool sendPong();
-    bool sendHello(uint32_t protocolVersion, uint32_t firmwareVersion, const char* deviceName);
+    bool sendPing();                // Timestamped, carries getLinkStats()
+    bool sendPong();                // Echoes the timestamp of the last processPing()
+    void processPing(const uint8_t *payload, uint16_t length);   // From the PING handler
+    void processPong(const uint8_t *payload, uint16_t length);   // From the PONG handler: RTT sample
+    bool sendHello(uint32_t protocolVersion, uint32_t firmwareVersion, const char* deviceName,
+                   const IPC_ConfigDigest_t* configDigest = nullptr, uint8_t baudRates = 0);
     bool sendError(uint8_t errorCode, const char* message);
     
     // Sensor data helpers
@@ -161,14 +337,24 @@ private:
     uint8_t _rxMessageType;         // Received message type
     bool _rxEscapeNext;             // Escape sequence flag
     
-    // Transmit queue
-    IPC_TxPacket_t _txQueue[IPC_TX_QUEUE_SIZE];
-    uint8_t _txQueueHead;           // Queue head index
-    uint8_t _txQueueTail;           // Queue tail index
+    // Transmit queue (byte ring of IPC_TxRecord_t + payload, split into lanes)
+    uint8_t _txRing[IPC_TX_RING_SIZE] __attribute__((aligned(4)));
+    IPC_TxLane_t _txLane[IPC_TX_LANE_COUNT];
+    uint16_t _txQueueCount;         // Records queued (all lanes)
+    bool _txReserved;               // Space handed out by reservePacket()
+    uint8_t _txReserveLane;         // Lane of the reserved record
+    uint8_t _txReserveType;         // Message type of the reserved record
+    uint16_t _txReserveOffset;      // Where the reserved record starts (lane relative)
+    uint8_t _txControlBurst;        // Control frames sent while bulk was waiting
+    
+    // TX backpressure
+    IPC_TxWaiter_t _txWaiters[IPC_TX_MAX_WAITERS];
+    uint8_t _txWaiterCount;
     
     // Message handlers
     IPC_MessageHandler_t _handlers[IPC_MAX_HANDLERS];
     uint8_t _handlerCount;
+    IPC_FrameTap _frameTap;
     
     // Statistics
     uint32_t _rxPacketCount;
@@ -177,11 +363,57 @@ private:
     uint32_t _crcErrorCount;
     uint32_t _lastRxTime;
     uint32_t _lastTxTime;
+    uint16_t _txQueueHighWater;
+    uint16_t _txQueuePeak;
+    uint32_t _txQueueFullCount;
+    uint32_t _rxWireBytes;
+    uint32_t _txWireBytes;
+    uint16_t _rxBacklogHighWater;
+    
+    // Link quality (see IPC_LinkStats_t)
+    uint32_t _baudRate;
+    uint32_t _rttSample[IPC_RTT_SAMPLES];  // Ring of PING round trips (us)
+    uint8_t _rttCount;
+    uint8_t _rttNext;
+    uint32_t _pingEcho;             // Timestamp of the last PING, echoed by sendPong()
+    uint32_t _linkWindowStart;      // millis() at the start of the rate window
+    uint32_t _linkWindowRxBytes;    // Counters at the start of the window
+    uint32_t _linkWindowTxBytes;
+    uint32_t _linkWindowRxFrames;
+    uint32_t _linkWindowTxFrames;
+    IPC_LinkStats_t _link;          // This side, updated at the end of each window
+    IPC_LinkStats_t _peerLink;      // IO MCU's view from its last PING/PONG
+    uint32_t _peerLinkTime;         // millis() when _peerLink arrived
+    bool _peerLinkValid;
+    
+    // Baud rate change
+    IPC_BaudState_t _baudState;
+    uint8_t _baudResult;
+    uint32_t _baudTarget;
+    uint32_t _baudPrevious;         // Rate to return to if the switch is abandoned
+    uint32_t _baudSwitchTime;       // millis() when the UART switched
+    uint32_t _baudDeadline;         // millis() deadline of the current step
+    uint32_t _baudResendAt;         // millis() when the commit is sent again
+    uint8_t _baudTestNext;          // Sequence of the LINK_TEST awaiting its echo
+    uint16_t _baudSwitches;
+    uint16_t _baudFailures;
     
     // Internal methods
     void processRxByte(uint8_t byte);
     void processRxPacket();
+    void tapRxError();
+    void closeLinkWindow(uint32_t now);
+    uint16_t flushRx();
     void sendNextPacket();
+    void writeFrame(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength);
+    void applyBaud(uint32_t baudRate);
+    void serviceBaudSwitch(uint32_t now);
+    void abandonBaudSwitch(uint8_t result);
+    void sendLinkTest(uint8_t sequence);
+    void writeStuffed(uint8_t *chunk, uint8_t &chunkLen, uint8_t byte);
+    void initTxLanes();
+    bool placeRecord(IPC_TxLane_t &lane, uint16_t payloadLength, uint16_t &offset, uint16_t &cost);
+    void serviceTxWaiters();
     void dispatchMessage(uint8_t messageType, const uint8_t *payload, uint16_t payloadLength);
 };
 
@@ -24,6 +24,8 @@ void setDefaultIOConfig() {
         strcpy(ioConfig.adcInputs[i].unit, "mV");
         ioConfig.adcInputs[i].cal.scale = 1.0;
         ioConfig.adcInputs[i].cal.offset = 0.0;
+        ioConfig.adcInputs[i].filterType = IPC_ADC_FILTER_NONE;
+        ioConfig.adcInputs[i].filterLength = 1;
         ioConfig.adcInputs[i].enabled = true;
         ioConfig.adcInputs[i].showOnDashboard = false;
     }
@@ -52,6 +54,7 @@ void setDefaultIOConfig() {
         ioConfig.rtdSensors[i].cal.offset = 0.0;
         ioConfig.rtdSensors[i].wireConfig = 3;      // 3-wire by default
         ioConfig.rtdSensors[i].nominalOhms = 100;   // PT100 by default
+        ioConfig.rtdSensors[i].samplePeriodMs = 200;
         ioConfig.rtdSensors[i].enabled = true;
         ioConfig.rtdSensors[i].showOnDashboard = false;
     }
@@ -274,6 +277,7 @@ void setDefaultIOConfig() {
     memset(&ioConfig.dashboardLayout, 0, sizeof(ioConfig.dashboardLayout));
 }
 
+#ifndef ORC_NATIVE
 /**
  * @brief Load IO configuration from LittleFS
  * @return true if successful, false if file not found or invalid
@@ -346,6 +350,8 @@ bool loadIOConfig() {
                     sizeof(ioConfig.adcInputs[i].unit));
             ioConfig.adcInputs[i].cal.scale = adc["cal_scale"] | 1.0;
             ioConfig.adcInputs[i].cal.offset = adc["cal_offset"] | 0.0;
+            ioConfig.adcInputs[i].filterType = adc["filter_type"] | IPC_ADC_FILTER_NONE;
+            ioConfig.adcInputs[i].filterLength = adc["filter_length"] | 1;
             ioConfig.adcInputs[i].enabled = adc["enabled"] | true;
             ioConfig.adcInputs[i].showOnDashboard = adc["showOnDashboard"] | false;
         }
@@ -384,6 +390,7 @@ bool loadIOConfig() {
             ioConfig.rtdSensors[i].cal.offset = rtd["cal"]["offset"] | 0.0;
             ioConfig.rtdSensors[i].wireConfig = rtd["wire_config"] | 3;
             ioConfig.rtdSensors[i].nominalOhms = rtd["nominal_ohms"] | 100;
+            ioConfig.rtdSensors[i].samplePeriodMs = rtd["sample_period_ms"] | 200;
             ioConfig.rtdSensors[i].enabled = rtd["enabled"] | true;
             ioConfig.rtdSensors[i].showOnDashboard = rtd["showOnDashboard"] | false;
         }
@@ -758,6 +765,8 @@ void saveIOConfig() {
         adc["unit"] = ioConfig.adcInputs[i].unit;
         adc["cal_scale"] = ioConfig.adcInputs[i].cal.scale;
         adc["cal_offset"] = ioConfig.adcInputs[i].cal.offset;
+        adc["filter_type"] = ioConfig.adcInputs[i].filterType;
+        adc["filter_length"] = ioConfig.adcInputs[i].filterLength;
         adc["enabled"] = ioConfig.adcInputs[i].enabled;
         adc["showOnDashboard"] = ioConfig.adcInputs[i].showOnDashboard;
     }
@@ -789,6 +798,7 @@ void saveIOConfig() {
         cal["offset"] = ioConfig.rtdSensors[i].cal.offset;
         rtd["wire_config"] = ioConfig.rtdSensors[i].wireConfig;
         rtd["nominal_ohms"] = ioConfig.rtdSensors[i].nominalOhms;
+        rtd["sample_period_ms"] = ioConfig.rtdSensors[i].samplePeriodMs;
         rtd["enabled"] = ioConfig.rtdSensors[i].enabled;
         rtd["showOnDashboard"] = ioConfig.rtdSensors[i].showOnDashboard;
     }
@@ -1093,6 +1103,17 @@ void saveIOConfig() {
     
     // Don't end LittleFS here as it will prevent serving web files
 }
+#else
+// Host builds (IPC twin) have no LittleFS: run on the defaults, never persist
+bool loadIOConfig() {
+    setDefaultIOConfig();
+    return true;
+}
+
+void saveIOConfig() {
+    ioConfigChanged = true;
+}
+#endif
 
 /**
  * @brief Print current IO configuration for debugging
@@ -1105,18 +1126,20 @@ void printIOConfig() {
     // ADC Inputs
     log(LOG_INFO, true, "ADC Inputs:\n");
     for (int i = 0; i < MAX_ADC_INPUTS; i++) {
-        log(LOG_INFO, true, "  [%d] %s: %s (scale=%.3f, offset=%.3f) %s\n",
+        log(LOG_INFO, true, "  [%d] %s: %s (scale=%.3f, offset=%.3f) filter %u/%u %s\n",
             i, ioConfig.adcInputs[i].name, ioConfig.adcInputs[i].unit,
             ioConfig.adcInputs[i].cal.scale, ioConfig.adcInputs[i].cal.offset,
+            ioConfig.adcInputs[i].filterType, ioConfig.adcInputs[i].filterLength,
             ioConfig.adcInputs[i].enabled ? "ENABLED" : "DISABLED");
     }
     
     // RTD Sensors
     log(LOG_INFO, true, "\nRTD Sensors:\n");
     for (int i = 0; i < MAX_RTD_SENSORS; i++) {
-        log(LOG_INFO, true, "  [%d] %s: %s, %d-wire PT%d (scale=%.4f, offset=%.2f) %s\n",
+        log(LOG_INFO, true, "  [%d] %s: %s, %d-wire PT%d, %u ms (scale=%.4f, offset=%.2f) %s\n",
             i + 10, ioConfig.rtdSensors[i].name, ioConfig.rtdSensors[i].unit,
             ioConfig.rtdSensors[i].wireConfig, ioConfig.rtdSensors[i].nominalOhms,
+            ioConfig.rtdSensors[i].samplePeriodMs,
             ioConfig.rtdSensors[i].cal.scale, ioConfig.rtdSensors[i].cal.offset,
             ioConfig.rtdSensors[i].enabled ? "ENABLED" : "DISABLED");
     }
@@ -1136,17 +1159,16 @@ void printIOConfig() {
 
 /**
  * @brief Push IO configuration to IO MCU via IPC
- * Sends object-specific configuration for all enabled objects
+ * Stages object-specific configuration for all enabled objects into one
+ * configuration batch. The batch is sent without blocking and applied by the
+ * IO MCU in one pass on commit; the result arrives as CONFIG_RESULT.
+ * After a handshake, sections the IO MCU already has (same digest) are skipped.
  */
 void pushIOConfigToIOmcu() {
     log(LOG_INFO, false, "Pushing IO configuration to IO MCU...\n");
     
-    uint16_t sentCount = 0;
-    
-    // Config push delays - increase for more reliable transmission
-    const uint16_t CONFIG_DELAY_MS = 20;        // Delay between simple config messages
-    const uint16_t DEVICE_DELAY_MS = 30;        // Delay for device creation (needs more processing)
-    const uint16_t CONTROLLER_DELAY_MS = 20;    // Delay for controller config
+    uint16_t stagedCount = 0;
+    ipcConfigBatchBegin();
     
     // ========================================================================
     // Push ADC Input configurations (indices 0-7)
@@ -1155,32 +1177,23 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.adcInputs[i].enabled) continue;
         
         IPC_ConfigAnalogInput_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));  // Zeroed so identical config hashes identically (config digest)
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = i;
         strncpy(cfg.unit, ioConfig.adcInputs[i].unit, sizeof(cfg.unit) - 1);
         cfg.unit[sizeof(cfg.unit) - 1] = '\0';
         cfg.calScale = ioConfig.adcInputs[i].cal.scale;
         cfg.calOffset = ioConfig.adcInputs[i].cal.offset;
+        cfg.filterType = ioConfig.adcInputs[i].filterType;
+        cfg.filterLength = ioConfig.adcInputs[i].filterLength;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_ANALOG_INPUT, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_DEBUG, false, "  → ADC[%d]: %s, scale=%.3f, offset=%.3f\n",
-                    i, cfg.unit, cfg.calScale, cfg.calOffset);
-                break;
-            }
-            ipc.update();  // Process any pending RX/TX
-            delay(10);  // Wait for queue space
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send ADC[%d] config after retries\n", i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_ANALOG_INPUT, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_DEBUG, false, "  → ADC[%d]: %s, scale=%.3f, offset=%.3f\n",
+                i, cfg.unit, cfg.calScale, cfg.calOffset);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for ADC[%d] in config batch\n", i);
         }
-        
-        delay(CONFIG_DELAY_MS);  // Delay between messages
     }
     
     // ========================================================================
@@ -1190,32 +1203,21 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.dacOutputs[i].enabled) continue;
         
         IPC_ConfigAnalogOutput_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 8 + i;
         strncpy(cfg.unit, ioConfig.dacOutputs[i].unit, sizeof(cfg.unit) - 1);
         cfg.unit[sizeof(cfg.unit) - 1] = '\0';
         cfg.calScale = ioConfig.dacOutputs[i].cal.scale;
         cfg.calOffset = ioConfig.dacOutputs[i].cal.offset;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_ANALOG_OUTPUT, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_DEBUG, false, "  → DAC[%d]: %s, scale=%.3f, offset=%.3f\n",
-                    8 + i, cfg.unit, cfg.calScale, cfg.calOffset);
-                break;
-            }
-            ipc.update();  // Process any pending RX/TX
-            delay(10);  // Wait for queue space
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send DAC[%d] config after retries\n", 8 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_ANALOG_OUTPUT, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_DEBUG, false, "  → DAC[%d]: %s, scale=%.3f, offset=%.3f\n",
+                8 + i, cfg.unit, cfg.calScale, cfg.calOffset);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for DAC[%d] in config batch\n", 8 + i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1225,7 +1227,8 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.rtdSensors[i].enabled) continue;
         
         IPC_ConfigRTD_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 10 + i;
         strncpy(cfg.unit, ioConfig.rtdSensors[i].unit, sizeof(cfg.unit) - 1);
         cfg.unit[sizeof(cfg.unit) - 1] = '\0';
@@ -1233,26 +1236,15 @@ void pushIOConfigToIOmcu() {
         cfg.calOffset = ioConfig.rtdSensors[i].cal.offset;
         cfg.wireConfig = ioConfig.rtdSensors[i].wireConfig;
         cfg.nominalOhms = ioConfig.rtdSensors[i].nominalOhms;
+        cfg.samplePeriodMs = ioConfig.rtdSensors[i].samplePeriodMs;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_RTD, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_DEBUG, false, "  → RTD[%d]: %s, %d-wire, PT%d, scale=%.3f, offset=%.3f\n",
-                    10 + i, cfg.unit, cfg.wireConfig, cfg.nominalOhms, cfg.calScale, cfg.calOffset);
-                break;
-            }
-            ipc.update();  // Process any pending RX/TX
-            delay(10);  // Wait for queue space
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send RTD[%d] config after retries\n", 10 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_RTD, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_DEBUG, false, "  → RTD[%d]: %s, %d-wire, PT%d, scale=%.3f, offset=%.3f\n",
+                10 + i, cfg.unit, cfg.wireConfig, cfg.nominalOhms, cfg.calScale, cfg.calOffset);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for RTD[%d] in config batch\n", 10 + i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1262,34 +1254,23 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.gpio[i].enabled) continue;
         
         IPC_ConfigGPIO_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 13 + i;
         strncpy(cfg.name, ioConfig.gpio[i].name, sizeof(cfg.name) - 1);
         cfg.name[sizeof(cfg.name) - 1] = '\0';
         cfg.pullMode = (uint8_t)ioConfig.gpio[i].pullMode;
         cfg.enabled = ioConfig.gpio[i].enabled;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_GPIO, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                const char* pullStr = (cfg.pullMode == 1) ? "PULL-UP" :
-                                      (cfg.pullMode == 2) ? "PULL-DOWN" : "HIGH-Z";
-                log(LOG_DEBUG, false, "  → GPIO[%d]: %s, pull=%s\n",
-                    13 + i, cfg.name, pullStr);
-                break;
-            }
-            ipc.update();  // Process any pending RX/TX
-            delay(10);  // Wait for queue space
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send GPIO[%d] config after retries\n", 13 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_GPIO, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            const char* pullStr = (cfg.pullMode == 1) ? "PULL-UP" :
+                                  (cfg.pullMode == 2) ? "PULL-DOWN" : "HIGH-Z";
+            log(LOG_DEBUG, false, "  → GPIO[%d]: %s, pull=%s\n",
+                13 + i, cfg.name, pullStr);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for GPIO[%d] in config batch\n", 13 + i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1299,33 +1280,22 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.digitalOutputs[i].enabled) continue;
         
         IPC_ConfigDigitalOutput_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 21 + i;
         strncpy(cfg.name, ioConfig.digitalOutputs[i].name, sizeof(cfg.name) - 1);
         cfg.name[sizeof(cfg.name) - 1] = '\0';
         cfg.mode = (uint8_t)ioConfig.digitalOutputs[i].mode;
         cfg.enabled = ioConfig.digitalOutputs[i].enabled;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_DIGITAL_OUTPUT, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                const char* modeStr = (cfg.mode == 1) ? "PWM" : "ON/OFF";
-                log(LOG_DEBUG, false, "  → DigitalOutput[%d]: %s, mode=%s\n",
-                    21 + i, cfg.name, modeStr);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send DigitalOutput[%d] config after retries\n", 21 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_DIGITAL_OUTPUT, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            const char* modeStr = (cfg.mode == 1) ? "PWM" : "ON/OFF";
+            log(LOG_DEBUG, false, "  → DigitalOutput[%d]: %s, mode=%s\n",
+                21 + i, cfg.name, modeStr);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for DigitalOutput[%d] in config batch\n", 21 + i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1333,7 +1303,8 @@ void pushIOConfigToIOmcu() {
     // ========================================================================
     if (ioConfig.stepperMotor.enabled) {
         IPC_ConfigStepper_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 26;
         strncpy(cfg.name, ioConfig.stepperMotor.name, sizeof(cfg.name) - 1);
         cfg.name[sizeof(cfg.name) - 1] = '\0';
@@ -1353,25 +1324,13 @@ void pushIOConfigToIOmcu() {
         cfg.coolStepMinRPM = ioConfig.stepperMotor.coolStepMinRPM;
         cfg.fullStepMinRPM = ioConfig.stepperMotor.fullStepMinRPM;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_STEPPER, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_DEBUG, false, "  → Stepper[26]: %s, maxRPM=%d, steps=%d, Irun=%dmA\n",
-                    cfg.name, cfg.maxRPM, cfg.stepsPerRev, cfg.runCurrent_mA);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send Stepper config after retries\n");
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_STEPPER, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_DEBUG, false, "  → Stepper[26]: %s, maxRPM=%d, steps=%d, Irun=%dmA\n",
+                cfg.name, cfg.maxRPM, cfg.stepsPerRev, cfg.runCurrent_mA);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for Stepper in config batch\n");
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1381,32 +1340,21 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.dcMotors[i].enabled) continue;
         
         IPC_ConfigDCMotor_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 27 + i;
         strncpy(cfg.name, ioConfig.dcMotors[i].name, sizeof(cfg.name) - 1);
         cfg.name[sizeof(cfg.name) - 1] = '\0';
         cfg.invertDirection = ioConfig.dcMotors[i].invertDirection;
         cfg.enabled = ioConfig.dcMotors[i].enabled;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_DCMOTOR, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_DEBUG, false, "  → DCMotor[%d]: %s, invert=%s\n",
-                    27 + i, cfg.name, cfg.invertDirection ? "YES" : "NO");
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send DCMotor[%d] config after retries\n", 27 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_DCMOTOR, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_DEBUG, false, "  → DCMotor[%d]: %s, invert=%s\n",
+                27 + i, cfg.name, cfg.invertDirection ? "YES" : "NO");
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for DCMotor[%d] in config batch\n", 27 + i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1416,34 +1364,23 @@ void pushIOConfigToIOmcu() {
         if (!ioConfig.comPorts[i].enabled) continue;
         
         IPC_ConfigComPort_t cfg;
-        cfg.transactionId = generateTransactionId();
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = i;
         cfg.baudRate = ioConfig.comPorts[i].baudRate;
         cfg.dataBits = ioConfig.comPorts[i].dataBits;
         cfg.stopBits = ioConfig.comPorts[i].stopBits;
         cfg.parity = ioConfig.comPorts[i].parity;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_COMPORT, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                const char* parityStr = (cfg.parity == 0) ? "N" :
-                                       (cfg.parity == 1) ? "O" : "E";
-                log(LOG_DEBUG, false, "  → COM Port[%d]: %lu baud, %d%s%.0f\n",
-                    i, cfg.baudRate, cfg.dataBits, parityStr, cfg.stopBits);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send COM Port[%d] config after retries\n", i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_COMPORT, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            const char* parityStr = (cfg.parity == 0) ? "N" :
+                                   (cfg.parity == 1) ? "O" : "E";
+            log(LOG_DEBUG, false, "  → COM Port[%d]: %lu baud, %d%s%.0f\n",
+                i, cfg.baudRate, cfg.dataBits, parityStr, cfg.stopBits);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for COM Port[%d] in config batch\n", i);
         }
-        
-        delay(CONFIG_DELAY_MS);
     }
     
     // ========================================================================
@@ -1498,44 +1435,33 @@ void pushIOConfigToIOmcu() {
         
         // Send device create command
         IPC_DeviceCreate_t createCmd;
+        memset(&createCmd, 0, sizeof(createCmd));
         createCmd.startIndex = dynamicIndex;
         memcpy(&createCmd.config, &ipcConfig, sizeof(IPC_DeviceConfig_t));
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_DEVICE_CREATE, (uint8_t*)&createCmd, sizeof(createCmd))) {
-                sent = true;
-                sentCount++;
-                const char* devTypeStr = (ipcConfig.deviceType == IPC_DEV_HAMILTON_PH) ? "Hamilton pH" :
-                                       (ipcConfig.deviceType == IPC_DEV_HAMILTON_DO) ? "Hamilton DO" :
-                                       (ipcConfig.deviceType == IPC_DEV_HAMILTON_OD) ? "Hamilton OD" :
-                                       (ipcConfig.deviceType == IPC_DEV_ALICAT_MFC) ? "Alicat MFC" : "Unknown";
-                log(LOG_INFO, false, "  → Device[%d]: %s, type=%s, bus=%d, addr=%d\n",
-                    dynamicIndex, ioConfig.devices[i].name, devTypeStr,
-                    ipcConfig.busIndex, ipcConfig.address);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send Device[%d] config after retries\n", dynamicIndex);
+        if (ipcConfigBatchAdd(IPC_MSG_DEVICE_CREATE, createCmd.startIndex, &createCmd, sizeof(createCmd))) {
+            stagedCount++;
+            const char* devTypeStr = (ipcConfig.deviceType == IPC_DEV_HAMILTON_PH) ? "Hamilton pH" :
+                                   (ipcConfig.deviceType == IPC_DEV_HAMILTON_DO) ? "Hamilton DO" :
+                                   (ipcConfig.deviceType == IPC_DEV_HAMILTON_OD) ? "Hamilton OD" :
+                                   (ipcConfig.deviceType == IPC_DEV_ALICAT_MFC) ? "Alicat MFC" : "Unknown";
+            log(LOG_INFO, false, "  → Device[%d]: %s, type=%s, bus=%d, addr=%d\n",
+                dynamicIndex, ioConfig.devices[i].name, devTypeStr,
+                ipcConfig.busIndex, ipcConfig.address);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for Device[%d] in config batch\n", dynamicIndex);
         }
-        
-        delay(DEVICE_DELAY_MS);  // Extra delay for device initialization
     }
     
-    // Push pressure controller calibration (after device creation)
-    log(LOG_INFO, true, "Sending pressure controller calibration...\n");
+    // Push pressure controller calibration (after device creation - records are applied in order)
     for (int i = 0; i < MAX_DEVICES; i++) {
         if (ioConfig.devices[i].isActive && 
             ioConfig.devices[i].driverType == (DeviceDriverType)IPC_DEV_PRESSURE_CTRL &&
             ioConfig.devices[i].interfaceType == DEVICE_INTERFACE_ANALOGUE_IO) {
             
             IPC_ConfigPressureCtrl_t cfg;
-            cfg.transactionId = generateTransactionId();
+            memset(&cfg, 0, sizeof(cfg));
+            cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
             cfg.controlIndex = ioConfig.devices[i].dynamicIndex - 20;  // Control index
             cfg.dacIndex = ioConfig.devices[i].analogueIO.dacOutputIndex;
             strncpy(cfg.unit, ioConfig.devices[i].analogueIO.unit, sizeof(cfg.unit) - 1);
@@ -1543,24 +1469,13 @@ void pushIOConfigToIOmcu() {
             cfg.scale = ioConfig.devices[i].analogueIO.scale;
             cfg.offset = ioConfig.devices[i].analogueIO.offset;
             
-            bool sent = false;
-            for (int retry = 0; retry < 10; retry++) {
-                if (ipc.sendPacket(IPC_MSG_CONFIG_PRESSURE_CTRL, (uint8_t*)&cfg, sizeof(cfg))) {
-                    sent = true;
-                    sentCount++;
-                    log(LOG_DEBUG, false, "  → Pressure[%d]: scale=%.6f, offset=%.2f %s at DAC %d\n",
-                        cfg.controlIndex, cfg.scale, cfg.offset, cfg.unit, cfg.dacIndex);
-                    break;
-                }
-                ipc.update();
-                delay(10);
-            }
-            
-            if (!sent) {
-                log(LOG_WARNING, false, "  ✗ Failed to send pressure controller calibration\n");
+            if (ipcConfigBatchAdd(IPC_MSG_CONFIG_PRESSURE_CTRL, cfg.controlIndex, &cfg, sizeof(cfg))) {
+                stagedCount++;
+                log(LOG_DEBUG, false, "  → Pressure[%d]: scale=%.6f, offset=%.2f %s at DAC %d\n",
+                    cfg.controlIndex, cfg.scale, cfg.offset, cfg.unit, cfg.dacIndex);
+            } else {
+                log(LOG_WARNING, false, "  ✗ No room for pressure controller calibration in config batch\n");
             }
-            
-            delay(CONTROLLER_DELAY_MS);
         }
     }
     
@@ -1589,26 +1504,14 @@ void pushIOConfigToIOmcu() {
         cfg.outputMin = ioConfig.tempControllers[i].outputMin;
         cfg.outputMax = ioConfig.tempControllers[i].outputMax;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_TEMP_CONTROLLER, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_INFO, false, "  → TempController[%d]: %s, sensor=%d, output=%d, method=%s\n",
-                    cfg.index, cfg.name, cfg.pvSourceIndex, cfg.outputIndex,
-                    cfg.controlMethod == 0 ? "On/Off" : "PID");
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send TempController[%d] config after retries\n", 40 + i);
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_TEMP_CONTROLLER, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_INFO, false, "  → TempController[%d]: %s, sensor=%d, output=%d, method=%s\n",
+                cfg.index, cfg.name, cfg.pvSourceIndex, cfg.outputIndex,
+                cfg.controlMethod == 0 ? "On/Off" : "PID");
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for TempController[%d] in config batch\n", 40 + i);
         }
-        
-        delay(CONTROLLER_DELAY_MS);
     }
     
     // ========================================================================
@@ -1618,7 +1521,7 @@ void pushIOConfigToIOmcu() {
         IPC_ConfigpHController_t cfg;
         memset(&cfg, 0, sizeof(cfg));
         
-        cfg.transactionId = generateTransactionId();
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 43;
         cfg.isActive = true;
         strncpy(cfg.name, ioConfig.phController.name, sizeof(cfg.name) - 1);
@@ -1647,25 +1550,13 @@ void pushIOConfigToIOmcu() {
         cfg.alkalineVolumePerDose_mL = ioConfig.phController.alkalineDosing.volumePerDose_mL;
         cfg.alkalineMfcFlowRate_mL_min = ioConfig.phController.alkalineDosing.mfcFlowRate_mL_min;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_PH_CONTROLLER, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_INFO, false, "  → pHController[43]: %s, sensor=%d, setpoint=%.2f\n",
-                    cfg.name, cfg.pvSourceIndex, cfg.setpoint);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send pHController[43] config after retries\n");
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_PH_CONTROLLER, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_INFO, false, "  → pHController[43]: %s, sensor=%d, setpoint=%.2f\n",
+                cfg.name, cfg.pvSourceIndex, cfg.setpoint);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for pHController[43] in config batch\n");
         }
-        
-        delay(CONTROLLER_DELAY_MS);
     }
     
     // ========================================================================
@@ -1676,7 +1567,7 @@ void pushIOConfigToIOmcu() {
             IPC_ConfigFlowController_t cfg;
             memset(&cfg, 0, sizeof(cfg));
             
-            cfg.transactionId = generateTransactionId();
+            cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
             cfg.index = 44 + i;
             cfg.isActive = true;
             strncpy(cfg.name, ioConfig.flowControllers[i].name, sizeof(cfg.name) - 1);
@@ -1695,25 +1586,13 @@ void pushIOConfigToIOmcu() {
             cfg.minDosingInterval_ms = ioConfig.flowControllers[i].minDosingInterval_ms;
             cfg.maxDosingTime_ms = ioConfig.flowControllers[i].maxDosingTime_ms;
             
-            // Retry up to 10 times if queue is full
-            bool sent = false;
-            for (int retry = 0; retry < 10; retry++) {
-                if (ipc.sendPacket(IPC_MSG_CONFIG_FLOW_CONTROLLER, (uint8_t*)&cfg, sizeof(cfg))) {
-                    sent = true;
-                    sentCount++;
-                    log(LOG_INFO, false, "  → FlowController[%d]: %s, flow=%.2f mL/min\n",
-                        cfg.index, cfg.name, cfg.flowRate_mL_min);
-                    break;
-                }
-                ipc.update();
-                delay(10);
-            }
-            
-            if (!sent) {
-                log(LOG_WARNING, false, "  ✗ Failed to send FlowController[%d] config after retries\n", cfg.index);
+            if (ipcConfigBatchAdd(IPC_MSG_CONFIG_FLOW_CONTROLLER, cfg.index, &cfg, sizeof(cfg))) {
+                stagedCount++;
+                log(LOG_INFO, false, "  → FlowController[%d]: %s, flow=%.2f mL/min\n",
+                    cfg.index, cfg.name, cfg.flowRate_mL_min);
+            } else {
+                log(LOG_WARNING, false, "  ✗ No room for FlowController[%d] in config batch\n", cfg.index);
             }
-            
-            delay(CONTROLLER_DELAY_MS);
         }
     }
     
@@ -1724,7 +1603,7 @@ void pushIOConfigToIOmcu() {
         IPC_ConfigDOController_t cfg;
         memset(&cfg, 0, sizeof(cfg));
         
-        cfg.transactionId = generateTransactionId();
+        cfg.transactionId = IPC_TXN_NONE;  // Batched - status comes back in CONFIG_RESULT
         cfg.index = 48;
         cfg.isActive = true;
         strncpy(cfg.name, ioConfig.doController.name, sizeof(cfg.name) - 1);
@@ -1759,28 +1638,20 @@ void pushIOConfigToIOmcu() {
         cfg.mfcEnabled = ioConfig.doController.mfcEnabled;
         cfg.mfcDeviceIndex = ioConfig.doController.mfcDeviceIndex;
         
-        // Retry up to 10 times if queue is full
-        bool sent = false;
-        for (int retry = 0; retry < 10; retry++) {
-            if (ipc.sendPacket(IPC_MSG_CONFIG_DO_CONTROLLER, (uint8_t*)&cfg, sizeof(cfg))) {
-                sent = true;
-                sentCount++;
-                log(LOG_INFO, false, "  → DOController[48]: %s, setpoint=%.2f mg/L, %d profile points\n",
-                    cfg.name, cfg.setpoint_mg_L, cfg.numPoints);
-                break;
-            }
-            ipc.update();
-            delay(10);
-        }
-        
-        if (!sent) {
-            log(LOG_WARNING, false, "  ✗ Failed to send DOController[48] config after retries\n");
+        if (ipcConfigBatchAdd(IPC_MSG_CONFIG_DO_CONTROLLER, cfg.index, &cfg, sizeof(cfg))) {
+            stagedCount++;
+            log(LOG_INFO, false, "  → DOController[48]: %s, setpoint=%.2f mg/L, %d profile points\n",
+                cfg.name, cfg.setpoint_mg_L, cfg.numPoints);
+        } else {
+            log(LOG_WARNING, false, "  ✗ No room for DOController[48] in config batch\n");
         }
-        
-        delay(CONTROLLER_DELAY_MS);
     }
     
-    log(LOG_INFO, false, "IO configuration push complete: %d objects configured (inputs + outputs + COM ports + devices + controllers)\n", sentCount);
+    if (ipcConfigBatchCommit()) {
+        log(LOG_INFO, false, "IO configuration batch committed: %d objects staged (inputs + outputs + COM ports + devices + controllers)\n", stagedCount);
+    } else {
+        log(LOG_WARNING, false, "IO configuration batch could not be started\n");
+    }
 }
 
 // ============================================================================
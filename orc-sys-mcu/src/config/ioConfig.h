@@ -39,6 +39,8 @@ struct ADCInputConfig {
     char name[32];          // User-defined name
     char unit[8];           // Unit of measurement (mV, V, mA, uV)
     CalibrationConfig cal;  // Calibration scale and offset
+    uint8_t filterType;     // IPC_ADC_FILTER_* (none, average, IIR, median, CIC)
+    uint8_t filterLength;   // Window / time constant / decimation in samples
     bool enabled;           // Enable/disable this input
     bool showOnDashboard;   // Show on main dashboard
 };
@@ -63,6 +65,7 @@ struct RTDSensorConfig {
     CalibrationConfig cal;  // Calibration (scale and offset)
     uint8_t wireConfig;     // 2, 3, or 4 wire configuration
     uint16_t nominalOhms;   // 100 (PT100) or 1000 (PT1000)
+    uint16_t samplePeriodMs; // 17-60000 ms; below 100 ms the MAX31865 converts continuously
     bool enabled;
     bool showOnDashboard;   // Show on main dashboard
 };
@@ -165,6 +165,18 @@ float getWebserverUp();
 float getWebserverBusy();
 float getMqttConnected();
 float getMqttBusy();
+float getIpcRttP50();
+float getIpcRttP90();
+float getIpcRttMax();
+float getIpcRxFrameRate();
+float getIpcTxFrameRate();
+float getIpcRxUtil();
+float getIpcTxUtil();
+float getIpcRxErrorPpm();
+float getIpcTxQueuePeak();
+float getIoIpcRxErrorPpm();
+float getIpcBaudRate();
+float getIpcBaudFallbacks();
 
 MqttTopicEntry mqttTopics[] = {
     {"sensors/power/voltage", getVpsu, "Main PSU voltage (V)"},
@@ -185,6 +197,18 @@ MqttTopicEntry mqttTopics[] = {
     {"status/webserver_busy", getWebserverBusy, "Webserver busy (1=Busy, 0=Idle)"},
     {"status/mqtt_connected", getMqttConnected, "MQTT connected (1=Connected, 0=Not)"},
     {"status/mqtt_busy", getMqttBusy, "MQTT busy (1=Busy, 0=Idle)"},
+    {"ipc/rtt_p50_ms", getIpcRttP50, "IPC round trip, median of the last 32 pings (ms)"},
+    {"ipc/rtt_p90_ms", getIpcRttP90, "IPC round trip, 90th percentile (ms)"},
+    {"ipc/rtt_max_ms", getIpcRttMax, "IPC round trip, worst of the last 32 pings (ms)"},
+    {"ipc/rx_frames_per_s", getIpcRxFrameRate, "Frames received from the IO MCU (1/s)"},
+    {"ipc/tx_frames_per_s", getIpcTxFrameRate, "Frames sent to the IO MCU (1/s)"},
+    {"ipc/rx_util_percent", getIpcRxUtil, "IO to SYS link utilisation (%)"},
+    {"ipc/tx_util_percent", getIpcTxUtil, "SYS to IO link utilisation (%)"},
+    {"ipc/rx_error_ppm", getIpcRxErrorPpm, "Frames rejected by the SYS MCU (per million)"},
+    {"ipc/io_rx_error_ppm", getIoIpcRxErrorPpm, "Frames rejected by the IO MCU (per million)"},
+    {"ipc/tx_queue_peak_percent", getIpcTxQueuePeak, "SYS MCU TX queue high-water mark (%)"},
+    {"ipc/baud_rate", getIpcBaudRate, "Negotiated link rate (baud)"},
+    {"ipc/baud_fallbacks", getIpcBaudFallbacks, "Drops to a lower link rate on errors or silence"},
 };
 const size_t mqttTopicCount = sizeof(mqttTopics) / sizeof(mqttTopics[0]);
 
@@ -209,6 +233,34 @@ float getWebserverBusy() { return status.webserverBusy ? 1.0f : 0.0f; }
 float getMqttConnected() { return status.mqttConnected ? 1.0f : 0.0f; }
 float getMqttBusy() { return status.mqttBusy ? 1.0f : 0.0f; }
 
+static IPC_LinkStats_t ipcLink() {
+    IPC_LinkStats_t link;
+    ipc.getLinkStats(&link);
+    return link;
+}
+float getIpcRttP50() { return ipcLink().rttP50Us / 1000.0f; }
+float getIpcRttP90() { return ipcLink().rttP90Us / 1000.0f; }
+float getIpcRttMax() { return ipcLink().rttMaxUs / 1000.0f; }
+float getIpcRxFrameRate() { return ipcLink().rxFramesPerSec; }
+float getIpcTxFrameRate() { return ipcLink().txFramesPerSec; }
+float getIpcRxUtil() { return ipcLink().rxUtilPermille / 10.0f; }
+float getIpcTxUtil() { return ipcLink().txUtilPermille / 10.0f; }
+float getIpcRxErrorPpm() { return ipcLink().rxErrorPpm; }
+float getIpcTxQueuePeak() {
+    IPC_LinkStats_t link = ipcLink();
+    return link.txQueueSize ? link.txQueueHighWater * 100.0f / link.txQueueSize : 0.0f;
+}
+float getIoIpcRxErrorPpm() {
+    IPC_LinkStats_t link;
+    return ipc.getPeerLinkStats(&link) != UINT32_MAX ? link.rxErrorPpm : 0.0f;
+}
+float getIpcBaudRate() { return ipc.getBaudRate(); }
+float getIpcBaudFallbacks() {
+    IpcBaudInfo_t baud;
+    getIpcBaudInfo(&baud);
+    return baud.fallbacks;
+}
+
 
 void init_mqttManager() {
     // Configure client parameters ONCE during initialization
@@ -327,7 +379,7 @@ static void mqttPublishAllSensorData() {
     }
 
     // Create JSON payload for all sensor data, each with its own ISO8601 timestamp
-    DynamicJsonDocument doc(2048);
+    DynamicJsonDocument doc(4096);
     ensureTopicPrefix();
 
     for (size_t i = 0; i < mqttTopicCount; i++) {
@@ -26,6 +26,8 @@
 #include "mqtt/mqttManager.h"
 
 #include "utils/ipcManager.h"
+#include "utils/ipcCapture.h"
+#include "utils/adcCapture.h"
 #include "utils/logger.h"
 #include "utils/objectCache.h"
 #include "utils/powerManager.h"
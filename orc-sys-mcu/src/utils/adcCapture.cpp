@@ -0,0 +1,367 @@
+#include "adcCapture.h"
+
+// The whole exchange is driven from here: one ARM, then one STATUS poll or
+// one READ outstanding at a time, each chasing the IO MCU's reply.
+static AdcCapturePhase capPhase = ADC_CAP_IDLE;
+static IPC_AdcCaptureStatus_t capStatus;
+static AdcCaptureRequest_t capRequest;
+static int16_t *capSamples = nullptr;   // lengthScans x channels, scan-interleaved
+static uint32_t capTotal = 0;
+static uint32_t capRead = 0;
+static uint8_t capRetries = 0;
+static uint16_t capTxn = 0;              // Outstanding ARM / REQ (0 = none)
+static unsigned long capLastPoll = 0;
+static bool capSavePending = false;
+static char capSavedPath[64] = "";
+
+static bool sendArm(void);
+static bool sendReq(uint8_t op, uint32_t offset);
+
+static void retryArm() {
+  if (ipcReady && capPhase == ADC_CAP_ARMING && capTxn == 0) {
+    sendArm();
+  }
+}
+
+static void retryRead() {
+  if (ipcReady && capPhase == ADC_CAP_READING && capTxn == 0) {
+    sendReq(IPC_ADC_CAPTURE_OP_READ, capRead);
+  }
+}
+
+static void capTxnDone(uint16_t txnId, IPC_TxnResult result) {
+  if (txnId != capTxn || result == IPC_TXN_COMPLETE) {
+    return;
+  }
+  capTxn = 0;
+
+  // A lost poll is just sent again; a lost chunk is retried a few times
+  if (capPhase == ADC_CAP_ARMING) {
+    log(LOG_WARNING, false, "[ADC] Capture arm request %u failed (result %u)\n", txnId, result);
+    capPhase = ADC_CAP_FAILED;
+  } else if (capPhase == ADC_CAP_READING) {
+    if (++capRetries > ADC_CAPTURE_READ_RETRIES) {
+      log(LOG_WARNING, false, "[ADC] Capture transfer gave up at sample %lu of %lu\n",
+          (unsigned long)capRead, (unsigned long)capTotal);
+      capPhase = ADC_CAP_FAILED;
+    } else {
+      sendReq(IPC_ADC_CAPTURE_OP_READ, capRead);
+    }
+  }
+}
+
+static bool sendArm(void) {
+  IPC_AdcCaptureArm_t arm = {};
+  arm.transactionId = generateTransactionId();
+  arm.channelMask = capRequest.channelMask;
+  arm.trigger = capRequest.trigger;
+  arm.triggerChannel = capRequest.triggerChannel;
+  arm.sampleRateHz = capRequest.sampleRateHz;
+  arm.preTriggerScans = capRequest.preTriggerScans;
+  arm.lengthScans = capRequest.lengthScans;
+  arm.triggerTimeoutMs = capRequest.triggerTimeoutMs;
+  arm.triggerLevel = capRequest.triggerLevel;
+
+  if (!ipc.sendPacket(IPC_MSG_ADC_CAPTURE_ARM, (uint8_t*)&arm, sizeof(arm))) {
+    ipc.notifyWhenFree(IPC_MSG_ADC_CAPTURE_ARM, sizeof(arm), retryArm);
+    return false;
+  }
+  capTxn = arm.transactionId;
+  addPendingTransaction(arm.transactionId, IPC_MSG_ADC_CAPTURE_ARM, IPC_MSG_ADC_CAPTURE_STATUS, 1, 0,
+                        IPC_TXN_TIMEOUT_MS, capTxnDone);
+  return true;
+}
+
+static bool sendReq(uint8_t op, uint32_t offset) {
+  IPC_AdcCaptureReq_t req = {};
+  req.transactionId = generateTransactionId();
+  req.op = op;
+  req.offset = offset;
+
+  uint8_t respType = (op == IPC_ADC_CAPTURE_OP_READ) ? IPC_MSG_ADC_CAPTURE_DATA : IPC_MSG_ADC_CAPTURE_STATUS;
+  if (!ipc.sendPacket(IPC_MSG_ADC_CAPTURE_REQ, (uint8_t*)&req, sizeof(req))) {
+    if (op == IPC_ADC_CAPTURE_OP_READ) {
+      ipc.notifyWhenFree(IPC_MSG_ADC_CAPTURE_REQ, sizeof(req), retryRead);
+    }
+    return false;
+  }
+  capTxn = req.transactionId;
+  addPendingTransaction(req.transactionId, IPC_MSG_ADC_CAPTURE_REQ, respType, 1, 0,
+                        IPC_TXN_READ_TIMEOUT_MS, capTxnDone);
+  return true;
+}
+
+/**
+ * @brief Arm a capture on the IO MCU
+ * @return true if the request was queued or deferred until TX space frees
+ */
+bool adcCaptureArm(const AdcCaptureRequest_t *req) {
+  if (!ipcReady || req == nullptr) {
+    return false;
+  }
+  adcCaptureFree();
+  capRequest = *req;
+  memset(&capStatus, 0, sizeof(capStatus));
+  capTxn = 0;
+  capPhase = ADC_CAP_ARMING;
+  sendArm();
+  return true;
+}
+
+bool adcCaptureAbort(void) {
+  if (capPhase == ADC_CAP_IDLE || capPhase == ADC_CAP_READY) {
+    return true;
+  }
+  capPhase = ADC_CAP_IDLE;
+  capTxn = 0;
+  return ipcReady && sendReq(IPC_ADC_CAPTURE_OP_ABORT, 0);
+}
+
+void adcCaptureFree(void) {
+  free(capSamples);
+  capSamples = nullptr;
+  capTotal = 0;
+  capRead = 0;
+  capSavePending = false;
+  capSavedPath[0] = '\0';
+  if (capPhase == ADC_CAP_READING || capPhase == ADC_CAP_READY) {
+    capPhase = ADC_CAP_IDLE;
+  }
+}
+
+void adcCaptureGetInfo(AdcCaptureInfo_t *info) {
+  if (info == nullptr) return;
+  info->phase = capPhase;
+  info->status = capStatus;
+  info->samplesRead = capRead;
+  info->totalSamples = capTotal;
+  info->saveToSD = capRequest.saveToSD;
+  strlcpy(info->savedPath, capSavedPath, sizeof(info->savedPath));
+}
+
+static void startTransfer(void) {
+  capTotal = (uint32_t)capStatus.lengthScans * capStatus.channels;
+  capSamples = (int16_t *)malloc(capTotal * sizeof(int16_t));
+  if (capSamples == nullptr) {
+    log(LOG_ERROR, false, "[ADC] Capture: cannot allocate %lu samples\n", (unsigned long)capTotal);
+    capTotal = 0;
+    capPhase = ADC_CAP_FAILED;
+    return;
+  }
+  capRead = 0;
+  capRetries = 0;
+  capPhase = ADC_CAP_READING;
+  sendReq(IPC_ADC_CAPTURE_OP_READ, 0);
+}
+
+/**
+ * @brief Handler for ADC_CAPTURE_STATUS (reply to ARM and to status polls)
+ */
+void handleAdcCaptureStatus(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  if (payload == nullptr || length != sizeof(IPC_AdcCaptureStatus_t)) {
+    log(LOG_ERROR, false, "IPC: Invalid ADC capture status payload\n");
+    return;
+  }
+  const IPC_AdcCaptureStatus_t *status = (const IPC_AdcCaptureStatus_t *)payload;
+  if (status->transactionId != capTxn || !completeTransaction(status->transactionId, IPC_MSG_ADC_CAPTURE_STATUS)) {
+    log(LOG_DEBUG, false, "[IPC] Ignoring stale ADC_CAPTURE_STATUS %d\n", status->transactionId);
+    return;
+  }
+  capTxn = 0;
+  capStatus = *status;
+
+  if (capPhase != ADC_CAP_ARMING && capPhase != ADC_CAP_ARMED) {
+    return;
+  }
+  if (status->flags & IPC_ADC_CAPTURE_FLAG_REFUSED) {
+    log(LOG_WARNING, true, "ADC capture refused by the IO MCU (check channels and length)\n");
+    capPhase = ADC_CAP_FAILED;
+    return;
+  }
+
+  switch (status->state) {
+    case IPC_ADC_CAPTURE_ARMED:
+    case IPC_ADC_CAPTURE_TRIGGERED:
+      if (capPhase == ADC_CAP_ARMING && (status->flags & IPC_ADC_CAPTURE_FLAG_CLAMPED)) {
+        log(LOG_WARNING, false, "[ADC] Capture rate clamped to the IO MCU maximum\n");
+      }
+      capPhase = ADC_CAP_ARMED;
+      capLastPoll = millis();
+      break;
+
+    case IPC_ADC_CAPTURE_COMPLETE:
+      log(LOG_INFO, false, "[ADC] Capture complete: %u scans of %u channels, %lu ns/scan, %lu missed%s\n",
+          status->lengthScans, status->channels, (unsigned long)status->scanPeriodNs,
+          (unsigned long)status->missedSamples,
+          (status->flags & IPC_ADC_CAPTURE_FLAG_TIMEOUT) ? " (trigger timed out)" : "");
+      startTransfer();
+      break;
+
+    default:
+      log(LOG_WARNING, true, "ADC capture failed on the IO MCU (state %u)\n", status->state);
+      capPhase = ADC_CAP_FAILED;
+      break;
+  }
+}
+
+/**
+ * @brief Handler for ADC_CAPTURE_DATA chunks; each one requests the next
+ */
+void handleAdcCaptureData(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  const uint16_t headerLen = sizeof(IPC_AdcCaptureData_t) - sizeof(((IPC_AdcCaptureData_t*)0)->sample);
+  if (payload == nullptr || length < headerLen) {
+    log(LOG_ERROR, false, "IPC: Invalid ADC capture data payload\n");
+    return;
+  }
+  const IPC_AdcCaptureData_t *chunk = (const IPC_AdcCaptureData_t *)payload;
+  if (chunk->count > IPC_ADC_CAPTURE_CHUNK_SAMPLES || length != headerLen + chunk->count * sizeof(int16_t)) {
+    log(LOG_ERROR, false, "IPC: Invalid ADC capture data payload\n");
+    return;
+  }
+  if (capPhase != ADC_CAP_READING || chunk->transactionId != capTxn || chunk->offset != capRead ||
+      !completeTransaction(chunk->transactionId, IPC_MSG_ADC_CAPTURE_DATA)) {
+    log(LOG_DEBUG, false, "[IPC] Ignoring stale ADC_CAPTURE_DATA %d\n", chunk->transactionId);
+    return;
+  }
+  capTxn = 0;
+  capRetries = 0;
+
+  uint32_t count = min((uint32_t)chunk->count, capTotal - capRead);
+  memcpy(&capSamples[capRead], payload + headerLen, count * sizeof(int16_t));
+  capRead += count;
+
+  // An empty chunk before the end means the IO MCU no longer holds the block
+  if (count == 0 && capRead < capTotal) {
+    log(LOG_WARNING, false, "[ADC] Capture block gone at sample %lu\n", (unsigned long)capRead);
+    capPhase = ADC_CAP_FAILED;
+    return;
+  }
+  if (capRead < capTotal) {
+    sendReq(IPC_ADC_CAPTURE_OP_READ, capRead);
+    return;
+  }
+  capPhase = ADC_CAP_READY;
+  capSavePending = capRequest.saveToSD;
+  log(LOG_INFO, false, "[ADC] Capture transferred (%lu samples)\n", (unsigned long)capTotal);
+}
+
+void manageAdcCapture(void) {
+  if (capPhase == ADC_CAP_ARMED && capTxn == 0 && ipcReady &&
+      millis() - capLastPoll >= ADC_CAPTURE_POLL_MS) {
+    capLastPoll = millis();
+    sendReq(IPC_ADC_CAPTURE_OP_STATUS, 0);
+  }
+
+#ifndef ORC_NATIVE
+  // Retried while the card is busy
+  if (capSavePending && capPhase == ADC_CAP_READY && sdInfo.ready && !sdLocked) {
+    capSavePending = false;
+    if (adcCaptureSaveToSD(capSavedPath, sizeof(capSavedPath))) {
+      log(LOG_INFO, true, "ADC capture saved: %s\n", capSavedPath);
+    } else {
+      capSavedPath[0] = '\0';
+      log(LOG_ERROR, true, "ADC capture not saved to SD\n");
+    }
+  }
+#endif
+}
+
+static const char *captureUnit(uint8_t ch) {
+  return (ch < MAX_ADC_INPUTS && ioConfig.adcInputs[ch].unit[0] != '\0') ? ioConfig.adcInputs[ch].unit : "mV";
+}
+
+bool adcCaptureExportCsv(AdcCaptureWriter writer, void *context) {
+  if (capPhase != ADC_CAP_READY || capSamples == nullptr || writer == nullptr) return false;
+
+  const uint8_t channels = capStatus.channels;
+  uint8_t chanList[8];
+  for (uint8_t ch = 0, k = 0; ch < 8; ch++) {
+    if (capStatus.channelMask & (1 << ch)) chanList[k++] = ch;
+  }
+
+  // Measured scan period; the requested rate if too few scans were timed
+  double periodS = capStatus.scanPeriodNs * 1e-9;
+  if (periodS <= 0.0 && capRequest.sampleRateHz > 0) {
+    periodS = 1.0 / capRequest.sampleRateHz;
+  }
+
+  char line[256];
+  int n = snprintf(line, sizeof(line),
+                   "# ADC capture: %u scans (%u pre-trigger), %.3f us/scan, %lu missed samples, flags 0x%02X\n",
+                   capStatus.lengthScans, capStatus.preTriggerScans, periodS * 1e6,
+                   (unsigned long)capStatus.missedSamples, capStatus.flags);
+  bool ok = writer(context, (const uint8_t *)line, n);
+
+  n = snprintf(line, sizeof(line), "time_s");
+  for (uint8_t k = 0; k < channels; k++) {
+    uint8_t ch = chanList[k];
+    const char *name = (ch < MAX_ADC_INPUTS) ? ioConfig.adcInputs[ch].name : "";
+    n += snprintf(&line[n], sizeof(line) - n, ",%s%sADC%u (%s)", name, name[0] ? " " : "", ch, captureUnit(ch));
+    if (n >= (int)sizeof(line)) n = sizeof(line) - 1;
+  }
+  n += snprintf(&line[n], sizeof(line) - n, "\n");
+  ok = ok && writer(context, (const uint8_t *)line, min(n, (int)sizeof(line) - 1));
+
+  for (uint32_t scan = 0; ok && scan < capStatus.lengthScans; scan++) {
+    double t = ((double)scan - capStatus.preTriggerScans) * periodS;
+    n = snprintf(line, sizeof(line), "%.6f", t);
+    const int16_t *codes = &capSamples[scan * channels];
+    for (uint8_t k = 0; k < channels; k++) {
+      uint8_t ch = chanList[k];
+      float value = codes[k] * capStatus.gain[ch] + capStatus.offset[ch];
+      n += snprintf(&line[n], sizeof(line) - n, ",%.5g", value);
+    }
+    n += snprintf(&line[n], sizeof(line) - n, "\n");
+    ok = writer(context, (const uint8_t *)line, n);
+  }
+  return ok;
+}
+
+#ifndef ORC_NATIVE
+// Rows are small, so they are collected into sector-sized writes
+struct SdCsvWriter {
+  FsFile *file;
+  uint8_t buf[512];
+  size_t used;
+};
+
+static bool sdCsvFlush(SdCsvWriter *w) {
+  bool ok = w->file->write(w->buf, w->used) == w->used;
+  w->used = 0;
+  return ok;
+}
+
+static bool sdCsvWriter(void *context, const uint8_t *data, size_t length) {
+  SdCsvWriter *w = (SdCsvWriter *)context;
+  if (w->used + length > sizeof(w->buf) && !sdCsvFlush(w)) return false;
+  memcpy(&w->buf[w->used], data, length);
+  w->used += length;
+  return true;
+}
+
+bool adcCaptureSaveToSD(char *path, size_t pathSize) {
+  if (capPhase != ADC_CAP_READY || !sdInfo.ready || sdLocked) return false;
+  sdLocked = true;
+
+  if (!sd.exists(ADC_CAPTURE_DIR) && !sd.mkdir(ADC_CAPTURE_DIR)) {
+    sdLocked = false;
+    return false;
+  }
+  snprintf(path, pathSize, "%s/adc_%04d-%02d-%02d_%02d-%02d-%02d.csv", ADC_CAPTURE_DIR,
+           globalDateTime.year, globalDateTime.month, globalDateTime.day,
+           globalDateTime.hour, globalDateTime.minute, globalDateTime.second);
+
+  FsFile capFile = sd.open(path, O_WRITE | O_CREAT | O_TRUNC);
+  if (!capFile) {
+    sdLocked = false;
+    return false;
+  }
+  SdCsvWriter w;
+  w.file = &capFile;
+  w.used = 0;
+  bool ok = adcCaptureExportCsv(sdCsvWriter, &w) && sdCsvFlush(&w);
+  capFile.close();
+  sdLocked = false;
+  return ok;
+}
+#endif
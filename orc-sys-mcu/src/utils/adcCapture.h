@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../sys_init.h"
+
+// ADC burst capture client (IPC v2.17). The IO MCU records the block into
+// its own RAM at the MCP346x scan rate; this side arms it, polls the status
+// until the block is complete, then pulls it one ADC_CAPTURE_DATA chunk at a
+// time into a buffer that is only allocated while a block is held. A complete
+// block can be exported as CSV (web API) and, if requested, is saved to SD.
+
+#define ADC_CAPTURE_DIR             "/adc_capture"
+#define ADC_CAPTURE_POLL_MS         250     // Status poll interval while armed
+#define ADC_CAPTURE_READ_RETRIES    3       // Per chunk, before the readout fails
+
+enum AdcCapturePhase : uint8_t {
+  ADC_CAP_IDLE,           // No capture
+  ADC_CAP_ARMING,         // ARM sent, waiting for the IO MCU to accept it
+  ADC_CAP_ARMED,          // Recording on the IO MCU (armed or triggered)
+  ADC_CAP_READING,        // Block complete, transferring
+  ADC_CAP_READY,          // Block held here
+  ADC_CAP_FAILED          // Refused, failed on the IO MCU, or the transfer gave up
+};
+
+struct AdcCaptureRequest_t {
+  uint8_t channelMask;        // ADC channels 0-7
+  uint16_t sampleRateHz;      // Scans per second (clamped by the IO MCU)
+  uint16_t preTriggerScans;
+  uint16_t lengthScans;       // Including the pre-trigger scans
+  uint8_t trigger;            // IPC_ADC_TRIG_*
+  uint8_t triggerChannel;
+  float triggerLevel;         // In the channel's unit
+  uint32_t triggerTimeoutMs;  // 0 = wait for the trigger indefinitely
+  bool saveToSD;              // Write the block to ADC_CAPTURE_DIR once transferred
+};
+
+struct AdcCaptureInfo_t {
+  AdcCapturePhase phase;
+  IPC_AdcCaptureStatus_t status;  // Last status from the IO MCU
+  uint32_t samplesRead;           // Transferred so far
+  uint32_t totalSamples;
+  bool saveToSD;
+  char savedPath[64];             // Empty until saved
+};
+
+bool adcCaptureArm(const AdcCaptureRequest_t *req);   // Replaces any held block
+bool adcCaptureAbort(void);
+void adcCaptureFree(void);            // Drop the held block
+void adcCaptureGetInfo(AdcCaptureInfo_t *info);
+
+// Called from manageIPC(): status polling and the deferred SD save
+void manageAdcCapture(void);
+
+void handleAdcCaptureStatus(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleAdcCaptureData(uint8_t messageType, const uint8_t *payload, uint16_t length);
+
+// Writer for adcCaptureExportCsv(): returns false to abort
+typedef bool (*AdcCaptureWriter)(void *context, const uint8_t *data, size_t length);
+
+// Write the held block as CSV: time from the trigger in seconds, then one
+// column per channel converted with the IO MCU calibration at arm time
+bool adcCaptureExportCsv(AdcCaptureWriter writer, void *context);
+
+#ifndef ORC_NATIVE
+bool adcCaptureSaveToSD(char *path, size_t pathSize);   // New file in ADC_CAPTURE_DIR, path returned
+#endif
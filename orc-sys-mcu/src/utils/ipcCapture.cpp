@@ -0,0 +1,185 @@
+#include "ipcCapture.h"
+
+// Byte ring of IPC_CaptureRecord_t + payload. Records are packed back to back
+// and may straddle the end of the buffer.
+static uint8_t *capBuffer = nullptr;
+static uint32_t capSize = 0;
+static uint32_t capHead = 0;            // Oldest record
+static uint32_t capUsed = 0;
+static uint32_t capRecords = 0;
+static bool capActive = false;
+
+static uint32_t capStartMicros = 0;
+static uint32_t capFrames = 0;
+static uint32_t capOverwritten = 0;
+static uint32_t capMissed = 0;
+
+static void ringWrite(uint32_t offset, const void *data, uint32_t length) {
+  uint32_t first = min(length, capSize - offset);
+  memcpy(&capBuffer[offset], data, first);
+  memcpy(capBuffer, (const uint8_t *)data + first, length - first);
+}
+
+static void ringRead(uint32_t offset, void *data, uint32_t length) {
+  uint32_t first = min(length, capSize - offset);
+  memcpy(data, &capBuffer[offset], first);
+  memcpy((uint8_t *)data + first, capBuffer, length - first);
+}
+
+// IPCProtocol frame tap: runs inside ipc.update() for every frame
+static void ipcCaptureTap(uint8_t flags, uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  capFrames++;
+  uint32_t need = sizeof(IPC_CaptureRecord_t) + length;
+  if (need > capSize) {
+    capMissed++;
+    return;
+  }
+
+  // Make room by dropping the oldest records
+  while (capSize - capUsed < need) {
+    IPC_CaptureRecord_t oldest;
+    ringRead(capHead, &oldest, sizeof(oldest));
+    uint32_t oldestSize = sizeof(oldest) + oldest.length;
+    capHead = (capHead + oldestSize) % capSize;
+    capUsed -= oldestSize;
+    capRecords--;
+    capOverwritten++;
+  }
+
+  IPC_CaptureRecord_t rec;
+  rec.timeUs = micros();
+  rec.flags = flags & (IPC_CAPTURE_TX | IPC_CAPTURE_ERROR);
+  rec.messageType = messageType;
+  rec.length = length;
+  uint32_t tail = (capHead + capUsed) % capSize;
+  ringWrite(tail, &rec, sizeof(rec));
+  if (length > 0) {
+    ringWrite((tail + sizeof(rec)) % capSize, payload, length);
+  }
+  capUsed += need;
+  capRecords++;
+}
+
+bool ipcCaptureStart(uint32_t bufferSize) {
+  if (bufferSize < IPC_CAPTURE_MIN_SIZE) {
+    bufferSize = IPC_CAPTURE_MIN_SIZE;
+  }
+  ipc.setFrameTap(nullptr);
+  capActive = false;
+
+  if (capBuffer == nullptr || capSize != bufferSize) {
+    free(capBuffer);
+    capBuffer = (uint8_t *)malloc(bufferSize);
+    if (capBuffer == nullptr) {
+      capSize = 0;
+      log(LOG_ERROR, false, "IPC capture: cannot allocate %lu byte buffer\n", (unsigned long)bufferSize);
+      return false;
+    }
+    capSize = bufferSize;
+  }
+
+  capHead = 0;
+  capUsed = 0;
+  capRecords = 0;
+  capFrames = 0;
+  capOverwritten = 0;
+  capMissed = 0;
+  capStartMicros = micros();
+  capActive = true;
+  ipc.setFrameTap(ipcCaptureTap);
+  log(LOG_INFO, false, "IPC capture started (%lu byte ring)\n", (unsigned long)capSize);
+  return true;
+}
+
+void ipcCaptureStop(void) {
+  ipc.setFrameTap(nullptr);
+  capActive = false;
+}
+
+void ipcCaptureFree(void) {
+  ipcCaptureStop();
+  free(capBuffer);
+  capBuffer = nullptr;
+  capSize = 0;
+  capHead = 0;
+  capUsed = 0;
+  capRecords = 0;
+}
+
+void ipcCaptureGetStats(IPC_CaptureStats_t *stats) {
+  if (stats == nullptr) return;
+  stats->active = capActive;
+  stats->bufferSize = capSize;
+  stats->bytesUsed = capUsed;
+  stats->records = capRecords;
+  stats->frames = capFrames;
+  stats->overwritten = capOverwritten;
+  stats->missed = capMissed;
+}
+
+bool ipcCaptureExport(IPC_CaptureWriter writer, void *context) {
+  if (capBuffer == nullptr || writer == nullptr) return false;
+
+  // Nothing may be added while the ring is walked
+  ipc.setFrameTap(nullptr);
+
+  IPC_CaptureFileHeader_t header;
+  header.magic = IPC_CAPTURE_MAGIC;
+  header.version = IPC_CAPTURE_VERSION;
+  header.headerSize = sizeof(header);
+  header.protocolVersion = IPC_PROTOCOL_VERSION;
+  header.baudRate = ipc.getBaudRate();
+  header.startMicros = capStartMicros;
+  header.recordCount = capRecords;
+  header.overwritten = capOverwritten;
+  header.missed = capMissed;
+  bool ok = writer(context, (const uint8_t *)&header, sizeof(header));
+
+  // Oldest first, in at most two contiguous pieces per record
+  uint32_t offset = capHead;
+  for (uint32_t i = 0; ok && i < capRecords; i++) {
+    IPC_CaptureRecord_t rec;
+    ringRead(offset, &rec, sizeof(rec));
+    uint32_t size = sizeof(rec) + rec.length;
+    uint32_t first = min(size, capSize - offset);
+    ok = writer(context, &capBuffer[offset], first);
+    if (ok && first < size) {
+      ok = writer(context, capBuffer, size - first);
+    }
+    offset = (offset + size) % capSize;
+  }
+
+  if (capActive) {
+    ipc.setFrameTap(ipcCaptureTap);
+  }
+  return ok;
+}
+
+#ifndef ORC_NATIVE
+static bool sdCaptureWriter(void *context, const uint8_t *data, size_t length) {
+  return ((FsFile *)context)->write(data, length) == length;
+}
+
+bool ipcCaptureDumpToSD(char *path, size_t pathSize) {
+  if (capBuffer == nullptr || !sdInfo.ready || sdLocked) return false;
+  sdLocked = true;
+
+  if (!sd.exists(IPC_CAPTURE_DIR) && !sd.mkdir(IPC_CAPTURE_DIR)) {
+    sdLocked = false;
+    return false;
+  }
+  snprintf(path, pathSize, "%s/ipc_%04d-%02d-%02d_%02d-%02d-%02d.icap", IPC_CAPTURE_DIR,
+           globalDateTime.year, globalDateTime.month, globalDateTime.day,
+           globalDateTime.hour, globalDateTime.minute, globalDateTime.second);
+
+  FsFile capFile = sd.open(path, O_WRITE | O_CREAT | O_TRUNC);
+  if (!capFile) {
+    sdLocked = false;
+    return false;
+  }
+  bool ok = ipcCaptureExport(sdCaptureWriter, &capFile);
+  capFile.close();
+  sdLocked = false;
+  return ok;
+}
+#endif
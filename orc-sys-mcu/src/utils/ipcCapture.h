@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../sys_init.h"
+#include "ipcCaptureFormat.h"
+
+// IPC traffic capture: a RAM flight recorder of every decoded IPC frame
+// (both directions, rejected RX frames included) with micros() timestamps.
+// When the ring is full the oldest frames are overwritten, so a dump after a
+// fault holds the traffic leading up to it. Off by default; the buffer is
+// only allocated while a capture exists.
+
+#define IPC_CAPTURE_DEFAULT_SIZE    (48 * 1024)
+#define IPC_CAPTURE_MIN_SIZE        (4 * 1024)   // Must hold a maximum size frame
+#define IPC_CAPTURE_DIR             "/ipc_capture"
+
+struct IPC_CaptureStats_t {
+  bool active;                // Recording
+  uint32_t bufferSize;        // 0 when no buffer is allocated
+  uint32_t bytesUsed;
+  uint32_t records;           // Records in the ring
+  uint32_t frames;            // Frames seen since start
+  uint32_t overwritten;       // Records lost to ring wrap
+  uint32_t missed;            // Frames larger than the ring
+};
+
+// Writer for ipcCaptureExport(): returns false to abort
+typedef bool (*IPC_CaptureWriter)(void *context, const uint8_t *data, size_t length);
+
+bool ipcCaptureStart(uint32_t bufferSize = IPC_CAPTURE_DEFAULT_SIZE);   // Clears any previous capture
+void ipcCaptureStop(void);            // Stop recording, keep the buffer for export
+void ipcCaptureFree(void);            // Stop and release the buffer
+void ipcCaptureGetStats(IPC_CaptureStats_t *stats);
+
+// Write the capture as an .icap file (see ipcCaptureFormat.h). Recording is
+// paused while the ring is read.
+bool ipcCaptureExport(IPC_CaptureWriter writer, void *context);
+
+#ifndef ORC_NATIVE
+bool ipcCaptureDumpToSD(char *path, size_t pathSize);   // New file in IPC_CAPTURE_DIR, path returned
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+
+// IPC capture file (.icap), written by ipcCaptureExport() and read by the host
+// tools in orc-io-mcu/native/twin. Little-endian, no padding:
+//
+//   IPC_CaptureFileHeader_t
+//   IPC_CaptureRecord_t + payload[length]   (oldest first, recordCount times)
+//
+// Directions are from the SYS MCU's point of view: RX came from the IO MCU,
+// TX went to it. Timestamps are SYS micros() and wrap every ~71 minutes;
+// readers unwrap them from record to record.
+
+#define IPC_CAPTURE_MAGIC       0x50414349  // "ICAP"
+#define IPC_CAPTURE_VERSION     1
+
+// Record flags (same values as the IPCProtocol frame tap)
+#define IPC_CAPTURE_TX          0x01        // SYS -> IO (clear: IO -> SYS)
+#define IPC_CAPTURE_ERROR       0x02        // Rejected RX frame: payload is LENGTH + TYPE + PAYLOAD + CRC as received
+
+typedef struct __attribute__((packed)) {
+    uint32_t magic;             // IPC_CAPTURE_MAGIC
+    uint16_t version;           // IPC_CAPTURE_VERSION
+    uint16_t headerSize;        // sizeof(IPC_CaptureFileHeader_t), for forward compatibility
+    uint32_t protocolVersion;   // IPC_PROTOCOL_VERSION of the capturing firmware
+    uint32_t baudRate;          // Link baud rate at capture time
+    uint32_t startMicros;       // micros() when capture started
+    uint32_t recordCount;       // Records in this file
+    uint32_t overwritten;       // Oldest records lost to ring wrap before the dump
+    uint32_t missed;            // Frames not recorded (larger than the ring)
+} IPC_CaptureFileHeader_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t timeUs;            // micros() when the frame was decoded / encoded
+    uint8_t flags;              // IPC_CAPTURE_*
+    uint8_t messageType;
+    uint16_t length;            // Payload bytes that follow
+} IPC_CaptureRecord_t;
@@ -1,4 +1,5 @@
 #include "ipcManager.h"
+#include "IPCConfigDigest.h"
 
 // Global IPC ready flag - moved to top to fix declaration error
 bool ipcReady = false;  // Only start polling after handshake and config push complete
@@ -8,8 +9,14 @@ unsigned long lastSensorPollTime = 0;
 const unsigned long SENSOR_POLL_INTERVAL = 1000; // Poll every 1 second
 
 // ============================================================================
-// Transaction ID Management (v2.6)
+// Transaction Management (v2.9)
 // ============================================================================
+// Pending transactions live in a table indexed by transactionId modulo its size.
+// IDs are issued in sequence and an ID whose slot is still busy is skipped, so
+// lookup, insert and completion are O(1). Each transaction has its own deadline
+// and an optional completion callback. Bulk/delta range requests are limited to
+// the window the IO MCU advertises in HELLO/HELLO_ACK; each one is completed by
+// the BULK_CREDIT the IO MCU sends after its last data frame.
 
 // Transaction ID counter (starts at 1, skips 0 and 0xFFFF)
 static uint16_t nextTransactionId = 1;
@@ -17,37 +24,62 @@ static uint16_t nextTransactionId = 1;
 // Pending transaction tracking
 struct PendingTransaction {
     uint16_t transactionId;
+    bool active;
     uint8_t requestType;          // IPC_MSG_* that was sent
     uint8_t expectedResponseType; // IPC_MSG_* expected back
     uint16_t expectedResponseCount; // For bulk operations (number of responses expected)
     uint16_t receivedResponseCount; // Responses received so far
     uint8_t startIndex;           // Starting object index for bulk requests
-    unsigned long timestamp;      // For timeout detection
+    unsigned long timestamp;      // When the request was sent
+    unsigned long timeoutMs;      // Deadline relative to timestamp
+    IPC_TxnCallback callback;     // Called once when the transaction ends (may be nullptr)
+    unsigned long startMicros;    // micros() when the request was sent (latency observer)
 };
 
-// Transaction tracking table (max 32 concurrent operations)
-// Increased from 16 to handle bulk operations during startup
+// Transaction tracking table (max 32 concurrent operations, power of two)
 #define MAX_PENDING_TRANSACTIONS 32
 static PendingTransaction pendingTransactions[MAX_PENDING_TRANSACTIONS];
 static uint8_t pendingTxnCount = 0;
 
-// Transaction timeout (5 seconds)
-const unsigned long TRANSACTION_TIMEOUT_MS = 5000;
+// Bulk request window (ranges the IO MCU can queue, from HELLO/HELLO_ACK)
+#define IPC_BULK_WINDOW_DEFAULT 1  // Until the IO MCU reports its window
+static uint8_t bulkWindow = IPC_BULK_WINDOW_DEFAULT;
+static uint8_t bulkInFlight = 0;
+static uint8_t bulkCredit = IPC_BULK_WINDOW_DEFAULT;  // Last credit reported by the IO MCU
+
+static IPC_TxnObserver txnObserver = nullptr;
+
+static inline PendingTransaction* txnSlot(uint16_t txnId) {
+    return &pendingTransactions[txnId & (MAX_PENDING_TRANSACTIONS - 1)];
+}
+
+// Requests answered by a queued range on the IO MCU (completed by BULK_CREDIT)
+static inline bool isWindowedRequest(uint8_t requestType) {
+    return requestType == IPC_MSG_SENSOR_BULK_READ_REQ || requestType == IPC_MSG_SENSOR_DELTA_REQ;
+}
 
 /**
  * @brief Generate a unique transaction ID
+ * IDs whose table slot is still in use are skipped.
  * @return Transaction ID (1-65534, skips 0 and 0xFFFF)
  */
 uint16_t generateTransactionId() {
-    uint16_t id = nextTransactionId++;
-    
-    // Skip reserved values (0 = none, 0xFFFF = broadcast)
-    if (id == IPC_TXN_NONE || id == IPC_TXN_BROADCAST) {
-        id = 1;
-        nextTransactionId = 2;
+    uint16_t id;
+    for (uint8_t tries = 0; tries < MAX_PENDING_TRANSACTIONS; tries++) {
+        id = nextTransactionId++;
+        
+        // Skip reserved values (0 = none, 0xFFFF = broadcast)
+        if (id == IPC_TXN_NONE || id == IPC_TXN_BROADCAST) {
+            id = 1;
+            nextTransactionId = 2;
+        }
+        
+        if (!txnSlot(id)->active) {
+            break;
+        }
     }
     
-    return id;
+    return id;  // Table full - addPendingTransaction() will refuse it
 }
 
 /**
@@ -57,17 +89,25 @@ uint16_t generateTransactionId() {
  * @param respType Expected response message type
  * @param respCount Number of responses expected (1 for single, N for bulk)
  * @param startIdx Starting object index for bulk requests (0 for single)
+ * @param timeoutMs Deadline for this transaction
+ * @param callback Called once with the result (may be nullptr)
  * @return true if added successfully, false if table is full
  */
-bool addPendingTransaction(uint16_t txnId, uint8_t reqType, uint8_t respType, uint16_t respCount, uint8_t startIdx) {
-    if (pendingTxnCount >= MAX_PENDING_TRANSACTIONS) {
+bool addPendingTransaction(uint16_t txnId, uint8_t reqType, uint8_t respType, uint16_t respCount, uint8_t startIdx,
+                           uint32_t timeoutMs, IPC_TxnCallback callback) {
+    PendingTransaction *txn = txnSlot(txnId);
+    if (txn->active) {
         log(LOG_WARNING, false, "[IPC] Transaction table full! Cannot track txn %d\n", txnId);
         return false;
     }
     
-    pendingTransactions[pendingTxnCount++] = {
-        txnId, reqType, respType, respCount, 0, startIdx, millis()
+    *txn = {
+        txnId, true, reqType, respType, respCount, 0, startIdx, millis(), timeoutMs, callback, micros()
     };
+    pendingTxnCount++;
+    if (isWindowedRequest(reqType)) {
+        bulkInFlight++;
+    }
     
     return true;
 }
@@ -78,50 +118,358 @@ bool addPendingTransaction(uint16_t txnId, uint8_t reqType, uint8_t respType, ui
  * @return Pointer to transaction or nullptr if not found
  */
 PendingTransaction* findPendingTransaction(uint16_t txnId) {
-    for (uint8_t i = 0; i < pendingTxnCount; i++) {
-        if (pendingTransactions[i].transactionId == txnId) {
-            return &pendingTransactions[i];
-        }
+    PendingTransaction *txn = txnSlot(txnId);
+    if (txn->active && txn->transactionId == txnId) {
+        return txn;
     }
     return nullptr;
 }
 
+/**
+ * @brief Remove a transaction from the table and report its result
+ */
+static void finishTransaction(PendingTransaction *txn, IPC_TxnResult result) {
+    // Free the slot before the callback so it can start a new transaction
+    uint16_t txnId = txn->transactionId;
+    IPC_TxnCallback callback = txn->callback;
+    txn->active = false;
+    pendingTxnCount--;
+    if (isWindowedRequest(txn->requestType) && bulkInFlight > 0) {
+        bulkInFlight--;
+    }
+    
+    // Clear timeout flag once the last pending transaction has been answered
+    if (result != IPC_TXN_TIMEOUT && pendingTxnCount == 0 && status.ipcTimeout) {
+        if (!statusLocked) {
+            statusLocked = true;
+            status.ipcTimeout = false;
+            status.updated = true;
+            statusLocked = false;
+        }
+    }
+    
+    if (txnObserver != nullptr) {
+        txnObserver(txn->requestType, result, micros() - txn->startMicros);
+    }
+    
+    if (callback != nullptr) {
+        callback(txnId, result);
+    }
+}
+
+/**
+ * @brief Complete a single-response transaction from a handler outside this file
+ * @return true if txnId was pending and expected respType
+ */
+bool completeTransaction(uint16_t txnId, uint8_t respType) {
+    PendingTransaction *txn = findPendingTransaction(txnId);
+    if (txn == nullptr || txn->expectedResponseType != respType) {
+        return false;
+    }
+    txn->receivedResponseCount++;
+    finishTransaction(txn, IPC_TXN_COMPLETE);
+    return true;
+}
+
 /**
  * @brief Remove a completed transaction from the tracking table
  * @param txnId Transaction ID to remove
  */
 void completePendingTransaction(uint16_t txnId) {
-    for (uint8_t i = 0; i < pendingTxnCount; i++) {
-        if (pendingTransactions[i].transactionId == txnId) {
-            //log(LOG_DEBUG, false, "[IPC] Completed txn %d\n", txnId);
-            
-            // Shift remaining transactions down
-            for (uint8_t j = i; j < pendingTxnCount - 1; j++) {
-                pendingTransactions[j] = pendingTransactions[j + 1];
-            }
-            pendingTxnCount--;
-            return;
+    PendingTransaction *txn = findPendingTransaction(txnId);
+    if (txn != nullptr) {
+        finishTransaction(txn, IPC_TXN_COMPLETE);
+    }
+}
+
+/**
+ * @brief Cancel every pending transaction (handshake, long operations)
+ */
+static void clearPendingTransactions() {
+    for (uint8_t i = 0; i < MAX_PENDING_TRANSACTIONS; i++) {
+        if (pendingTransactions[i].active) {
+            finishTransaction(&pendingTransactions[i], IPC_TXN_CANCELLED);
         }
     }
+    bulkInFlight = 0;
+    bulkCredit = bulkWindow;
+}
+
+/**
+ * @brief Check if another bulk/delta range request may be sent
+ * Requests beyond the window would be refused by the IO MCU, so callers hold
+ * them until a BULK_CREDIT frees a slot.
+ */
+bool ipcBulkWindowOpen() {
+    return bulkInFlight < bulkWindow;
+}
+
+/**
+ * @brief Adopt the bulk window advertised by the IO MCU
+ */
+static void setBulkWindow(uint8_t window) {
+    bulkWindow = (window > 0) ? window : IPC_BULK_WINDOW_DEFAULT;
+    bulkCredit = bulkWindow;
+    log(LOG_DEBUG, false, "[IPC] Bulk request window: %u\n", bulkWindow);
+}
+
+/**
+ * @brief Report every finished transaction (request type, result, latency) to observer
+ */
+void setIpcTransactionObserver(IPC_TxnObserver observer) {
+    txnObserver = observer;
+}
+
+/**
+ * @brief Log transaction table and bulk window state (ipc-stats)
+ */
+void printIpcTransactionStats() {
+    log(LOG_INFO, false, "Transactions: %u/%u pending, bulk %u/%u in flight (IO credit %u)\n",
+        pendingTxnCount, MAX_PENDING_TRANSACTIONS, bulkInFlight, bulkWindow, bulkCredit);
+}
+
+static void printLinkView(const char *side, const IPC_LinkStats_t *link) {
+  log(LOG_INFO, false, "%s: RX %lu B/s %u fr/s (%u.%u%%, peak %u.%u%%), TX %lu B/s %u fr/s (%u.%u%%, peak %u.%u%%)\n",
+      side, link->rxBytesPerSec, link->rxFramesPerSec, link->rxUtilPermille / 10, link->rxUtilPermille % 10,
+      link->rxUtilPeakPermille / 10, link->rxUtilPeakPermille % 10,
+      link->txBytesPerSec, link->txFramesPerSec, link->txUtilPermille / 10, link->txUtilPermille % 10,
+      link->txUtilPeakPermille / 10, link->txUtilPeakPermille % 10);
+  log(LOG_INFO, false, "%s: RTT p50 %lu us, p90 %lu us, max %lu us (%u samples), RX errors %lu ppm (%lu CRC), "
+      "TX queue peak %u/%u bytes, RX backlog peak %u bytes\n",
+      side, link->rttP50Us, link->rttP90Us, link->rttMaxUs, link->rttSamples, link->rxErrorPpm, link->crcErrors,
+      link->txQueueHighWater, link->txQueueSize, link->rxBacklogHighWater);
+}
+
+/**
+ * @brief Log link quality as seen by both MCUs (ipc-stats)
+ */
+void printIpcLinkStats() {
+  IPC_LinkStats_t link;
+  ipc.getLinkStats(&link);
+  printLinkView("Link (SYS)", &link);
+  uint32_t age = ipc.getPeerLinkStats(&link);
+  if (age != UINT32_MAX) {
+    printLinkView("Link (IO) ", &link);
+  }
+  
+  IpcBaudInfo_t baud;
+  getIpcBaudInfo(&baud);
+  log(LOG_INFO, false, "Baud: %lu (SYS rates 0x%02X, IO rates 0x%02X, failed 0x%02X), %u switches, "
+      "%u failed, %u fallbacks, %lu ppm frame errors\n",
+      (unsigned long)baud.baudRate, baud.sysRates, baud.ioRates, baud.failedRates,
+      baud.switches, baud.failures, baud.fallbacks, (unsigned long)baud.errorPpm);
+}
+
+// ============================================================================
+// Link Baud Rate (v2.14)
+// ============================================================================
+// HELLO / HELLO_ACK run at IPC_BAUD_DEFAULT and carry each side's rate mask.
+// Once the configuration is pushed the highest common rate is requested from
+// the IO MCU (IPCProtocol runs the switch and its link test). The frame error
+// rate of both directions is measured over IPC_BAUD_FALLBACK_WINDOW_MS at each
+// rate; over the threshold the link steps down one rate. A rate that fails is
+// skipped until IPC_BAUD_RETRY_MS has passed.
+
+static uint8_t ioBaudRates = 0;         // IO MCU's mask, from HELLO / HELLO_ACK
+static uint8_t baudFailedRates = 0;
+static unsigned long baudFailedAt = 0;
+static uint32_t baudRequested = 0;      // Rate of the switch in progress
+static uint16_t baudFallbacks = 0;
+static uint16_t baudSeenSwitches = 0;   // IPC_BaudStatus_t counters already logged
+static uint16_t baudSeenFailures = 0;
+static uint32_t baudErrorPpm = 0;
+
+// Counter snapshots: own RX, and the IO MCU's RX from PING/PONG
+static uint32_t baudRxFrames = 0, baudRxErrors = 0;
+static uint32_t baudPeerFrames = 0, baudPeerErrors = 0;
+static uint32_t baudSilentFrames = 0;
+static unsigned long baudSilentSince = 0;
+
+// Error rate window, restarted at every rate change
+static uint32_t baudWindowRate = 0;
+static unsigned long baudWindowStart = 0;
+static uint32_t baudWindowFrames = 0, baudWindowErrors = 0;
+
+static int8_t baudRateIndex(uint32_t baudRate) {
+  for (uint8_t i = 0; i < IPC_BAUD_RATE_COUNT; i++) {
+    if (ipc_baudRates[i] == baudRate) return i;
+  }
+  return -1;
+}
+
+static void markBaudFailed(uint32_t baudRate, unsigned long now) {
+  int8_t i = baudRateIndex(baudRate);
+  if (i > 0) {  // The default rate is always usable
+    baudFailedRates |= 1 << i;
+    baudFailedAt = now;
+  }
+}
+
+// Valid and rejected frames since the last call, both directions
+static void countBaudFrames(uint32_t *frames, uint32_t *errors) {
+  IPC_Statistics_t stats;
+  ipc.getStatistics(&stats);
+  uint32_t rxErrors = stats.rxErrorCount + stats.crcErrorCount;
+  *frames = stats.rxPacketCount - baudRxFrames;
+  *errors = rxErrors - baudRxErrors;
+  baudRxFrames = stats.rxPacketCount;
+  baudRxErrors = rxErrors;
+  
+  IPC_LinkStats_t peer;
+  if (ipc.getPeerLinkStats(&peer) != UINT32_MAX) {
+    // Counters restart with the IO MCU
+    if (peer.rxFrames >= baudPeerFrames && peer.rxErrors >= baudPeerErrors) {
+      *frames += peer.rxFrames - baudPeerFrames;
+      *errors += peer.rxErrors - baudPeerErrors;
+    }
+    baudPeerFrames = peer.rxFrames;
+    baudPeerErrors = peer.rxErrors;
+  }
+}
+
+static void requestBaud(uint32_t baudRate, uint8_t reason) {
+  if (ipc.startBaudSwitch(baudRate, reason)) {
+    baudRequested = baudRate;
+    log(LOG_INFO, false, "IPC: Requesting %lu baud link (%s)\n", (unsigned long)baudRate,
+        reason == IPC_BAUD_REASON_FALLBACK ? "error rate fallback" : "negotiated");
+  }
+}
+
+// Log finished switches and remember the rates that failed
+static void checkBaudResult(unsigned long now) {
+  IPC_BaudStatus_t st;
+  ipc.getBaudStatus(&st);
+  if (st.switches != baudSeenSwitches) {
+    baudSeenSwitches = st.switches;
+    log(LOG_INFO, true, "IPC: Link running at %lu baud\n", (unsigned long)st.baudRate);
+  }
+  if (st.failures != baudSeenFailures) {
+    baudSeenFailures = st.failures;
+    markBaudFailed(baudRequested, now);
+    log(LOG_WARNING, true, "IPC: %lu baud link %s, staying at %lu baud\n", (unsigned long)baudRequested,
+        st.lastResult == IPC_BAUD_RESULT_REFUSED ? "refused by IO MCU" :
+        st.lastResult == IPC_BAUD_RESULT_NO_ACK ? "not acknowledged" : "failed its link test",
+        (unsigned long)st.baudRate);
+  }
 }
 
 /**
- * @brief Clean up stalled transactions that have timed out
+ * @brief Negotiate the link rate and fall back on errors
+ * Called once per connection check from manageIPC()
+ */
+static void manageIpcBaud(unsigned long now) {
+  if (ipc.baudSwitchBusy()) {
+    return;
+  }
+  checkBaudResult(now);
+  
+  uint32_t frames, errors;
+  countBaudFrames(&frames, &errors);
+  uint32_t current = ipc.getBaudRate();
+  if (current != baudWindowRate) {
+    baudWindowRate = current;
+    baudWindowStart = now;
+    baudWindowFrames = 0;
+    baudWindowErrors = 0;
+  } else {
+    baudWindowFrames += frames;
+    baudWindowErrors += errors;
+  }
+  
+  // A mismatched rate only produces garbage (which keeps lastRxTime fresh), so
+  // fall back when a check saw nothing but rejected frames, or no valid frame
+  // has arrived for a while. The IO MCU drops to the default rate on its own
+  // connection timeout.
+  if (baudRxFrames != baudSilentFrames) {
+    baudSilentFrames = baudRxFrames;
+    baudSilentSince = now;
+  } else if (current != IPC_BAUD_DEFAULT && (errors > 0 || now - baudSilentSince >= IPC_BAUD_SILENCE_MS)) {
+    markBaudFailed(current, now);
+    ipc.setBaudRate(IPC_BAUD_DEFAULT);
+    baudFallbacks++;
+    log(LOG_WARNING, true, "IPC: No valid frames at %lu baud, back to %lu baud\n",
+        (unsigned long)current, (unsigned long)IPC_BAUD_DEFAULT);
+    return;
+  }
+  
+  if (baudFailedRates != 0 && now - baudFailedAt >= IPC_BAUD_RETRY_MS) {
+    baudFailedRates = 0;
+  }
+  if (!ipcReady || ioBaudRates == 0) {
+    return;
+  }
+  
+  uint8_t usable = IPC_BAUD_SUPPORTED_SYS & ioBaudRates & ~baudFailedRates;
+  int8_t currentIndex = baudRateIndex(current);
+  
+  bool fallback = false;
+  if (now - baudWindowStart >= IPC_BAUD_FALLBACK_WINDOW_MS) {
+    uint32_t seen = baudWindowFrames + baudWindowErrors;
+    baudErrorPpm = seen ? (uint32_t)(baudWindowErrors * 1000000ULL / seen) : 0;
+    fallback = baudErrorPpm > IPC_BAUD_FALLBACK_PPM && baudWindowErrors >= IPC_BAUD_FALLBACK_MIN_ERRORS;
+    baudWindowStart = now;
+    baudWindowFrames = 0;
+    baudWindowErrors = 0;
+  }
+  
+  if (fallback && currentIndex > 0) {
+    log(LOG_WARNING, true, "IPC: %lu ppm frame errors at %lu baud\n", baudErrorPpm, (unsigned long)current);
+    markBaudFailed(current, now);
+    baudFallbacks++;
+    int8_t lower = currentIndex - 1;
+    while (lower > 0 && !(usable & (1 << lower))) lower--;
+    requestBaud(ipc_baudRates[lower], IPC_BAUD_REASON_FALLBACK);
+    return;
+  }
+  
+  // Highest common rate above the current one
+  for (int8_t i = IPC_BAUD_RATE_COUNT - 1; i > currentIndex; i--) {
+    if (usable & (1 << i)) {
+      requestBaud(ipc_baudRates[i], IPC_BAUD_REASON_NEGOTIATED);
+      break;
+    }
+  }
+}
+
+void getIpcBaudInfo(IpcBaudInfo_t *info) {
+  IPC_BaudStatus_t st;
+  ipc.getBaudStatus(&st);
+  info->baudRate = st.baudRate;
+  info->sysRates = IPC_BAUD_SUPPORTED_SYS;
+  info->ioRates = ioBaudRates;
+  info->failedRates = baudFailedRates;
+  info->lastResult = st.lastResult;
+  info->switches = st.switches;
+  info->failures = st.failures;
+  info->fallbacks = baudFallbacks;
+  info->errorPpm = baudErrorPpm;
+}
+
+/**
+ * @brief Clean up stalled transactions that have passed their deadline
  * Called periodically from manageIPC()
  */
 void cleanupStalledTransactions() {
+    if (pendingTxnCount == 0) {
+        return;
+    }
+    
     unsigned long now = millis();
     
-    for (uint8_t i = 0; i < pendingTxnCount; ) {
-        unsigned long age = now - pendingTransactions[i].timestamp;
+    for (uint8_t i = 0; i < MAX_PENDING_TRANSACTIONS; i++) {
+        PendingTransaction *txn = &pendingTransactions[i];
+        if (!txn->active) {
+            continue;
+        }
         
-        if (age > TRANSACTION_TIMEOUT_MS) {
+        unsigned long age = now - txn->timestamp;
+        if (age > txn->timeoutMs) {
             log(LOG_WARNING, false, "[IPC] Transaction %d timed out after %lu ms (indices %d-%d, received %d/%d)\n",
-                pendingTransactions[i].transactionId, age,
-                pendingTransactions[i].startIndex,
-                pendingTransactions[i].startIndex + pendingTransactions[i].expectedResponseCount - 1,
-                pendingTransactions[i].receivedResponseCount,
-                pendingTransactions[i].expectedResponseCount);
+                txn->transactionId, age,
+                txn->startIndex,
+                txn->startIndex + txn->expectedResponseCount - 1,
+                txn->receivedResponseCount,
+                txn->expectedResponseCount);
             
             // Set timeout flag for LED status
             if (!statusLocked) {
@@ -131,13 +479,653 @@ void cleanupStalledTransactions() {
                 statusLocked = false;
             }
             
-            // Remove timed out transaction
-            completePendingTransaction(pendingTransactions[i].transactionId);
-            // Don't increment i - array was shifted down
-        } else {
-            i++;
+            finishTransaction(txn, IPC_TXN_TIMEOUT);
+        }
+    }
+}
+
+// ============================================================================
+// Sensor Stream Subscription (v2.7, compact records v2.18)
+// ============================================================================
+// Once subscribed, the IO MCU pushes SENSOR_DELTA records (txn = IPC_TXN_NONE)
+// whenever an object moves by more than its deadband, and at least every
+// heartbeat interval. Each object class is subscribed with its own rate limit
+// and deadband, one request per ACK; analog inputs get one request per channel
+// so the absolute band follows the configured unit. Polling is only used until
+// the last range is acknowledged, or as the fallback if one is refused.
+
+const uint16_t SENSOR_STREAM_MAX_INTERVAL_MS = 2000;  // Heartbeat (one lost push still inside CACHE_STALE_TIME_MS)
+const uint16_t SENSOR_STREAM_ADC_INTERVAL_MS = 500;   // Noisy analog inputs
+const float SENSOR_STREAM_ADC_DEADBAND_REL = 0.002f;  // 0.2% of reading, or the unit band below
+
+struct SensorStreamRange {
+  uint8_t startIndex;
+  uint8_t count;
+  uint16_t minIntervalMs;   // Per-object push rate limit
+  float deadband;           // Absolute change required to push
+  float deadbandRel;        // ... or relative to the last pushed value, whichever is larger
+};
+
+// Everything after the analog inputs
+static const SensorStreamRange sensorStreamRanges[] = {
+  {  8,  2,  100, 0.0f,  0.0f   },  // DAC outputs - only move when written
+  { 10,  3,  500, 0.02f, 0.0f   },  // RTD temperatures
+  { 13, 18,  100, 0.0f,  0.0f   },  // GPIO, outputs, motors - discrete states
+  { 31,  2, 1000, 0.0f,  0.005f },  // Energy monitors (V, A, W)
+  { 33,  7,  250, 0.0f,  0.0f   },  // COM ports, onboard device feedback
+  { 40, 30,  250, 0.0f,  0.001f },  // Controllers and device controls
+  { 70, 30,  500, 0.0f,  0.002f },  // Device sensors (pH, DO, flow, pressure, ...)
+};
+#define SENSOR_STREAM_STEPS   (MAX_ADC_INPUTS + sizeof(sensorStreamRanges) / sizeof(sensorStreamRanges[0]))
+
+static bool ipcStreamActive = false;     // IO MCU accepted every range - polling disabled
+static uint16_t streamSubscribeTxn = 0;  // Transaction ID of outstanding subscribe request
+static uint8_t streamSubscribeStep = 0;  // Range being subscribed
+
+// Absolute analog input band for the configured unit (about 0.5 mV at the input)
+static float adcStreamDeadband(const char *unit) {
+  if (strcmp(unit, "V") == 0) return 0.0005f;
+  if (strcmp(unit, "uV") == 0) return 500.0f;
+  if (strcmp(unit, "mA") == 0) return 0.005f;
+  return 0.5f;
+}
+
+static void retrySensorStreamSubscribe();
+
+static bool sendSensorStreamRange() {
+  IPC_SensorStreamReq_t req;
+  req.transactionId = generateTransactionId();
+  req.maxIntervalMs = SENSOR_STREAM_MAX_INTERVAL_MS;
+  if (streamSubscribeStep < MAX_ADC_INPUTS) {
+    req.startIndex = streamSubscribeStep;
+    req.count = 1;
+    req.minIntervalMs = SENSOR_STREAM_ADC_INTERVAL_MS;
+    req.deadband = adcStreamDeadband(ioConfig.adcInputs[streamSubscribeStep].unit);
+    req.deadbandRel = SENSOR_STREAM_ADC_DEADBAND_REL;
+  } else {
+    const SensorStreamRange *range = &sensorStreamRanges[streamSubscribeStep - MAX_ADC_INPUTS];
+    req.startIndex = range->startIndex;
+    req.count = range->count;
+    req.minIntervalMs = range->minIntervalMs;
+    req.deadband = range->deadband;
+    req.deadbandRel = range->deadbandRel;
+  }
+  
+  if (!ipc.sendPacket(IPC_MSG_SENSOR_STREAM, (uint8_t*)&req, sizeof(req))) {
+    log(LOG_WARNING, false, "[IPC] TX queue full, sensor stream subscription deferred (polling meanwhile)\n");
+    ipc.notifyWhenFree(IPC_MSG_SENSOR_STREAM, sizeof(req), retrySensorStreamSubscribe);
+    return false;
+  }
+  
+  streamSubscribeTxn = req.transactionId;
+  addPendingTransaction(req.transactionId, IPC_MSG_SENSOR_STREAM, IPC_MSG_CONTROL_ACK, 1, req.startIndex);
+  return true;
+}
+
+static void retrySensorStreamSubscribe() {
+  if (ipcReady && !ipcStreamActive) {
+    sendSensorStreamRange();
+  }
+}
+
+/**
+ * @brief Subscribe to pushed sensor updates for all objects
+ * Polling continues until the IO MCU acknowledges every range.
+ * If the TX queue is full the request is retried once space frees up.
+ * @return true if the first request was queued
+ */
+bool subscribeSensorStream() {
+  ipcStreamActive = false;
+  streamSubscribeStep = 0;
+  return sendSensorStreamRange();
+}
+
+// ============================================================================
+// IO MCU Task Statistics (v2.12)
+// ============================================================================
+// The IO MCU scheduler table is fetched one TASK_STATS page at a time; each
+// reply triggers the request for the next page until all tasks are in. The
+// last complete table is kept for the web API and the "tasks" terminal command.
+
+static IoTaskStats_t ioTaskStats;
+static IoTaskStats_t ioTaskStatsPending;   // Pages received so far for the refresh in progress
+static uint16_t taskStatsTxn = 0;          // Outstanding TASK_STATS_REQ (0 = none)
+static uint8_t taskStatsFlags = 0;         // IPC_TASK_STATS_REQ_xxx of the refresh in progress
+static bool taskStatsPrint = false;        // Print the table once the refresh completes
+
+static bool sendTaskStatsRequest(uint8_t startTask);
+
+static void retryTaskStatsRequest() {
+  if (ipcReady && taskStatsTxn == 0) {
+    sendTaskStatsRequest(ioTaskStatsPending.count);
+  }
+}
+
+static void taskStatsDone(uint16_t txnId, IPC_TxnResult result) {
+  if (txnId == taskStatsTxn && result != IPC_TXN_COMPLETE) {
+    log(LOG_WARNING, false, "[IPC] Task statistics request %u failed (result %u)\n", txnId, result);
+    taskStatsTxn = 0;
+    taskStatsPrint = false;
+  }
+}
+
+static bool sendTaskStatsRequest(uint8_t startTask) {
+  IPC_TaskStatsReq_t req;
+  req.transactionId = generateTransactionId();
+  req.startTask = startTask;
+  req.flags = taskStatsFlags;
+  
+  if (!ipc.sendPacket(IPC_MSG_TASK_STATS_REQ, (uint8_t*)&req, sizeof(req))) {
+    ipc.notifyWhenFree(IPC_MSG_TASK_STATS_REQ, sizeof(req), retryTaskStatsRequest);
+    return false;
+  }
+  
+  taskStatsTxn = req.transactionId;
+  addPendingTransaction(req.transactionId, IPC_MSG_TASK_STATS_REQ, IPC_MSG_TASK_STATS, 1, startTask,
+                        IPC_TXN_TIMEOUT_MS, taskStatsDone);
+  return true;
+}
+
+/**
+ * @brief Fetch the IO MCU scheduler task table
+ * @param reset Reset the IO MCU task statistics once the table is captured
+ * @param print Print the table to the terminal when it arrives
+ * @return true if the first request was queued or deferred until TX space frees
+ */
+bool requestIoTaskStats(bool reset, bool print) {
+  if (!ipcReady) {
+    return false;
+  }
+  if (taskStatsTxn != 0) {
+    taskStatsPrint |= print;   // Refresh already running
+    return true;
+  }
+  
+  memset(&ioTaskStatsPending, 0, sizeof(ioTaskStatsPending));
+  taskStatsFlags = reset ? IPC_TASK_STATS_REQ_RESET : 0;
+  taskStatsPrint = print;
+  sendTaskStatsRequest(0);
+  return true;
+}
+
+const IoTaskStats_t *getIoTaskStats() {
+  return &ioTaskStats;
+}
+
+/**
+ * @brief Handler for TASK_STATS pages from IO MCU
+ */
+void handleTaskStats(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  const uint16_t headerLen = sizeof(IPC_TaskStats_t) - sizeof(((IPC_TaskStats_t*)0)->task);
+  if (payload == nullptr || length < headerLen) {
+    log(LOG_ERROR, false, "IPC: Invalid task stats payload\n");
+    return;
+  }
+  
+  const IPC_TaskStats_t *page = (const IPC_TaskStats_t *)payload;
+  if (page->count > IPC_TASK_STATS_PER_FRAME || length != headerLen + page->count * sizeof(IPC_TaskStatsEntry_t)) {
+    log(LOG_ERROR, false, "IPC: Invalid task stats payload\n");
+    return;
+  }
+  
+  PendingTransaction *txn = findPendingTransaction(page->transactionId);
+  if (txn == nullptr || page->transactionId != taskStatsTxn || page->startTask != ioTaskStatsPending.count) {
+    log(LOG_DEBUG, false, "[IPC] Ignoring stale TASK_STATS %d\n", page->transactionId);
+    return;
+  }
+  taskStatsTxn = 0;
+  finishTransaction(txn, IPC_TXN_COMPLETE);
+  
+  for (uint8_t i = 0; i < page->count && ioTaskStatsPending.count < IO_TASK_STATS_MAX; i++) {
+    ioTaskStatsPending.task[ioTaskStatsPending.count++] = page->task[i];
+  }
+  ioTaskStatsPending.totalTasks = page->totalTasks;
+  ioTaskStatsPending.idlePermille = page->idlePermille;
+  ioTaskStatsPending.uptimeMs = page->uptimeMs;
+  
+  // Next page, unless the table is complete (or the IO MCU had nothing more to send)
+  if (page->count > 0 && ioTaskStatsPending.count < page->totalTasks && ioTaskStatsPending.count < IO_TASK_STATS_MAX) {
+    sendTaskStatsRequest(ioTaskStatsPending.count);
+    return;
+  }
+  
+  ioTaskStatsPending.valid = true;
+  ioTaskStatsPending.updatedAt = millis();
+  ioTaskStats = ioTaskStatsPending;
+  if (taskStatsPrint) {
+    taskStatsPrint = false;
+    printIoTaskStats();
+  }
+}
+
+// Bucket n of a log2 histogram covers 2^(n-1)..2^n - 1 us; report its upper bound
+static uint32_t taskHistPercentile(const uint16_t *hist, uint8_t percent) {
+  uint32_t total = 0;
+  for (uint8_t i = 0; i < IPC_TASK_HIST_BUCKETS; i++) total += hist[i];
+  if (total == 0) return 0;
+  
+  uint32_t target = (total * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t i = 0; i < IPC_TASK_HIST_BUCKETS; i++) {
+    seen += hist[i];
+    if (seen >= target) {
+      return (i == 0) ? 0 : ((1UL << i) - 1);
+    }
+  }
+  return (1UL << (IPC_TASK_HIST_BUCKETS - 1)) - 1;
+}
+
+/**
+ * @brief Print the last IO MCU task table (tasks)
+ */
+void printIoTaskStats() {
+  if (!ioTaskStats.valid) {
+    log(LOG_INFO, false, "No IO MCU task statistics yet\n");
+    return;
+  }
+  
+  log(LOG_INFO, false, "=== IO MCU Tasks (%u, idle %.1f%%, uptime %lu s, %lu ms ago) ===\n",
+      ioTaskStats.totalTasks, ioTaskStats.idlePermille / 10.0f, ioTaskStats.uptimeMs / 1000,
+      millis() - ioTaskStats.updatedAt);
+  log(LOG_INFO, false, "%-15s %8s %6s %8s %8s %8s %8s %8s %6s %6s\n",
+      "Task", "Period", "CPU%", "Avg us", "p99 us", "Max us", "Late p99", "Late max", "Ovrun", "Miss");
+  for (uint8_t i = 0; i < ioTaskStats.count; i++) {
+    const IPC_TaskStatsEntry_t *t = &ioTaskStats.task[i];
+    char name[IPC_TASK_NAME_LEN + 1];
+    memcpy(name, t->name, IPC_TASK_NAME_LEN);
+    name[IPC_TASK_NAME_LEN] = '\0';
+    // The entry is packed: copy the histograms out rather than pass pointers
+    // to members that may not be 2-byte aligned
+    uint16_t execHist[IPC_TASK_HIST_BUCKETS];
+    uint16_t latenessHist[IPC_TASK_HIST_BUCKETS];
+    memcpy(execHist, t->execHist, sizeof(execHist));
+    memcpy(latenessHist, t->latenessHist, sizeof(latenessHist));
+    log(LOG_INFO, false, "%-15s %6lums %6.1f %8lu %8lu %8lu %8lu %8lu %6lu %6lu%s%s%s\n",
+        name, t->intervalUs / 1000, t->cpuPermille / 10.0f, t->avgExecUs,
+        taskHistPercentile(execHist, 99), t->maxExecUs,
+        taskHistPercentile(latenessHist, 99), t->maxLatenessUs,
+        t->overrunCount, t->missedPeriods,
+        (t->flags & IPC_TASK_FLAG_HIGH_PRIORITY) ? " HI" : "",
+        (t->flags & IPC_TASK_FLAG_PAUSED) ? " PAUSED" : "",
+        (t->flags & IPC_TASK_FLAG_EVENT) ? " EVENT" : "");
+  }
+}
+
+// ============================================================================
+// Configuration Batch (v2.10)
+// ============================================================================
+// pushIOConfigToIOmcu() stages every configuration record here. The batch is
+// then sent as CONFIG_BEGIN, CONFIG_BATCH frames and CONFIG_COMMIT without
+// blocking - frames that do not fit in the TX queue go out as space frees up.
+// The IO MCU applies the whole batch in one pass and answers with a single
+// CONFIG_RESULT. A batch it had to reject (lost frame) is sent again.
+// After a handshake, sections whose digest matches the one the IO MCU reported
+// in HELLO / HELLO_ACK are dropped from the batch, so a reconnect to an IO MCU
+// that kept its configuration does not recreate controllers and devices.
+
+#define IPC_CONFIG_BATCH_RETRIES  2   // Resends after the IO MCU rejected a batch
+
+enum ConfigBatchStage : uint8_t {
+  CONFIG_BATCH_IDLE,
+  CONFIG_BATCH_STAGING,     // Records being added
+  CONFIG_BATCH_SENDING,     // Frames being queued
+  CONFIG_BATCH_WAITING      // COMMIT queued, waiting for CONFIG_RESULT
+};
+
+static struct {
+  uint8_t stage;
+  uint8_t retries;
+  bool beginSent;
+  uint16_t transactionId;
+  uint16_t recordCount;
+  uint16_t length;
+  uint16_t sentRecords;       // Records already queued in CONFIG_BATCH frames
+  uint16_t sentBytes;
+  uint16_t sectionMask;       // Sections the batch replaces on the IO MCU
+  unsigned long startTime;
+  IPC_ConfigDigest_t digest;  // Digest of the complete configuration last staged
+  uint8_t recordType[IPC_CONFIG_MAX_RECORDS];
+  uint8_t recordIndex[IPC_CONFIG_MAX_RECORDS];
+  uint8_t records[IPC_CONFIG_STAGING_SIZE];
+} configBatch;
+
+// Configuration the IO MCU reported in the last handshake (used by the next commit only)
+static IPC_ConfigDigest_t ioConfigDigest;
+static bool ioConfigDigestValid = false;
+
+static void sendConfigBatch();
+static bool startConfigBatch();
+
+/**
+ * @brief Short name of a batch record type for log messages
+ */
+static const char* configRecordName(uint8_t msgType) {
+  switch (msgType) {
+    case IPC_MSG_CONFIG_ANALOG_INPUT:    return "ADC";
+    case IPC_MSG_CONFIG_ANALOG_OUTPUT:   return "DAC";
+    case IPC_MSG_CONFIG_RTD:             return "RTD";
+    case IPC_MSG_CONFIG_GPIO:            return "GPIO";
+    case IPC_MSG_CONFIG_DIGITAL_OUTPUT:  return "DigitalOutput";
+    case IPC_MSG_CONFIG_STEPPER:         return "Stepper";
+    case IPC_MSG_CONFIG_DCMOTOR:         return "DCMotor";
+    case IPC_MSG_CONFIG_COMPORT:         return "COM Port";
+    case IPC_MSG_CONFIG_TEMP_CONTROLLER: return "TempController";
+    case IPC_MSG_CONFIG_PH_CONTROLLER:   return "pHController";
+    case IPC_MSG_CONFIG_FLOW_CONTROLLER: return "FlowController";
+    case IPC_MSG_CONFIG_DO_CONTROLLER:   return "DOController";
+    case IPC_MSG_CONFIG_PRESSURE_CTRL:   return "Pressure";
+    case IPC_MSG_DEVICE_CREATE:          return "Device";
+    default:                             return "Unknown";
+  }
+}
+
+/**
+ * @brief Enable polling and the sensor stream once the IO MCU has its configuration
+ * Only needed after a handshake; a push made while connected (config restore)
+ * leaves them running.
+ */
+static void startSensorPolling() {
+  if (ipcReady) {
+    return;
+  }
+  
+  // Enable sensor polling now that handshake and config push are complete
+  ipcReady = true;
+  
+  // Reset poll timer to delay first poll by a full interval
+  lastSensorPollTime = millis();
+  
+  // Request pushed updates - polling stays active until the IO MCU acknowledges
+  subscribeSensorStream();
+  
+  log(LOG_INFO, false, "IPC: Sensor polling enabled - system fully operational\n");
+}
+
+static void configBatchDone(uint16_t txnId, IPC_TxnResult result) {
+  if (txnId != configBatch.transactionId) {
+    return;
+  }
+  configBatch.stage = CONFIG_BATCH_IDLE;
+  
+  switch (result) {
+    case IPC_TXN_REFUSED:
+      if (configBatch.retries < IPC_CONFIG_BATCH_RETRIES) {
+        configBatch.retries++;
+        log(LOG_WARNING, false, "IPC: Config batch rejected by IO MCU, resending (%u/%u)\n",
+            configBatch.retries, IPC_CONFIG_BATCH_RETRIES);
+        configBatch.stage = CONFIG_BATCH_STAGING;
+        if (startConfigBatch()) {
+          return;
         }
+      }
+      log(LOG_ERROR, true, "IPC: IO MCU rejected the configuration batch\n");
+      break;
+    case IPC_TXN_TIMEOUT:
+      log(LOG_WARNING, true, "IPC: No CONFIG_RESULT from IO MCU, continuing\n");
+      break;
+    case IPC_TXN_CANCELLED:
+      return;  // Superseded by a new push or handshake
+    default:
+      break;
+  }
+  
+  startSensorPolling();
+}
+
+/**
+ * @brief Discard any staged or in-flight batch and start staging a new one
+ */
+void ipcConfigBatchBegin() {
+  if (configBatch.stage == CONFIG_BATCH_SENDING || configBatch.stage == CONFIG_BATCH_WAITING) {
+    PendingTransaction *txn = findPendingTransaction(configBatch.transactionId);
+    if (txn != nullptr) {
+      finishTransaction(txn, IPC_TXN_CANCELLED);
+    }
+  }
+  
+  configBatch.stage = CONFIG_BATCH_STAGING;
+  configBatch.retries = 0;
+  configBatch.recordCount = 0;
+  configBatch.length = 0;
+}
+
+/**
+ * @brief Append one configuration record to the staged batch
+ * @param msgType Standalone message type the record replaces (IPC_MSG_CONFIG_* / DEVICE_CREATE)
+ * @param index Object index (for result logging)
+ * @param payload Message payload
+ * @param length Payload length
+ * @return false if the batch is full
+ */
+bool ipcConfigBatchAdd(uint8_t msgType, uint8_t index, const void *payload, uint16_t length) {
+  uint16_t recordLen = sizeof(IPC_ConfigRecord_t) + length;
+  if (configBatch.stage != CONFIG_BATCH_STAGING ||
+      ipc_configSection(msgType) == IPC_CONFIG_SECTION_NONE ||
+      configBatch.recordCount >= IPC_CONFIG_MAX_RECORDS ||
+      configBatch.length + recordLen > IPC_CONFIG_STAGING_SIZE ||
+      sizeof(IPC_ConfigBatchHeader_t) + recordLen > IPC_MAX_PAYLOAD_SIZE) {
+    return false;
+  }
+  
+  IPC_ConfigRecord_t *rec = (IPC_ConfigRecord_t *)&configBatch.records[configBatch.length];
+  rec->msgType = msgType;
+  rec->length = length;
+  memcpy(&configBatch.records[configBatch.length + sizeof(IPC_ConfigRecord_t)], payload, length);
+  
+  configBatch.recordType[configBatch.recordCount] = msgType;
+  configBatch.recordIndex[configBatch.recordCount] = index;
+  configBatch.recordCount++;
+  configBatch.length += recordLen;
+  return true;
+}
+
+/**
+ * @brief Remove the staged records of sections outside sectionMask
+ */
+static void dropConfigSections(uint16_t sectionMask) {
+  uint16_t readPos = 0;
+  uint16_t writePos = 0;
+  uint16_t kept = 0;
+  
+  for (uint16_t i = 0; i < configBatch.recordCount; i++) {
+    const IPC_ConfigRecord_t *rec = (const IPC_ConfigRecord_t *)&configBatch.records[readPos];
+    uint16_t recordLen = sizeof(IPC_ConfigRecord_t) + rec->length;
+    
+    if (sectionMask & (1u << ipc_configSection(rec->msgType))) {
+      memmove(&configBatch.records[writePos], &configBatch.records[readPos], recordLen);
+      configBatch.recordType[kept] = configBatch.recordType[i];
+      configBatch.recordIndex[kept] = configBatch.recordIndex[i];
+      writePos += recordLen;
+      kept++;
+    }
+    readPos += recordLen;
+  }
+  
+  configBatch.recordCount = kept;
+  configBatch.length = writePos;
+}
+
+/**
+ * @brief Send the staged batch (returns immediately, result via CONFIG_RESULT)
+ * After a handshake only the sections that differ from the IO MCU's digest are sent.
+ * @return false if nothing is staged or the transaction table is full
+ */
+bool ipcConfigBatchCommit() {
+  if (configBatch.stage != CONFIG_BATCH_STAGING) {
+    return false;
+  }
+  
+  // Digest of the complete configuration, before any section is dropped
+  memset(&configBatch.digest, 0, sizeof(configBatch.digest));
+  uint16_t pos = 0;
+  for (uint16_t i = 0; i < configBatch.recordCount; i++) {
+    const IPC_ConfigRecord_t *rec = (const IPC_ConfigRecord_t *)&configBatch.records[pos];
+    const uint8_t *data = &configBatch.records[pos + sizeof(IPC_ConfigRecord_t)];
+    configBatch.digest.section[ipc_configSection(rec->msgType)] += ipc_configRecordHash(rec->msgType, data, rec->length);
+    pos += sizeof(IPC_ConfigRecord_t) + rec->length;
+  }
+  ipc_configDigestFinish(&configBatch.digest);
+  
+  configBatch.sectionMask = IPC_CONFIG_SECTIONS_ALL;
+  if (ioConfigDigestValid) {
+    ioConfigDigestValid = false;
+    
+    uint16_t changed = ipc_configDigestDiff(&configBatch.digest, &ioConfigDigest);
+    if (changed & (1u << IPC_CONFIG_SECTION_DEVICE)) {
+      // Recreating a device resets its pressure calibration
+      changed |= (1u << IPC_CONFIG_SECTION_PRESSURE_CTRL);
+    }
+    
+    uint16_t stagedRecords = configBatch.recordCount;
+    dropConfigSections(changed);
+    configBatch.sectionMask = changed;
+    
+    if (changed == 0) {
+      configBatch.stage = CONFIG_BATCH_IDLE;
+      log(LOG_INFO, true, "IPC: IO MCU configuration up to date (digest %08lX), nothing to push\n",
+          (unsigned long)configBatch.digest.overall);
+      startSensorPolling();
+      return true;
+    }
+    
+    log(LOG_INFO, true, "IPC: Configuration digest differs in %u of %u sections, pushing %u/%u records\n",
+        __builtin_popcount(changed), IPC_CONFIG_SECTION_COUNT, configBatch.recordCount, stagedRecords);
+  }
+  
+  return startConfigBatch();
+}
+
+const IPC_ConfigDigest_t *ipcConfigDigest() {
+  return &configBatch.digest;
+}
+
+static bool startConfigBatch() {
+  configBatch.transactionId = generateTransactionId();
+  if (!addPendingTransaction(configBatch.transactionId, IPC_MSG_CONFIG_COMMIT, IPC_MSG_CONFIG_RESULT,
+                             1, 0, IPC_TXN_TIMEOUT_MS, configBatchDone)) {
+    configBatch.stage = CONFIG_BATCH_IDLE;
+    return false;
+  }
+  
+  configBatch.stage = CONFIG_BATCH_SENDING;
+  configBatch.beginSent = false;
+  configBatch.sentRecords = 0;
+  configBatch.sentBytes = 0;
+  configBatch.startTime = millis();
+  sendConfigBatch();
+  return true;
+}
+
+/**
+ * @brief Queue as much of the batch as the TX queue takes, resume when space frees
+ */
+static void sendConfigBatch() {
+  if (configBatch.stage != CONFIG_BATCH_SENDING) {
+    return;  // Finished or cancelled while waiting for space
+  }
+  
+  if (!configBatch.beginSent) {
+    IPC_ConfigBegin_t begin;
+    begin.transactionId = configBatch.transactionId;
+    begin.recordCount = configBatch.recordCount;
+    begin.totalBytes = configBatch.length;
+    begin.sectionMask = configBatch.sectionMask;
+    if (!ipc.sendPacket(IPC_MSG_CONFIG_BEGIN, (uint8_t*)&begin, sizeof(begin))) {
+      ipc.notifyWhenFree(IPC_MSG_CONFIG_BEGIN, sizeof(begin), sendConfigBatch);
+      return;
     }
+    configBatch.beginSent = true;
+  }
+  
+  while (configBatch.sentRecords < configBatch.recordCount) {
+    // As many whole records as fit in one frame
+    uint16_t bytes = 0;
+    uint8_t count = 0;
+    while (configBatch.sentRecords + count < configBatch.recordCount && count < 255) {
+      const IPC_ConfigRecord_t *rec =
+          (const IPC_ConfigRecord_t *)&configBatch.records[configBatch.sentBytes + bytes];
+      uint16_t recordLen = sizeof(IPC_ConfigRecord_t) + rec->length;
+      if (sizeof(IPC_ConfigBatchHeader_t) + bytes + recordLen > IPC_MAX_PAYLOAD_SIZE) {
+        break;
+      }
+      bytes += recordLen;
+      count++;
+    }
+    
+    uint16_t frameLen = sizeof(IPC_ConfigBatchHeader_t) + bytes;
+    uint8_t *frame = ipc.reservePacket(IPC_MSG_CONFIG_BATCH, frameLen);
+    if (frame == nullptr) {
+      ipc.notifyWhenFree(IPC_MSG_CONFIG_BATCH, frameLen, sendConfigBatch);
+      return;
+    }
+    
+    IPC_ConfigBatchHeader_t *hdr = (IPC_ConfigBatchHeader_t *)frame;
+    hdr->transactionId = configBatch.transactionId;
+    hdr->firstRecord = configBatch.sentRecords;
+    hdr->recordCount = count;
+    memcpy(frame + sizeof(IPC_ConfigBatchHeader_t), &configBatch.records[configBatch.sentBytes], bytes);
+    ipc.commitPacket(frameLen);
+    
+    configBatch.sentRecords += count;
+    configBatch.sentBytes += bytes;
+  }
+  
+  IPC_ConfigCommit_t commit;
+  commit.transactionId = configBatch.transactionId;
+  commit.recordCount = configBatch.recordCount;
+  if (!ipc.sendPacket(IPC_MSG_CONFIG_COMMIT, (uint8_t*)&commit, sizeof(commit))) {
+    ipc.notifyWhenFree(IPC_MSG_CONFIG_COMMIT, sizeof(commit), sendConfigBatch);
+    return;
+  }
+  
+  configBatch.stage = CONFIG_BATCH_WAITING;
+  log(LOG_DEBUG, false, "[IPC] Config batch %u queued: %u records, %u bytes in %lu ms\n",
+      configBatch.transactionId, configBatch.recordCount, configBatch.length,
+      millis() - configBatch.startTime);
+}
+
+/**
+ * @brief Handler for CONFIG_RESULT messages from IO MCU
+ */
+void handleConfigResult(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  const uint16_t headerLen = sizeof(IPC_ConfigResult_t) - IPC_CONFIG_MAX_RECORDS;
+  if (payload == nullptr || length < headerLen) {
+    log(LOG_ERROR, false, "IPC: Invalid config result payload\n");
+    return;
+  }
+  
+  const IPC_ConfigResult_t *result = (const IPC_ConfigResult_t *)payload;
+  if (result->recordCount > IPC_CONFIG_MAX_RECORDS || length != headerLen + result->recordCount) {
+    log(LOG_ERROR, false, "IPC: Invalid config result payload\n");
+    return;
+  }
+  
+  PendingTransaction *txn = findPendingTransaction(result->transactionId);
+  if (txn == nullptr || configBatch.stage != CONFIG_BATCH_WAITING ||
+      result->transactionId != configBatch.transactionId) {
+    log(LOG_DEBUG, false, "[IPC] Ignoring CONFIG_RESULT for stale batch %d\n", result->transactionId);
+    return;
+  }
+  
+  if (result->status != IPC_CONFIG_BATCH_APPLIED) {
+    log(LOG_WARNING, false, "IPC: Config batch %u not applied (status %u)\n",
+        result->transactionId, result->status);
+    finishTransaction(txn, IPC_TXN_REFUSED);
+    return;
+  }
+  
+  for (uint16_t i = 0; i < result->recordCount && i < configBatch.recordCount; i++) {
+    if (result->recordStatus[i] != IPC_CONFIG_REC_OK) {
+      log(LOG_WARNING, true, "IPC: ✗ %s[%u] config not applied (status %u)\n",
+          configRecordName(configBatch.recordType[i]), configBatch.recordIndex[i],
+          result->recordStatus[i]);
+    }
+  }
+  
+  log(LOG_INFO, true, "IPC: Configuration applied by IO MCU: %u/%u records in %lu ms\n",
+      result->appliedCount, result->recordCount, millis() - configBatch.startTime);
+  
+  finishTransaction(txn, (result->appliedCount == result->recordCount) ? IPC_TXN_COMPLETE : IPC_TXN_FAILED);
 }
 
 // ============================================================================
@@ -178,7 +1166,7 @@ void ipcPrepareForLongOperation() {
     //    Better to clear them now and avoid the timeout warnings later
     if (pendingTxnCount > 0) {
         log(LOG_DEBUG, false, "[IPC] Clearing %d pending transactions before long operation\n", pendingTxnCount);
-        pendingTxnCount = 0;
+        clearPendingTransactions();
     }
     
     // 4. Flush UART RX buffer - any data arriving during the operation will be
@@ -250,7 +1238,7 @@ void init_ipcManager(void) {
     statusLocked = false;
   }
   
-  ipc.begin(2000000); // 2 Mbps
+  ipc.begin(IPC_BAUD_DEFAULT);  // Faster rates negotiated once connected
   
   // Register message handlers
   registerIpcCallbacks();
@@ -288,42 +1276,27 @@ void pollSensors(void) {
     return;
   }
   
-  unsigned long now = millis();
-  if (now - lastSensorPollTime < SENSOR_POLL_INTERVAL) return;
-  lastSensorPollTime = now;
-  
-  // Request fixed hardware range (0-36: ADC, DAC, RTD, GPIO, outputs, motors, COM ports)
-  // Always 37 objects (indices 37-39 are reserved for future use)
-  objectCache.requestBulkUpdate(0, 37);
-  
-  // Request controllers (40-48: temp, pH, flow, DO controllers)
-  // Only poll active controllers based on config
-  uint8_t controllerRangeSize = getFixedHardwareObjectCount() - 37;  // Returns highest index + 1
-  uint8_t controllerExpectedCount = getFixedHardwareExpectedCount() - 37;  // Subtract base hardware
-  if (controllerRangeSize > 0) {
-    objectCache.requestBulkUpdateSparse(40, controllerRangeSize, controllerExpectedCount);
+  // IO MCU pushes updates once the stream subscription is acknowledged. Pushes
+  // share the delta shadow and sequence, so a lost one is repaired by a resync.
+  if (ipcStreamActive) {
+    if (objectCache.deltaResyncPending()) {
+      objectCache.requestDeltaUpdate(0, MAX_CACHED_OBJECTS);
+    }
+    return;
   }
   
-  // Request device control objects (indices 50-69)
-  // These provide control status for peripheral devices (setpoint, actual, connected, fault)
-  // Control objects are sparse (only even indices used: 50, 52, 54, 56...)
-  // Use sparse request to handle mismatch between requested range and expected responses
-  uint8_t controlCount = getActiveDeviceControlCount();
-  if (controlCount > 0) {
-    // Request full device control range (20 indices) but expect only valid responses
-    // IO MCU will only respond for actual control objects (e.g., 50, 52, 54, 56)
-    objectCache.requestBulkUpdateSparse(50, 20, controlCount);
-  }
+  unsigned long now = millis();
+  if (now - lastSensorPollTime < SENSOR_POLL_INTERVAL) return;
   
-  // Request dynamic device sensor objects (indices 70-99)
-  // These are user-created device sensors (Modbus, I2C, etc.)
-  // Dynamically count based on active devices from config
-  uint8_t sensorCount = getActiveDeviceSensorCount();
-  if (sensorCount > 0) {
-    objectCache.requestBulkUpdate(70, sensorCount);
+  // Request all objects as delta-encoded batches - the IO MCU only sends objects
+  // that changed since the last poll (plus removals), and the FINAL frame refreshes
+  // the rest of the range. Unused indices cost nothing, so one range covers the
+  // fixed hardware, controllers, device controls and dynamic device sensors.
+  // If the bulk window is full the poll is retried on the next call instead of
+  // being sent and refused.
+  if (objectCache.requestDeltaUpdate(0, MAX_CACHED_OBJECTS)) {
+    lastSensorPollTime = now;
   }
-  
-  //log(LOG_DEBUG, false, "Polling objects: Requested bulk update for indices 0-42 (fixed+controllers), 50-69 (control), and 70-99 (sensors)\n");
 }
 
 void manageIPC(void) {
@@ -340,6 +1313,14 @@ void manageIPC(void) {
     // Clean up stalled transactions
     cleanupStalledTransactions();
     
+    // Link rate negotiation and error fallback
+    manageIpcBaud(now);
+    
+    // Round-trip sample from this side (the IO MCU pings on its own keepalive)
+    if (ipcReady) {
+      ipc.sendPing();
+    }
+    
     // Check if connection has been lost (timeout)
     if (ipcReady) {
       IPC_Statistics_t stats;
@@ -347,7 +1328,9 @@ void manageIPC(void) {
       if (now - stats.lastRxTime > 5000) {
         log(LOG_WARNING, true, "IPC: Connection timeout detected, resetting to disconnected state\n");
         ipcReady = false;
-        objectCache.clear();
+        ipcStreamActive = false;
+        ipc.setBaudRate(IPC_BAUD_DEFAULT);  // The handshake runs at the default rate
+        // Object cache is kept - the next handshake decides whether it is still valid
         
         // Update status flags - connection lost
         if (!statusLocked) {
@@ -365,6 +1348,9 @@ void manageIPC(void) {
   
   // Continuously poll sensors to keep cache fresh
   pollSensors();
+  
+  // ADC capture status polling and block transfer
+  manageAdcCapture();
 }
 
 /**
@@ -400,19 +1386,11 @@ void handleSensorData(uint8_t messageType, const uint8_t *payload, uint16_t leng
     // Valid transaction - increment received count
     txn->receivedResponseCount++;
     
-    // If all expected responses received, complete the transaction
-    if (txn->receivedResponseCount >= txn->expectedResponseCount) {
-      completePendingTransaction(sensorData->transactionId);
-      
-      // Clear timeout flag if this was the last pending transaction
-      if (pendingTxnCount == 0 && status.ipcTimeout) {
-        if (!statusLocked) {
-          statusLocked = true;
-          status.ipcTimeout = false;
-          status.updated = true;
-          statusLocked = false;
-        }
-      }
+    // Single reads complete here; bulk ranges complete on their BULK_CREDIT
+    // (unused indices in the range send nothing, so the count is only a hint)
+    if (!isWindowedRequest(txn->requestType) &&
+        txn->receivedResponseCount >= txn->expectedResponseCount) {
+      finishTransaction(txn, IPC_TXN_COMPLETE);
     }
   }
   
@@ -441,11 +1419,90 @@ void handleSensorData(uint8_t messageType, const uint8_t *payload, uint16_t leng
   // This will be implemented when the status manager is updated for the new IPC protocol
 }
 
+// SENSOR_DELTA sequence tracking (gap = lost frame, request resync)
+static uint16_t expectedDeltaSequence = 0;
+static bool deltaSequenceValid = false;
+
+/**
+ * @brief Handler for delta-encoded sensor batches from SAME51
+ */
+void handleSensorDelta(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  if (payload == nullptr || length < sizeof(IPC_SensorDeltaHeader_t)) {
+    log(LOG_ERROR, false, "IPC: Invalid sensor delta payload\n");
+    return;
+  }
+  
+  IPC_SensorDeltaHeader_t header;
+  memcpy(&header, payload, sizeof(header));
+  
+  // A missing frame means the IO MCU believes we hold records we never received
+  if (deltaSequenceValid && header.sequence != expectedDeltaSequence &&
+      !(header.flags & IPC_DELTA_FLAG_FULL)) {
+    log(LOG_WARNING, false, "[IPC] Delta sequence gap (expected %u, got %u) - resync requested\n",
+        expectedDeltaSequence, header.sequence);
+    objectCache.markDeltaResync();
+  }
+  expectedDeltaSequence = header.sequence + 1;
+  deltaSequenceValid = true;
+  
+  // Apply records
+  uint16_t pos = sizeof(IPC_SensorDeltaHeader_t);
+  for (uint8_t i = 0; i < header.recordCount; i++) {
+    uint16_t consumed = objectCache.applyDeltaRecord(&payload[pos], length - pos);
+    if (consumed == 0) {
+      log(LOG_ERROR, false, "IPC: Malformed sensor delta record %u/%u (txn %u)\n",
+          i + 1, header.recordCount, header.transactionId);
+      objectCache.markDeltaResync();
+      return;
+    }
+    pos += consumed;
+  }
+  
+  // Stream pushes (IPC_TXN_NONE) and intermediate frames confirm nothing else
+  if (!(header.flags & IPC_DELTA_FLAG_FINAL)) {
+    return;
+  }
+  
+  // Final frame: objects not sent in this response are unchanged
+  // (the transaction itself is completed by the BULK_CREDIT that follows)
+  objectCache.touchRange(header.startIndex, header.count);
+}
+
+/**
+ * @brief Handler for bulk range completion/refusal from SAME51
+ * Completes the range transaction and frees its window slot.
+ */
+void handleBulkCredit(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  if (payload == nullptr || length != sizeof(IPC_BulkCredit_t)) {
+    log(LOG_ERROR, false, "IPC: Invalid bulk credit payload\n");
+    return;
+  }
+  
+  const IPC_BulkCredit_t *credit = (const IPC_BulkCredit_t *)payload;
+  bulkCredit = credit->credit;
+  
+  PendingTransaction* txn = findPendingTransaction(credit->transactionId);
+  if (txn == nullptr) {
+    // Already timed out or cleared
+    return;
+  }
+  
+  if (credit->status == IPC_BULK_CREDIT_REFUSED) {
+    log(LOG_WARNING, false, "[IPC] Bulk request txn %d refused by IO MCU (credit %u/%u)\n",
+        credit->transactionId, credit->credit, bulkWindow);
+    finishTransaction(txn, IPC_TXN_REFUSED);
+  } else {
+    finishTransaction(txn, IPC_TXN_COMPLETE);
+  }
+}
+
 /**
  * @brief Handler for PING messages
  * Only respond if handshake is complete to allow IO MCU timeout detection
  */
 void handlePing(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  ipc.processPing(payload, length);  // IO MCU's link statistics, timestamp to echo
+  
   // Only respond to PING if handshake is complete
   // If we respond before handshake, IO MCU won't timeout and restart HELLO broadcasts
   if (ipcReady) {
@@ -459,6 +1516,38 @@ void handlePing(uint8_t messageType, const uint8_t *payload, uint16_t length) {
  */
 void handlePong(uint8_t messageType, const uint8_t *payload, uint16_t length) {
   // Connection is alive - no need to log every keepalive
+  ipc.processPong(payload, length);  // Round-trip sample
+}
+
+/**
+ * @brief Handlers for the link baud rate change (run by IPCProtocol)
+ */
+void handleBaudSwitchAck(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  ipc.processBaudSwitchAck(payload, length);
+}
+
+void handleLinkTest(uint8_t messageType, const uint8_t *payload, uint16_t length) {
+  ipc.processLinkTest(payload, length);  // Echo compared, next test or commit sent
+}
+
+/**
+ * @brief Take the IO MCU's configuration digest from HELLO / HELLO_ACK
+ * The next config push only sends the sections that differ. The object cache
+ * is kept across a reconnect (the first delta poll resends every object)
+ * unless the IO MCU has no configuration, i.e. it rebooted.
+ */
+static void adoptIoConfigDigest(const IPC_ConfigDigest_t *digest) {
+  ioConfigDigest = *digest;
+  ioConfigDigestValid = true;
+  
+  if (digest->overall == 0) {
+    objectCache.clear();
+    log(LOG_INFO, false, "IPC: IO MCU has no configuration, object cache cleared\n");
+  } else {
+    objectCache.markDeltaResync();
+    log(LOG_INFO, false, "IPC: IO MCU configuration digest %08lX, object cache kept\n",
+        (unsigned long)digest->overall);
+  }
 }
 
 /**
@@ -481,43 +1570,26 @@ void handleHello(uint8_t messageType, const uint8_t *payload, uint16_t length) {
   ack.firmwareVersion = 0x00010001; // v1.0.1
   ack.maxObjectCount = IPC_MAX_OBJECTS;
   ack.currentObjectCount = 0; // TODO: Get from object index manager
+  ack.bulkWindow = 0;         // SYS MCU does not serve bulk ranges
+  ack.configDigest = *ipcConfigDigest();
+  ack.baudRates = IPC_BAUD_SUPPORTED_SYS;
   
   ipc.sendPacket(IPC_MSG_HELLO_ACK, (uint8_t*)&ack, sizeof(ack));
   
   log(LOG_INFO, false, "IPC: Sent HELLO_ACK to SAME51\n");
   
-  // Clear object cache for fresh start
-  objectCache.clear();
-  log(LOG_INFO, false, "IPC: Object cache cleared for fresh start\n");
+  adoptIoConfigDigest(&hello->configDigest);
+  ioBaudRates = hello->baudRates;
   
-  // Clear any stale transactions before config push
-  pendingTxnCount = 0;
+  // Clear any stale transactions before config push and adopt the IO MCU's bulk window
+  setBulkWindow(hello->bulkWindow);
+  clearPendingTransactions();
   
   // Push IO configuration to IO MCU before enabling polling
-  // This ensures IO MCU always has current config after any reboot
+  // Only sections that differ from the IO MCU's digest are sent (all of them after a reboot)
+  // Polling starts when the IO MCU reports the batch applied (configBatchDone)
+  ipcReady = false;
   pushIOConfigToIOmcu();
-  log(LOG_INFO, false, "IPC: Configuration pushed to IO MCU\n");
-  
-  // Wait for IO MCU to finish processing config messages before starting polling
-  // Device creation and controller setup can take significant time on IO MCU
-  // Use non-blocking wait that continues to call ipc.update() to:
-  // 1. Process any pending TX/RX data (ensures large packets complete)
-  // 2. Respond to PING keepalives (prevents IO MCU timeout)
-  // 3. Receive ACKs from config messages
-  unsigned long configWaitStart = millis();
-  while (millis() - configWaitStart < 500) {
-    ipc.update();
-    delay(10);  // Small delay to prevent tight loop
-  }
-  log(LOG_DEBUG, false, "IPC: Config processing delay complete\n");
-  
-  // Enable sensor polling now that handshake and config push are complete
-  ipcReady = true;
-  
-  // Reset poll timer to delay first poll by a full interval
-  // This prevents polling from starting immediately after config push
-  // and gives IO MCU extra time to complete all config processing
-  lastSensorPollTime = millis();
   
   // Update status flags - connection restored
   if (!statusLocked) {
@@ -553,32 +1625,18 @@ void handleHelloAck(uint8_t messageType, const uint8_t *payload, uint16_t length
   log(LOG_INFO, true, "IPC: ✓ Handshake complete! SAME51 firmware v%08X (%u/%u objects)\n",
       ack->firmwareVersion, ack->currentObjectCount, ack->maxObjectCount);
   
-  // Clear object cache and push fresh configuration on every handshake
-  // This ensures IO MCU always has current config after any reboot
-  objectCache.clear();
-  log(LOG_INFO, false, "IPC: Object cache cleared for fresh start\n");
+  adoptIoConfigDigest(&ack->configDigest);
+  ioBaudRates = ack->baudRates;
   
-  // Clear any stale transactions before config push
-  pendingTxnCount = 0;
+  // Clear any stale transactions before config push and adopt the IO MCU's bulk window
+  setBulkWindow(ack->bulkWindow);
+  clearPendingTransactions();
   
   // Push IO configuration to IO MCU now that IPC is established
+  // Only sections that differ from the IO MCU's digest are sent (all of them after a reboot)
+  // Polling starts when the IO MCU reports the batch applied (configBatchDone)
+  ipcReady = false;
   pushIOConfigToIOmcu();
-  log(LOG_INFO, false, "IPC: Configuration pushed to IO MCU\n");
-  
-  // Wait for IO MCU to finish processing config messages before starting polling
-  // Use non-blocking wait that continues to call ipc.update() to process keepalives
-  unsigned long configWaitStart = millis();
-  while (millis() - configWaitStart < 500) {
-    ipc.update();
-    delay(10);  // Small delay to prevent tight loop
-  }
-  log(LOG_DEBUG, false, "IPC: Config processing delay complete\n");
-  
-  // Enable sensor polling now that IPC is ready
-  ipcReady = true;
-  
-  // Reset poll timer to delay first poll by a full interval
-  lastSensorPollTime = millis();
   
   // Update status flags - connection restored
   if (!statusLocked) {
@@ -590,7 +1648,7 @@ void handleHelloAck(uint8_t messageType, const uint8_t *payload, uint16_t length
     statusLocked = false;
   }
   
-  log(LOG_INFO, false, "IPC: Sensor polling enabled - system fully operational\n");
+  log(LOG_INFO, false, "IPC: Connection established, waiting for configuration result\n");
 }
 
 /**
@@ -633,6 +1691,8 @@ void registerIpcCallbacks(void) {
   // Protocol messages
   ipc.registerHandler(IPC_MSG_PING, handlePing);
   ipc.registerHandler(IPC_MSG_PONG, handlePong);
+  ipc.registerHandler(IPC_MSG_BAUD_SWITCH_ACK, handleBaudSwitchAck);
+  ipc.registerHandler(IPC_MSG_LINK_TEST, handleLinkTest);
   ipc.registerHandler(IPC_MSG_HELLO, handleHello);
   ipc.registerHandler(IPC_MSG_HELLO_ACK, handleHelloAck);
   ipc.registerHandler(IPC_MSG_ERROR, handleError);
@@ -640,6 +1700,8 @@ void registerIpcCallbacks(void) {
   // Sensor data
   ipc.registerHandler(IPC_MSG_SENSOR_DATA, handleSensorData);
   ipc.registerHandler(IPC_MSG_SENSOR_BATCH, handleSensorData); // Can use same handler
+  ipc.registerHandler(IPC_MSG_SENSOR_DELTA, handleSensorDelta);
+  ipc.registerHandler(IPC_MSG_BULK_CREDIT, handleBulkCredit);
   
   // Fault notifications
   ipc.registerHandler(IPC_MSG_FAULT_NOTIFY, handleFaultNotify);
@@ -652,6 +1714,16 @@ void registerIpcCallbacks(void) {
   
   // Index synchronization
   ipc.registerHandler(IPC_MSG_INDEX_SYNC_DATA, handleIndexSyncData);
+  
+  // Configuration batch
+  ipc.registerHandler(IPC_MSG_CONFIG_RESULT, handleConfigResult);
+  
+  // Scheduler diagnostics
+  ipc.registerHandler(IPC_MSG_TASK_STATS, handleTaskStats);
+  
+  // ADC burst capture
+  ipc.registerHandler(IPC_MSG_ADC_CAPTURE_STATUS, handleAdcCaptureStatus);
+  ipc.registerHandler(IPC_MSG_ADC_CAPTURE_DATA, handleAdcCaptureData);
 
   log(LOG_INFO, false, "IPC message handlers registered.\n");
 }
@@ -682,8 +1754,25 @@ void handleControlAck(uint8_t messageType, const uint8_t *payload, uint16_t leng
     txn->receivedResponseCount++;
     
     if (txn->receivedResponseCount >= txn->expectedResponseCount) {
-      completePendingTransaction(ack->transactionId);
+      finishTransaction(txn, ack->success ? IPC_TXN_COMPLETE : IPC_TXN_FAILED);
+    }
+  }
+  
+  // Sensor stream subscription result - next range, or fall back to polling if refused
+  if (streamSubscribeTxn != 0 && ack->transactionId == streamSubscribeTxn) {
+    streamSubscribeTxn = 0;
+    if (ack->success && ++streamSubscribeStep < SENSOR_STREAM_STEPS) {
+      sendSensorStreamRange();
+      return;
+    }
+    ipcStreamActive = ack->success;
+    if (ack->success) {
+      log(LOG_INFO, false, "IPC: Sensor stream active - polling disabled\n");
+    } else {
+      log(LOG_WARNING, false, "IPC: Sensor stream refused (error %d: %s), using polling\n",
+          ack->errorCode, ack->message);
     }
+    return;
   }
   
   if (ack->success) {
@@ -2,14 +2,28 @@
 
 #include "../sys_init.h"
 
+// Inter-MCU link (Serial1) starts at IPC_BAUD_DEFAULT; faster rates are negotiated (v2.14)
+#define IPC_BAUD_SUPPORTED_SYS        0x0F      // Rates the RP2040 UART runs (bit n = ipc_baudRates[n], 125 MHz clk_peri)
+#define IPC_BAUD_FALLBACK_WINDOW_MS   10000     // Frame error rate measurement window (both directions)
+#define IPC_BAUD_FALLBACK_PPM         10000     // Error rate over a window that forces a lower rate
+#define IPC_BAUD_FALLBACK_MIN_ERRORS  5         // ... with at least this many rejected frames
+#define IPC_BAUD_SILENCE_MS           3000      // No valid frame above the default rate: drop to it without the IO MCU
+#define IPC_BAUD_RETRY_MS             600000    // A rate that failed is not tried again for this long
+
+extern bool ipcReady;        // Handshake and configuration push complete
+
 void init_ipcManager(void);
 void manageIPC(void);
 
 // IPC message handlers
 void registerIpcCallbacks(void);
 void handleSensorData(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleSensorDelta(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleBulkCredit(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handlePing(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handlePong(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleBaudSwitchAck(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleLinkTest(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handleHello(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handleHelloAck(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handleError(uint8_t messageType, const uint8_t *payload, uint16_t length);
@@ -17,6 +31,8 @@ void handleFaultNotify(uint8_t messageType, const uint8_t *payload, uint16_t len
 void handleControlAck(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handleDeviceStatus(uint8_t messageType, const uint8_t *payload, uint16_t length);
 void handleIndexSyncData(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleConfigResult(uint8_t messageType, const uint8_t *payload, uint16_t length);
+void handleTaskStats(uint8_t messageType, const uint8_t *payload, uint16_t length);
 
 // Output control command senders
 bool sendDigitalOutputCommand(uint16_t index, uint8_t command, bool state, float pwmDuty);
@@ -30,9 +46,70 @@ bool sendDeviceDeleteCommand(uint8_t startIndex);
 bool sendDeviceConfigCommand(uint8_t startIndex, const IPC_DeviceConfig_t* config);
 bool sendDeviceQueryCommand(uint8_t startIndex);
 
-// Transaction ID management (v2.6)
+// Transaction management (v2.9)
+#define IPC_TXN_TIMEOUT_MS        5000  // Default transaction deadline
+#define IPC_TXN_READ_TIMEOUT_MS   2000  // Sensor read / bulk / delta deadline
+
+enum IPC_TxnResult : uint8_t {
+  IPC_TXN_COMPLETE,     // All responses received
+  IPC_TXN_FAILED,       // IO MCU reported failure (CONTROL_ACK success = false)
+  IPC_TXN_REFUSED,      // Bulk range not queued by the IO MCU
+  IPC_TXN_TIMEOUT,      // Deadline passed
+  IPC_TXN_CANCELLED     // Table cleared (handshake, long operation)
+};
+
+typedef void (*IPC_TxnCallback)(uint16_t txnId, IPC_TxnResult result);
+typedef void (*IPC_TxnObserver)(uint8_t reqType, IPC_TxnResult result, uint32_t latencyUs);
+
 uint16_t generateTransactionId();
-bool addPendingTransaction(uint16_t txnId, uint8_t reqType, uint8_t respType, uint16_t respCount, uint8_t startIdx);
+bool addPendingTransaction(uint16_t txnId, uint8_t reqType, uint8_t respType, uint16_t respCount, uint8_t startIdx,
+                           uint32_t timeoutMs = IPC_TXN_TIMEOUT_MS, IPC_TxnCallback callback = nullptr);
+bool completeTransaction(uint16_t txnId, uint8_t respType);
+bool ipcBulkWindowOpen();
+void printIpcTransactionStats();
+void printIpcLinkStats();                                  // Link quality, both MCUs' views (v2.13)
+void setIpcTransactionObserver(IPC_TxnObserver observer);  // Latency instrumentation (host twin)
+
+// Link baud rate (v2.14)
+struct IpcBaudInfo_t {
+  uint32_t baudRate;          // Current link rate
+  uint8_t sysRates;           // IPC_BAUD_SUPPORTED_SYS
+  uint8_t ioRates;            // From the IO MCU's HELLO / HELLO_ACK (0 = not known yet)
+  uint8_t failedRates;        // Rates not retried until IPC_BAUD_RETRY_MS has passed
+  uint8_t lastResult;         // IPC_BaudResult_t of the last switch
+  uint16_t switches;          // Switches committed
+  uint16_t failures;          // Switches refused or abandoned
+  uint16_t fallbacks;         // Drops to a lower rate on the error rate or silence
+  uint32_t errorPpm;          // Frame errors, both directions, over the last IPC_BAUD_FALLBACK_WINDOW_MS
+};
+
+void getIpcBaudInfo(IpcBaudInfo_t *info);
+
+// Configuration batch (v2.10)
+void ipcConfigBatchBegin();
+bool ipcConfigBatchAdd(uint8_t msgType, uint8_t index, const void *payload, uint16_t length);
+bool ipcConfigBatchCommit();
+const IPC_ConfigDigest_t *ipcConfigDigest();  // Digest of the configuration last pushed (v2.11)
+
+// IO MCU scheduler task statistics (v2.12)
+#define IO_TASK_STATS_MAX  64
+
+struct IoTaskStats_t {
+  bool valid;                 // A complete table has been received
+  uint32_t updatedAt;         // millis() when the last page arrived
+  uint32_t uptimeMs;          // IO MCU uptime at capture
+  uint16_t idlePermille;      // IO MCU idle (WFI) share, 0.1 %
+  uint8_t totalTasks;         // Tasks reported by the IO MCU
+  uint8_t count;              // Entries in task[]
+  IPC_TaskStatsEntry_t task[IO_TASK_STATS_MAX];
+};
+
+bool requestIoTaskStats(bool reset, bool print);
+const IoTaskStats_t *getIoTaskStats();
+void printIoTaskStats();
+
+// Sensor stream subscription (v2.7)
+bool subscribeSensorStream();
 
 // Long operation coordination (prevents IPC timeouts during flash writes)
 void ipcPrepareForLongOperation();
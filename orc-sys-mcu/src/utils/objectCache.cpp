@@ -8,7 +8,14 @@ ObjectCache objectCache;
 // External IPC instance
 extern IPCProtocol ipc;
 
-ObjectCache::ObjectCache() : _lastBulkRequest(0) {
+// Lost or abandoned delta frames leave the cache out of step with the IO MCU shadow
+static void deltaTransactionDone(uint16_t txnId, IPC_TxnResult result) {
+    if (result == IPC_TXN_TIMEOUT || result == IPC_TXN_CANCELLED) {
+        objectCache.markDeltaResync();
+    }
+}
+
+ObjectCache::ObjectCache() : _lastBulkRequest(0), _deltaResync(true) {
     clear();
 }
 
@@ -40,6 +47,111 @@ void ObjectCache::updateObject(const IPC_SensorData_t* data) {
     }
 }
 
+// Copy a length-prefixed delta string into dst (always terminated)
+static uint16_t readDeltaString(const uint8_t* src, uint16_t len, char* dst, size_t dstSize) {
+    if (len < 1 || len < 1 + src[0]) {
+        return 0;
+    }
+    uint8_t strLen = src[0];
+    if (dst != nullptr) {
+        size_t copyLen = (strLen < dstSize - 1) ? strLen : dstSize - 1;
+        memcpy(dst, &src[1], copyLen);
+        dst[copyLen] = '\0';
+    }
+    return 1 + strLen;
+}
+
+uint16_t ObjectCache::applyDeltaRecord(const uint8_t* record, uint16_t len) {
+    if (record == nullptr || len < 3) {
+        return 0;
+    }
+    
+    uint8_t index = record[0];
+    uint8_t flags = record[1];
+    uint8_t fields = record[2];
+    uint16_t pos = 3;
+    
+    // Out-of-range records are parsed (to find the next one) but not stored
+    CachedObject* obj = (index < MAX_CACHED_OBJECTS) ? &_cache[index] : nullptr;
+    
+    if (fields & IPC_DELTA_FIELD_REMOVED) {
+        if (obj != nullptr) {
+            invalidate(index);
+        }
+        return pos;
+    }
+    
+    uint8_t valueCount = fields & IPC_DELTA_FIELD_VALUES_MASK;
+    if (valueCount > 4) {
+        return 0;
+    }
+    
+    if (fields & IPC_DELTA_FIELD_TYPE) {
+        if (pos + 1 > len) return 0;
+        if (obj != nullptr) obj->objectType = record[pos];
+        pos++;
+    }
+    
+    uint16_t valuesLen = sizeof(float) * (1 + valueCount);
+    if (pos + valuesLen > len) {
+        return 0;
+    }
+    if (obj != nullptr) {
+        memcpy(&obj->value, &record[pos], sizeof(float));
+        memcpy(obj->additionalValues, &record[pos + sizeof(float)], sizeof(float) * valueCount);
+    }
+    pos += valuesLen;
+    
+    if (fields & IPC_DELTA_FIELD_UNIT) {
+        uint16_t n = readDeltaString(&record[pos], len - pos, obj ? obj->unit : nullptr, sizeof(obj->unit));
+        if (n == 0) return 0;
+        pos += n;
+    }
+    
+    if (fields & IPC_DELTA_FIELD_EXTRA_UNITS) {
+        for (uint8_t i = 0; i < valueCount; i++) {
+            uint16_t n = readDeltaString(&record[pos], len - pos, obj ? obj->additionalUnits[i] : nullptr,
+                                         sizeof(obj->additionalUnits[i]));
+            if (n == 0) return 0;
+            pos += n;
+        }
+    }
+    
+    if (fields & IPC_DELTA_FIELD_MSG) {
+        uint16_t n = readDeltaString(&record[pos], len - pos, obj ? obj->message : nullptr, sizeof(obj->message));
+        if (n == 0) return 0;
+        pos += n;
+    }
+    
+    if (obj != nullptr) {
+        obj->index = index;
+        obj->flags = flags;
+        obj->valueCount = valueCount;
+        obj->lastUpdate = millis();
+        obj->valid = true;
+    }
+    
+    return pos;
+}
+
+void ObjectCache::touchRange(uint8_t startIndex, uint8_t count) {
+    if (startIndex >= MAX_CACHED_OBJECTS || count == 0) {
+        return;
+    }
+    
+    // Clamp count to valid range
+    if (startIndex + count > MAX_CACHED_OBJECTS) {
+        count = MAX_CACHED_OBJECTS - startIndex;
+    }
+    
+    unsigned long now = millis();
+    for (uint8_t i = startIndex; i < startIndex + count; i++) {
+        if (_cache[i].valid) {
+            _cache[i].lastUpdate = now;
+        }
+    }
+}
+
 void ObjectCache::updateObjectName(uint8_t index, const char* name, uint8_t type) {
     if (index >= MAX_CACHED_OBJECTS || name == nullptr) {
         return;
@@ -84,15 +196,21 @@ void ObjectCache::requestUpdate(uint8_t index) {
     request.index = index;
     
     if (ipc.sendPacket(IPC_MSG_SENSOR_READ_REQ, (uint8_t*)&request, sizeof(request))) {
-        addPendingTransaction(txnId, IPC_MSG_SENSOR_READ_REQ, IPC_MSG_SENSOR_DATA, 1, index);
+        addPendingTransaction(txnId, IPC_MSG_SENSOR_READ_REQ, IPC_MSG_SENSOR_DATA, 1, index,
+                              IPC_TXN_READ_TIMEOUT_MS);
     }
     
     // log(LOG_DEBUG, false, "Cache: Requested update for object %d\n", index);
 }
 
-void ObjectCache::requestBulkUpdate(uint8_t startIndex, uint8_t count) {
+bool ObjectCache::requestBulkUpdate(uint8_t startIndex, uint8_t count) {
     if (startIndex >= MAX_CACHED_OBJECTS || count == 0) {
-        return;
+        return false;
+    }
+    
+    // Hold the request until the IO MCU has a free range slot
+    if (!ipcBulkWindowOpen()) {
+        return false;
     }
     
     // Clamp count to valid range
@@ -109,20 +227,28 @@ void ObjectCache::requestBulkUpdate(uint8_t startIndex, uint8_t count) {
     request.startIndex = startIndex;
     request.count = count;
     
-    if (ipc.sendPacket(IPC_MSG_SENSOR_BULK_READ_REQ, (uint8_t*)&request, sizeof(request))) {
-        // Track transaction - expecting 'count' SENSOR_DATA responses
-        addPendingTransaction(txnId, IPC_MSG_SENSOR_BULK_READ_REQ, IPC_MSG_SENSOR_DATA, count, startIndex);
+    bool sent = ipc.sendPacket(IPC_MSG_SENSOR_BULK_READ_REQ, (uint8_t*)&request, sizeof(request));
+    if (sent) {
+        // Track transaction - up to 'count' SENSOR_DATA responses, completed by BULK_CREDIT
+        addPendingTransaction(txnId, IPC_MSG_SENSOR_BULK_READ_REQ, IPC_MSG_SENSOR_DATA, count, startIndex,
+                              IPC_TXN_READ_TIMEOUT_MS);
     }
     
     _lastBulkRequest = millis();
     
     // log(LOG_DEBUG, false, "Cache: Requested bulk update for %d objects starting at %d\n", 
     //     count, startIndex);
+    return sent;
 }
 
-void ObjectCache::requestBulkUpdateSparse(uint8_t startIndex, uint8_t requestCount, uint8_t expectedResponses) {
+bool ObjectCache::requestBulkUpdateSparse(uint8_t startIndex, uint8_t requestCount, uint8_t expectedResponses) {
     if (startIndex >= MAX_CACHED_OBJECTS || requestCount == 0) {
-        return;
+        return false;
+    }
+    
+    // Hold the request until the IO MCU has a free range slot
+    if (!ipcBulkWindowOpen()) {
+        return false;
     }
     
     // Clamp request count to valid range
@@ -139,12 +265,51 @@ void ObjectCache::requestBulkUpdateSparse(uint8_t startIndex, uint8_t requestCou
     request.startIndex = startIndex;
     request.count = requestCount;
     
-    if (ipc.sendPacket(IPC_MSG_SENSOR_BULK_READ_REQ, (uint8_t*)&request, sizeof(request))) {
+    bool sent = ipc.sendPacket(IPC_MSG_SENSOR_BULK_READ_REQ, (uint8_t*)&request, sizeof(request));
+    if (sent) {
         // Track transaction - expecting fewer responses than requested due to sparse objects
-        addPendingTransaction(txnId, IPC_MSG_SENSOR_BULK_READ_REQ, IPC_MSG_SENSOR_DATA, expectedResponses, startIndex);
+        addPendingTransaction(txnId, IPC_MSG_SENSOR_BULK_READ_REQ, IPC_MSG_SENSOR_DATA, expectedResponses, startIndex,
+                              IPC_TXN_READ_TIMEOUT_MS);
+    }
+    
+    _lastBulkRequest = millis();
+    return sent;
+}
+
+bool ObjectCache::requestDeltaUpdate(uint8_t startIndex, uint8_t count) {
+    if (startIndex >= MAX_CACHED_OBJECTS || count == 0) {
+        return false;
+    }
+    
+    // Hold the request until the IO MCU has a free range slot
+    if (!ipcBulkWindowOpen()) {
+        return false;
+    }
+    
+    // Clamp count to valid range
+    if (startIndex + count > MAX_CACHED_OBJECTS) {
+        count = MAX_CACHED_OBJECTS - startIndex;
+    }
+    
+    // Generate transaction ID and track delta request
+    uint16_t txnId = generateTransactionId();
+    
+    IPC_SensorDeltaReq_t request;
+    request.transactionId = txnId;
+    request.startIndex = startIndex;
+    request.count = count;
+    request.flags = _deltaResync ? IPC_DELTA_REQ_RESYNC : 0;
+    
+    bool sent = ipc.sendPacket(IPC_MSG_SENSOR_DELTA_REQ, (uint8_t*)&request, sizeof(request));
+    if (sent) {
+        // Response is one or more SENSOR_DELTA frames followed by BULK_CREDIT
+        addPendingTransaction(txnId, IPC_MSG_SENSOR_DELTA_REQ, IPC_MSG_SENSOR_DELTA, 1, startIndex,
+                              IPC_TXN_READ_TIMEOUT_MS, deltaTransactionDone);
+        _deltaResync = false;
     }
     
     _lastBulkRequest = millis();
+    return sent;
 }
 
 void ObjectCache::refreshStaleObjects(uint8_t startIndex, uint8_t count) {
@@ -189,6 +354,9 @@ void ObjectCache::invalidate(uint8_t index) {
     _cache[index].valid = false;
     _cache[index].lastUpdate = 0;
     // Keep other fields intact for potential debugging
+    
+    // IO MCU only resends changed objects - make the next delta poll resend everything
+    _deltaResync = true;
 }
 
 void ObjectCache::invalidateRange(uint8_t startIndex, uint8_t count) {
@@ -211,6 +379,9 @@ void ObjectCache::clear() {
         memset(&_cache[i], 0, sizeof(CachedObject));
         _cache[i].valid = false;
     }
+    
+    // Cache no longer mirrors what the IO MCU has sent
+    _deltaResync = true;
 }
 
 uint8_t ObjectCache::getValidCount() {
@@ -39,6 +39,20 @@ public:
      */
     void updateObject(const IPC_SensorData_t* data);
     
+    /**
+     * @brief Apply one IPC_MSG_SENSOR_DELTA record to the cache
+     * Records for indices beyond the cache are parsed and skipped.
+     * @param record Pointer to the start of the record
+     * @param len Bytes remaining in the frame
+     * @return Bytes consumed, or 0 if the record is malformed
+     */
+    uint16_t applyDeltaRecord(const uint8_t* record, uint16_t len);
+    
+    /**
+     * @brief Mark valid objects in range as fresh (unchanged per delta FINAL frame)
+     */
+    void touchRange(uint8_t startIndex, uint8_t count);
+    
     /**
      * @brief Update cache with object name from index sync
      */
@@ -61,8 +75,9 @@ public:
     
     /**
      * @brief Request bulk sensor update via IPC
+     * @return true if sent (false if the bulk window or TX queue is full)
      */
-    void requestBulkUpdate(uint8_t startIndex, uint8_t count);
+    bool requestBulkUpdate(uint8_t startIndex, uint8_t count);
     
     /**
      * @brief Request bulk sensor update with explicit expected response count
@@ -70,8 +85,24 @@ public:
      * @param startIndex First object index
      * @param requestCount Number of consecutive indices to request
      * @param expectedResponses Number of valid objects expected to respond
+     * @return true if sent (false if the bulk window or TX queue is full)
+     */
+    bool requestBulkUpdateSparse(uint8_t startIndex, uint8_t requestCount, uint8_t expectedResponses);
+    
+    /**
+     * @brief Request changed objects in range as delta-encoded batches
+     * Sends a resync request (full records) if markDeltaResync() was called
+     * or the cache was cleared since the last request.
+     * @return true if sent (false if the bulk window or TX queue is full)
+     */
+    bool requestDeltaUpdate(uint8_t startIndex, uint8_t count);
+    
+    /**
+     * @brief Force the next delta request to resend every object in full
+     * Called on sequence gaps, malformed frames and delta transaction timeouts.
      */
-    void requestBulkUpdateSparse(uint8_t startIndex, uint8_t requestCount, uint8_t expectedResponses);
+    void markDeltaResync() { _deltaResync = true; }
+    bool deltaResyncPending() const { return _deltaResync; }
     
     /**
      * @brief Request update for stale objects in range
@@ -117,6 +148,7 @@ public:
 private:
     CachedObject _cache[MAX_CACHED_OBJECTS];
     unsigned long _lastBulkRequest;
+    bool _deltaResync;                  // Next delta request must resync
 };
 
 extern ObjectCache objectCache;
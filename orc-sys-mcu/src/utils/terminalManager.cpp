@@ -93,7 +93,8 @@ void manageTerminal(void)
       }
       else if (strcmp(serialString, "hello") == 0) {
         log(LOG_INFO, true, "Sending HELLO to SAME51...\n");
-        if (ipc.sendHello(IPC_PROTOCOL_VERSION, 0x00010001, "RP2040-ORC-SYS")) {
+        if (ipc.sendHello(IPC_PROTOCOL_VERSION, 0x00010001, "RP2040-ORC-SYS", ipcConfigDigest(),
+                          IPC_BAUD_SUPPORTED_SYS)) {
           log(LOG_INFO, false, "HELLO sent successfully (waiting for HELLO_ACK)\n");
         } else {
           log(LOG_ERROR, true, "Failed to send HELLO (TX queue full)\n");
@@ -133,8 +134,46 @@ void manageTerminal(void)
         log(LOG_INFO, false, "TX Packets: %lu\n", stats.txPacketCount);
         log(LOG_INFO, false, "RX Errors: %lu\n", stats.rxErrorCount);
         log(LOG_INFO, false, "CRC Errors: %lu\n", stats.crcErrorCount);
+        log(LOG_INFO, false, "TX Queue: %u packets (peak %u, %u/%u bytes peak, %lu full)\n",
+            ipc.txQueueCount(), stats.txQueuePeak, stats.txQueueHighWater, IPC_TX_RING_SIZE,
+            stats.txQueueFullCount);
+        printIpcTransactionStats();
+        printIpcLinkStats();
         log(LOG_INFO, false, "Last RX: %lu ms ago\n", stats.lastRxTime > 0 ? millis() - stats.lastRxTime : 0);
         log(LOG_INFO, false, "Last TX: %lu ms ago\n", stats.lastTxTime > 0 ? millis() - stats.lastTxTime : 0);
+        IPC_CaptureStats_t cap;
+        ipcCaptureGetStats(&cap);
+        if (cap.bufferSize > 0) {
+          log(LOG_INFO, false, "Capture: %s, %lu records (%lu/%lu bytes), %lu frames seen, %lu overwritten, %lu missed\n",
+              cap.active ? "recording" : "stopped", cap.records, cap.bytesUsed, cap.bufferSize,
+              cap.frames, cap.overwritten, cap.missed);
+        }
+      }
+      else if (strcmp(serialString, "ipc-cap") == 0) {
+        ipcCaptureStart();
+      }
+      else if (strcmp(serialString, "ipc-cap-stop") == 0) {
+        ipcCaptureStop();
+        log(LOG_INFO, false, "IPC capture stopped (ipc-cap-save to write it to SD)\n");
+      }
+      else if (strcmp(serialString, "ipc-cap-save") == 0) {
+        char path[64];
+        if (ipcCaptureDumpToSD(path, sizeof(path))) {
+          log(LOG_INFO, true, "IPC capture saved: %s\n", path);
+        } else {
+          log(LOG_ERROR, false, "IPC capture not saved (no capture or SD card not ready)\n");
+        }
+      }
+      else if (strcmp(serialString, "ipc-cap-free") == 0) {
+        ipcCaptureFree();
+        log(LOG_INFO, false, "IPC capture buffer released\n");
+      }
+      else if (strcmp(serialString, "tasks") == 0 || strcmp(serialString, "tasks-reset") == 0) {
+        bool reset = (strcmp(serialString, "tasks-reset") == 0);
+        if (!requestIoTaskStats(reset, true)) {
+          log(LOG_WARNING, false, "IPC not connected, showing last IO MCU task statistics\n");
+          printIoTaskStats();
+        }
       }
       else if (strcmp(serialString, "ipc-dump") == 0) {
         log(LOG_INFO, true, "Reading raw bytes from Serial1 for 2 seconds...\n");
@@ -189,6 +228,8 @@ void manageTerminal(void)
         log(LOG_INFO, false, "  ping-raw    - Send raw PING bytes (debug)\n");
         log(LOG_INFO, false, "  ipc-stats   - Print IPC statistics\n");
         log(LOG_INFO, false, "  ipc-dump    - Dump raw bytes from Serial1 for 2s\n");
+        log(LOG_INFO, false, "  ipc-cap     - Start capturing IPC frames to RAM (ipc-cap-stop, -save to SD, -free)\n");
+        log(LOG_INFO, false, "  tasks       - Print IO MCU task timing (tasks-reset also clears it)\n");
         log(LOG_INFO, false, "  ipc-test    - Simulate IPC message (e.g., ipc-test temp 25.5)\n");
         log(LOG_INFO, false, "  reboot      - Reboot system\n");
       }
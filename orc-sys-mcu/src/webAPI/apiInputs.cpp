@@ -83,6 +83,12 @@ void setupInputsAPI(void)
         server.on(getPath.c_str(), HTTP_GET, [i]() { handleGetComPortConfig(i); });
         server.on(postPath.c_str(), HTTP_POST, [i]() { handleSaveComPortConfig(i); });
     }
+    
+    // ADC burst capture
+    server.on("/api/adc/capture", HTTP_GET, handleGetADCCapture);
+    server.on("/api/adc/capture", HTTP_POST, handleArmADCCapture);
+    server.on("/api/adc/capture/abort", HTTP_POST, handleAbortADCCapture);
+    server.on("/api/adc/capture/data", HTTP_GET, handleGetADCCaptureData);
 }
 
 // =============================================================================
@@ -237,6 +243,9 @@ void handleGetADCConfig(uint8_t index) {
     cal["scale"] = ioConfig.adcInputs[index].cal.scale;
     cal["offset"] = ioConfig.adcInputs[index].cal.offset;
     
+    doc["filterType"] = ioConfig.adcInputs[index].filterType;
+    doc["filterLength"] = ioConfig.adcInputs[index].filterLength;
+    
     String response;
     serializeJson(doc, response);
     server.send(200, "application/json", response);
@@ -285,6 +294,15 @@ void handleSaveADCConfig(uint8_t index) {
         ioConfig.adcInputs[index].showOnDashboard = doc["showOnDashboard"];
     }
     
+    // Per-type length limits are applied by the IO MCU
+    if (doc.containsKey("filterType")) {
+        uint8_t type = doc["filterType"];
+        ioConfig.adcInputs[index].filterType = (type <= IPC_ADC_FILTER_CIC) ? type : IPC_ADC_FILTER_NONE;
+    }
+    if (doc.containsKey("filterLength")) {
+        ioConfig.adcInputs[index].filterLength = constrain((uint32_t)doc["filterLength"], 1, 32);
+    }
+    
     saveIOConfig();
     
     IPC_ConfigAnalogInput_t cfg;
@@ -294,6 +312,8 @@ void handleSaveADCConfig(uint8_t index) {
     cfg.unit[sizeof(cfg.unit) - 1] = '\0';
     cfg.calScale = ioConfig.adcInputs[index].cal.scale;
     cfg.calOffset = ioConfig.adcInputs[index].cal.offset;
+    cfg.filterType = ioConfig.adcInputs[index].filterType;
+    cfg.filterLength = ioConfig.adcInputs[index].filterLength;
     
     bool sent = ipc.sendPacket(IPC_MSG_CONFIG_ANALOG_INPUT, (uint8_t*)&cfg, sizeof(cfg));
     
@@ -416,6 +436,7 @@ void handleGetRTDConfig(uint8_t index) {
     doc["unit"] = ioConfig.rtdSensors[rtdIndex].unit;
     doc["wires"] = ioConfig.rtdSensors[rtdIndex].wireConfig;
     doc["type"] = ioConfig.rtdSensors[rtdIndex].nominalOhms;
+    doc["samplePeriodMs"] = ioConfig.rtdSensors[rtdIndex].samplePeriodMs;
     doc["showOnDashboard"] = ioConfig.rtdSensors[rtdIndex].showOnDashboard;
     
     JsonObject cal = doc.createNestedObject("cal");
@@ -466,6 +487,10 @@ void handleSaveRTDConfig(uint8_t index) {
         ioConfig.rtdSensors[rtdIndex].nominalOhms = doc["type"];
     }
     
+    if (doc.containsKey("samplePeriodMs")) {
+        ioConfig.rtdSensors[rtdIndex].samplePeriodMs = constrain((uint32_t)doc["samplePeriodMs"], 17, 60000);
+    }
+    
     if (doc.containsKey("cal")) {
         JsonObject cal = doc["cal"];
         if (cal.containsKey("scale")) {
@@ -491,6 +516,7 @@ void handleSaveRTDConfig(uint8_t index) {
     cfg.calOffset = ioConfig.rtdSensors[rtdIndex].cal.offset;
     cfg.wireConfig = ioConfig.rtdSensors[rtdIndex].wireConfig;
     cfg.nominalOhms = ioConfig.rtdSensors[rtdIndex].nominalOhms;
+    cfg.samplePeriodMs = ioConfig.rtdSensors[rtdIndex].samplePeriodMs;
     
     bool sent = ipc.sendPacket(IPC_MSG_CONFIG_RTD, (uint8_t*)&cfg, sizeof(cfg));
     
@@ -826,3 +852,141 @@ void handleGetComPorts() {
     serializeJson(doc, response);
     server.send(200, "application/json", response);
 }
+
+// =============================================================================
+// ADC Burst Capture Handlers
+// =============================================================================
+
+static const char *const adcCapturePhaseNames[] = {"idle", "arming", "armed", "reading", "ready", "failed"};
+static const char *const adcCaptureTriggerNames[] = {"immediate", "rising", "falling", "either"};
+
+void handleGetADCCapture() {
+    AdcCaptureInfo_t info;
+    adcCaptureGetInfo(&info);
+    const IPC_AdcCaptureStatus_t *st = &info.status;
+    
+    StaticJsonDocument<768> doc;
+    doc["phase"] = adcCapturePhaseNames[info.phase];
+    doc["triggered"] = st->state >= IPC_ADC_CAPTURE_TRIGGERED && st->state != IPC_ADC_CAPTURE_FAILED;
+    doc["triggerTimeout"] = (st->flags & IPC_ADC_CAPTURE_FLAG_TIMEOUT) != 0;
+    doc["overrun"] = (st->flags & IPC_ADC_CAPTURE_FLAG_OVERRUN) != 0;
+    doc["rateClamped"] = (st->flags & IPC_ADC_CAPTURE_FLAG_CLAMPED) != 0;
+    JsonArray channels = doc.createNestedArray("channels");
+    for (uint8_t ch = 0; ch < MAX_ADC_INPUTS; ch++) {
+        if (st->channelMask & (1 << ch)) channels.add(ch);
+    }
+    doc["preTriggerScans"] = st->preTriggerScans;
+    doc["lengthScans"] = st->lengthScans;
+    doc["scansCaptured"] = st->scansCaptured;
+    doc["scanPeriodUs"] = st->scanPeriodNs / 1000.0f;
+    doc["missedSamples"] = st->missedSamples;
+    doc["samplesRead"] = info.samplesRead;
+    doc["totalSamples"] = info.totalSamples;
+    doc["saveToSD"] = info.saveToSD;
+    doc["savedPath"] = info.savedPath;
+    
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
+void handleArmADCCapture() {
+    if (!server.hasArg("plain")) {
+        server.send(400, "application/json", "{\"error\":\"No data received\"}");
+        return;
+    }
+    
+    StaticJsonDocument<512> doc;
+    DeserializationError error = deserializeJson(doc, server.arg("plain"));
+    if (error) {
+        server.send(400, "application/json", "{\"error\":\"Invalid JSON\"}");
+        return;
+    }
+    
+    AdcCaptureRequest_t req = {};
+    for (JsonVariant ch : doc["channels"].as<JsonArray>()) {
+        uint8_t index = ch.as<uint8_t>();
+        if (index < MAX_ADC_INPUTS) req.channelMask |= 1 << index;
+    }
+    req.sampleRateHz = doc["rateHz"] | 1000;
+    req.lengthScans = doc["lengthScans"] | 1000;
+    req.preTriggerScans = doc["preTriggerScans"] | 0;
+    req.triggerChannel = doc["triggerChannel"] | 0;
+    req.triggerLevel = doc["triggerLevel"] | 0.0f;
+    req.triggerTimeoutMs = doc["triggerTimeoutMs"] | 0;
+    req.saveToSD = doc["saveToSD"] | false;
+    
+    const char *trigger = doc["trigger"] | "immediate";
+    req.trigger = 0xFF;
+    for (uint8_t t = 0; t < sizeof(adcCaptureTriggerNames) / sizeof(adcCaptureTriggerNames[0]); t++) {
+        if (strcmp(trigger, adcCaptureTriggerNames[t]) == 0) req.trigger = t;
+    }
+    
+    // Range checks the IO MCU would refuse anyway, reported with a reason here
+    if (req.channelMask == 0 || req.trigger == 0xFF || req.lengthScans == 0 ||
+        req.preTriggerScans >= req.lengthScans ||
+        (uint32_t)req.lengthScans * __builtin_popcount(req.channelMask) > IPC_ADC_CAPTURE_MAX_SAMPLES ||
+        (req.trigger != IPC_ADC_TRIG_IMMEDIATE &&
+         (req.triggerChannel >= MAX_ADC_INPUTS || !(req.channelMask & (1 << req.triggerChannel))))) {
+        server.send(400, "application/json", "{\"error\":\"Invalid capture request\"}");
+        return;
+    }
+    
+    if (!adcCaptureArm(&req)) {
+        server.send(503, "application/json", "{\"error\":\"IO MCU not connected\"}");
+        return;
+    }
+    server.send(200, "application/json", "{\"success\":true}");
+}
+
+void handleAbortADCCapture() {
+    if (adcCaptureAbort()) {
+        server.send(200, "application/json", "{\"success\":true}");
+    } else {
+        server.send(503, "application/json", "{\"error\":\"IO MCU not connected\"}");
+    }
+}
+
+// CSV rows are collected into TCP-sized chunks
+struct WebCsvWriter {
+    char buf[1024];
+    size_t used;
+};
+
+static void webCsvFlush(WebCsvWriter *w) {
+    if (w->used > 0) {
+        server.sendContent(w->buf, w->used);
+        w->used = 0;
+    }
+}
+
+static bool webCsvWriter(void *context, const uint8_t *data, size_t length) {
+    WebCsvWriter *w = (WebCsvWriter *)context;
+    if (w->used + length > sizeof(w->buf)) {
+        webCsvFlush(w);
+    }
+    memcpy(&w->buf[w->used], data, length);
+    w->used += length;
+    return server.client().connected();
+}
+
+void handleGetADCCaptureData() {
+    AdcCaptureInfo_t info;
+    adcCaptureGetInfo(&info);
+    if (info.phase != ADC_CAP_READY) {
+        server.send(404, "application/json", "{\"error\":\"No capture available\"}");
+        return;
+    }
+    
+    server.sendHeader("Content-Disposition", "attachment; filename=\"adc_capture.csv\"");
+    server.sendHeader("Cache-Control", "no-cache");
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/csv", "");
+    
+    WebCsvWriter *w = new WebCsvWriter;
+    w->used = 0;
+    adcCaptureExportCsv(webCsvWriter, w);
+    webCsvFlush(w);
+    delete w;
+    server.sendContent("");
+}
@@ -13,6 +13,7 @@
  * - Energy sensor configuration (indices 31-32)
  * - Device sensor configuration (indices 70-99)
  * - COM port configuration (indices 0-3)
+ * - ADC burst capture (arm, status, abort, CSV download)
  */
 
 #include <Arduino.h>
@@ -50,3 +51,9 @@ void handleSaveDeviceSensorConfig(uint8_t index);
 void handleGetComPortConfig(uint8_t index);
 void handleSaveComPortConfig(uint8_t index);
 void handleGetComPorts(void);
+
+// ADC burst capture handlers
+void handleGetADCCapture(void);
+void handleArmADCCapture(void);
+void handleAbortADCCapture(void);
+void handleGetADCCaptureData(void);
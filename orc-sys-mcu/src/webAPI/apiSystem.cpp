@@ -9,6 +9,7 @@
 #include "../utils/statusManager.h"
 #include "../utils/objectCache.h"
 #include "../utils/timeManager.h"
+#include "../utils/ipcManager.h"
 #include "../config/ioConfig.h"
 #include "../storage/sdManager.h"
 #include <ArduinoJson.h>
@@ -22,6 +23,9 @@ void setupSystemAPI(void) {
     // System status endpoint for the UI
     server.on("/api/system/status", HTTP_GET, handleSystemStatus);
 
+    // IO MCU scheduler task statistics
+    server.on("/api/system/tasks", HTTP_GET, handleSystemTasks);
+
     // System reboot endpoint
     server.on("/api/system/reboot", HTTP_POST, []() {
         // Send response first before rebooting
@@ -54,11 +58,33 @@ void setupSystemAPI(void) {
 // Status Handlers
 // =============================================================================
 
+// One MCU's view of the inter-MCU link (IPC_LinkStats_t)
+static void addLinkStats(JsonObject obj, const IPC_LinkStats_t *link) {
+    obj["rttP50Us"] = link->rttP50Us;
+    obj["rttP90Us"] = link->rttP90Us;
+    obj["rttMaxUs"] = link->rttMaxUs;
+    obj["rttSamples"] = link->rttSamples;
+    obj["rxFramesPerSec"] = link->rxFramesPerSec;
+    obj["txFramesPerSec"] = link->txFramesPerSec;
+    obj["rxBytesPerSec"] = link->rxBytesPerSec;
+    obj["txBytesPerSec"] = link->txBytesPerSec;
+    obj["rxUtilPercent"] = link->rxUtilPermille / 10.0f;
+    obj["txUtilPercent"] = link->txUtilPermille / 10.0f;
+    obj["rxUtilPeakPercent"] = link->rxUtilPeakPermille / 10.0f;
+    obj["txUtilPeakPercent"] = link->txUtilPeakPermille / 10.0f;
+    obj["rxErrorPpm"] = link->rxErrorPpm;
+    obj["crcErrors"] = link->crcErrors;
+    obj["txQueueHighWater"] = link->txQueueHighWater;
+    obj["txQueueSize"] = link->txQueueSize;
+    obj["rxBacklogHighWater"] = link->rxBacklogHighWater;
+    obj["baudRate"] = link->baudRate;
+}
+
 void handleSystemStatus() {
     // NOTE: This handler only READS from status/sdInfo structs, it doesn't write.
     // Therefore we don't need to acquire statusLocked - reads are safe without it.
 
-    StaticJsonDocument<1024> doc;
+    DynamicJsonDocument doc(2048);
 
     // Power info
     JsonObject power = doc.createNestedObject("power");
@@ -77,11 +103,37 @@ void handleSystemStatus() {
     // Subsystem status
     doc["mqtt"] = status.mqttConnected;
     
+    // Link quality as measured by each MCU (IO MCU figures arrive with its PING/PONG)
+    IPC_LinkStats_t sysLink, ioLink;
+    ipc.getLinkStats(&sysLink);
+    uint32_t ioLinkAge = ipc.getPeerLinkStats(&ioLink);
+
     // IPC status with detailed state
     JsonObject ipc = doc.createNestedObject("ipc");
     ipc["ok"] = status.ipcOK;
     ipc["connected"] = status.ipcConnected;
     ipc["timeout"] = status.ipcTimeout;
+    JsonObject link = ipc.createNestedObject("link");
+    addLinkStats(link.createNestedObject("sys"), &sysLink);
+    if (ioLinkAge != UINT32_MAX) {
+        JsonObject io = link.createNestedObject("io");
+        addLinkStats(io, &ioLink);
+        io["ageMs"] = ioLinkAge;
+    }
+    
+    // Negotiated link rate (v2.14): rate masks are bit n = ipc_baudRates[n]
+    IpcBaudInfo_t baudInfo;
+    getIpcBaudInfo(&baudInfo);
+    JsonObject baud = link.createNestedObject("baud");
+    baud["rate"] = baudInfo.baudRate;
+    baud["sysRates"] = baudInfo.sysRates;
+    baud["ioRates"] = baudInfo.ioRates;
+    baud["failedRates"] = baudInfo.failedRates;
+    baud["switches"] = baudInfo.switches;
+    baud["failures"] = baudInfo.failures;
+    baud["fallbacks"] = baudInfo.fallbacks;
+    baud["lastResult"] = baudInfo.lastResult;
+    baud["errorPpm"] = baudInfo.errorPpm;
     
     // Modbus status with detailed state
     JsonObject modbus = doc.createNestedObject("modbus");
@@ -102,6 +154,57 @@ void handleSystemStatus() {
     server.send(200, "application/json", response);
 }
 
+void handleSystemTasks() {
+    // Serve the last table and start a refresh, so polling this endpoint keeps it current.
+    // ?reset=1 clears the IO MCU statistics once the refreshed table is captured.
+    bool reset = server.hasArg("reset") && server.arg("reset") == "1";
+    requestIoTaskStats(reset, false);
+
+    const IoTaskStats_t *stats = getIoTaskStats();
+    DynamicJsonDocument doc(32768);
+    doc["valid"] = stats->valid;
+    doc["ageMs"] = stats->valid ? millis() - stats->updatedAt : 0;
+    doc["uptimeMs"] = stats->uptimeMs;
+    doc["idlePercent"] = stats->idlePermille / 10.0f;
+    doc["totalTasks"] = stats->totalTasks;
+
+    JsonArray list = doc.createNestedArray("tasks");
+    for (uint8_t i = 0; i < stats->count; i++) {
+        const IPC_TaskStatsEntry_t *t = &stats->task[i];
+        char name[IPC_TASK_NAME_LEN + 1];
+        memcpy(name, t->name, IPC_TASK_NAME_LEN);
+        name[IPC_TASK_NAME_LEN] = '\0';
+
+        JsonObject task = list.createNestedObject();
+        task["name"] = name;
+        task["intervalUs"] = t->intervalUs;
+        task["budgetUs"] = t->budgetUs;
+        task["cpuPercent"] = t->cpuPermille / 10.0f;
+        task["execCount"] = t->execCount;
+        task["avgExecUs"] = t->avgExecUs;
+        task["maxExecUs"] = t->maxExecUs;
+        task["maxLatenessUs"] = t->maxLatenessUs;
+        task["overruns"] = t->overrunCount;
+        task["missedPeriods"] = t->missedPeriods;
+        task["highPriority"] = (t->flags & IPC_TASK_FLAG_HIGH_PRIORITY) != 0;
+        task["paused"] = (t->flags & IPC_TASK_FLAG_PAUSED) != 0;
+        task["fixedRate"] = (t->flags & IPC_TASK_FLAG_FIXED_RATE) != 0;
+        task["eventDriven"] = (t->flags & IPC_TASK_FLAG_EVENT) != 0;
+
+        // log2 buckets: [0] = 0 us, [n] = 2^(n-1)..2^n - 1 us
+        JsonArray execHist = task.createNestedArray("execHist");
+        JsonArray lateHist = task.createNestedArray("latenessHist");
+        for (uint8_t b = 0; b < IPC_TASK_HIST_BUCKETS; b++) {
+            execHist.add(t->execHist[b]);
+            lateHist.add(t->latenessHist[b]);
+        }
+    }
+
+    String response;
+    serializeJson(doc, response);
+    server.send(200, "application/json", response);
+}
+
 void handleGetSensors() {
     if (statusLocked) {
         server.send(503, "application/json", "{\"error\":\"Status temporarily unavailable\"}");
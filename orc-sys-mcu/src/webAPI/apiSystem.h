@@ -6,6 +6,7 @@
  * 
  * Handles:
  * - System status (/api/system/status)
+ * - IO MCU task statistics (/api/system/tasks)
  * - All status aggregation (/api/status/all)
  * - Sensor data (/api/sensors)
  * - System reboot
@@ -28,6 +29,7 @@ void setupSystemAPI(void);
 // =============================================================================
 
 void handleSystemStatus(void);
+void handleSystemTasks(void);
 
 // Recording configuration
 void handleGetRecordingConfig(void);
@@ -2585,6 +2585,8 @@ async function openADCConfigModal(index) {
         document.getElementById('adcConfigIndex').textContent = `[${index}]`;
         document.getElementById('adcConfigName').value = adcConfigData.name || '';
         document.getElementById('adcConfigUnit').value = adcConfigData.unit || 'mV';
+        document.getElementById('adcConfigFilter').value = adcConfigData.filterType || 0;
+        document.getElementById('adcConfigFilterLength').value = adcConfigData.filterLength || 1;
         document.getElementById('calScale').value = adcConfigData.cal.scale || 1.0;
         document.getElementById('calOffset').value = adcConfigData.cal.offset || 0.0;
         document.getElementById('resultScale').textContent = adcConfigData.cal.scale.toFixed(4);
@@ -2608,6 +2610,8 @@ function closeADCConfigModal() {
     // Reset form
     document.getElementById('adcConfigName').value = '';
     document.getElementById('adcConfigUnit').value = 'mV';
+    document.getElementById('adcConfigFilter').value = 0;
+    document.getElementById('adcConfigFilterLength').value = 1;
     document.getElementById('calP1Raw').value = '';
     document.getElementById('calP1Real').value = '';
     document.getElementById('calP2Raw').value = '';
@@ -2632,6 +2636,8 @@ async function saveADCConfig() {
         name: name,
         unit: unit,
         showOnDashboard: document.getElementById('adcShowOnDashboard').checked,
+        filterType: parseInt(document.getElementById('adcConfigFilter').value) || 0,
+        filterLength: parseInt(document.getElementById('adcConfigFilterLength').value) || 1,
         cal: {
             scale: scale,
             offset: offset
@@ -2919,6 +2925,7 @@ async function openRTDConfigModal(index) {
         document.getElementById('rtdConfigUnit').value = rtdConfigData.unit || '°C';
         document.getElementById('rtdConfigWires').value = rtdConfigData.wires || '3';
         document.getElementById('rtdConfigType').value = rtdConfigData.type || '100';
+        document.getElementById('rtdConfigPeriod').value = rtdConfigData.samplePeriodMs || 200;
         document.getElementById('calScaleRTD').value = rtdConfigData.cal.scale || 1.0;
         document.getElementById('calOffsetRTD').value = rtdConfigData.cal.offset || 0.0;
         document.getElementById('resultScaleRTD').textContent = rtdConfigData.cal.scale.toFixed(4);
@@ -2944,6 +2951,7 @@ function closeRTDConfigModal() {
     document.getElementById('rtdConfigUnit').value = '°C';
     document.getElementById('rtdConfigWires').value = '3';
     document.getElementById('rtdConfigType').value = '100';
+    document.getElementById('rtdConfigPeriod').value = '200';
     document.getElementById('calP1RawRTD').value = '';
     document.getElementById('calP1RealRTD').value = '';
     document.getElementById('calP2RawRTD').value = '';
@@ -2962,6 +2970,7 @@ async function saveRTDConfig() {
     const unit = document.getElementById('rtdConfigUnit').value;
     const wires = parseInt(document.getElementById('rtdConfigWires').value);
     const type = parseInt(document.getElementById('rtdConfigType').value);
+    const samplePeriodMs = parseInt(document.getElementById('rtdConfigPeriod').value) || 200;
     const scale = parseFloat(document.getElementById('calScaleRTD').value) || 1.0;
     const offset = parseFloat(document.getElementById('calOffsetRTD').value) || 0.0;
     
@@ -2971,6 +2980,7 @@ async function saveRTDConfig() {
         unit: unit,
         wires: wires,
         type: type,
+        samplePeriodMs: samplePeriodMs,
         showOnDashboard: document.getElementById('rtdShowOnDashboard').checked,
         cal: {
             scale: scale,